@@ -0,0 +1,35 @@
+# Check that no heap allocator is linked in an executable.
+#
+# Usage: cmake -DMAP_FILE=<linker map file> -P check_no_heap.cmake
+#
+# The map file is generated by GNU ld with -Wl,-Map=<file>. Sections discarded by --gc-sections are listed
+# before "Linker script and memory map", so only the symbols placed in the image are searched.
+
+IF(NOT DEFINED MAP_FILE OR NOT EXISTS ${MAP_FILE})
+    MESSAGE(FATAL_ERROR "Linker map file not found (${MAP_FILE}). Pass it with -DMAP_FILE=<map_file>")
+ENDIF()
+
+FILE(READ ${MAP_FILE} MAP_CONTENT)
+STRING(FIND "${MAP_CONTENT}" "Linker script and memory map" MAP_START)
+IF(MAP_START EQUAL -1)
+    MESSAGE(FATAL_ERROR "${MAP_FILE} is not a GNU ld map file")
+ENDIF()
+STRING(SUBSTRING "${MAP_CONTENT}" ${MAP_START} -1 MAP_CONTENT)
+STRING(FIND "${MAP_CONTENT}" "Cross Reference Table" MAP_END)
+IF(NOT MAP_END EQUAL -1)
+    STRING(SUBSTRING "${MAP_CONTENT}" 0 ${MAP_END} MAP_CONTENT)
+ENDIF()
+
+SET(HEAP_SYMBOLS malloc _malloc_r calloc _calloc_r realloc _realloc_r free _free_r _sbrk _sbrk_r)
+SET(FOUND_SYMBOLS "")
+FOREACH(symbol ${HEAP_SYMBOLS})
+    # Symbols are listed as "<address> <name>" or as input sections ".text.<name>"
+    IF("${MAP_CONTENT}" MATCHES "(0x[0-9a-fA-F]+[ \t]+|\\.text\\.)${symbol}[ \t\r\n]")
+        LIST(APPEND FOUND_SYMBOLS ${symbol})
+    ENDIF()
+ENDFOREACH()
+
+IF(FOUND_SYMBOLS)
+    MESSAGE(FATAL_ERROR "Heap allocator linked (${FOUND_SYMBOLS}) although the static pool is enabled. See ${MAP_FILE}")
+ENDIF()
+MESSAGE(STATUS "No heap allocator linked (${MAP_FILE})")
@@ -0,0 +1,55 @@
+/**
+ * @file debounce.h
+ * @author agent (agent@local)
+ * @brief Header file for the timestamp debouncer of the edges of a digital input.
+ *
+ * A mechanical contact bounces for a few milliseconds when it closes or opens, and every bounce is an edge that interrupts. The debouncer runs in the ISR of the edge with the system time and needs no timer: an edge that changes the debounced level is accepted and opens a window of `window_ms`, and every edge inside the window, or that leaves the level as it was, is rejected as a bounce. Rejecting an edge is a subtraction, a comparison and a counter, and the rejected edges push no event, so the FSM does not see them.
+ *
+ * The level read by an edge inside the window is not looked at again when the window closes: if a glitch shorter than the window is accepted, the debounced level is wrong until the next edge.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the debouncer of a digital input.
+ */
+typedef struct
+{
+    uint32_t window_ms;    /*!< Time after an accepted edge in which the edges are bounces. With 0 every change of level is accepted */
+    uint32_t last_edge_ms; /*!< Time of the last accepted edge */
+    bool level;            /*!< Debounced level */
+    uint32_t accepted;     /*!< Number of edges accepted as a change of level */
+    uint32_t rejected;     /*!< Number of edges rejected as bounces */
+} debounce_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initializes a debouncer: sets the window and the level and clears the counters. The first edge is never inside a window.
+ *
+ * @param p_debounce Pointer to the debouncer.
+ * @param window_ms Time after an accepted edge in which the edges are bounces.
+ * @param level Debounced level at start.
+ */
+void debounce_init(debounce_t *p_debounce, uint32_t window_ms, bool level);
+
+/**
+ * @brief Debounces an edge of the input. To be called from the ISR of the edge.
+ *
+ * @param p_debounce Pointer to the debouncer.
+ * @param now_ms System time of the edge.
+ * @param level Level of the input read after the edge.
+ * @return true if the edge is accepted: the debounced level is now `level`.
+ * @return false if the edge is a bounce.
+ */
+bool debounce_edge(debounce_t *p_debounce, uint32_t now_ms, bool level);
+
+#endif /* DEBOUNCE_H */
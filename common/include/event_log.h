@@ -0,0 +1,143 @@
+/**
+ * @file event_log.h
+ * @author agent (agent@local)
+ * @brief Header file for the binary log of the events of the automatic door.
+ *
+ * Instead of a line of text such as "PRESENCE!!! Presence detected at 123456. Opening door...\n" (57 bytes and a `vfprintf()`), each event of the door is logged as a record of 2 to 11 bytes encoded with a few shifts and stores:
+ * - The time since the previous record, from `port_system_get_millis()`, as a little-endian base-128 varint (7 bits per byte, bit 7 set in all the bytes but the last one): 1 byte up to 127 ms, 2 bytes up to 16 s, 3 bytes up to 35 min. The time of the first record is counted from 0.
+ * - A code byte: the event in bits 7..4 (one of `EVENT_QUEUE_EVENTS` or of the log-only `EVENT_LOG_CODES`), the state of the door in bits 3..1 and, in bit 0, a flag that tells whether a payload follows.
+ * - The payload, if any, as a varint of up to 32 bits.
+ *
+ * The encoder takes no memory but the record it writes and has no branches that depend on the data. It does not advance its time until the caller commits the record (`event_log_commit()`): a record dropped by the output (e.g. a full ring of the UART) does not shift the time of the next ones.
+ *
+ * The reader decodes a stream of records split in chunks of any size: a record cut at the end of a chunk is left for the next one (see `test/simulation/decode_event_log.c`).
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define EVENT_LOG_VARINT_MAX_SIZE 5                                    /*!< Maximum number of bytes of a varint of 32 bits */
+#define EVENT_LOG_MAX_SIZE (2 * EVENT_LOG_VARINT_MAX_SIZE + 1)         /*!< Maximum number of bytes of a record, and size of the buffer that the encoder needs */
+#define EVENT_LOG_MAX_EVENT 15U                                        /*!< Highest event code */
+#define EVENT_LOG_MAX_STATE 7U                                         /*!< Highest state code */
+
+/**
+ * @brief Codes of the events that are only logged, after the input events of `EVENT_QUEUE_EVENTS`.
+ */
+enum EVENT_LOG_CODES
+{
+    EVENT_LOG_PRESENCE = 8, /*!< A presence or a press of the button has been detected */
+    EVENT_LOG_STATE,        /*!< The door has changed to the state of the record */
+    EVENT_LOG_LOST,         /*!< Records have been dropped before this one. Payload: bytes lost so far */
+};
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define an encoder of records.
+ */
+typedef struct
+{
+    uint32_t last_ms; /*!< Timestamp of the last committed record */
+} event_log_t;
+
+/**
+ * @brief Structure to define a decoded record.
+ */
+typedef struct
+{
+    uint64_t time_ms;  /*!< Time of the record since the first one (64 bits: it does not wrap around after 49 days) */
+    uint8_t event;     /*!< Event code */
+    uint8_t state;     /*!< State code */
+    bool has_payload;  /*!< Whether the record has a payload */
+    uint32_t payload;  /*!< Payload, or 0 */
+} event_log_entry_t;
+
+/**
+ * @brief Structure to define a reader of records.
+ */
+typedef struct
+{
+    const uint8_t *p_buffer; /*!< Chunk with the records */
+    uint32_t length;         /*!< Bytes of the chunk */
+    uint32_t pos;            /*!< Position of the next record in the chunk */
+    uint64_t time_ms;        /*!< Time of the last record read */
+} event_log_reader_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes an encoder: the next record is counted from time 0.
+ *
+ * @param p_log Pointer to the encoder.
+ */
+void event_log_init(event_log_t *p_log);
+
+/**
+ * @brief Encodes a record without payload. The time of the encoder does not change.
+ *
+ * @param p_log Pointer to the encoder.
+ * @param p_record Buffer of `EVENT_LOG_MAX_SIZE` bytes where the record is written (all of it may be written to).
+ * @param timestamp_ms System time of the event. It must not be lower than the time of the last committed record.
+ * @param event Event code, up to `EVENT_LOG_MAX_EVENT`.
+ * @param state State code, up to `EVENT_LOG_MAX_STATE`.
+ * @return uint32_t Number of bytes of the record.
+ */
+uint32_t event_log_encode(const event_log_t *p_log, uint8_t *p_record, uint32_t timestamp_ms, uint8_t event, uint8_t state);
+
+/**
+ * @brief Encodes a record with a payload. The time of the encoder does not change.
+ *
+ * @param p_log Pointer to the encoder.
+ * @param p_record Buffer of `EVENT_LOG_MAX_SIZE` bytes where the record is written (all of it may be written to).
+ * @param timestamp_ms System time of the event. It must not be lower than the time of the last committed record.
+ * @param event Event code, up to `EVENT_LOG_MAX_EVENT`.
+ * @param state State code, up to `EVENT_LOG_MAX_STATE`.
+ * @param payload Payload.
+ * @return uint32_t Number of bytes of the record.
+ */
+uint32_t event_log_encode_payload(const event_log_t *p_log, uint8_t *p_record, uint32_t timestamp_ms, uint8_t event, uint8_t state, uint32_t payload);
+
+/**
+ * @brief Commits the last record encoded, once it has been written to the output: the next record is counted from its time.
+ *
+ * @param p_log Pointer to the encoder.
+ * @param timestamp_ms System time of the record.
+ */
+void event_log_commit(event_log_t *p_log, uint32_t timestamp_ms);
+
+/**
+ * @brief Initializes a reader with the first chunk of a stream: the first record is counted from time 0.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_buffer Chunk with the records.
+ * @param length Bytes of the chunk.
+ */
+void event_log_reader_init(event_log_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length);
+
+/**
+ * @brief Gives the reader the next chunk of the stream. The time goes on from the last record read. The bytes of the previous chunk from `pos` on (a record cut at its end) must be at the start of the new one.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_buffer Chunk with the records.
+ * @param length Bytes of the chunk.
+ */
+void event_log_reader_refill(event_log_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length);
+
+/**
+ * @brief Reads the next record of the chunk.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_entry Pointer where the record is stored.
+ * @return true if a record has been read.
+ * @return false if there are no more records in the chunk or the next one is cut at its end (or it is not valid: a varint of more than 32 bits).
+ */
+bool event_log_read(event_log_reader_t *p_reader, event_log_entry_t *p_entry);
+
+#endif /* EVENT_LOG_H */
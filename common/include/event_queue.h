@@ -0,0 +1,111 @@
+/**
+ * @file event_queue.h
+ * @author agent (agent@local)
+ * @brief Header file for the lock-free queue of input events of the automatic door.
+ *
+ * The interrupt service routines push typed events (PIR edges, button press/release, motor timeout, end of travel) and the main loop pops them. The queue is a bounded ring with a sequence number per slot: producers reserve a slot with a compare-and-swap, so ISRs with different priorities can push even if they preempt each other; there is a single consumer. No interrupt is ever disabled.
+ *
+ * When the queue is full the new event is dropped and the drop counter is incremented.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define EVENT_QUEUE_SIZE 16 /*!< Number of slots of the queue. It must be a power of 2 */
+
+/* Enums */
+/**
+ * @brief Enumerates the input events of the automatic door.
+ *
+ */
+enum EVENT_QUEUE_EVENTS
+{
+    EVENT_NONE = 0,           /*!< No event */
+    EVENT_PIR_RISING,         /*!< The PIR sensor starts detecting presence */
+    EVENT_PIR_FALLING,        /*!< The PIR sensor stops detecting presence */
+    EVENT_BUTTON_PRESS,       /*!< The button has been pressed */
+    EVENT_BUTTON_RELEASE,     /*!< The button has been released */
+    EVENT_MOTOR_TIMEOUT,      /*!< The motor timeout timer has expired */
+    EVENT_MOTOR_END_OF_TRAVEL /*!< The door has reached the end of the travel of the motor (only motors with position feedback) */
+};
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a slot of the queue.
+ */
+typedef struct
+{
+    atomic_uint seq; /*!< Sequence number of the slot. It tells whether the slot is free for a producer or ready for the consumer */
+    uint8_t event;   /*!< Event stored in the slot */
+} event_queue_slot_t;
+
+/**
+ * @brief Structure to define the queue of input events.
+ */
+typedef struct
+{
+    event_queue_slot_t slots[EVENT_QUEUE_SIZE]; /*!< Slots of the ring */
+    atomic_uint enqueue_pos;                    /*!< Next position to be reserved by a producer */
+    uint32_t dequeue_pos;                       /*!< Next position to be read by the consumer (only the consumer accesses it) */
+    atomic_uint dropped;                        /*!< Number of events dropped because the queue was full */
+} event_queue_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern event_queue_t event_queue_automatic_door; /*!< Queue fed by the ISRs of the automatic door. Public for access to interrupt handlers. */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (empties) the queue and resets the drop counter.
+ *
+ * @warning It must not be called while a producer or the consumer may be using the queue.
+ *
+ * @param p_queue Pointer to the queue.
+ */
+void event_queue_init(event_queue_t *p_queue);
+
+/**
+ * @brief Pushes an event into the queue. It can be called from any ISR or thread.
+ *
+ * @param p_queue Pointer to the queue.
+ * @param event Event to push (one of `EVENT_QUEUE_EVENTS`).
+ * @return true if the event has been queued.
+ * @return false if the queue was full. The event is dropped and counted.
+ */
+bool event_queue_push(event_queue_t *p_queue, uint8_t event);
+
+/**
+ * @brief Pops the oldest event of the queue. Only one consumer may call it.
+ *
+ * @param p_queue Pointer to the queue.
+ * @param p_event Pointer where the event is stored.
+ * @return true if an event has been popped.
+ * @return false if the queue is empty (or the oldest event is still being written by a producer).
+ */
+bool event_queue_pop(event_queue_t *p_queue, uint8_t *p_event);
+
+/**
+ * @brief Checks if there is any event pending. Only the consumer may call it.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return true if there is at least one event ready to be popped.
+ */
+bool event_queue_is_pending(event_queue_t *p_queue);
+
+/**
+ * @brief Gets the number of events dropped because the queue was full.
+ *
+ * @param p_queue Pointer to the queue.
+ * @return uint32_t Number of dropped events since the last `event_queue_init()`.
+ */
+uint32_t event_queue_get_dropped(event_queue_t *p_queue);
+
+#endif /* EVENT_QUEUE_H */
@@ -0,0 +1,119 @@
+/**
+ * @file event_record.h
+ * @author agent (agent@local)
+ * @brief Header file for the recorder of input events of the automatic door.
+ *
+ * The recorder logs every input event fed to the FSM (PIR edges, button press/release, motor timeout) with its `port_system_get_millis()` timestamp into a buffer given by the user, so that the exact sequence can be replayed offline on the host (see `test/simulation/replay_events.c`).
+ *
+ * Each record takes 1 byte when the event comes less than 16 ms after the previous one and 2 bytes up to 2 s: the header byte holds the event in bits 7..5, a continuation flag in bit 4 and the 4 lowest bits of the time since the previous record in bits 3..0; if the flag is set, the rest of the time follows as a little-endian base-128 varint (7 bits per byte, bit 7 set in all the bytes but the last one). The time of the first record is counted from 0.
+ *
+ * When the buffer is full the new records are dropped and counted: the buffer always holds a consistent prefix of the sequence.
+ *
+ * The log of a door with position feedback starts with a record of `EVENT_RECORD_POSITION_FEEDBACK`, which is not an input event: the door that replays the log must end its movements on the `EVENT_MOTOR_END_OF_TRAVEL` of the log too.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef EVENT_RECORD_H
+#define EVENT_RECORD_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define EVENT_RECORD_MAX_SIZE 5          /*!< Maximum number of bytes of a record: header and a varint of up to 28 bits (4 bytes) */
+#define EVENT_RECORD_POSITION_FEEDBACK 0 /*!< Event of the record that opens the log of a door with position feedback: `EVENT_NONE`, which is never fed to a door */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a recorder of input events.
+ */
+typedef struct
+{
+    uint8_t *p_buffer; /*!< Buffer where the records are written */
+    uint32_t size;     /*!< Size of the buffer in bytes */
+    uint32_t length;   /*!< Bytes of the buffer in use */
+    uint32_t last_ms;  /*!< Timestamp of the last record */
+    uint32_t count;    /*!< Number of records in the buffer */
+    uint32_t dropped;  /*!< Number of records dropped because the buffer was full */
+} event_record_t;
+
+/**
+ * @brief Structure to define a reader of the records written by a recorder.
+ */
+typedef struct
+{
+    const uint8_t *p_buffer; /*!< Buffer with the records */
+    uint32_t length;         /*!< Bytes of the buffer with records */
+    uint32_t pos;            /*!< Position of the next record */
+    uint32_t last_ms;        /*!< Timestamp of the last record read */
+} event_record_reader_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (empties) a recorder.
+ *
+ * @param p_record Pointer to the recorder.
+ * @param p_buffer Buffer where the records are written.
+ * @param size Size of the buffer in bytes.
+ */
+void event_record_init(event_record_t *p_record, uint8_t *p_buffer, uint32_t size);
+
+/**
+ * @brief Appends an input event to the recorder. Only the consumer of the events (the main loop) may call it.
+ *
+ * @param p_record Pointer to the recorder.
+ * @param timestamp_ms System time of the event. It must not be lower than the time of the previous record.
+ * @param event Event (one of `EVENT_QUEUE_EVENTS`).
+ * @return true if the event has been recorded.
+ * @return false if the buffer is full. The event is dropped and counted.
+ */
+bool event_record_append(event_record_t *p_record, uint32_t timestamp_ms, uint8_t event);
+
+/**
+ * @brief Gets the number of bytes of the buffer in use.
+ *
+ * @param p_record Pointer to the recorder.
+ * @return uint32_t Bytes with records, from the start of the buffer.
+ */
+uint32_t event_record_get_length(event_record_t *p_record);
+
+/**
+ * @brief Gets the number of records in the buffer.
+ *
+ * @param p_record Pointer to the recorder.
+ * @return uint32_t Number of records.
+ */
+uint32_t event_record_get_count(event_record_t *p_record);
+
+/**
+ * @brief Gets the number of records dropped because the buffer was full.
+ *
+ * @param p_record Pointer to the recorder.
+ * @return uint32_t Number of dropped records since the last `event_record_init()`.
+ */
+uint32_t event_record_get_dropped(event_record_t *p_record);
+
+/**
+ * @brief Initializes a reader of records.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_buffer Buffer with the records.
+ * @param length Bytes of the buffer with records.
+ */
+void event_record_reader_init(event_record_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length);
+
+/**
+ * @brief Reads the next record.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_timestamp_ms Pointer where the system time of the event is stored.
+ * @param p_event Pointer where the event is stored.
+ * @return true if a record has been read.
+ * @return false if there are no more records or the next one is truncated.
+ */
+bool event_record_read(event_record_reader_t *p_reader, uint32_t *p_timestamp_ms, uint8_t *p_event);
+
+#endif /* EVENT_RECORD_H */
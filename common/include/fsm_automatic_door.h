@@ -15,14 +15,26 @@
 
 /* Other includes */
 #include <fsm.h>
+#include "event_queue.h"
+#include "event_record.h"
+#include "fsm_stats.h"
+#include "fsm_trace.h"
 #include "port_button.h"
 #include "port_led.h"
 #include "port_pir_sensor.h"
 #include "port_motor.h"
 
 /* Defines and enums ----------------------------------------------------------*/
-#define AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS  /*!< Timeout for the automatic door to open or close */
-#define AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS      /*!< Timeout for the automatic door to leave the door open or closed */
+#define AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS 5000 /*!< Timeout for the automatic door to open or close */
+#define AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS 10000     /*!< Timeout for the automatic door to leave the door open or closed */
+#define AUTOMATIC_DOOR_TRAVEL_FAULT_MARGIN_MS 1000     /*!< Margin over the opening and closing timeout when the motor has position feedback: the door ends the movement on reaching the end of the travel, and the timeout is only the limit of a fault (e.g. the door is blocked) */
+#define FSM_AUTOMATIC_DOOR_MAX_FIRES_PER_EVENT 4       /*!< Maximum number of fires after an input event, while each of them changes the state (one per state) */
+
+/* Inputs of the automatic door, as bits of the input snapshot */
+#define FSM_AUTOMATIC_DOOR_INPUT_PRESENCE 0x01U      /*!< The PIR sensor detects presence */
+#define FSM_AUTOMATIC_DOOR_INPUT_BUTTON 0x02U        /*!< The button is pressed */
+#define FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT 0x04U       /*!< The motor timeout has expired */
+#define FSM_AUTOMATIC_DOOR_INPUT_END_OF_TRAVEL 0x08U /*!< The door has reached the end of the travel of the motor */
 
 /* Enums */
 /**
@@ -52,21 +64,58 @@ typedef struct
     bool presence_or_button_status;        /*!< Presence status in front of the door  or button pressed */
     bool motor_timeout;                    /*!< Timeout of the automatic door for opening or closing */
     uint32_t last_time_presence_or_button; /*!< Last time a presence was detected */
+    uint8_t inputs;                        /*!< Snapshot of the inputs (`FSM_AUTOMATIC_DOOR_INPUT_*`) the guards are evaluated against during a fire */
+    uint8_t inputs_valid;                  /*!< Inputs of the snapshot that are current: read in this fire, or not changed by any event since they were read */
+    bool inputs_snapshot;                  /*!< Whether a fire with input snapshot is in progress. Otherwise the guards read the hardware directly */
+    uint32_t inputs_dropped;               /*!< Events dropped by the queue of the door when the snapshot was last checked */
+    uint32_t input_reads;                  /*!< Number of inputs read from the hardware by the guards */
+    uint32_t input_reads_saved;            /*!< Number of inputs used by the guards that were served from the snapshot without reading the hardware */
+    fsm_stats_t stats;                     /*!< Dwell time histograms per state and counters per transition of the door */
+    event_record_t *p_record;              /*!< Recorder of the input events fed to the door, or NULL if they are not recorded */
+#if defined(FSM_AUTOMATIC_DOOR_TRACE)
+    fsm_trace_t trace; /*!< Trace of the last transitions of the door */
+#endif
 } fsm_automatic_door_t;
 
+/* Global variables -----------------------------------------------------------*/
+extern fsm_trans_t fsm_trans_automatic_door[]; /*!< Transitions table of the automatic door FSM. Public for the alternative dispatchers and benchmarks. */
+
 /* Function prototypes and explanations ---------------------------------------*/
 /**
  * @brief Creates a new automatic door FSM.
  *
+ * By default the door is allocated with `malloc()`. If `FSM_AUTOMATIC_DOOR_POOL_SIZE` is defined (CMake option `DOOR_POOL_SIZE`), it is taken in constant time from a static pool of that many doors and no heap is used.
+ *
  * @param p_button Pointer to the button of the automatic door.
  * @param p_led_open Pointer to the opening LED of the automatic door.
  * @param p_led_close Pointer to the closing LED of the automatic door.
  * @param p_pir Pointer to the PIR sensor of the automatic door.
  * @param p_motor Pointer to the motor of the automatic door.
- * @return fsm_automatic_door_t* Pointer to the new automatic door FSM.
+ * @return fsm_automatic_door_t* Pointer to the new automatic door FSM, or NULL if there is no memory (or no free slot in the pool) left.
  */
 fsm_t *fsm_automatic_door_new(port_button_hw_t *p_button, port_led_hw_t *p_led_open, port_led_hw_t *p_led_close, port_pir_hw_t *p_pir, port_motor_hw_t *p_motor);
 
+/**
+ * @brief Destroys an automatic door FSM created with `fsm_automatic_door_new()`. With the static pool, its slot is given back to the free list. A door already deleted, or a pointer that is not a door of the pool, is ignored.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ */
+void fsm_automatic_door_delete(fsm_t *p_this);
+
+/**
+ * @brief Initializes (or resets to its initial status) an automatic door FSM that is already allocated: state `CLOSED`, peripherals initialized, closing LED on, statistics cleared and no recorder attached.
+ *
+ * `fsm_automatic_door_new()` calls it on the new door. Calling it again on an existing door is a cheap way to restart it without going through the allocator, e.g. from a thread other than the one that created the door.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @param p_button Pointer to the button of the automatic door.
+ * @param p_led_open Pointer to the opening LED of the automatic door.
+ * @param p_led_close Pointer to the closing LED of the automatic door.
+ * @param p_pir Pointer to the PIR sensor of the automatic door.
+ * @param p_motor Pointer to the motor of the automatic door.
+ */
+void fsm_automatic_door_init(fsm_t *p_this, port_button_hw_t *p_button, port_led_hw_t *p_led_open, port_led_hw_t *p_led_close, port_pir_hw_t *p_pir, port_motor_hw_t *p_motor);
+
 /**
  * @brief Gets the last time a presence was detected.
  *
@@ -81,4 +130,91 @@ uint32_t fsm_automatic_door_get_last_time_presence(fsm_t *p_this);
  */
 bool fsm_automatic_door_get_presence_status(fsm_t *p_this);
 
+/**
+ * @brief Checks if the automatic door is doing something that needs time to advance.
+ *
+ * Only in state `CLOSED` there is no timer armed (motor timeout or LED blinking), so the door can only leave it with an input event and the system can sleep with the System tick suspended.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @return true if the door is opening, open or closing.
+ * @return false if the door is closed.
+ */
+bool fsm_automatic_door_check_activity(fsm_t *p_this);
+
+/**
+ * @brief Fires the automatic door FSM.
+ *
+ * Drop-in replacement of `fsm_fire()` for the automatic door. Instead of scanning the whole transitions table through function pointers, the transitions are compiled into a switch on the current state with direct calls to the guards and actions (see `fsm_compiled.h`). With `FSM_AUTOMATIC_DOOR_INDEXED` (CMake option `USE_DOOR_INDEXED`) the transitions leaving the current state are taken instead from a per-state index of the table (see `fsm_indexed.h`), built by the first `fsm_automatic_door_init()`. The priority of the transitions is the same as with `fsm_fire()`.
+ *
+ * The guards are evaluated against an input snapshot taken at the start of the fire: each input (presence, button, timeout) is read from the hardware at most once, the first time a guard needs it, and keeps that value until the end of the fire.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @return true if a transition has been taken, false otherwise.
+ */
+bool fsm_automatic_door_fire(fsm_t *p_this);
+
+/**
+ * @brief Gets the number of inputs read from the hardware by the guards of the door.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @return uint32_t Number of hardware reads since the door was created.
+ */
+uint32_t fsm_automatic_door_get_input_reads(fsm_t *p_this);
+
+/**
+ * @brief Gets the number of hardware reads saved by the input snapshot.
+ *
+ * Every time a guard uses an input that is already in the snapshot, a read of the hardware is saved. `fsm_automatic_door_get_input_reads()` plus this value is the number of reads without snapshot.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @return uint32_t Number of inputs used by the guards and served from the snapshot since the door was created.
+ */
+uint32_t fsm_automatic_door_get_input_reads_saved(fsm_t *p_this);
+
+/**
+ * @brief Sets the recorder of the input events of the door.
+ *
+ * From now on, every event popped by `fsm_automatic_door_fire_events()` is appended to the recorder with the time of `port_system_get_millis()` before it is fed to the FSM. If the motor has position feedback, a record of `EVENT_RECORD_POSITION_FEEDBACK` is appended first. Replaying the records in order on a new door with the same feedback, with the system time set to the time of each record, reproduces the same transitions (see `test/simulation/replay_events.c`).
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @param p_record Pointer to the recorder, or NULL to stop recording.
+ */
+void fsm_automatic_door_set_record(fsm_t *p_this, event_record_t *p_record);
+
+/**
+ * @brief Reads the dwell time histograms per state and the counters per transition of the door.
+ *
+ * The statistics are updated on every transition, in constant time, with the time of `port_system_get_millis()`. They can be read at any time without stopping the FSM: the copy is consistent. The histograms are indexed by the states of the door (`CLOSED`, `OPENING`, `OPEN`, `CLOSING`) and the buckets of `fsm_stats_bucket()`; the counters by the index of the arc in `fsm_trans_automatic_door` (e.g. arc 4 counts the reversals from `CLOSING` to `OPENING`). The state the door is in counts only when it is left.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @param p_data Pointer where the statistics are copied.
+ * @return true if the copy is consistent, false if the door kept transitioning while it was being read (only possible if this function preempts the FSM).
+ */
+bool fsm_automatic_door_get_stats(fsm_t *p_this, fsm_stats_data_t *p_data);
+
+/**
+ * @brief Dumps the trace of the last transitions of the door, from the oldest to the newest.
+ *
+ * The trace is only kept if `FSM_AUTOMATIC_DOOR_TRACE` is defined (CMake option `USE_DOOR_TRACE`); otherwise nothing is recorded and this function returns 0. Each entry has the time, the states, the index of the arc in `fsm_trans_automatic_door` and the input snapshot (`FSM_AUTOMATIC_DOOR_INPUT_*` values in the low nibble, the same bits in the high nibble for the inputs that were current in the snapshot).
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @param p_entries Array where the entries are copied.
+ * @param max_entries Size of `p_entries`.
+ * @return uint32_t Number of entries copied.
+ */
+uint32_t fsm_automatic_door_get_trace(fsm_t *p_this, fsm_trace_entry_t *p_entries, uint32_t max_entries);
+
+/**
+ * @brief Fires the automatic door FSM only if there are input events pending (event-driven mode).
+ *
+ * Each pending event is popped in order, applied to the inputs of the door (PIR status, button flags, motor timeout or end of travel) and then the FSM is fired. This way every edge is seen by the FSM even if several of them happen between two calls. The FSM is run to completion: while a fire changes the state, it is fired again (at most `FSM_AUTOMATIC_DOOR_MAX_FIRES_PER_EVENT` times), because the new state may take an input that brought no event of its own, as the main loop of the polling mode would. For example, a press of the button while the door is opening is taken as soon as the door is open, and not at the next event. If there is no event pending the FSM is not evaluated at all.
+ *
+ * The input snapshot is carried from one fire to the next one, also across calls: every change of an input comes with an event, so only the input changed by the event is read again from the hardware. The whole snapshot is discarded after a transition, because the actions may change the inputs (e.g. restarting the motor timer clears the timeout), when the queue has dropped an event and on `fsm_automatic_door_fire()`.
+ *
+ * @param p_this Pointer to the FSM structure of the automatic door.
+ * @param p_queue Pointer to the queue of input events of the door.
+ * @return uint32_t Number of events processed.
+ */
+uint32_t fsm_automatic_door_fire_events(fsm_t *p_this, event_queue_t *p_queue);
+
 #endif /* FSM_AUTOMATIC_DOOR_H */
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file fsm_automatic_door_fleet.h
+ * @author agent (agent@local)
+ * @brief Header file for the fleet of automatic doors.
+ *
+ * A fleet runs the automatic door FSM for many doors at once, without peripherals. The data of the doors is stored as a struct of arrays (one contiguous array per field) and `fsm_automatic_door_fleet_fire_all()` advances every door in a single pass over the arrays. The transitions, guards and actions follow `fsm_automatic_door.c` for a door whose motor has no position feedback: a movement ends when its timeout expires, never at the end of the travel. A press of the button is taken once, like `port_button_consume_press()`. The outputs (LEDs and motor timer) are kept as flags and the motor timeout is a deadline compared with the time given to the fire. `test_fsm_automatic_door_fleet.c` checks the fleet against the single-door FSM.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef FSM_AUTOMATIC_DOOR_FLEET_H
+#define FSM_AUTOMATIC_DOOR_FLEET_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Other includes */
+#include "fsm_automatic_door.h"
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Inputs of a door of the fleet */
+#define FLEET_INPUT_PRESENCE 0x01U /*!< The PIR sensor of the door detects presence */
+#define FLEET_INPUT_BUTTON 0x02U   /*!< The button of the door has a press not yet taken by the FSM */
+
+/* Outputs and status flags of a door of the fleet */
+#define FLEET_FLAG_LED_OPEN_ON 0x01U     /*!< The opening LED is on */
+#define FLEET_FLAG_LED_OPEN_BLINK 0x02U  /*!< The timer of the opening LED is blinking it */
+#define FLEET_FLAG_LED_CLOSE_ON 0x04U    /*!< The closing LED is on */
+#define FLEET_FLAG_LED_CLOSE_BLINK 0x08U /*!< The timer of the closing LED is blinking it */
+#define FLEET_FLAG_MOTOR_ARMED 0x10U     /*!< The motor timeout timer is running */
+#define FLEET_FLAG_PRESENCE 0x20U        /*!< Presence status of the door (`presence_or_button_status`) */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a fleet of automatic doors as a struct of arrays. Element `i` of every array belongs to door `i`.
+ */
+typedef struct
+{
+    uint32_t num_doors;                       /*!< Number of doors of the fleet */
+    uint32_t *p_last_time_presence_or_button; /*!< Last time a presence was detected or the button was pressed */
+    uint32_t *p_motor_deadline_ms;            /*!< System time at which the motor timeout expires (valid if `FLEET_FLAG_MOTOR_ARMED`) */
+    uint8_t *p_state;                         /*!< State of the door (`FSM_AUTOMATIC_DOOR_STATES`) */
+    uint8_t *p_inputs;                        /*!< Inputs of the door (`FLEET_INPUT_*`), written by the user of the fleet. The FSM clears `FLEET_INPUT_BUTTON` when it takes the press */
+    uint8_t *p_flags;                         /*!< Outputs and status flags of the door (`FLEET_FLAG_*`) */
+} fsm_automatic_door_fleet_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Creates a fleet of automatic doors. All the doors start `CLOSED`, with the closing LED on and no input.
+ *
+ * The arrays are carved out of a single allocation.
+ *
+ * @param num_doors Number of doors of the fleet.
+ * @return fsm_automatic_door_fleet_t* Pointer to the new fleet, or NULL if there is not enough memory.
+ */
+fsm_automatic_door_fleet_t *fsm_automatic_door_fleet_new(uint32_t num_doors);
+
+/**
+ * @brief Destroys a fleet of automatic doors.
+ *
+ * @param p_fleet Pointer to the fleet.
+ */
+void fsm_automatic_door_fleet_delete(fsm_automatic_door_fleet_t *p_fleet);
+
+/**
+ * @brief Sets the inputs of a door of the fleet.
+ *
+ * The presence is a level. The button is a press: it stays pending until a guard that reads the button takes it, so passing `false` does not cancel a press not yet taken.
+ *
+ * @param p_fleet Pointer to the fleet.
+ * @param door Index of the door.
+ * @param presence true if the PIR sensor of the door detects presence.
+ * @param button true if the button of the door has been pressed.
+ */
+void fsm_automatic_door_fleet_set_inputs(fsm_automatic_door_fleet_t *p_fleet, uint32_t door, bool presence, bool button);
+
+/**
+ * @brief Fires the FSM of every door of the fleet once, in a single pass.
+ *
+ * @param p_fleet Pointer to the fleet.
+ * @param now_ms Current system time in milliseconds. It is used to check the motor timeouts and as time of the last presence.
+ * @return uint32_t Number of doors that have taken a transition.
+ */
+uint32_t fsm_automatic_door_fleet_fire_all(fsm_automatic_door_fleet_t *p_fleet, uint32_t now_ms);
+
+/**
+ * @brief Gets the number of bytes used by each door of the fleet.
+ *
+ * @return size_t Bytes per door (sum of the size of one element of every array).
+ */
+size_t fsm_automatic_door_fleet_bytes_per_door(void);
+
+#endif /* FSM_AUTOMATIC_DOOR_FLEET_H */
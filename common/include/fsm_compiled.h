@@ -0,0 +1,77 @@
+/**
+ * @file fsm_compiled.h
+ * @author agent (agent@local)
+ * @brief Macros to compile a transition table of the FSM library into a fire function.
+ *
+ * The transitions are written once as an X-macro list, with one `ARC(orig_state, in, dest_state, out)` per row in priority order:
+ *
+ * ```c
+ * #define MY_FSM_TRANSITIONS(ARC)              \
+ *     ARC(IDLE, check_start, RUNNING, do_start) \
+ *     ARC(RUNNING, check_stop, IDLE, do_stop)
+ * ```
+ *
+ * From the same list, `FSM_COMPILED_TABLE()` gives the `fsm_trans_t` rows for `fsm_init()` and `FSM_COMPILED_DEFINE_FIRE()` defines a fire function where each row becomes a test of the current state followed by a direct call to the guard and the action. There are no function pointers, so the compiler can inline the guards and the actions and turn the chain of state tests into a jump table. The result is the same as `fsm_fire()` on the table: same priority, same order of state update and action.
+ *
+ * Every row must have an action (use `fsm_compiled_no_action` if there is none) and the list must be in the same translation unit as the guards and actions for them to be inlined.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef FSM_COMPILED_H
+#define FSM_COMPILED_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Other includes */
+#include <fsm.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/**
+ * @brief Expands a row of an X-macro transition list into an initializer of `fsm_trans_t`.
+ */
+#define FSM_COMPILED_TRANS_ROW(orig_state, in, dest_state, out) {(orig_state), (in), (dest_state), (out)},
+
+/**
+ * @brief Expands an X-macro transition list into the initializers of a `fsm_trans_t` table, end-of-table row included.
+ */
+#define FSM_COMPILED_TABLE(TRANSITIONS) {TRANSITIONS(FSM_COMPILED_TRANS_ROW){-1, NULL, -1, NULL}}
+
+/**
+ * @brief Expands a row of an X-macro transition list into the test of the state and the guard, and the direct call to the action. `arc` is the index of the row in the table (a constant for the compiler).
+ */
+#define FSM_COMPILED_TRANS_ARC(orig_state, in, dest_state, out) \
+    if ((state == (orig_state)) && in(p_this))                 \
+    {                                                           \
+        fsm_set_state(p_this, (dest_state));                    \
+        out(p_this);                                            \
+        return arc;                                             \
+    }                                                           \
+    arc++;
+
+/**
+ * @brief Defines `static int name(fsm_t *p_this)`, a fire function compiled from an X-macro transition list. It returns the index in the table of the transition taken, or -1 if no transition has been taken.
+ */
+#define FSM_COMPILED_DEFINE_FIRE(name, TRANSITIONS) \
+    static int name(fsm_t *p_this)                 \
+    {                                              \
+        int state = fsm_get_state(p_this);         \
+        int arc = 0;                               \
+        TRANSITIONS(FSM_COMPILED_TRANS_ARC)        \
+        return -1;                                 \
+    }
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Empty action for the rows of an X-macro transition list that have no action.
+ *
+ * @param p_this Pointer to the FSM.
+ */
+static inline void fsm_compiled_no_action(fsm_t *p_this)
+{
+    (void)p_this;
+}
+
+#endif /* FSM_COMPILED_H */
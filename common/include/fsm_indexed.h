@@ -0,0 +1,75 @@
+/**
+ * @file fsm_indexed.h
+ * @author agent (agent@local)
+ * @brief Header file for the indexed transition dispatcher of the FSM library.
+ *
+ * The stock `fsm_fire()` walks the whole transition table on every call and compares the origin state of each row before running its guard. This module builds, once, a copy of a `fsm_trans_t` table sorted by origin state together with an (offset, count) index per state, so that a fire only visits the arcs that leave the current state.
+ *
+ * The sort is stable: arcs leaving the same state keep the relative order they have in the original table, so guard priority is exactly the same as with `fsm_fire()`.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef FSM_INDEXED_H
+#define FSM_INDEXED_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Other includes */
+#include <fsm.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define FSM_INDEXED_MAX_STATES 8       /*!< Maximum number of states that can be indexed */
+#define FSM_INDEXED_MAX_TRANSITIONS 16 /*!< Maximum number of transitions (without the end-of-table row) that can be indexed */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the per-state index of a transition table.
+ */
+typedef struct
+{
+    fsm_trans_t trans[FSM_INDEXED_MAX_TRANSITIONS]; /*!< Copy of the transitions of the table, sorted by origin state */
+    uint8_t offset[FSM_INDEXED_MAX_STATES];         /*!< Index in `trans` of the first transition leaving each state */
+    uint8_t count[FSM_INDEXED_MAX_STATES];          /*!< Number of transitions leaving each state */
+    uint8_t arc[FSM_INDEXED_MAX_TRANSITIONS];       /*!< Index in the original table of each transition of `trans` */
+    uint8_t num_trans;                              /*!< Number of transitions in the index */
+} fsm_indexed_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Builds the per-state index of a transition table.
+ *
+ * The table must follow the format expected by `fsm_init()`: one row per arc and a last row with a negative origin state (`{-1, NULL, -1, NULL}`).
+ *
+ * @param p_index Pointer to the index to build.
+ * @param p_tt Pointer to the transition table.
+ * @return true if the table has been indexed.
+ * @return false if the table has more transitions than `FSM_INDEXED_MAX_TRANSITIONS` or a state greater or equal than `FSM_INDEXED_MAX_STATES`. The index is left empty in that case.
+ */
+bool fsm_indexed_init(fsm_indexed_t *p_index, fsm_trans_t *p_tt);
+
+/**
+ * @brief Fires the FSM using the per-state index instead of scanning the whole table.
+ *
+ * Only the transitions leaving the current state are evaluated, in table order. The first one whose guard returns true is taken: the state is updated and then the output function (if any) is called, as `fsm_fire()` does.
+ *
+ * @param p_index Pointer to the index of the transition table of the FSM.
+ * @param p_fsm Pointer to the FSM.
+ * @return true if a transition has been taken.
+ * @return false if no guard of the current state returned true.
+ */
+bool fsm_indexed_fire(const fsm_indexed_t *p_index, fsm_t *p_fsm);
+
+/**
+ * @brief Fires the FSM using the per-state index, as `fsm_indexed_fire()`, and tells which transition has been taken.
+ *
+ * @param p_index Pointer to the index of the transition table of the FSM.
+ * @param p_fsm Pointer to the FSM.
+ * @return Index in the original table of the transition taken, or -1 if no guard of the current state returned true.
+ */
+int fsm_indexed_fire_arc(const fsm_indexed_t *p_index, fsm_t *p_fsm);
+
+#endif /* FSM_INDEXED_H */
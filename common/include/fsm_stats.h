@@ -0,0 +1,99 @@
+/**
+ * @file fsm_stats.h
+ * @author agent (agent@local)
+ * @brief Header file for the statistics of the FSMs: dwell time histograms per state and counters per transition.
+ *
+ * The dwell time of a state is the time from the transition that enters it to the transition that leaves it for another state (transitions to the same state do not end the dwell). It is counted in a histogram with logarithmic buckets: bucket 0 is 0 ms, bucket `b` (1 <= `b` < `FSM_STATS_NUM_BUCKETS` - 1) is [2^(b-1), 2^b) ms and the last bucket is everything from 2^(`FSM_STATS_NUM_BUCKETS` - 2) ms on. Every transition also increments the counter of its arc (row of the transitions table).
+ *
+ * Recording a transition takes constant time. There must be a single writer (the FSM); the statistics can be read at any time from another context thanks to a sequence counter: the reader retries if the writer has updated them while they were being copied.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef FSM_STATS_H
+#define FSM_STATS_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#ifndef FSM_STATS_MAX_STATES
+#define FSM_STATS_MAX_STATES 4 /*!< Maximum number of states with dwell time histogram */
+#endif
+#ifndef FSM_STATS_MAX_ARCS
+#define FSM_STATS_MAX_ARCS 8 /*!< Maximum number of transitions (rows of the table) with counter */
+#endif
+#ifndef FSM_STATS_NUM_BUCKETS
+#define FSM_STATS_NUM_BUCKETS 24 /*!< Number of buckets of the dwell time histograms. The last one starts at 2^22 ms (70 minutes) */
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the statistics of a FSM.
+ */
+typedef struct
+{
+    uint32_t dwell[FSM_STATS_MAX_STATES][FSM_STATS_NUM_BUCKETS]; /*!< Dwell time histogram of each state */
+    uint32_t arcs[FSM_STATS_MAX_ARCS];                           /*!< Number of times each transition has been taken */
+    uint32_t state_entry_ms;                                     /*!< System time at which the current state was entered */
+} fsm_stats_data_t;
+
+/**
+ * @brief Structure to define the statistics of a FSM and their sequence counter.
+ */
+typedef struct
+{
+    atomic_uint seq;       /*!< Sequence counter: odd while the writer is updating the statistics */
+    fsm_stats_data_t data; /*!< Statistics */
+} fsm_stats_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (resets) the statistics.
+ *
+ * @param p_stats Pointer to the statistics.
+ * @param now_ms System time at which the FSM enters its initial state.
+ */
+void fsm_stats_init(fsm_stats_t *p_stats, uint32_t now_ms);
+
+/**
+ * @brief Records a transition. Only the FSM that owns the statistics may call it.
+ *
+ * @param p_stats Pointer to the statistics.
+ * @param now_ms System time of the transition.
+ * @param from_state State before the transition.
+ * @param to_state State after the transition.
+ * @param arc Index of the transition in the transitions table.
+ */
+void fsm_stats_record(fsm_stats_t *p_stats, uint32_t now_ms, int from_state, int to_state, int arc);
+
+/**
+ * @brief Reads a consistent copy of the statistics without stopping the FSM.
+ *
+ * @param p_stats Pointer to the statistics.
+ * @param p_data Pointer where the statistics are copied.
+ * @return true if the copy is consistent.
+ * @return false if the writer kept updating the statistics during all the attempts (e.g. the reader is an ISR that has preempted it). `p_data` must not be used.
+ */
+bool fsm_stats_read(fsm_stats_t *p_stats, fsm_stats_data_t *p_data);
+
+/**
+ * @brief Gets the bucket of the dwell time histograms of a dwell time.
+ *
+ * @param dwell_ms Dwell time in milliseconds.
+ * @return uint32_t Index of the bucket.
+ */
+uint32_t fsm_stats_bucket(uint32_t dwell_ms);
+
+/**
+ * @brief Gets the lowest dwell time of a bucket of the dwell time histograms.
+ *
+ * @param bucket Index of the bucket.
+ * @return uint32_t Lowest dwell time in milliseconds counted in the bucket.
+ */
+uint32_t fsm_stats_bucket_min_ms(uint32_t bucket);
+
+#endif /* FSM_STATS_H */
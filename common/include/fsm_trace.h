@@ -0,0 +1,95 @@
+/**
+ * @file fsm_trace.h
+ * @author agent (agent@local)
+ * @brief Header file for the transition trace of the FSMs.
+ *
+ * A trace is a fixed-size ring of the last `FSM_TRACE_SIZE` transitions taken by a FSM: when it is full, the oldest entry is overwritten. Each entry keeps the time, the origin and destination states, the index of the arc of the transitions table (i.e. which guard was true) and the input snapshot the guards were evaluated against.
+ *
+ * Recording an entry takes constant time and can be done from any ISR: the slot is reserved with an atomic increment and published with a sequence number, so writers that preempt each other never share a slot, and a reader that runs at the same time as a writer skips the entry being written instead of returning a torn one.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef FSM_TRACE_H
+#define FSM_TRACE_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#ifndef FSM_TRACE_SIZE
+#define FSM_TRACE_SIZE 16 /*!< Number of entries of a trace. It must be a power of 2 */
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a transition recorded in a trace.
+ */
+typedef struct
+{
+    uint32_t timestamp_ms; /*!< System time of the transition */
+    uint8_t from_state;    /*!< State before the transition */
+    uint8_t to_state;      /*!< State after the transition */
+    uint8_t arc;           /*!< Index of the transition in the transitions table (the guard that was true) */
+    uint8_t inputs;        /*!< Input snapshot: values in the low nibble, inputs actually read by the guards in the high nibble */
+} fsm_trace_entry_t;
+
+/**
+ * @brief Structure to define a slot of a trace.
+ */
+typedef struct
+{
+    atomic_uint seq;         /*!< Position + 1 of the entry stored in the slot, 0 while it is being written */
+    fsm_trace_entry_t entry; /*!< Entry stored in the slot */
+} fsm_trace_slot_t;
+
+/**
+ * @brief Structure to define a trace.
+ */
+typedef struct
+{
+    fsm_trace_slot_t slots[FSM_TRACE_SIZE]; /*!< Slots of the ring */
+    atomic_uint head;                        /*!< Number of entries recorded since the trace was initialized */
+} fsm_trace_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (empties) a trace.
+ *
+ * @param p_trace Pointer to the trace.
+ */
+void fsm_trace_init(fsm_trace_t *p_trace);
+
+/**
+ * @brief Records a transition in a trace, overwriting the oldest entry if it is full. It can be called from any ISR.
+ *
+ * @param p_trace Pointer to the trace.
+ * @param timestamp_ms System time of the transition.
+ * @param from_state State before the transition.
+ * @param to_state State after the transition.
+ * @param arc Index of the transition in the transitions table.
+ * @param inputs Input snapshot.
+ */
+void fsm_trace_record(fsm_trace_t *p_trace, uint32_t timestamp_ms, uint8_t from_state, uint8_t to_state, uint8_t arc, uint8_t inputs);
+
+/**
+ * @brief Dumps the entries of a trace, from the oldest to the newest.
+ *
+ * @param p_trace Pointer to the trace.
+ * @param p_entries Array where the entries are copied.
+ * @param max_entries Size of `p_entries`. If there are more entries, the newest ones are copied.
+ * @return uint32_t Number of entries copied.
+ */
+uint32_t fsm_trace_dump(fsm_trace_t *p_trace, fsm_trace_entry_t *p_entries, uint32_t max_entries);
+
+/**
+ * @brief Gets the number of transitions recorded since the trace was initialized, overwritten ones included.
+ *
+ * @param p_trace Pointer to the trace.
+ * @return uint32_t Number of transitions recorded.
+ */
+uint32_t fsm_trace_get_count(fsm_trace_t *p_trace);
+
+#endif /* FSM_TRACE_H */
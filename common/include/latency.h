@@ -0,0 +1,129 @@
+/**
+ * @file latency.h
+ * @author agent (agent@local)
+ * @brief Header file for the measurement of latencies with the cycle counter.
+ *
+ * A latency is the time between a start point, usually in an ISR (e.g. the edge of the PIR sensor landing in `EXTI15_10_IRQHandler()`), and a stop point in the FSM (e.g. `do_open_door()` activating the LED and motor timers). Both points are timestamped with `port_system_get_cycles()`: DWT CYCCNT on the STM32F4, the monotonic clock in nanoseconds on the native platform.
+ *
+ * Each sample updates the count, min, max and sum, and a log-linear histogram (8 sub-buckets per power of 2) from which the p99 is computed with an error below 12.5 %. Only the start point may run in an ISR: it is a single atomic store, and a start that is never stopped is overwritten by the next one.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define LATENCY_SUB_BUCKET_BITS 3                                    /*!< Bits of the sub-bucket inside each power of 2 of the histogram */
+#define LATENCY_SUB_BUCKETS (1U << LATENCY_SUB_BUCKET_BITS)          /*!< Sub-buckets inside each power of 2 of the histogram */
+#define LATENCY_NUM_BUCKETS ((32U - LATENCY_SUB_BUCKET_BITS + 1U) * LATENCY_SUB_BUCKETS) /*!< Buckets of the histogram, enough for any 32-bit latency */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the measurement of a latency.
+ */
+typedef struct
+{
+    atomic_uint start_cycles;              /*!< Timestamp of the pending start point with its lowest bit set, or 0 if there is none */
+    uint32_t count;                        /*!< Number of samples */
+    uint32_t min_cycles;                   /*!< Lowest latency */
+    uint32_t max_cycles;                   /*!< Highest latency */
+    uint64_t sum_cycles;                   /*!< Sum of the latencies, for the mean */
+    uint32_t histogram[LATENCY_NUM_BUCKETS]; /*!< Log-linear histogram of the latencies, for the percentiles */
+} latency_t;
+
+/**
+ * @brief Structure to define the report of a latency.
+ */
+typedef struct
+{
+    uint32_t count;         /*!< Number of samples */
+    uint32_t min_cycles;    /*!< Lowest latency in cycles */
+    uint32_t mean_cycles;   /*!< Mean latency in cycles */
+    uint32_t max_cycles;    /*!< Highest latency in cycles */
+    uint32_t p99_cycles;    /*!< 99th percentile of the latency in cycles (upper bound of its histogram bucket, never above the max) */
+    uint32_t cycles_per_us; /*!< Cycles per microsecond, to convert the values */
+} latency_report_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern latency_t latency_automatic_door; /*!< Latency from the PIR edge to the opening of the automatic door. Public for access to interrupt handlers. */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (resets) a latency measurement and the cycle counter.
+ *
+ * @param p_latency Pointer to the latency.
+ */
+void latency_init(latency_t *p_latency);
+
+/**
+ * @brief Marks the start point of a latency. It can be called from any ISR. A previous start point that has not been stopped is discarded.
+ *
+ * The lowest bit of the timestamp is used to mark that there is a start point pending, so the resolution is 2 cycles.
+ *
+ * @param p_latency Pointer to the latency.
+ * @param cycles Timestamp of the start point, from `port_system_get_cycles()`.
+ */
+void latency_start(latency_t *p_latency, uint32_t cycles);
+
+/**
+ * @brief Marks the stop point of a latency and records the sample. It does nothing if there is no start point pending.
+ *
+ * @param p_latency Pointer to the latency.
+ * @param cycles Timestamp of the stop point, from `port_system_get_cycles()`.
+ */
+void latency_stop(latency_t *p_latency, uint32_t cycles);
+
+/**
+ * @brief Discards the start point pending, if any, without recording a sample. For a start point whose event has not led to the stop point, so that a later stop does not record it.
+ *
+ * @param p_latency Pointer to the latency.
+ */
+void latency_cancel(latency_t *p_latency);
+
+/**
+ * @brief Records a sample of a latency directly.
+ *
+ * @param p_latency Pointer to the latency.
+ * @param cycles Latency in cycles.
+ */
+void latency_record(latency_t *p_latency, uint32_t cycles);
+
+/**
+ * @brief Computes the report of a latency: min, mean, max and p99 in cycles. All the values are 0 if there are no samples.
+ *
+ * @param p_latency Pointer to the latency.
+ * @param p_report Pointer where the report is written.
+ */
+void latency_get_report(latency_t *p_latency, latency_report_t *p_report);
+
+/**
+ * @brief Prints the report of a latency, in cycles and microseconds, with `printf()`.
+ *
+ * @param name Name of the latency.
+ * @param p_latency Pointer to the latency.
+ */
+void latency_print_report(const char *name, latency_t *p_latency);
+
+/**
+ * @brief Gets the histogram bucket of a latency.
+ *
+ * @param cycles Latency in cycles.
+ * @return uint32_t Index of the bucket.
+ */
+uint32_t latency_bucket(uint32_t cycles);
+
+/**
+ * @brief Gets the lowest latency of a histogram bucket.
+ *
+ * @param bucket Index of the bucket.
+ * @return uint32_t Lowest latency in cycles counted in the bucket.
+ */
+uint32_t latency_bucket_min_cycles(uint32_t bucket);
+
+#endif /* LATENCY_H */
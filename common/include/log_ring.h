@@ -0,0 +1,91 @@
+/**
+ * @file log_ring.h
+ * @author agent (agent@local)
+ * @brief Header file for the ring buffer of the log output (`printf`) drained in the background.
+ *
+ * `_write()` copies the text into the ring and returns at once; the UART drains the ring with DMA, a contiguous chunk per transfer, while the main loop goes on. There is a single producer (the main loop, through `_write()`) and a single consumer (the ISR of the end of a DMA transfer), so the positions are only written by one side each and no interrupt is disabled to copy.
+ *
+ * The cost of a write is bounded: at most `LOG_RING_SIZE` bytes are copied in two blocks. A write that does not fit in the free space is dropped whole, so the log never has half lines, and its bytes are added to the lost-bytes counter.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define LOG_RING_SIZE 1024 /*!< Number of bytes of the ring. It must be a power of 2 */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the ring buffer of the log.
+ */
+typedef struct
+{
+    uint8_t data[LOG_RING_SIZE]; /*!< Bytes of the ring */
+    atomic_uint head;            /*!< Position of the next byte to write (only the producer writes it) */
+    atomic_uint tail;            /*!< Position of the next byte to send (only the consumer writes it) */
+    atomic_uint lost;            /*!< Number of bytes dropped because the ring was full */
+} log_ring_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes (empties) the ring and resets the lost-bytes counter.
+ *
+ * @warning It must not be called while the producer or the consumer may be using the ring.
+ *
+ * @param p_ring Pointer to the ring.
+ */
+void log_ring_init(log_ring_t *p_ring);
+
+/**
+ * @brief Copies a block of bytes into the ring. Only the producer may call it.
+ *
+ * @param p_ring Pointer to the ring.
+ * @param p_data Bytes to write.
+ * @param len Number of bytes.
+ * @return true if the bytes have been queued.
+ * @return false if they do not fit in the free space of the ring. Nothing is written and the bytes are counted as lost.
+ */
+bool log_ring_write(log_ring_t *p_ring, const void *p_data, uint32_t len);
+
+/**
+ * @brief Gets the oldest bytes of the ring that are contiguous in memory, to be sent in a single transfer. They stay in the ring until `log_ring_consume()`. Only the consumer may call it.
+ *
+ * @param p_ring Pointer to the ring.
+ * @param pp_data Pointer where the address of the first byte is stored.
+ * @return uint32_t Number of contiguous bytes, 0 if the ring is empty.
+ */
+uint32_t log_ring_peek(log_ring_t *p_ring, const uint8_t **pp_data);
+
+/**
+ * @brief Frees the oldest bytes of the ring once they have been sent. Only the consumer may call it.
+ *
+ * @param p_ring Pointer to the ring.
+ * @param len Number of bytes sent (at most the last value returned by `log_ring_peek()`).
+ */
+void log_ring_consume(log_ring_t *p_ring, uint32_t len);
+
+/**
+ * @brief Gets the number of bytes waiting in the ring.
+ *
+ * @param p_ring Pointer to the ring.
+ * @return uint32_t Number of bytes written and not consumed yet.
+ */
+uint32_t log_ring_get_used(log_ring_t *p_ring);
+
+/**
+ * @brief Gets the number of bytes dropped because the ring was full.
+ *
+ * @param p_ring Pointer to the ring.
+ * @return uint32_t Number of lost bytes since the last `log_ring_init()`.
+ */
+uint32_t log_ring_get_lost(log_ring_t *p_ring);
+
+#endif /* LOG_RING_H */
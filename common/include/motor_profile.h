@@ -0,0 +1,61 @@
+/**
+ * @file motor_profile.h
+ * @author agent (agent@local)
+ * @brief Header file for the trapezoidal speed profile of a motor, precomputed into a table of PWM duties.
+ *
+ * The motor of the door accelerates, cruises and decelerates: the PWM duty rises linearly for `ramp_ms`, stays at full scale and falls linearly for `ramp_ms` at the end of the travel. The profile is computed once, with integer arithmetic only, into a table with the duty of every step of `step_ms`, in counts of the compare register of the PWM timer (full scale: ARR + 1). The update ISR of the PWM timer loads the next entry into the compare register: its cost is an index and a store, the same in the ramps and in the cruise.
+ *
+ * Taking the speed of the door proportional to the duty, the travel of a step is its duty times `step_ms`. The duties are the differences of the exact travel up to the end of each step, rounded down, so the rounding errors do not accumulate: the whole profile travels exactly `full_scale` * (`total_ms` - `ramp_ms`), the travel of `total_ms` - `ramp_ms` at full speed.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef MOTOR_PROFILE_H
+#define MOTOR_PROFILE_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#ifndef MOTOR_PROFILE_MAX_STEPS
+#define MOTOR_PROFILE_MAX_STEPS 512U /*!< Maximum number of steps of a profile (size of the table) */
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the speed profile of a motor.
+ */
+typedef struct
+{
+    uint16_t duty[MOTOR_PROFILE_MAX_STEPS]; /*!< PWM duty of each step, in counts of the compare register */
+    uint32_t steps;                         /*!< Number of steps of the profile. 0 if it has not been built */
+    uint32_t ramp_steps;                    /*!< Number of steps of the acceleration, and of the deceleration */
+    uint32_t step_ms;                       /*!< Duration of a step */
+    uint32_t full_scale;                    /*!< Duty of the cruise: 100 % */
+} motor_profile_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Computes the table of duties of a trapezoidal profile, with integer arithmetic only.
+ *
+ * @param p_profile Pointer to the profile.
+ * @param total_ms Duration of the profile. It must be a multiple of `step_ms` of at most `MOTOR_PROFILE_MAX_STEPS` steps.
+ * @param step_ms Duration of a step: the period of the update of the duty.
+ * @param ramp_ms Duration of the acceleration, and of the deceleration. It is rounded down to a multiple of `step_ms` and it must be at most half of `total_ms`.
+ * @param full_scale Duty of the cruise, in counts of the compare register (at most 65535).
+ * @return true if the profile has been built, false if the parameters are not valid: then the profile is left with no steps.
+ */
+bool motor_profile_build(motor_profile_t *p_profile, uint32_t total_ms, uint32_t step_ms, uint32_t ramp_ms, uint32_t full_scale);
+
+/**
+ * @brief Gets the travel of the steps of a profile up to a step, as the sum of their duties times `step_ms`.
+ *
+ * @param p_profile Pointer to the profile.
+ * @param steps Number of steps from the start of the profile. The steps beyond the end of the profile have a duty of 0.
+ * @return uint64_t Travel in counts of the compare register times milliseconds.
+ */
+uint64_t motor_profile_get_travel(const motor_profile_t *p_profile, uint32_t steps);
+
+#endif /* MOTOR_PROFILE_H */
@@ -0,0 +1,82 @@
+/**
+ * @file pir_filter.h
+ * @author agent (agent@local)
+ * @brief Header file for the filter of the output of a PIR sensor: minimum high time, retrigger hold and coalescing of bursts.
+ *
+ * The output of a PIR module chatters: short spikes with nobody there, and short drops while somebody is still moving in front of it. Passed through, every edge is an event that fires the FSM, and every rising edge while the door is open re-arms its timeout. The filter turns the raw edges into one presence per person:
+ *
+ * - A rising edge is a presence only when the input has stayed high for `min_high_ms`. Shorter pulses are glitches and are dropped.
+ * - When the input falls, the presence is held for `hold_ms`. A rising edge inside the hold continues the same presence (the burst is coalesced): no event is delivered for it, nor for the drop before it.
+ *
+ * The filter works with the timestamps of the edges and needs no timer of its own: `pir_filter_edge()` runs in the ISR of the edge, and `pir_filter_poll()` in a periodic tick (the SysTick) while `pir_filter_is_pending()`, to deliver the changes whose time has come with no edge. With both times at 0 every change of level is delivered at once.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef PIR_FILTER_H
+#define PIR_FILTER_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the filter of a PIR sensor.
+ */
+typedef struct
+{
+    uint32_t min_high_ms; /*!< Time the input must stay high for a presence. 0 delivers the presence on the rising edge */
+    uint32_t hold_ms;     /*!< Time the presence is held after the input falls. 0 delivers the end of the presence on the falling edge */
+    bool raw;             /*!< Last level of the input */
+    bool present;         /*!< Filtered status: whether there is a presence */
+    uint32_t rise_ms;     /*!< Time of the last rising edge of the input */
+    uint32_t fall_ms;     /*!< Time of the last falling edge of the input */
+    uint32_t raw_edges;   /*!< Number of edges of the input */
+    uint32_t delivered;   /*!< Number of changes of the filtered status (presence and end of presence) */
+    uint32_t glitches;    /*!< Number of pulses shorter than `min_high_ms` dropped */
+    uint32_t coalesced;   /*!< Number of rising edges inside the hold that continued a presence */
+} pir_filter_t;
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initializes a filter with the input at a level and the filtered status equal to it, and clears the counters.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param min_high_ms Time the input must stay high for a presence.
+ * @param hold_ms Time the presence is held after the input falls.
+ * @param level Level of the input at start.
+ */
+void pir_filter_init(pir_filter_t *p_filter, uint32_t min_high_ms, uint32_t hold_ms, bool level);
+
+/**
+ * @brief Filters an edge of the input. To be called from the ISR of the edge.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param now_ms System time of the edge.
+ * @param level Level of the input read after the edge.
+ * @return true if the filtered status has changed: it is in `present`.
+ * @return false otherwise.
+ */
+bool pir_filter_edge(pir_filter_t *p_filter, uint32_t now_ms, bool level);
+
+/**
+ * @brief Whether the filtered status may change with no edge: a rising edge waiting for its minimum high time or a presence in its hold.
+ *
+ * @param p_filter Pointer to the filter.
+ * @return true if `pir_filter_poll()` has to be called.
+ */
+bool pir_filter_is_pending(const pir_filter_t *p_filter);
+
+/**
+ * @brief Delivers the change of the filtered status whose time has come: the presence after the minimum high time, or its end after the hold. To be called from a periodic tick while `pir_filter_is_pending()`.
+ *
+ * @param p_filter Pointer to the filter.
+ * @param now_ms System time.
+ * @return true if the filtered status has changed: it is in `present`.
+ * @return false otherwise.
+ */
+bool pir_filter_poll(pir_filter_t *p_filter, uint32_t now_ms);
+
+#endif /* PIR_FILTER_H */
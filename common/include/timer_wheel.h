@@ -0,0 +1,113 @@
+/**
+ * @file timer_wheel.h
+ * @author agent (agent@local)
+ * @brief Header file for the hierarchical timing wheel: software timers multiplexed on a single tick source.
+ *
+ * Each door needs a motor timeout and two blinking periods. With a hardware timer each (TIM2, TIM3 and TIM4) the MCU runs out of timers after one door. The timing wheel runs any number of software timers on a single tick (the SysTick on the board): `timer_wheel_advance()` is called with the system time in milliseconds and runs the callbacks of the timers that expire, in the context of the caller (the ISR of the tick).
+ *
+ * The wheel has `TIMER_WHEEL_LEVELS` levels of `TIMER_WHEEL_SLOTS` slots. A timer that expires within the next 64 ticks is in a slot of level 0; later ones are in the upper levels, with a coarser slot each, and move down (cascade) when their slot comes around. Every slot is a doubly linked list of timers, and the timers are embedded in their owners (no allocation), so arming, cancelling and re-arming a timer are O(1) regardless of how many timers there are. A tick visits one slot of level 0 and, once every 64 ticks, one slot of each upper level. A timer cascades at most `TIMER_WHEEL_LEVELS - 1` times, so the time of a tick does not grow with the number of pending timers, only with those that expire or cascade in it.
+ *
+ * The timers can be periodic: they are re-armed before their callback runs, at the exact period from their last expiry.
+ * @warning The wheel has no locks. If the tick runs in an ISR, the functions that arm or cancel timers must be called with that ISR masked (the callbacks themselves run in the ISR and need not).
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+#define TIMER_WHEEL_SLOT_BITS 6U                                                           /*!< Bits of the expiry time per level */
+#define TIMER_WHEEL_SLOTS (1U << TIMER_WHEEL_SLOT_BITS)                                    /*!< Number of slots per level */
+#define TIMER_WHEEL_LEVELS 4U                                                              /*!< Number of levels */
+#define TIMER_WHEEL_MAX_DELAY ((1UL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1U) /*!< Longest delay in ticks (about 4.6 hours of 1 ms). Longer ones are clamped to it */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Function called when a timer expires. It may arm or cancel any timer of the wheel, itself included.
+ *
+ * @param p_arg Argument given to `timer_wheel_timer_init()`.
+ */
+typedef void (*timer_wheel_callback_t)(void *p_arg);
+
+/**
+ * @brief Structure to define a software timer. It is embedded in its owner (e.g. the motor of a door).
+ */
+typedef struct timer_wheel_timer
+{
+    struct timer_wheel_timer *p_next;   /*!< Next timer of the slot */
+    struct timer_wheel_timer **pp_prev; /*!< Pointer to the pointer to this timer in the slot, NULL if the timer is not pending */
+    uint32_t expires;                   /*!< Tick at which the timer expires */
+    uint32_t period;                    /*!< Period in ticks of a periodic timer, 0 if it is a one-shot timer */
+    timer_wheel_callback_t callback;    /*!< Function called when the timer expires */
+    void *p_arg;                        /*!< Argument of the callback */
+} timer_wheel_timer_t;
+
+/**
+ * @brief Structure to define a timing wheel.
+ */
+typedef struct
+{
+    timer_wheel_timer_t *p_slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; /*!< Lists of pending timers of each slot of each level */
+    uint32_t now;                                                        /*!< Last tick processed */
+    uint32_t pending;                                                    /*!< Number of pending timers */
+} timer_wheel_t;
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes an empty wheel.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param now Current tick (e.g. the system time in milliseconds).
+ */
+void timer_wheel_init(timer_wheel_t *p_wheel, uint32_t now);
+
+/**
+ * @brief Initializes a timer (not pending).
+ *
+ * @param p_timer Pointer to the timer.
+ * @param callback Function called when the timer expires.
+ * @param p_arg Argument of the callback.
+ */
+void timer_wheel_timer_init(timer_wheel_timer_t *p_timer, timer_wheel_callback_t callback, void *p_arg);
+
+/**
+ * @brief Arms a timer, or re-arms it if it is already pending. O(1).
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param p_timer Pointer to the timer.
+ * @param delay Ticks from the current one until the timer expires. A delay of 0 makes it expire in the next tick.
+ * @param period Period in ticks to re-arm the timer every time it expires, or 0 for a one-shot timer.
+ */
+void timer_wheel_arm(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer, uint32_t delay, uint32_t period);
+
+/**
+ * @brief Cancels a timer. O(1). Nothing happens if it is not pending.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param p_timer Pointer to the timer.
+ */
+void timer_wheel_cancel(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer);
+
+/**
+ * @brief Checks if a timer is pending.
+ *
+ * @param p_timer Pointer to the timer.
+ * @return true if the timer is armed and has not expired yet (a periodic timer is pending until it is cancelled).
+ */
+bool timer_wheel_timer_is_pending(const timer_wheel_timer_t *p_timer);
+
+/**
+ * @brief Processes every tick up to `now` and runs the callbacks of the timers that expire, in order of expiry. Called once per tick it processes a single one; after a gap (e.g. a tickless sleep) it catches up, and if no timer is pending it just jumps to `now`.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param now Current tick. It must not go back in time.
+ */
+void timer_wheel_advance(timer_wheel_t *p_wheel, uint32_t now);
+
+#endif /* TIMER_WHEEL_H */
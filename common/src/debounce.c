@@ -0,0 +1,35 @@
+/**
+ * @file debounce.c
+ * @author agent (agent@local)
+ * @brief Timestamp debouncer of the edges of a digital input.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "debounce.h"
+
+/* Function definitions ------------------------------------------------------*/
+void debounce_init(debounce_t *p_debounce, uint32_t window_ms, bool level)
+{
+    p_debounce->window_ms = window_ms;
+    p_debounce->last_edge_ms = 0;
+    p_debounce->level = level;
+    p_debounce->accepted = 0;
+    p_debounce->rejected = 0;
+}
+
+bool debounce_edge(debounce_t *p_debounce, uint32_t now_ms, bool level)
+{
+    // The subtraction is right across the wrap-around of the system time
+    bool in_window = (p_debounce->accepted > 0) && ((now_ms - p_debounce->last_edge_ms) < p_debounce->window_ms);
+    if (in_window || (level == p_debounce->level))
+    {
+        p_debounce->rejected++;
+        return false;
+    }
+    p_debounce->level = level;
+    p_debounce->last_edge_ms = now_ms;
+    p_debounce->accepted++;
+    return true;
+}
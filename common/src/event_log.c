@@ -0,0 +1,137 @@
+/**
+ * @file event_log.c
+ * @author agent (agent@local)
+ * @brief Binary log of the events of the automatic door.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "event_log.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define EVENT_LOG_EVENT_POS 4                /*!< Position of the event in the code byte */
+#define EVENT_LOG_STATE_POS 1                /*!< Position of the state in the code byte */
+#define EVENT_LOG_STATE_MASK 0x07U           /*!< Bits of the state in the code byte, once shifted */
+#define EVENT_LOG_PAYLOAD 0x01U              /*!< Flag of the code byte: a payload follows */
+#define EVENT_LOG_VARINT_MORE 0x80U          /*!< Flag of a varint byte: another byte follows */
+#define EVENT_LOG_VARINT_MASK 0x7FU          /*!< Bits of the value in a varint byte */
+#define EVENT_LOG_VARINT_BITS 7              /*!< Number of bits of the value in a varint byte */
+#define EVENT_LOG_VARINT_FLAGS 0x80808080ULL /*!< Continuation flags of the 4 first bytes of a varint */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Writes a varint with straight-line code: the groups of 7 bits are spread to bytes with masks and shifts, the continuation flags of all the bytes but the last one are set with a mask of the length, and the `EVENT_LOG_VARINT_MAX_SIZE` bytes are always written (only the first ones count). There is no branch on the value.
+ *
+ * @param p_bytes Where the varint is written.
+ * @param value Value.
+ * @return uint32_t Number of bytes of the varint.
+ */
+static uint32_t _write_varint(uint8_t *p_bytes, uint32_t value)
+{
+    uint32_t num = 1U + (value >= (1U << 7)) + (value >= (1U << 14)) + (value >= (1U << 21)) + (value >= (1U << 28));
+    uint64_t bytes = (value & 0x7FU) | ((uint64_t)(value & 0x3F80U) << 1) | ((uint64_t)(value & 0x1FC000U) << 2) | ((uint64_t)(value & 0xFE00000U) << 3) |
+                     ((uint64_t)(value & 0xF0000000U) << 4);
+    bytes |= EVENT_LOG_VARINT_FLAGS & ((1ULL << (8 * (num - 1))) - 1);
+    p_bytes[0] = (uint8_t)bytes;
+    p_bytes[1] = (uint8_t)(bytes >> 8);
+    p_bytes[2] = (uint8_t)(bytes >> 16);
+    p_bytes[3] = (uint8_t)(bytes >> 24);
+    p_bytes[4] = (uint8_t)(bytes >> 32);
+    return num;
+}
+
+/**
+ * @brief Reads a varint of up to 32 bits.
+ *
+ * @param p_reader Pointer to the reader.
+ * @param p_pos Position of the varint in the chunk. It is moved past the varint.
+ * @param p_value Pointer where the value is stored.
+ * @return true if the varint has been read.
+ * @return false if it is cut at the end of the chunk or it is longer than `EVENT_LOG_VARINT_MAX_SIZE` bytes.
+ */
+static bool _read_varint(const event_log_reader_t *p_reader, uint32_t *p_pos, uint32_t *p_value)
+{
+    uint32_t pos = *p_pos;
+    uint32_t value = 0;
+    for (uint32_t shift = 0; shift < EVENT_LOG_VARINT_BITS * EVENT_LOG_VARINT_MAX_SIZE; shift += EVENT_LOG_VARINT_BITS)
+    {
+        if (pos >= p_reader->length)
+        {
+            return false;
+        }
+        uint8_t byte = p_reader->p_buffer[pos++];
+        value |= (uint32_t)(byte & EVENT_LOG_VARINT_MASK) << shift;
+        if (!(byte & EVENT_LOG_VARINT_MORE))
+        {
+            *p_pos = pos;
+            *p_value = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Function definitions ------------------------------------------------------*/
+void event_log_init(event_log_t *p_log)
+{
+    p_log->last_ms = 0;
+}
+
+uint32_t event_log_encode(const event_log_t *p_log, uint8_t *p_record, uint32_t timestamp_ms, uint8_t event, uint8_t state)
+{
+    uint32_t num = _write_varint(p_record, timestamp_ms - p_log->last_ms);
+    p_record[num] = (uint8_t)((event << EVENT_LOG_EVENT_POS) | ((state & EVENT_LOG_STATE_MASK) << EVENT_LOG_STATE_POS));
+    return num + 1;
+}
+
+uint32_t event_log_encode_payload(const event_log_t *p_log, uint8_t *p_record, uint32_t timestamp_ms, uint8_t event, uint8_t state, uint32_t payload)
+{
+    uint32_t num = event_log_encode(p_log, p_record, timestamp_ms, event, state);
+    p_record[num - 1] |= EVENT_LOG_PAYLOAD;
+    return num + _write_varint(&p_record[num], payload);
+}
+
+void event_log_commit(event_log_t *p_log, uint32_t timestamp_ms)
+{
+    p_log->last_ms = timestamp_ms;
+}
+
+void event_log_reader_init(event_log_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length)
+{
+    event_log_reader_refill(p_reader, p_buffer, length);
+    p_reader->time_ms = 0;
+}
+
+void event_log_reader_refill(event_log_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length)
+{
+    p_reader->p_buffer = p_buffer;
+    p_reader->length = length;
+    p_reader->pos = 0;
+}
+
+bool event_log_read(event_log_reader_t *p_reader, event_log_entry_t *p_entry)
+{
+    uint32_t pos = p_reader->pos;
+    uint32_t delta;
+    uint32_t payload = 0;
+    if (!_read_varint(p_reader, &pos, &delta) || (pos >= p_reader->length))
+    {
+        return false;
+    }
+    uint8_t code = p_reader->p_buffer[pos++];
+    if ((code & EVENT_LOG_PAYLOAD) && !_read_varint(p_reader, &pos, &payload))
+    {
+        return false;
+    }
+
+    // Only a whole record moves the reader
+    p_reader->pos = pos;
+    p_reader->time_ms += delta;
+    p_entry->time_ms = p_reader->time_ms;
+    p_entry->event = code >> EVENT_LOG_EVENT_POS;
+    p_entry->state = (code >> EVENT_LOG_STATE_POS) & EVENT_LOG_STATE_MASK;
+    p_entry->has_payload = code & EVENT_LOG_PAYLOAD;
+    p_entry->payload = payload;
+    return true;
+}
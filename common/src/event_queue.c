@@ -0,0 +1,97 @@
+/**
+ * @file event_queue.c
+ * @author agent (agent@local)
+ * @brief Lock-free queue of input events of the automatic door.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "event_queue.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1) /*!< Mask to convert a position into a slot index */
+
+_Static_assert((EVENT_QUEUE_SIZE & EVENT_QUEUE_MASK) == 0, "EVENT_QUEUE_SIZE must be a power of 2");
+
+/* Global variables -----------------------------------------------------------*/
+event_queue_t event_queue_automatic_door;
+
+/* Function definitions ------------------------------------------------------*/
+void event_queue_init(event_queue_t *p_queue)
+{
+    for (uint32_t i = 0; i < EVENT_QUEUE_SIZE; i++)
+    {
+        atomic_store_explicit(&p_queue->slots[i].seq, i, memory_order_relaxed);
+        p_queue->slots[i].event = EVENT_NONE;
+    }
+    atomic_store_explicit(&p_queue->enqueue_pos, 0, memory_order_relaxed);
+    p_queue->dequeue_pos = 0;
+    atomic_store_explicit(&p_queue->dropped, 0, memory_order_release);
+}
+
+bool event_queue_push(event_queue_t *p_queue, uint8_t event)
+{
+    unsigned int pos = atomic_load_explicit(&p_queue->enqueue_pos, memory_order_relaxed);
+    event_queue_slot_t *p_slot;
+
+    while (1)
+    {
+        p_slot = &p_queue->slots[pos & EVENT_QUEUE_MASK];
+        unsigned int seq = atomic_load_explicit(&p_slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+
+        if (diff == 0)
+        {
+            // The slot is free: try to reserve it. On failure `pos` is reloaded with the current position
+            if (atomic_compare_exchange_weak_explicit(&p_queue->enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The slot still holds an event of the previous lap: the queue is full
+            atomic_fetch_add_explicit(&p_queue->dropped, 1, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            // Another producer has reserved this position meanwhile
+            pos = atomic_load_explicit(&p_queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    // Write the event and publish the slot to the consumer
+    p_slot->event = event;
+    atomic_store_explicit(&p_slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+bool event_queue_pop(event_queue_t *p_queue, uint8_t *p_event)
+{
+    uint32_t pos = p_queue->dequeue_pos;
+    event_queue_slot_t *p_slot = &p_queue->slots[pos & EVENT_QUEUE_MASK];
+
+    if (atomic_load_explicit(&p_slot->seq, memory_order_acquire) != pos + 1)
+    {
+        return false;
+    }
+
+    // Read the event and give the slot back to the producers for the next lap
+    *p_event = p_slot->event;
+    atomic_store_explicit(&p_slot->seq, pos + EVENT_QUEUE_SIZE, memory_order_release);
+    p_queue->dequeue_pos = pos + 1;
+    return true;
+}
+
+bool event_queue_is_pending(event_queue_t *p_queue)
+{
+    uint32_t pos = p_queue->dequeue_pos;
+    return atomic_load_explicit(&p_queue->slots[pos & EVENT_QUEUE_MASK].seq, memory_order_acquire) == pos + 1;
+}
+
+uint32_t event_queue_get_dropped(event_queue_t *p_queue)
+{
+    return atomic_load_explicit(&p_queue->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file event_record.c
+ * @author agent (agent@local)
+ * @brief Recorder of input events of the automatic door.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "event_record.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define EVENT_RECORD_EVENT_POS 5          /*!< Position of the event in the header byte */
+#define EVENT_RECORD_MORE 0x10U           /*!< Flag of the header byte: a varint with the rest of the time follows */
+#define EVENT_RECORD_DELTA_MASK 0x0FU     /*!< Bits of the time in the header byte */
+#define EVENT_RECORD_DELTA_BITS 4         /*!< Number of bits of the time in the header byte */
+#define EVENT_RECORD_VARINT_MORE 0x80U    /*!< Flag of a varint byte: another byte follows */
+#define EVENT_RECORD_VARINT_MASK 0x7FU    /*!< Bits of the value in a varint byte */
+
+/* Function definitions ------------------------------------------------------*/
+void event_record_init(event_record_t *p_record, uint8_t *p_buffer, uint32_t size)
+{
+    p_record->p_buffer = p_buffer;
+    p_record->size = size;
+    p_record->length = 0;
+    p_record->last_ms = 0;
+    p_record->count = 0;
+    p_record->dropped = 0;
+}
+
+bool event_record_append(event_record_t *p_record, uint32_t timestamp_ms, uint8_t event)
+{
+    uint8_t bytes[EVENT_RECORD_MAX_SIZE];
+    uint32_t delta = timestamp_ms - p_record->last_ms;
+    uint32_t rest = delta >> EVENT_RECORD_DELTA_BITS;
+    uint32_t num = 1;
+
+    bytes[0] = (uint8_t)((event << EVENT_RECORD_EVENT_POS) | (delta & EVENT_RECORD_DELTA_MASK) | (rest ? EVENT_RECORD_MORE : 0));
+    while (rest)
+    {
+        bytes[num] = (uint8_t)(rest & EVENT_RECORD_VARINT_MASK);
+        rest >>= 7;
+        bytes[num++] |= rest ? EVENT_RECORD_VARINT_MORE : 0;
+    }
+
+    // Once a record is dropped all the next ones are dropped too, so that the buffer keeps a prefix of the sequence
+    if ((p_record->dropped != 0) || (p_record->size - p_record->length < num))
+    {
+        p_record->dropped++;
+        return false;
+    }
+    for (uint32_t i = 0; i < num; i++)
+    {
+        p_record->p_buffer[p_record->length++] = bytes[i];
+    }
+    p_record->last_ms = timestamp_ms;
+    p_record->count++;
+    return true;
+}
+
+uint32_t event_record_get_length(event_record_t *p_record)
+{
+    return p_record->length;
+}
+
+uint32_t event_record_get_count(event_record_t *p_record)
+{
+    return p_record->count;
+}
+
+uint32_t event_record_get_dropped(event_record_t *p_record)
+{
+    return p_record->dropped;
+}
+
+void event_record_reader_init(event_record_reader_t *p_reader, const uint8_t *p_buffer, uint32_t length)
+{
+    p_reader->p_buffer = p_buffer;
+    p_reader->length = length;
+    p_reader->pos = 0;
+    p_reader->last_ms = 0;
+}
+
+bool event_record_read(event_record_reader_t *p_reader, uint32_t *p_timestamp_ms, uint8_t *p_event)
+{
+    uint32_t pos = p_reader->pos;
+    if (pos >= p_reader->length)
+    {
+        return false;
+    }
+
+    uint8_t header = p_reader->p_buffer[pos++];
+    uint32_t delta = header & EVENT_RECORD_DELTA_MASK;
+    bool more = header & EVENT_RECORD_MORE;
+    for (uint32_t shift = EVENT_RECORD_DELTA_BITS; more; shift += 7)
+    {
+        if ((pos >= p_reader->length) || (shift >= 32))
+        {
+            return false;
+        }
+        uint8_t byte = p_reader->p_buffer[pos++];
+        delta |= (uint32_t)(byte & EVENT_RECORD_VARINT_MASK) << shift;
+        more = byte & EVENT_RECORD_VARINT_MORE;
+    }
+
+    p_reader->pos = pos;
+    p_reader->last_ms += delta;
+    *p_timestamp_ms = p_reader->last_ms;
+    *p_event = header >> EVENT_RECORD_EVENT_POS;
+    return true;
+}
@@ -8,13 +8,65 @@
 
 /* Includes ------------------------------------------------------------------*/
 /* Standard C includes */
+#include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /* Project includes */
 #include "fsm_automatic_door.h"
+#include "fsm_compiled.h"
+#include "fsm_indexed.h"
+#include "latency.h"
 #include "port_button.h"
 #include "port_led.h"
 #include "port_pir_sensor.h"
+#include "port_motor.h"
+
+_Static_assert(MOTOR_AUTOMATIC_DOOR_PROFILE_MS == AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, "The speed profile of the motor must last the opening and closing timeout of the door");
+
+/* Input snapshot */
+
+/**
+ * @brief Get an input of the door for a guard. During a fire it is taken from the snapshot, reading the hardware only if the input is not current yet.
+ *
+ * @param p_fsm Pointer to the automatic door FSM.
+ * @param input Input to get (one of `FSM_AUTOMATIC_DOOR_INPUT_*`).
+ * @return true if the input is active.
+ */
+static inline bool _get_input(fsm_automatic_door_t *p_fsm, uint8_t input)
+{
+    if (p_fsm->inputs_snapshot && (p_fsm->inputs_valid & input))
+    {
+        p_fsm->input_reads_saved++;
+        return (p_fsm->inputs & input) != 0;
+    }
+
+    bool status;
+    switch (input)
+    {
+    case FSM_AUTOMATIC_DOOR_INPUT_PRESENCE:
+        status = port_pir_sensor_get_status(p_fsm->p_pir_sensor);
+        break;
+    case FSM_AUTOMATIC_DOOR_INPUT_BUTTON:
+        // A press is taken once: a press read as true always takes a transition, which invalidates the snapshot
+        status = port_button_consume_press(p_fsm->p_button);
+        break;
+    case FSM_AUTOMATIC_DOOR_INPUT_END_OF_TRAVEL:
+        status = port_motor_is_at_end_of_travel(p_fsm->p_motor);
+        break;
+    default:
+        status = p_fsm->p_motor->timeout;
+        break;
+    }
+    p_fsm->input_reads++;
+
+    if (p_fsm->inputs_snapshot)
+    {
+        p_fsm->inputs = status ? (p_fsm->inputs | input) : (p_fsm->inputs & ~input);
+        p_fsm->inputs_valid |= input;
+    }
+    return status;
+}
 
 /* State machine input or transition functions */
 
@@ -31,29 +83,42 @@ bool check_open(fsm_t *p_this)
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
     // Get the status of the PIR sensor
-    bool pir_status = port_pir_sensor_get_status(p_fsm->p_pir_sensor);
+    bool pir_status = _get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_PRESENCE);
 
     // Get the status of the button
-    bool button_status = port_button_is_pressed(p_fsm->p_button);
+    bool button_status = _get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_BUTTON);
 
     // Check if there is a new presence or the button has been pressed
     return (pir_status || button_status);
 }
 
 /**
- * @brief Check if the opening timeout has expired
+ * @brief Check if the door has ended the movement: it has reached the end of the travel or, as a fault limit, the timeout has expired.
+ *
+ * The end of the travel is only read if the motor has position feedback. Otherwise the timeout is the duration of the movement.
+ *
+ * @param p_fsm Pointer to the automatic door FSM.
+ * @return true If the movement has ended.
+ */
+static bool _check_end_of_movement(fsm_automatic_door_t *p_fsm)
+{
+    return _get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT) || (port_motor_has_position(p_fsm->p_motor) && _get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_END_OF_TRAVEL));
+}
+
+/**
+ * @brief Check if the door is open: it has reached the end of the travel, or the opening timeout has expired
  *
  * @param p_this Pointer to the FSM structure
- * @return true If the opening timeout has expired
- * @return false If the opening timeout has not expired
+ * @return true If the door is open or the opening timeout has expired
+ * @return false If the door is still opening
  */
 bool check_opening_timeout(fsm_t *p_this)
 {
     // Retrieve the FSM structure
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Check if the opening timeout has expired
-    return p_fsm->p_motor->timeout;
+    // Check if the door has reached the end of the travel or the opening timeout has expired
+    return _check_end_of_movement(p_fsm);
 }
 
 /**
@@ -81,7 +146,7 @@ bool check_inactivity_timeout(fsm_t *p_this)
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
     // Check if the closing timeout has expired
-    return p_fsm->p_motor->timeout;
+    return _get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT);
 }
 
 /**
@@ -97,23 +162,34 @@ bool check_presence_or_button(fsm_t *p_this)
 }
 
 /**
- * @brief Check if the closing timeout has expired
+ * @brief Check if the door is closed: it has reached the end of the travel, or the closing timeout has expired
  *
  * @param p_this Pointer to the FSM structure
- * @return true
- * @return false
+ * @return true If the door is closed or the closing timeout has expired
+ * @return false If the door is still closing
  */
 bool check_closing_timeout(fsm_t *p_this)
 {
     // Retrieve the FSM structure
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Check if the closing timeout has expired
-    return p_fsm->p_motor->timeout;
+    // Check if the door has reached the end of the travel or the closing timeout has expired
+    return _check_end_of_movement(p_fsm);
 }
 
 /* State machine output or action functions */
 
+/**
+ * @brief Get the timeout of the opening or the closing of the door. With position feedback the movement ends at the end of the travel, and the timeout is only a fault limit, a margin over the duration of the speed profile.
+ *
+ * @param p_fsm Pointer to the automatic door FSM.
+ * @return uint32_t Timeout in milliseconds.
+ */
+static uint32_t _travel_timeout_ms(fsm_automatic_door_t *p_fsm)
+{
+    return AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + (port_motor_has_position(p_fsm->p_motor) ? AUTOMATIC_DOOR_TRAVEL_FAULT_MARGIN_MS : 0U);
+}
+
 /**
  * @brief Open the door
  *
@@ -124,14 +200,31 @@ void do_open_door(fsm_t *p_this)
     // Retrieve the FSM structure and get the LED
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Turn off the closing LED
-    port_led_off(p_fsm->p_led_close);
+    // Turn off the closing LED and start the blinking of the opening LED from off, in a single write of their GPIO port
+    port_led_batch_t leds;
+    port_led_batch_init(&leds);
+    port_led_batch_off(&leds, p_fsm->p_led_close);
+    port_led_batch_off(&leds, p_fsm->p_led_open);
+    port_led_batch_commit(&leds);
 
     // Activate the opening LED timer
     port_led_timer_activate(p_fsm->p_led_open);
 
-    // Activate the timer to start the motor and open the door
-    port_motor_timeout_timer_activate(p_fsm->p_motor, AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    // Start the motor with its speed profile and the timer of the travel to open the door
+    port_motor_move(p_fsm->p_motor, true);
+    port_motor_timeout_timer_activate(p_fsm->p_motor, _travel_timeout_ms(p_fsm));
+
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    // The door is actuated: end of the latency from the PIR edge, if a presence opens it. An opening by the button discards the start of an older presence
+    if (_get_input(p_fsm, FSM_AUTOMATIC_DOOR_INPUT_PRESENCE))
+    {
+        latency_stop(&latency_automatic_door, port_system_get_cycles());
+    }
+    else
+    {
+        latency_cancel(&latency_automatic_door);
+    }
+#endif
 
     // Update the last time there was a presence or the button was pressed
     p_fsm->presence_or_button_status = true; // If the button is pressed or the PIR sensor detects a presence
@@ -148,12 +241,24 @@ void do_stay_open(fsm_t *p_this)
     // Retrieve the FSM structure and get the LED
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Leave the opening LED on
-    port_led_on(p_fsm->p_led_open);
+    // Leave the opening LED on and the closing LED off
+    port_led_batch_t leds;
+    port_led_batch_init(&leds);
+    port_led_batch_on(&leds, p_fsm->p_led_open);
+    port_led_batch_off(&leds, p_fsm->p_led_close);
+    port_led_batch_commit(&leds);
 
     // Deactivate the opening LED timer
     port_led_timer_deactivate(p_fsm->p_led_open);
 
+    // The door is open: the profile has ended, stop the motor in case it has not
+    port_motor_stop(p_fsm->p_motor);
+
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    // A presence that arrived while the door was opening has not actuated it
+    latency_cancel(&latency_automatic_door);
+#endif
+
     // Activate the timer to block the motor for a while
     port_motor_timeout_timer_activate(p_fsm->p_motor, AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
 }
@@ -171,6 +276,11 @@ void do_keep_open(fsm_t *p_this)
     // Restart the motor timeout timer
     // Activate the timer to block the motor for a while
     port_motor_timeout_timer_activate(p_fsm->p_motor, AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
+
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    // The door was already open: the presence has not actuated it
+    latency_cancel(&latency_automatic_door);
+#endif
 }
 
 /**
@@ -183,14 +293,19 @@ void do_close_door(fsm_t *p_this)
     // Retrieve the FSM structure and get the LED
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Turn off the opening LED
-    port_led_off(p_fsm->p_led_open);
+    // Turn off the opening LED and start the blinking of the closing LED from off
+    port_led_batch_t leds;
+    port_led_batch_init(&leds);
+    port_led_batch_off(&leds, p_fsm->p_led_open);
+    port_led_batch_off(&leds, p_fsm->p_led_close);
+    port_led_batch_commit(&leds);
 
     // Activate the closing LED timer
     port_led_timer_activate(p_fsm->p_led_close);
 
-    // Activate the timer to start the motor and close the door
-    port_motor_timeout_timer_activate(p_fsm->p_motor, AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    // Start the motor with its speed profile and the timer of the travel to close the door
+    port_motor_move(p_fsm->p_motor, false);
+    port_motor_timeout_timer_activate(p_fsm->p_motor, _travel_timeout_ms(p_fsm));
 
     p_fsm->presence_or_button_status = false;
 }
@@ -208,7 +323,8 @@ void do_stop_closing_door(fsm_t *p_this)
     // Deactivate the closing LED timer
     port_led_timer_deactivate(p_fsm->p_led_close);
 
-    // Deactivate the current motor timeout timer
+    // Stop the motor and deactivate the current motor timeout timer
+    port_motor_stop(p_fsm->p_motor);
     port_motor_timeout_timer_deactivate(p_fsm->p_motor);
 
     // Call the function to open the door
@@ -225,13 +341,18 @@ void do_stay_closed(fsm_t *p_this)
     // Retrieve the FSM structure and get the LED
     fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
 
-    // Leave the closing LED on
-    port_led_on(p_fsm->p_led_close);
+    // Leave the closing LED on and the opening LED off
+    port_led_batch_t leds;
+    port_led_batch_init(&leds);
+    port_led_batch_on(&leds, p_fsm->p_led_close);
+    port_led_batch_off(&leds, p_fsm->p_led_open);
+    port_led_batch_commit(&leds);
 
     // Deactivate the closing LED timer
     port_led_timer_deactivate(p_fsm->p_led_close);
 
-    // Deactivate the motor timeout timer
+    // Stop the motor and deactivate the motor timeout timer
+    port_motor_stop(p_fsm->p_motor);
     port_motor_timeout_timer_deactivate(p_fsm->p_motor);
 }
 
@@ -242,13 +363,43 @@ void do_stay_closed(fsm_t *p_this)
  * { EstadoOrigen, CondicionDeDisparo, EstadoFinal, AccionesSiTransicion }
  */
 
+/**
+ * @brief Transitions of the automatic door FSM, as an X-macro list (see `fsm_compiled.h`). It is expanded into the transitions table and into the compiled fire function.
+ *
+ */
+#define FSM_AUTOMATIC_DOOR_TRANSITIONS(ARC)                                \
+    ARC(CLOSED, check_open, OPENING, do_open_door)                         \
+    ARC(OPENING, check_opening_timeout, OPEN, do_stay_open)                \
+    ARC(OPEN, check_keep_open, OPEN, do_keep_open)                         \
+    ARC(OPEN, check_inactivity_timeout, CLOSING, do_close_door)            \
+    ARC(CLOSING, check_presence_or_button, OPENING, do_stop_closing_door) \
+    ARC(CLOSING, check_closing_timeout, CLOSED, do_stay_closed)
+
 /**
  * @brief Transitions table for the automatic door FSM
  *
  */
-fsm_trans_t fsm_trans_automatic_door[] = {
-    
-};
+fsm_trans_t fsm_trans_automatic_door[] = FSM_COMPILED_TABLE(FSM_AUTOMATIC_DOOR_TRANSITIONS);
+
+#if defined(FSM_AUTOMATIC_DOOR_INDEXED)
+/**
+ * @brief Per-state index of the transitions table. It is shared by all the automatic doors because they all use the same table.
+ *
+ */
+static fsm_indexed_t fsm_index_automatic_door;
+
+/**
+ * @brief Flag to indicate that `fsm_index_automatic_door` has already been built.
+ *
+ */
+static bool fsm_index_automatic_door_ready = false;
+#else
+/**
+ * @brief Fire function compiled from the transitions of the automatic door: a switch on the state with direct (inlinable) calls to the guards and actions.
+ *
+ */
+FSM_COMPILED_DEFINE_FIRE(_fire_compiled, FSM_AUTOMATIC_DOOR_TRANSITIONS)
+#endif
 
 uint32_t fsm_automatic_door_get_last_time_presence(fsm_t *p_this)
 {
@@ -262,6 +413,164 @@ bool fsm_automatic_door_get_presence_status(fsm_t *p_this)
     return p_fsm->presence_or_button_status;
 }
 
+bool fsm_automatic_door_check_activity(fsm_t *p_this)
+{
+    return fsm_get_state(p_this) != CLOSED;
+}
+
+uint32_t fsm_automatic_door_get_input_reads(fsm_t *p_this)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    return p_fsm->input_reads;
+}
+
+uint32_t fsm_automatic_door_get_input_reads_saved(fsm_t *p_this)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    return p_fsm->input_reads_saved;
+}
+
+/**
+ * @brief Fire the FSM with the guards evaluated against the input snapshot. The inputs of the snapshot that are not current (`inputs_valid`) are read from the hardware when a guard needs them.
+ *
+ * @param p_fsm Pointer to the automatic door FSM.
+ * @return true if a transition has been taken, false otherwise.
+ */
+static bool _fire_snapshot(fsm_automatic_door_t *p_fsm)
+{
+    int from_state = fsm_get_state(&p_fsm->f);
+    p_fsm->inputs_snapshot = true;
+#if defined(FSM_AUTOMATIC_DOOR_INDEXED)
+    int arc = fsm_indexed_fire_arc(&fsm_index_automatic_door, &p_fsm->f);
+#else
+    int arc = _fire_compiled(&p_fsm->f);
+#endif
+    p_fsm->inputs_snapshot = false;
+
+    if (arc < 0)
+    {
+        return false;
+    }
+    uint32_t now = port_system_get_millis();
+    fsm_stats_record(&p_fsm->stats, now, from_state, fsm_get_state(&p_fsm->f), arc);
+#if defined(FSM_AUTOMATIC_DOOR_TRACE)
+    fsm_trace_record(&p_fsm->trace, now, (uint8_t)from_state, (uint8_t)fsm_get_state(&p_fsm->f), (uint8_t)arc,
+                     (uint8_t)((p_fsm->inputs & p_fsm->inputs_valid) | (p_fsm->inputs_valid << 4)));
+#endif
+
+    // The actions may change the inputs (e.g. restarting the motor timer clears the timeout)
+    p_fsm->inputs_valid = 0;
+    return true;
+}
+
+void fsm_automatic_door_set_record(fsm_t *p_this, event_record_t *p_record)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    p_fsm->p_record = p_record;
+
+    // The end of the movements depends on whether the motor has position feedback: the log says it for the replay
+    if ((p_record != NULL) && port_motor_has_position(p_fsm->p_motor))
+    {
+        event_record_append(p_record, port_system_get_millis(), EVENT_RECORD_POSITION_FEEDBACK);
+    }
+}
+
+bool fsm_automatic_door_get_stats(fsm_t *p_this, fsm_stats_data_t *p_data)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    return fsm_stats_read(&p_fsm->stats, p_data);
+}
+
+uint32_t fsm_automatic_door_get_trace(fsm_t *p_this, fsm_trace_entry_t *p_entries, uint32_t max_entries)
+{
+#if defined(FSM_AUTOMATIC_DOOR_TRACE)
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    return fsm_trace_dump(&p_fsm->trace, p_entries, max_entries);
+#else
+    return 0;
+#endif
+}
+
+bool fsm_automatic_door_fire(fsm_t *p_this)
+{
+    // Without events nothing tells which inputs have changed since the last fire: take a fresh snapshot
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    p_fsm->inputs_valid = 0;
+    return _fire_snapshot(p_fsm);
+}
+
+/**
+ * @brief Apply an input event to the peripherals of the door, as the ISR did when it was generated.
+ *
+ * @param p_fsm Pointer to the automatic door FSM.
+ * @param event Event to apply.
+ * @return uint8_t Input changed by the event (`FSM_AUTOMATIC_DOOR_INPUT_*`), 0 if none.
+ */
+static uint8_t _apply_event(fsm_automatic_door_t *p_fsm, uint8_t event)
+{
+    switch (event)
+    {
+    case EVENT_PIR_RISING:
+        port_pir_sensor_set_status(p_fsm->p_pir_sensor, true);
+        return FSM_AUTOMATIC_DOOR_INPUT_PRESENCE;
+    case EVENT_PIR_FALLING:
+        port_pir_sensor_set_status(p_fsm->p_pir_sensor, false);
+        return FSM_AUTOMATIC_DOOR_INPUT_PRESENCE;
+    case EVENT_BUTTON_PRESS:
+        p_fsm->p_button->flag_released = false;
+        p_fsm->p_button->flag_pressed = true;
+        return FSM_AUTOMATIC_DOOR_INPUT_BUTTON;
+    case EVENT_BUTTON_RELEASE:
+        // The press stays pending until a guard consumes it
+        p_fsm->p_button->flag_released = true;
+        return 0;
+    case EVENT_MOTOR_TIMEOUT:
+        // The ISR already set the timeout, and an action earlier in this drain may have re-armed the timer since: it is read from the motor
+        return FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT;
+    case EVENT_MOTOR_END_OF_TRAVEL:
+        // The motor stopped itself on reaching the end: it is read from it
+        return FSM_AUTOMATIC_DOOR_INPUT_END_OF_TRAVEL;
+    default:
+        return 0;
+    }
+}
+
+uint32_t fsm_automatic_door_fire_events(fsm_t *p_this, event_queue_t *p_queue)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    uint32_t num_events = 0;
+    uint8_t event;
+
+    while (event_queue_pop(p_queue, &event))
+    {
+        // An event has been lost: any input may have changed without telling
+        uint32_t dropped = event_queue_get_dropped(p_queue);
+        if (dropped != p_fsm->inputs_dropped)
+        {
+            p_fsm->inputs_dropped = dropped;
+            p_fsm->inputs_valid = 0;
+        }
+
+        if (p_fsm->p_record != NULL)
+        {
+            event_record_append(p_fsm->p_record, port_system_get_millis(), event);
+        }
+
+        // Only the input changed by the event has to be read again
+        p_fsm->inputs_valid &= ~_apply_event(p_fsm, event);
+
+        // Run to completion: the new state may take an input that will bring no event (e.g. a press left pending while the door was opening)
+        uint32_t num_fires = 0;
+        int state;
+        do
+        {
+            state = fsm_get_state(p_this);
+        } while (_fire_snapshot(p_fsm) && (fsm_get_state(p_this) != state) && (++num_fires < FSM_AUTOMATIC_DOOR_MAX_FIRES_PER_EVENT));
+        num_events++;
+    }
+    return num_events;
+}
+
 /* Initialize the FSM */
 
 /**
@@ -276,7 +585,7 @@ bool fsm_automatic_door_get_presence_status(fsm_t *p_this)
  * > ✅ 4. Initialize the presence status flag in the FSM structure.
  * > ✅ 5. Initialize the peripherals: button, LEDs, PIR sensor, and motor calling the corresponding initialization functions from the port layer: `port_button_init()`, `port_led_init()`, `port_pir_sensor_init()`, and `port_motor_init()`.
  * > ✅ 6. Turn the red LED on calling the `port_led_on()` function.
- * 
+ *
  * @param p_this Pointer to the FSM structure
  * @param p_button Pointer to the button structure
  * @param p_led_open Pointer to the LED structure
@@ -286,17 +595,150 @@ bool fsm_automatic_door_get_presence_status(fsm_t *p_this)
  */
 void fsm_automatic_door_init(fsm_t *p_this, port_button_hw_t *p_button, port_led_hw_t *p_led_open, port_led_hw_t *p_led_close, port_pir_hw_t *p_pir, port_motor_hw_t *p_motor)
 {
-    
+    // Initialize the FSM
+    fsm_init(p_this, fsm_trans_automatic_door);
+#if defined(FSM_AUTOMATIC_DOOR_INDEXED)
+    if (!fsm_index_automatic_door_ready)
+    {
+        fsm_index_automatic_door_ready = fsm_indexed_init(&fsm_index_automatic_door, fsm_trans_automatic_door);
+        assert(fsm_index_automatic_door_ready);
+    }
+#endif
+
+    // Assign the peripherals
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+    p_fsm->p_button = p_button;
+    p_fsm->p_led_open = p_led_open;
+    p_fsm->p_led_close = p_led_close;
+    p_fsm->p_pir_sensor = p_pir;
+    p_fsm->p_motor = p_motor;
+
+    // Initialize the status of the door
+    p_fsm->last_time_presence_or_button = 0;
+    p_fsm->presence_or_button_status = false;
+    p_fsm->motor_timeout = false;
+    p_fsm->inputs = 0;
+    p_fsm->inputs_valid = 0;
+    p_fsm->inputs_snapshot = false;
+    p_fsm->inputs_dropped = 0;
+    p_fsm->input_reads = 0;
+    p_fsm->input_reads_saved = 0;
+    fsm_stats_init(&p_fsm->stats, port_system_get_millis());
+    p_fsm->p_record = NULL;
+#if defined(FSM_AUTOMATIC_DOOR_TRACE)
+    fsm_trace_init(&p_fsm->trace);
+#endif
+
+    // Initialize the peripherals
+    port_button_init(p_button);
+    port_led_init(p_led_open);
+    port_led_init(p_led_close);
+    port_pir_sensor_init(p_pir);
+    port_motor_init(p_motor);
+
+    // The door starts closed: red LED on
+    port_led_on(p_led_close);
 }
 
 /* Create FSM */
+#if defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) && (FSM_AUTOMATIC_DOOR_POOL_SIZE > 0)
+/**
+ * @brief Static pool of automatic doors.
+ *
+ */
+static fsm_automatic_door_t fsm_automatic_door_pool[FSM_AUTOMATIC_DOOR_POOL_SIZE];
+
+/**
+ * @brief Stack of indexes of the slots of the pool given back with `fsm_automatic_door_delete()`.
+ *
+ */
+static uint32_t fsm_automatic_door_pool_free[FSM_AUTOMATIC_DOOR_POOL_SIZE];
+
+/**
+ * @brief Whether each slot of the pool holds a door, so that a slot is given back only once.
+ *
+ */
+static bool fsm_automatic_door_pool_used[FSM_AUTOMATIC_DOOR_POOL_SIZE];
+
+static uint32_t fsm_automatic_door_pool_num_free = 0; /*!< Number of indexes in `fsm_automatic_door_pool_free` */
+static uint32_t fsm_automatic_door_pool_next = 0;     /*!< Index of the first slot of the pool that has never been used */
+
+/**
+ * @brief Take a slot of the pool: a freed one if any, otherwise the next one never used.
+ *
+ * @return fsm_t* Pointer to the slot, or NULL if the pool is full.
+ */
+static fsm_t *_pool_alloc(void)
+{
+    uint32_t index;
+    if (fsm_automatic_door_pool_num_free > 0)
+    {
+        index = fsm_automatic_door_pool_free[--fsm_automatic_door_pool_num_free];
+    }
+    else if (fsm_automatic_door_pool_next < FSM_AUTOMATIC_DOOR_POOL_SIZE)
+    {
+        index = fsm_automatic_door_pool_next++;
+    }
+    else
+    {
+        return NULL;
+    }
+    fsm_automatic_door_pool_used[index] = true;
+    return &fsm_automatic_door_pool[index].f;
+}
+
+fsm_t *fsm_automatic_door_new(port_button_hw_t *p_button, port_led_hw_t *p_led_open, port_led_hw_t *p_led_close, port_pir_hw_t *p_pir, port_motor_hw_t *p_motor)
+{
+    // Take a slot of the static pool (deterministic, no heap)
+    fsm_t *p_fsm = _pool_alloc();
+    if (p_fsm == NULL)
+    {
+        return NULL;
+    }
+
+    // Initialize the FSM
+    fsm_automatic_door_init(p_fsm, p_button, p_led_open, p_led_close, p_pir, p_motor);
+
+    return p_fsm;
+}
+
+void fsm_automatic_door_delete(fsm_t *p_this)
+{
+    fsm_automatic_door_t *p_fsm = (fsm_automatic_door_t *)p_this;
+
+    // Ignore pointers that are not the start of a slot of the pool, and slots already given back: a double free must not hand the same slot out twice
+    uintptr_t offset = (uintptr_t)p_fsm - (uintptr_t)fsm_automatic_door_pool;
+    if (((uintptr_t)p_fsm < (uintptr_t)fsm_automatic_door_pool) || (offset >= sizeof(fsm_automatic_door_pool)) || (offset % sizeof(fsm_automatic_door_t) != 0))
+    {
+        return;
+    }
+    uint32_t index = (uint32_t)(offset / sizeof(fsm_automatic_door_t));
+    if (!fsm_automatic_door_pool_used[index])
+    {
+        return;
+    }
+    fsm_automatic_door_pool_used[index] = false;
+    assert(fsm_automatic_door_pool_num_free < FSM_AUTOMATIC_DOOR_POOL_SIZE);
+    fsm_automatic_door_pool_free[fsm_automatic_door_pool_num_free++] = index;
+}
+#else
 fsm_t *fsm_automatic_door_new(port_button_hw_t *p_button, port_led_hw_t *p_led_open, port_led_hw_t *p_led_close, port_pir_hw_t *p_pir, port_motor_hw_t *p_motor)
 {
     // Do malloc for the whole FSM structure to reserve memory for the rest of the FSM, although I interpret it as fsm_t which is the first field of the structure so that the FSM library can work with it
     fsm_t *p_fsm = malloc(sizeof(fsm_automatic_door_t));
+    if (p_fsm == NULL)
+    {
+        return NULL;
+    }
 
     // Initialize the FSM
     fsm_automatic_door_init(p_fsm, p_button, p_led_open, p_led_close, p_pir, p_motor);
 
     return p_fsm;
 }
+
+void fsm_automatic_door_delete(fsm_t *p_this)
+{
+    free(p_this);
+}
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file fsm_automatic_door_fleet.c
+ * @author agent (agent@local)
+ * @brief Fleet of automatic doors stored as a struct of arrays.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "fsm_automatic_door_fleet.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define FLEET_FLAGS_LEDS (FLEET_FLAG_LED_OPEN_ON | FLEET_FLAG_LED_OPEN_BLINK | FLEET_FLAG_LED_CLOSE_ON | FLEET_FLAG_LED_CLOSE_BLINK) /*!< Mask of the LED flags */
+
+/* Function definitions ------------------------------------------------------*/
+fsm_automatic_door_fleet_t *fsm_automatic_door_fleet_new(uint32_t num_doors)
+{
+    // One allocation for the structure and all the arrays. The 32-bit arrays go first to keep them aligned
+    size_t size = sizeof(fsm_automatic_door_fleet_t) + (size_t)num_doors * fsm_automatic_door_fleet_bytes_per_door();
+    uint8_t *p_mem = malloc(size);
+    if (p_mem == NULL)
+    {
+        return NULL;
+    }
+
+    fsm_automatic_door_fleet_t *p_fleet = (fsm_automatic_door_fleet_t *)p_mem;
+    p_mem += sizeof(fsm_automatic_door_fleet_t);
+    p_fleet->num_doors = num_doors;
+    p_fleet->p_last_time_presence_or_button = (uint32_t *)p_mem;
+    p_mem += num_doors * sizeof(uint32_t);
+    p_fleet->p_motor_deadline_ms = (uint32_t *)p_mem;
+    p_mem += num_doors * sizeof(uint32_t);
+    p_fleet->p_state = p_mem;
+    p_mem += num_doors;
+    p_fleet->p_inputs = p_mem;
+    p_mem += num_doors;
+    p_fleet->p_flags = p_mem;
+
+    // Same initial status as fsm_automatic_door_init(): closed, closing LED on
+    memset(p_fleet->p_last_time_presence_or_button, 0, num_doors * sizeof(uint32_t));
+    memset(p_fleet->p_motor_deadline_ms, 0, num_doors * sizeof(uint32_t));
+    memset(p_fleet->p_state, CLOSED, num_doors);
+    memset(p_fleet->p_inputs, 0, num_doors);
+    memset(p_fleet->p_flags, FLEET_FLAG_LED_CLOSE_ON, num_doors);
+
+    return p_fleet;
+}
+
+void fsm_automatic_door_fleet_delete(fsm_automatic_door_fleet_t *p_fleet)
+{
+    free(p_fleet);
+}
+
+void fsm_automatic_door_fleet_set_inputs(fsm_automatic_door_fleet_t *p_fleet, uint32_t door, bool presence, bool button)
+{
+    // A pending press is kept until the FSM takes it, as the flag of the button ISR
+    uint8_t pending = p_fleet->p_inputs[door] & FLEET_INPUT_BUTTON;
+    p_fleet->p_inputs[door] = (presence ? FLEET_INPUT_PRESENCE : 0) | ((button || pending) ? FLEET_INPUT_BUTTON : 0);
+}
+
+uint32_t fsm_automatic_door_fleet_fire_all(fsm_automatic_door_fleet_t *p_fleet, uint32_t now_ms)
+{
+    uint32_t num_doors = p_fleet->num_doors;
+    uint8_t *p_state = p_fleet->p_state;
+    uint8_t *p_inputs = p_fleet->p_inputs;
+    uint8_t *p_flags = p_fleet->p_flags;
+    uint32_t *p_deadline = p_fleet->p_motor_deadline_ms;
+    uint32_t *p_last_time = p_fleet->p_last_time_presence_or_button;
+    uint32_t num_transitions = 0;
+
+    for (uint32_t i = 0; i < num_doors; i++)
+    {
+        uint8_t flags = p_flags[i];
+        uint8_t inputs = p_inputs[i];
+        bool presence_or_button = inputs != 0;
+        bool timeout = (flags & FLEET_FLAG_MOTOR_ARMED) && ((int32_t)(now_ms - p_deadline[i]) >= 0);
+
+        // Same guards, in the same order, as FSM_AUTOMATIC_DOOR_TRANSITIONS, for a motor without position feedback: the movements end at the timeout.
+        // Every state but OPENING reads the button first, which takes the press (port_button_consume_press())
+        if (p_state[i] != OPENING)
+        {
+            p_inputs[i] = inputs & ~FLEET_INPUT_BUTTON;
+        }
+        switch (p_state[i])
+        {
+        case CLOSED:
+            if (presence_or_button)
+            {
+                // do_open_door()
+                p_state[i] = OPENING;
+                flags = (flags & ~FLEET_FLAGS_LEDS) | FLEET_FLAG_LED_OPEN_BLINK | FLEET_FLAG_MOTOR_ARMED | FLEET_FLAG_PRESENCE;
+                p_deadline[i] = now_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS;
+                p_last_time[i] = now_ms;
+                num_transitions++;
+            }
+            break;
+        case OPENING:
+            if (timeout)
+            {
+                // do_stay_open()
+                p_state[i] = OPEN;
+                flags = (flags & ~FLEET_FLAG_LED_OPEN_BLINK) | FLEET_FLAG_LED_OPEN_ON | FLEET_FLAG_MOTOR_ARMED;
+                p_deadline[i] = now_ms + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS;
+                num_transitions++;
+            }
+            break;
+        case OPEN:
+            if (presence_or_button)
+            {
+                // do_keep_open()
+                flags |= FLEET_FLAG_MOTOR_ARMED;
+                p_deadline[i] = now_ms + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS;
+                num_transitions++;
+            }
+            else if (timeout)
+            {
+                // do_close_door()
+                p_state[i] = CLOSING;
+                flags = (flags & ~(FLEET_FLAG_LED_OPEN_ON | FLEET_FLAG_PRESENCE)) | FLEET_FLAG_LED_CLOSE_BLINK | FLEET_FLAG_MOTOR_ARMED;
+                p_deadline[i] = now_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS;
+                num_transitions++;
+            }
+            break;
+        case CLOSING:
+            if (presence_or_button)
+            {
+                // do_stop_closing_door() and do_open_door()
+                p_state[i] = OPENING;
+                flags = (flags & ~FLEET_FLAGS_LEDS) | FLEET_FLAG_LED_OPEN_BLINK | FLEET_FLAG_MOTOR_ARMED | FLEET_FLAG_PRESENCE;
+                p_deadline[i] = now_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS;
+                p_last_time[i] = now_ms;
+                num_transitions++;
+            }
+            else if (timeout)
+            {
+                // do_stay_closed()
+                p_state[i] = CLOSED;
+                flags = (flags & ~(FLEET_FLAG_LED_CLOSE_BLINK | FLEET_FLAG_MOTOR_ARMED)) | FLEET_FLAG_LED_CLOSE_ON;
+                num_transitions++;
+            }
+            break;
+        default:
+            break;
+        }
+        p_flags[i] = flags;
+    }
+    return num_transitions;
+}
+
+size_t fsm_automatic_door_fleet_bytes_per_door(void)
+{
+    return 2 * sizeof(uint32_t) + 3 * sizeof(uint8_t);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file fsm_indexed.c
+ * @author agent (agent@local)
+ * @brief Indexed transition dispatcher of the FSM library.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <string.h>
+
+/* Project includes */
+#include "fsm_indexed.h"
+
+/* Function definitions ------------------------------------------------------*/
+bool fsm_indexed_init(fsm_indexed_t *p_index, fsm_trans_t *p_tt)
+{
+    memset(p_index, 0, sizeof(fsm_indexed_t));
+
+    // Count the transitions leaving each state and check the limits
+    uint8_t num_trans = 0;
+    for (fsm_trans_t *p_t = p_tt; p_t->orig_state >= 0; p_t++)
+    {
+        if ((num_trans >= FSM_INDEXED_MAX_TRANSITIONS) || (p_t->orig_state >= FSM_INDEXED_MAX_STATES))
+        {
+            memset(p_index, 0, sizeof(fsm_indexed_t));
+            return false;
+        }
+        p_index->count[p_t->orig_state]++;
+        num_trans++;
+    }
+
+    // Compute the offset of each state (prefix sum of the counts)
+    uint8_t offset = 0;
+    for (uint8_t state = 0; state < FSM_INDEXED_MAX_STATES; state++)
+    {
+        p_index->offset[state] = offset;
+        offset += p_index->count[state];
+    }
+
+    // Place the transitions (stable counting sort, to keep the priority of the original table)
+    uint8_t next[FSM_INDEXED_MAX_STATES];
+    memcpy(next, p_index->offset, sizeof(next));
+    for (fsm_trans_t *p_t = p_tt; p_t->orig_state >= 0; p_t++)
+    {
+        uint8_t position = next[p_t->orig_state]++;
+        p_index->trans[position] = *p_t;
+        p_index->arc[position] = (uint8_t)(p_t - p_tt);
+    }
+    p_index->num_trans = num_trans;
+
+    return true;
+}
+
+bool fsm_indexed_fire(const fsm_indexed_t *p_index, fsm_t *p_fsm)
+{
+    return fsm_indexed_fire_arc(p_index, p_fsm) >= 0;
+}
+
+int fsm_indexed_fire_arc(const fsm_indexed_t *p_index, fsm_t *p_fsm)
+{
+    int state = fsm_get_state(p_fsm);
+    if ((state < 0) || (state >= FSM_INDEXED_MAX_STATES))
+    {
+        return -1;
+    }
+
+    uint8_t first = p_index->offset[state];
+    uint8_t end = first + p_index->count[state];
+    for (uint8_t i = first; i < end; i++)
+    {
+        const fsm_trans_t *p_t = &p_index->trans[i];
+        if (p_t->in(p_fsm))
+        {
+            fsm_set_state(p_fsm, p_t->dest_state);
+            if (p_t->out)
+            {
+                p_t->out(p_fsm);
+            }
+            return p_index->arc[i];
+        }
+    }
+    return -1;
+}
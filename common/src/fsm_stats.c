@@ -0,0 +1,83 @@
+/**
+ * @file fsm_stats.c
+ * @author agent (agent@local)
+ * @brief Statistics of the FSMs: dwell time histograms per state and counters per transition.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "fsm_stats.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define FSM_STATS_READ_ATTEMPTS 4 /*!< Number of attempts to read a consistent copy of the statistics */
+
+_Static_assert((FSM_STATS_NUM_BUCKETS >= 2) && (FSM_STATS_NUM_BUCKETS <= 33), "FSM_STATS_NUM_BUCKETS must be between 2 and 33");
+
+/* Function definitions ------------------------------------------------------*/
+uint32_t fsm_stats_bucket(uint32_t dwell_ms)
+{
+    if (dwell_ms == 0)
+    {
+        return 0;
+    }
+
+    // Bucket b holds [2^(b-1), 2^b): b is the number of significant bits
+    uint32_t bucket = 32 - (uint32_t)__builtin_clz(dwell_ms);
+    return bucket < FSM_STATS_NUM_BUCKETS ? bucket : FSM_STATS_NUM_BUCKETS - 1;
+}
+
+uint32_t fsm_stats_bucket_min_ms(uint32_t bucket)
+{
+    return bucket == 0 ? 0 : (1UL << (bucket - 1));
+}
+
+void fsm_stats_init(fsm_stats_t *p_stats, uint32_t now_ms)
+{
+    memset(&p_stats->data, 0, sizeof(p_stats->data));
+    p_stats->data.state_entry_ms = now_ms;
+    atomic_store_explicit(&p_stats->seq, 0, memory_order_release);
+}
+
+void fsm_stats_record(fsm_stats_t *p_stats, uint32_t now_ms, int from_state, int to_state, int arc)
+{
+    // Odd sequence: update in progress
+    unsigned int seq = atomic_load_explicit(&p_stats->seq, memory_order_relaxed);
+    atomic_store_explicit(&p_stats->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    if ((arc >= 0) && (arc < FSM_STATS_MAX_ARCS))
+    {
+        p_stats->data.arcs[arc]++;
+    }
+    if (from_state != to_state)
+    {
+        if ((from_state >= 0) && (from_state < FSM_STATS_MAX_STATES))
+        {
+            p_stats->data.dwell[from_state][fsm_stats_bucket(now_ms - p_stats->data.state_entry_ms)]++;
+        }
+        p_stats->data.state_entry_ms = now_ms;
+    }
+
+    atomic_store_explicit(&p_stats->seq, seq + 2, memory_order_release);
+}
+
+bool fsm_stats_read(fsm_stats_t *p_stats, fsm_stats_data_t *p_data)
+{
+    for (uint32_t attempt = 0; attempt < FSM_STATS_READ_ATTEMPTS; attempt++)
+    {
+        unsigned int seq = atomic_load_explicit(&p_stats->seq, memory_order_acquire);
+        if (seq & 1)
+        {
+            continue;
+        }
+        memcpy(p_data, &p_stats->data, sizeof(*p_data));
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&p_stats->seq, memory_order_relaxed) == seq)
+        {
+            return true;
+        }
+    }
+    return false;
+}
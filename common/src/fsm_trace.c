@@ -0,0 +1,70 @@
+/**
+ * @file fsm_trace.c
+ * @author agent (agent@local)
+ * @brief Transition trace of the FSMs.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fsm_trace.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define FSM_TRACE_MASK (FSM_TRACE_SIZE - 1) /*!< Mask to convert a position into a slot index */
+
+_Static_assert((FSM_TRACE_SIZE > 0) && ((FSM_TRACE_SIZE & FSM_TRACE_MASK) == 0), "FSM_TRACE_SIZE must be a power of 2");
+
+/* Function definitions ------------------------------------------------------*/
+void fsm_trace_init(fsm_trace_t *p_trace)
+{
+    for (uint32_t i = 0; i < FSM_TRACE_SIZE; i++)
+    {
+        atomic_store_explicit(&p_trace->slots[i].seq, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&p_trace->head, 0, memory_order_release);
+}
+
+void fsm_trace_record(fsm_trace_t *p_trace, uint32_t timestamp_ms, uint8_t from_state, uint8_t to_state, uint8_t arc, uint8_t inputs)
+{
+    // Reserve a position: a writer that preempts this one gets the next one
+    unsigned int pos = atomic_fetch_add_explicit(&p_trace->head, 1, memory_order_relaxed);
+    fsm_trace_slot_t *p_slot = &p_trace->slots[pos & FSM_TRACE_MASK];
+
+    // Invalidate the slot while it is written, then publish it
+    atomic_store_explicit(&p_slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    p_slot->entry = (fsm_trace_entry_t){.timestamp_ms = timestamp_ms, .from_state = from_state, .to_state = to_state, .arc = arc, .inputs = inputs};
+    atomic_store_explicit(&p_slot->seq, pos + 1, memory_order_release);
+}
+
+uint32_t fsm_trace_dump(fsm_trace_t *p_trace, fsm_trace_entry_t *p_entries, uint32_t max_entries)
+{
+    unsigned int head = atomic_load_explicit(&p_trace->head, memory_order_acquire);
+    uint32_t available = head < FSM_TRACE_SIZE ? head : FSM_TRACE_SIZE;
+    uint32_t num = available < max_entries ? available : max_entries;
+    uint32_t copied = 0;
+
+    for (unsigned int pos = head - num; pos != head; pos++)
+    {
+        fsm_trace_slot_t *p_slot = &p_trace->slots[pos & FSM_TRACE_MASK];
+
+        // Copy the entry only if it is the expected one and it has not changed while copying
+        if (atomic_load_explicit(&p_slot->seq, memory_order_acquire) != pos + 1)
+        {
+            continue;
+        }
+        fsm_trace_entry_t entry = p_slot->entry;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&p_slot->seq, memory_order_relaxed) != pos + 1)
+        {
+            continue;
+        }
+        p_entries[copied++] = entry;
+    }
+    return copied;
+}
+
+uint32_t fsm_trace_get_count(fsm_trace_t *p_trace)
+{
+    return atomic_load_explicit(&p_trace->head, memory_order_relaxed);
+}
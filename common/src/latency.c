@@ -0,0 +1,157 @@
+/**
+ * @file latency.c
+ * @author agent (agent@local)
+ * @brief Measurement of latencies with the cycle counter.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "latency.h"
+#include "port_system.h"
+
+/* Global variables -----------------------------------------------------------*/
+latency_t latency_automatic_door;
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Gets the highest latency of a histogram bucket.
+ *
+ * @param bucket Index of the bucket.
+ * @return uint32_t Highest latency in cycles counted in the bucket.
+ */
+static uint32_t _bucket_max_cycles(uint32_t bucket)
+{
+    return bucket + 1 < LATENCY_NUM_BUCKETS ? latency_bucket_min_cycles(bucket + 1) - 1 : UINT32_MAX;
+}
+
+/**
+ * @brief Prints a value in cycles and in microseconds with 3 decimals (integer arithmetic, no float support needed in `printf()`).
+ *
+ * @param label Label of the value.
+ * @param cycles Value in cycles.
+ * @param cycles_per_us Cycles per microsecond.
+ */
+static void _print_value(const char *label, uint32_t cycles, uint32_t cycles_per_us)
+{
+    uint64_t ns = ((uint64_t)cycles * 1000U) / cycles_per_us;
+    printf(" %s %" PRIu32 " cycles (%" PRIu32 ".%03" PRIu32 " us)", label, cycles, (uint32_t)(ns / 1000U), (uint32_t)(ns % 1000U));
+}
+
+/* Function definitions ------------------------------------------------------*/
+uint32_t latency_bucket(uint32_t cycles)
+{
+    if (cycles < LATENCY_SUB_BUCKETS)
+    {
+        return cycles;
+    }
+
+    // Position of the most significant bit, and the next LATENCY_SUB_BUCKET_BITS bits as sub-bucket
+    uint32_t msb = 31 - (uint32_t)__builtin_clz(cycles);
+    uint32_t sub = (cycles >> (msb - LATENCY_SUB_BUCKET_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+    return (msb - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS + sub;
+}
+
+uint32_t latency_bucket_min_cycles(uint32_t bucket)
+{
+    if (bucket < LATENCY_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    uint32_t msb = bucket / LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKET_BITS - 1;
+    uint32_t sub = bucket % LATENCY_SUB_BUCKETS;
+    return (LATENCY_SUB_BUCKETS + sub) << (msb - LATENCY_SUB_BUCKET_BITS);
+}
+
+void latency_init(latency_t *p_latency)
+{
+    port_system_cycle_counter_init();
+    p_latency->count = 0;
+    p_latency->min_cycles = UINT32_MAX;
+    p_latency->max_cycles = 0;
+    p_latency->sum_cycles = 0;
+    memset(p_latency->histogram, 0, sizeof(p_latency->histogram));
+    atomic_store_explicit(&p_latency->start_cycles, 0, memory_order_release);
+}
+
+void latency_start(latency_t *p_latency, uint32_t cycles)
+{
+    atomic_store_explicit(&p_latency->start_cycles, cycles | 1U, memory_order_release);
+}
+
+void latency_stop(latency_t *p_latency, uint32_t cycles)
+{
+    // Take the start point atomically: an ISR that starts a new one right after is not lost
+    uint32_t start = atomic_exchange_explicit(&p_latency->start_cycles, 0, memory_order_acquire);
+    if (start == 0)
+    {
+        return;
+    }
+    latency_record(p_latency, (cycles | 1U) - start);
+}
+
+void latency_cancel(latency_t *p_latency)
+{
+    atomic_store_explicit(&p_latency->start_cycles, 0, memory_order_release);
+}
+
+void latency_record(latency_t *p_latency, uint32_t cycles)
+{
+    p_latency->count++;
+    p_latency->sum_cycles += cycles;
+    if (cycles < p_latency->min_cycles)
+    {
+        p_latency->min_cycles = cycles;
+    }
+    if (cycles > p_latency->max_cycles)
+    {
+        p_latency->max_cycles = cycles;
+    }
+    p_latency->histogram[latency_bucket(cycles)]++;
+}
+
+void latency_get_report(latency_t *p_latency, latency_report_t *p_report)
+{
+    memset(p_report, 0, sizeof(*p_report));
+    p_report->cycles_per_us = port_system_get_cycles_per_us();
+    if (p_latency->count == 0)
+    {
+        return;
+    }
+
+    p_report->count = p_latency->count;
+    p_report->min_cycles = p_latency->min_cycles;
+    p_report->max_cycles = p_latency->max_cycles;
+    p_report->mean_cycles = (uint32_t)(p_latency->sum_cycles / p_latency->count);
+
+    // p99: the first bucket where the cumulative count reaches 99 % of the samples (rounded up)
+    uint64_t rank = ((uint64_t)p_latency->count * 99U + 99U) / 100U;
+    uint64_t cumulative = 0;
+    for (uint32_t bucket = 0; bucket < LATENCY_NUM_BUCKETS; bucket++)
+    {
+        cumulative += p_latency->histogram[bucket];
+        if (cumulative >= rank)
+        {
+            uint32_t p99 = _bucket_max_cycles(bucket);
+            p_report->p99_cycles = p99 < p_latency->max_cycles ? p99 : p_latency->max_cycles;
+            break;
+        }
+    }
+}
+
+void latency_print_report(const char *name, latency_t *p_latency)
+{
+    latency_report_t report;
+    latency_get_report(p_latency, &report);
+
+    printf("Latency %s: %" PRIu32 " samples,", name, report.count);
+    _print_value("min", report.min_cycles, report.cycles_per_us);
+    _print_value("mean", report.mean_cycles, report.cycles_per_us);
+    _print_value("max", report.max_cycles, report.cycles_per_us);
+    _print_value("p99", report.p99_cycles, report.cycles_per_us);
+    printf("\n");
+}
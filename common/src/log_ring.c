@@ -0,0 +1,71 @@
+/**
+ * @file log_ring.c
+ * @author agent (agent@local)
+ * @brief Ring buffer of the log output (`printf`) drained in the background.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "log_ring.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define LOG_RING_MASK (LOG_RING_SIZE - 1) /*!< Mask to convert a position into an index of the ring */
+
+_Static_assert((LOG_RING_SIZE & LOG_RING_MASK) == 0, "LOG_RING_SIZE must be a power of 2");
+
+/* Function definitions ------------------------------------------------------*/
+void log_ring_init(log_ring_t *p_ring)
+{
+    atomic_store_explicit(&p_ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_ring->tail, 0, memory_order_relaxed);
+    atomic_store_explicit(&p_ring->lost, 0, memory_order_release);
+}
+
+bool log_ring_write(log_ring_t *p_ring, const void *p_data, uint32_t len)
+{
+    unsigned int head = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+    if (len > LOG_RING_SIZE - (head - tail))
+    {
+        atomic_fetch_add_explicit(&p_ring->lost, len, memory_order_relaxed);
+        return false;
+    }
+
+    // At most two copies: up to the end of the ring and from its start
+    uint32_t index = head & LOG_RING_MASK;
+    uint32_t first = (len < LOG_RING_SIZE - index) ? len : LOG_RING_SIZE - index;
+    memcpy(&p_ring->data[index], p_data, first);
+    memcpy(&p_ring->data[0], (const uint8_t *)p_data + first, len - first);
+
+    // Publish the bytes to the consumer
+    atomic_store_explicit(&p_ring->head, head + len, memory_order_release);
+    return true;
+}
+
+uint32_t log_ring_peek(log_ring_t *p_ring, const uint8_t **pp_data)
+{
+    unsigned int tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+    uint32_t index = tail & LOG_RING_MASK;
+    uint32_t used = head - tail;
+    *pp_data = &p_ring->data[index];
+    return (used < LOG_RING_SIZE - index) ? used : LOG_RING_SIZE - index;
+}
+
+void log_ring_consume(log_ring_t *p_ring, uint32_t len)
+{
+    unsigned int tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    atomic_store_explicit(&p_ring->tail, tail + len, memory_order_release);
+}
+
+uint32_t log_ring_get_used(log_ring_t *p_ring)
+{
+    return atomic_load_explicit(&p_ring->head, memory_order_acquire) - atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+}
+
+uint32_t log_ring_get_lost(log_ring_t *p_ring)
+{
+    return atomic_load_explicit(&p_ring->lost, memory_order_relaxed);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file motor_profile.c
+ * @author agent (agent@local)
+ * @brief Trapezoidal speed profile of a motor, precomputed into a table of PWM duties.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_profile.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Exact travel of the trapezoid up to the end of a step, in units of full scale times a step, times 2 * `ramp_steps`.
+ *
+ * @param steps Number of steps of the profile.
+ * @param ramp_steps Number of steps of each ramp (at least 1).
+ * @param k Number of steps from the start of the profile.
+ * @return uint64_t Travel times 2 * `ramp_steps`.
+ */
+static uint64_t _motor_profile_area_x2ramp(uint32_t steps, uint32_t ramp_steps, uint32_t k)
+{
+    uint64_t a = ramp_steps;
+    if (k <= ramp_steps)
+    {
+        return (uint64_t)k * k; // Acceleration: k^2 / (2 * a)
+    }
+    if (k <= steps - ramp_steps)
+    {
+        return a * a + 2U * a * (k - ramp_steps); // Cruise: a / 2 + (k - a)
+    }
+    uint64_t left = steps - k;
+    return 2U * a * (steps - ramp_steps) - left * left; // Deceleration: (n - a) - (n - k)^2 / (2 * a)
+}
+
+/* Function definitions ------------------------------------------------------*/
+bool motor_profile_build(motor_profile_t *p_profile, uint32_t total_ms, uint32_t step_ms, uint32_t ramp_ms, uint32_t full_scale)
+{
+    p_profile->steps = 0;
+    if ((step_ms == 0) || (total_ms % step_ms != 0) || (total_ms / step_ms > MOTOR_PROFILE_MAX_STEPS) || (2U * ramp_ms > total_ms) || (full_scale > UINT16_MAX))
+    {
+        return false;
+    }
+    uint32_t steps = total_ms / step_ms;
+    uint32_t ramp_steps = ramp_ms / step_ms;
+
+    uint64_t travel = 0;
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        // The duty of a step is the travel up to its end minus the travel up to its start, both rounded down
+        uint64_t next = (ramp_steps == 0) ? (uint64_t)full_scale * (i + 1U) : ((uint64_t)full_scale * _motor_profile_area_x2ramp(steps, ramp_steps, i + 1U)) / (2U * ramp_steps);
+        p_profile->duty[i] = (uint16_t)(next - travel);
+        travel = next;
+    }
+
+    p_profile->ramp_steps = ramp_steps;
+    p_profile->step_ms = step_ms;
+    p_profile->full_scale = full_scale;
+    p_profile->steps = steps;
+    return true;
+}
+
+uint64_t motor_profile_get_travel(const motor_profile_t *p_profile, uint32_t steps)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; (i < steps) && (i < p_profile->steps); i++)
+    {
+        sum += p_profile->duty[i];
+    }
+    return sum * p_profile->step_ms;
+}
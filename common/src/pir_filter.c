@@ -0,0 +1,101 @@
+/**
+ * @file pir_filter.c
+ * @author agent (agent@local)
+ * @brief Filter of the output of a PIR sensor: minimum high time, retrigger hold and coalescing of bursts.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pir_filter.h"
+
+/* Function definitions ------------------------------------------------------*/
+void pir_filter_init(pir_filter_t *p_filter, uint32_t min_high_ms, uint32_t hold_ms, bool level)
+{
+    p_filter->min_high_ms = min_high_ms;
+    p_filter->hold_ms = hold_ms;
+    p_filter->raw = level;
+    p_filter->present = level;
+    p_filter->rise_ms = 0;
+    p_filter->fall_ms = 0;
+    p_filter->raw_edges = 0;
+    p_filter->delivered = 0;
+    p_filter->glitches = 0;
+    p_filter->coalesced = 0;
+}
+
+bool pir_filter_edge(pir_filter_t *p_filter, uint32_t now_ms, bool level)
+{
+    p_filter->raw_edges++;
+    if (level == p_filter->raw)
+    {
+        return false;
+    }
+    p_filter->raw = level;
+
+    if (level)
+    {
+        p_filter->rise_ms = now_ms;
+        if (p_filter->present)
+        {
+            // Inside the hold of a presence: the drop and this edge are the same presence
+            p_filter->coalesced++;
+            return false;
+        }
+        if (p_filter->min_high_ms > 0)
+        {
+            return false; // The presence is delivered by the poll if the input is still high then
+        }
+        p_filter->present = true;
+        p_filter->delivered++;
+        return true;
+    }
+
+    p_filter->fall_ms = now_ms;
+    if (!p_filter->present)
+    {
+        if ((now_ms - p_filter->rise_ms) < p_filter->min_high_ms)
+        {
+            p_filter->glitches++;
+            return false;
+        }
+        // Long enough, but no poll has delivered it yet: the presence is delivered now and its end by the next poll
+        p_filter->present = true;
+        p_filter->delivered++;
+        return true;
+    }
+    if (p_filter->hold_ms > 0)
+    {
+        return false; // The end of the presence is delivered by the poll if the input is still low then
+    }
+    p_filter->present = false;
+    p_filter->delivered++;
+    return true;
+}
+
+bool pir_filter_is_pending(const pir_filter_t *p_filter)
+{
+    return p_filter->raw != p_filter->present;
+}
+
+bool pir_filter_poll(pir_filter_t *p_filter, uint32_t now_ms)
+{
+    if (p_filter->raw == p_filter->present)
+    {
+        return false;
+    }
+    if (p_filter->raw)
+    {
+        if ((now_ms - p_filter->rise_ms) < p_filter->min_high_ms)
+        {
+            return false;
+        }
+    }
+    else if ((now_ms - p_filter->fall_ms) < p_filter->hold_ms)
+    {
+        return false;
+    }
+    p_filter->present = p_filter->raw;
+    p_filter->delivered++;
+    return true;
+}
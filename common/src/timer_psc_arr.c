@@ -0,0 +1,75 @@
+/**
+ * @file timer_psc_arr.c
+ * @author agent (agent@local)
+ * @brief Integer solver of the prescaler (PSC) and auto-reload (ARR) registers of the timers.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "timer_psc_arr.h"
+
+/* Function definitions ------------------------------------------------------*/
+bool timer_psc_arr_solve(uint32_t clock_hz, uint32_t period_ms, timer_psc_arr_t *p_psc_arr)
+{
+    // Ticks of the period. With a clock in whole kHz (the usual case) there is no 64-bit division
+    uint64_t ticks = (clock_hz % 1000U == 0) ? (uint64_t)(clock_hz / 1000U) * period_ms : TIMER_PSC_ARR_TICKS(clock_hz, period_ms);
+    if (ticks == 0)
+    {
+        p_psc_arr->psc = 0;
+        p_psc_arr->arr = 0;
+        return false;
+    }
+    if (ticks > UINT32_MAX)
+    {
+        p_psc_arr->psc = TIMER_PSC_ARR_MAX_COUNT - 1U;
+        p_psc_arr->arr = TIMER_PSC_ARR_MAX_COUNT - 1U;
+        return false;
+    }
+
+    // From here on 32-bit divisions only (a single UDIV instruction on the Cortex-M4)
+    uint32_t n = (uint32_t)ticks;
+    // The search starts one prescaler below the one that fits for sure: its count may still round down to 2^16
+    uint32_t div_min = n / TIMER_PSC_ARR_MAX_COUNT;
+    div_min = div_min > 0 ? div_min : 1;
+    uint32_t div_max = div_min + TIMER_PSC_ARR_SEARCH - 1U;
+    div_max = div_max < TIMER_PSC_ARR_MAX_COUNT ? div_max : TIMER_PSC_ARR_MAX_COUNT;
+
+    uint32_t best_div = div_min;
+    uint32_t best_count = 0;
+    uint64_t best_error = UINT64_MAX;
+    for (uint32_t div = div_min; div <= div_max; div++)
+    {
+        // Nearest count for this prescaler, without overflowing n + div / 2
+        uint32_t count = n / div;
+        uint32_t rest = n % div;
+        count += (rest >= div - rest);
+        count = count < TIMER_PSC_ARR_MAX_COUNT ? count : TIMER_PSC_ARR_MAX_COUNT;
+        if (count == 0)
+        {
+            break; // Periods of a few ticks: the prescaler is already longer than the period
+        }
+
+        uint64_t period = (uint64_t)div * count;
+        uint64_t error = period > n ? period - n : n - period;
+        if (error < best_error)
+        {
+            best_div = div;
+            best_count = count;
+            best_error = error;
+            if (error == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    p_psc_arr->psc = best_div - 1U;
+    p_psc_arr->arr = best_count - 1U;
+    return true;
+}
+
+uint64_t timer_psc_arr_get_ticks(const timer_psc_arr_t *p_psc_arr)
+{
+    return ((uint64_t)p_psc_arr->psc + 1U) * ((uint64_t)p_psc_arr->arr + 1U);
+}
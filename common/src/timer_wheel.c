@@ -0,0 +1,183 @@
+/**
+ * @file timer_wheel.c
+ * @author agent (agent@local)
+ * @brief Hierarchical timing wheel: software timers multiplexed on a single tick source.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "timer_wheel.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Links a timer into the slot of its expiry time. The expiry time must be at least the next tick.
+ *
+ * The level is the first one whose range covers the ticks from the next one to the expiry, and the slot the bits of the expiry time of that level. A timer of level L is then cascaded exactly when the lower bits of the time become 0 with its slot, which is before it expires.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param p_timer Pointer to the timer.
+ */
+static void _link(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer)
+{
+    uint32_t delta = p_timer->expires - (p_wheel->now + 1U);
+    uint32_t level = 0;
+    while ((level < TIMER_WHEEL_LEVELS - 1U) && (delta >> (TIMER_WHEEL_SLOT_BITS * (level + 1U))) != 0)
+    {
+        level++;
+    }
+    uint32_t slot = (p_timer->expires >> (TIMER_WHEEL_SLOT_BITS * level)) & (TIMER_WHEEL_SLOTS - 1U);
+
+    timer_wheel_timer_t **pp_head = &p_wheel->p_slots[level][slot];
+    p_timer->p_next = *pp_head;
+    if (p_timer->p_next != NULL)
+    {
+        p_timer->p_next->pp_prev = &p_timer->p_next;
+    }
+    p_timer->pp_prev = pp_head;
+    *pp_head = p_timer;
+    p_wheel->pending++;
+}
+
+/**
+ * @brief Unlinks a pending timer from its slot.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param p_timer Pointer to the timer.
+ */
+static void _unlink(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer)
+{
+    *p_timer->pp_prev = p_timer->p_next;
+    if (p_timer->p_next != NULL)
+    {
+        p_timer->p_next->pp_prev = p_timer->pp_prev;
+    }
+    p_timer->p_next = NULL;
+    p_timer->pp_prev = NULL;
+    p_wheel->pending--;
+}
+
+/**
+ * @brief Moves the timers of a slot of an upper level to the lower levels.
+ *
+ * @param p_wheel Pointer to the wheel.
+ * @param level Level of the slot.
+ * @param slot Index of the slot.
+ */
+static void _cascade(timer_wheel_t *p_wheel, uint32_t level, uint32_t slot)
+{
+    timer_wheel_timer_t *p_timer = p_wheel->p_slots[level][slot];
+    p_wheel->p_slots[level][slot] = NULL;
+    while (p_timer != NULL)
+    {
+        timer_wheel_timer_t *p_next = p_timer->p_next;
+        p_wheel->pending--; // _link() counts it again
+        _link(p_wheel, p_timer);
+        p_timer = p_next;
+    }
+}
+
+/**
+ * @brief Processes the next tick: cascades the upper slots that come around and runs the timers that expire.
+ *
+ * @param p_wheel Pointer to the wheel.
+ */
+static void _tick(timer_wheel_t *p_wheel)
+{
+    uint32_t tick = p_wheel->now + 1U;
+
+    // The timers cascaded in this tick are linked relative to it (the wheel is still at the previous one), so those that expire now land in its slot of level 0
+    for (uint32_t level = 1; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        if ((tick & ((1UL << (TIMER_WHEEL_SLOT_BITS * level)) - 1U)) != 0)
+        {
+            break;
+        }
+        _cascade(p_wheel, level, (tick >> (TIMER_WHEEL_SLOT_BITS * level)) & (TIMER_WHEEL_SLOTS - 1U));
+    }
+    p_wheel->now = tick;
+
+    // Take the expired timers out of the wheel first: the callbacks may arm timers in this very slot (for the next lap) or cancel the timers still to run
+    timer_wheel_timer_t *p_expired = p_wheel->p_slots[0][tick & (TIMER_WHEEL_SLOTS - 1U)];
+    p_wheel->p_slots[0][tick & (TIMER_WHEEL_SLOTS - 1U)] = NULL;
+    if (p_expired != NULL)
+    {
+        p_expired->pp_prev = &p_expired;
+    }
+    while (p_expired != NULL)
+    {
+        timer_wheel_timer_t *p_timer = p_expired;
+        _unlink(p_wheel, p_timer);
+        if (p_timer->period != 0)
+        {
+            p_timer->expires = tick + p_timer->period;
+            _link(p_wheel, p_timer);
+        }
+        p_timer->callback(p_timer->p_arg);
+    }
+}
+
+/* Function definitions ------------------------------------------------------*/
+void timer_wheel_init(timer_wheel_t *p_wheel, uint32_t now)
+{
+    for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        for (uint32_t slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+        {
+            p_wheel->p_slots[level][slot] = NULL;
+        }
+    }
+    p_wheel->now = now;
+    p_wheel->pending = 0;
+}
+
+void timer_wheel_timer_init(timer_wheel_timer_t *p_timer, timer_wheel_callback_t callback, void *p_arg)
+{
+    p_timer->p_next = NULL;
+    p_timer->pp_prev = NULL;
+    p_timer->expires = 0;
+    p_timer->period = 0;
+    p_timer->callback = callback;
+    p_timer->p_arg = p_arg;
+}
+
+void timer_wheel_arm(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer, uint32_t delay, uint32_t period)
+{
+    if (p_timer->pp_prev != NULL)
+    {
+        _unlink(p_wheel, p_timer);
+    }
+    delay = delay > 0 ? delay : 1;
+    delay = delay < TIMER_WHEEL_MAX_DELAY ? delay : TIMER_WHEEL_MAX_DELAY;
+    period = period < TIMER_WHEEL_MAX_DELAY ? period : TIMER_WHEEL_MAX_DELAY;
+    p_timer->expires = p_wheel->now + delay;
+    p_timer->period = period;
+    _link(p_wheel, p_timer);
+}
+
+void timer_wheel_cancel(timer_wheel_t *p_wheel, timer_wheel_timer_t *p_timer)
+{
+    if (p_timer->pp_prev != NULL)
+    {
+        _unlink(p_wheel, p_timer);
+    }
+}
+
+bool timer_wheel_timer_is_pending(const timer_wheel_timer_t *p_timer)
+{
+    return p_timer->pp_prev != NULL;
+}
+
+void timer_wheel_advance(timer_wheel_t *p_wheel, uint32_t now)
+{
+    while ((int32_t)(now - p_wheel->now) > 0)
+    {
+        if (p_wheel->pending == 0)
+        {
+            p_wheel->now = now; // Nothing can expire: skip the rest of the gap at once
+            break;
+        }
+        _tick(p_wheel);
+    }
+}
@@ -9,8 +9,56 @@
 
 /* INCLUDES */
 #include <stdio.h>
+#include <inttypes.h>
 #include "port_system.h"
 #include "fsm_automatic_door.h"
+#include "latency.h"
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+#include "event_log.h"
+#include "port_log.h"
+#endif
+
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+/* BINARY EVENT LOG */
+static event_log_t event_log;       /*!< Encoder of the binary log of the door */
+static uint32_t event_log_lost = 0; /*!< Lost bytes of the log last reported in it */
+
+/**
+ * @brief Sends a record through the UART and commits it if it has been queued.
+ *
+ * @param p_record Record.
+ * @param len Bytes of the record.
+ * @param now System time of the record.
+ * @return true if the record has been queued.
+ */
+static bool _log_send(const uint8_t *p_record, uint32_t len, uint32_t now)
+{
+    bool queued = port_log_try_write(&log_uart, p_record, len);
+    if (queued)
+    {
+        event_log_commit(&event_log, now);
+    }
+    return queued;
+}
+
+/**
+ * @brief Logs an event of the door as a binary record. If the log has lost bytes since the last report, a record with the count goes first.
+ *
+ * @param event Event code.
+ * @param state State of the door.
+ */
+static void _log_event(uint8_t event, int state)
+{
+    uint8_t record[EVENT_LOG_MAX_SIZE];
+    uint32_t now = port_system_get_millis();
+    uint32_t lost = port_log_get_lost(&log_uart);
+    if ((lost != event_log_lost) && _log_send(record, event_log_encode_payload(&event_log, record, now, EVENT_LOG_LOST, (uint8_t)state, lost), now))
+    {
+        event_log_lost = lost;
+    }
+    _log_send(record, event_log_encode(&event_log, record, now, event, (uint8_t)state), now);
+}
+#endif
 
 /* MAIN FUNCTION */
 
@@ -24,27 +72,79 @@ int main()
     // Local variables
 
     bool previous_presence_status = false;
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+    int previous_state = CLOSED;
+#endif
 
     /* Init board */
     port_system_init();
 
+    // Empty the queue of input events before the ISRs are enabled
+    event_queue_init(&event_queue_automatic_door);
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    latency_init(&latency_automatic_door);
+#endif
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+    event_log_init(&event_log);
+#endif
+
     // Create an automatic door FSM system
+    fsm_t *p_fsm_automatic_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
 
     while (1)
     {
-        // Launch the FSM
-        fsm_fire(p_fsm_automatic_door);
+        // Launch the FSM (only if there are input events pending)
+        fsm_automatic_door_fire_events(p_fsm_automatic_door, &event_queue_automatic_door);
 
         bool current_presence_status = fsm_automatic_door_get_presence_status(p_fsm_automatic_door);
         if (current_presence_status != previous_presence_status)
         {
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+            // A binary record instead of a line of text: no printf, so it is also in the heap-free (static pool) build
+            if (current_presence_status)
+            {
+                _log_event(EVENT_LOG_PRESENCE, fsm_get_state(p_fsm_automatic_door));
+            }
+#else
             uint32_t last_time_presence_or_button = fsm_automatic_door_get_last_time_presence(p_fsm_automatic_door);
+#if !defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) || (FSM_AUTOMATIC_DOOR_POOL_SIZE == 0)
+            // newlib stdio allocates its buffers on the heap, so there is no printf in the heap-free (static pool) build
             if (current_presence_status)
             {
-                printf("PRESENCE!!! Presence detected at %ld. Opening door...\n", last_time_presence_or_button);
+                printf("PRESENCE!!! Presence detected at %" PRIu32 ". Opening door...\n", last_time_presence_or_button);
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+                latency_print_report("PIR to door opening", &latency_automatic_door);
+#endif
             }
+#else
+            (void)last_time_presence_or_button;
+#endif
+#endif
             previous_presence_status = current_presence_status;
         }
+#if defined(FSM_AUTOMATIC_DOOR_EVENT_LOG)
+        int current_state = fsm_get_state(p_fsm_automatic_door);
+        if (current_state != previous_state)
+        {
+            _log_event(EVENT_LOG_STATE, current_state);
+            previous_state = current_state;
+        }
+#endif
+
+        // Sleep until the next interrupt. With the door closed no timeout is armed, so the system tick is stopped too, unless the filter of the PIR sensor waits for a time
+        port_system_enter_critical();
+        if (!event_queue_is_pending(&event_queue_automatic_door))
+        {
+            if (fsm_automatic_door_check_activity(p_fsm_automatic_door) || port_pir_sensor_is_filter_pending(&pir_sensor_automatic_door))
+            {
+                port_system_power_sleep();
+            }
+            else
+            {
+                port_system_power_sleep_tickless();
+            }
+        }
+        port_system_exit_critical();
     }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * @file port_button.h
+ * @author agent (agent@local)
+ * @brief Header file for the button port layer (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef PORT_BUTTON_H
+#define PORT_BUTTON_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "debounce.h"
+
+/* Defines --------------------------------------------------------------------*/
+#define BUTTON_EMERGENCY_PIN 13         /*!< EXTI line of the button, as on the board */
+#define BUTTON_EMERGENCY_DEBOUNCE_MS 50 /*!< Debouncing window of the button, as on the board */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the (simulated) HW dependencies of a button.
+ */
+typedef struct
+{
+    uint8_t pin;        /*!< EXTI line of the button */
+    bool gpio_level;    /*!< Simulated level of the GPIO: true when released (pull-up), false when pressed */
+    bool flag_pressed;  /*!< Flag to indicate that the button has been pressed and the press has not been consumed yet */
+    bool flag_released; /*!< Flag to indicate that the button has been released */
+    debounce_t debounce; /*!< Debouncer of the edges of the button. Its level is true when the button is pressed. With a window of 0 every edge is taken, as the buttons of the simulations, which are zero-initialized */
+} port_button_hw_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_button_hw_t button_emergency; /*!< Button of the automatic door system */
+
+/**
+ * @brief Initializes the button.
+ *
+ * @param p_button Pointer to the button structure.
+ */
+void port_button_init(port_button_hw_t *p_button);
+
+/**
+ * @brief Gets the status of the button.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return true if the button is released (GPIO high), false otherwise.
+ */
+bool port_button_read_gpio(port_button_hw_t *p_button);
+
+/**
+ * @brief Gets the status of the button. The button is considered pressed when it has been pressed and the press has not been consumed yet; it is not necessary to be released.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return true if the button is pressed, false otherwise.
+ */
+bool port_button_is_pressed(port_button_hw_t *p_button);
+
+/**
+ * @brief Consumes the press of the button: returns it once and clears it. The presses that happen before it is consumed count as one.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return true if the button has been pressed since the last time a press was consumed, false otherwise.
+ */
+bool port_button_consume_press(port_button_hw_t *p_button);
+
+/**
+ * @brief Gets the number of edges of the button rejected as bounces since the button was initialized.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return uint32_t Number of bounces.
+ */
+uint32_t port_button_get_bounces(port_button_hw_t *p_button);
+
+#endif /* PORT_BUTTON_H */
@@ -0,0 +1,70 @@
+/**
+ * @file port_door_sim.h
+ * @author agent (agent@local)
+ * @brief Header file for the physical model of the leaf of the automatic door, driven by the simulated motor (native platform).
+ *
+ * The leaf is a mass that slides along its travel pushed by the motor, with a viscous friction (proportional to the speed) and a Coulomb friction (constant, and static at rest: the leaf does not move unless the motor overcomes it). The end stops hold the leaf at 0 (closed) and at `length_m` (open) and stop it dead. The model is integrated with a semi-implicit Euler step of a millisecond, so that the results do not depend on how the simulation is sliced.
+ * @date 2026-10-17
+ *
+ */
+#ifndef PORT_DOOR_SIM_H_
+#define PORT_DOOR_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and macros --------------------------------------------------------*/
+#define DOOR_SIM_AUTOMATIC_DOOR_MASS_KG 40.0      /*!< Mass of the leaf of the automatic door */
+#define DOOR_SIM_AUTOMATIC_DOOR_VISCOUS_NS_M 80.0 /*!< Viscous friction of the rollers of the leaf, in N per m/s */
+#define DOOR_SIM_AUTOMATIC_DOOR_COULOMB_N 12.0    /*!< Coulomb (dry) friction of the rollers of the leaf */
+#define DOOR_SIM_AUTOMATIC_DOOR_FORCE_N 36.0      /*!< Force of the motor on the leaf at a duty of 100 % */
+#define DOOR_SIM_AUTOMATIC_DOOR_LENGTH_M 1.0      /*!< Travel of the leaf from closed to open */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the physical model of the leaf of a door.
+ */
+typedef struct
+{
+    double mass_kg;      /*!< Mass of the leaf */
+    double viscous_ns_m; /*!< Viscous friction, in N per m/s */
+    double coulomb_n;    /*!< Coulomb friction */
+    double force_n;      /*!< Force of the motor at a duty of 100 % */
+    double length_m;     /*!< Travel of the leaf */
+    double position_m;   /*!< Position of the leaf: 0 closed, `length_m` open */
+    double velocity_m_s; /*!< Velocity of the leaf, positive when it opens */
+} port_door_sim_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_door_sim_t door_sim_automatic_door; /*!< Leaf of the automatic door */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Puts the leaf at rest at a position. The parameters of the model are not changed.
+ *
+ * @param p_door Pointer to the model of the leaf.
+ * @param position_m Position of the leaf, clamped to the travel.
+ */
+void port_door_sim_init(port_door_sim_t *p_door, double position_m);
+
+/**
+ * @brief Integrates the motion of the leaf for a while under a constant force of the motor.
+ *
+ * @param p_door Pointer to the model of the leaf.
+ * @param force_n Force of the motor: positive to open, negative to close.
+ * @param dt_ms Time to integrate, in steps of a millisecond.
+ */
+void port_door_sim_step(port_door_sim_t *p_door, double force_n, uint32_t dt_ms);
+
+/**
+ * @brief Checks whether the leaf rests against an end stop.
+ *
+ * @param p_door Pointer to the model of the leaf.
+ * @param open End stop: true for the open one, false for the closed one.
+ * @return true If the leaf is at that end stop.
+ */
+bool port_door_sim_is_at_stop(port_door_sim_t *p_door, bool open);
+
+#endif /* PORT_DOOR_SIM_H_ */
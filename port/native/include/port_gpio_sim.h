@@ -0,0 +1,120 @@
+/**
+ * @file port_gpio_sim.h
+ * @author agent (agent@local)
+ * @brief Header file for the register-level simulation of the GPIO ports of the board (native platform).
+ *
+ * A simulated port has the output data register (ODR) of the board and counts the accesses of the port layer to it, as the bus of the board would see them: every read of ODR and every write of ODR or of the bit set/reset register (BSRR). BSRR sets the pins of its bits 0..15 and resets the pins of its bits 16..31 in a single write, and if a pin is both set and reset the set wins, as on the STM32F446RE.
+ *
+ * The batched writes compose the pin changes of several pins of the same port into one value of BSRR, written once per port on commit.
+ *
+ * The pending register of the EXTI (PR) is simulated too, for the lines that share an ISR: an edge sets the bit of its line and runs the ISR of the line, which clears the bits it handles, as on the board.
+ * @date 2026-10-17
+ *
+ */
+#ifndef PORT_GPIO_SIM_H_
+#define PORT_GPIO_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and macros --------------------------------------------------------*/
+#define PORT_GPIO_SIM_BATCH_MAX_PORTS 2 /*!< Number of ports a batch can hold. The writes to other ports are not batched */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a simulated GPIO port.
+ */
+typedef struct
+{
+    uint32_t ODR;    /*!< Output data register */
+    uint32_t reads;  /*!< Number of reads of ODR */
+    uint32_t writes; /*!< Number of writes of ODR or BSRR */
+} port_gpio_sim_t;
+
+/**
+ * @brief Structure to define a batch of writes to the pins of simulated GPIO ports.
+ */
+typedef struct
+{
+    port_gpio_sim_t *p_ports[PORT_GPIO_SIM_BATCH_MAX_PORTS]; /*!< Ports with pending writes */
+    uint32_t bsrr[PORT_GPIO_SIM_BATCH_MAX_PORTS];            /*!< Value of BSRR to write in each port */
+    uint8_t num_ports;                                       /*!< Number of ports with pending writes */
+} port_gpio_sim_batch_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_gpio_sim_t gpio_sim_b; /*!< Simulated GPIOB (LEDs of the automatic door) */
+extern uint32_t gpio_sim_exti_pr;  /*!< Simulated pending register of the EXTI: a bit per line */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Reads ODR of a port.
+ *
+ * @param p_port Pointer to the port.
+ * @return uint32_t Value of ODR.
+ */
+uint32_t port_gpio_sim_read_odr(port_gpio_sim_t *p_port);
+
+/**
+ * @brief Writes BSRR of a port: sets the pins of the bits 0..15 and resets the pins of the bits 16..31.
+ *
+ * @param p_port Pointer to the port.
+ * @param bsrr Value of BSRR.
+ */
+void port_gpio_sim_write_bsrr(port_gpio_sim_t *p_port, uint32_t bsrr);
+
+/**
+ * @brief Sets the level of a pin with a single write of BSRR.
+ *
+ * @param p_port Pointer to the port.
+ * @param pin Pin of the port (0 to 15).
+ * @param value Level of the pin.
+ */
+void port_gpio_sim_write(port_gpio_sim_t *p_port, uint8_t pin, bool value);
+
+/**
+ * @brief Toggles a pin: a read of ODR and a write of BSRR. The other pins of the port are not written.
+ *
+ * @param p_port Pointer to the port.
+ * @param pin Pin of the port (0 to 15).
+ */
+void port_gpio_sim_toggle(port_gpio_sim_t *p_port, uint8_t pin);
+
+/**
+ * @brief Empties a batch of writes.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_gpio_sim_batch_init(port_gpio_sim_batch_t *p_batch);
+
+/**
+ * @brief Adds the level of a pin to a batch. A later level of the same pin replaces it. If the batch has no room for another port, the pin is written at once.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param p_port Pointer to the port.
+ * @param pin Pin of the port (0 to 15).
+ * @param value Level of the pin.
+ */
+void port_gpio_sim_batch_write(port_gpio_sim_batch_t *p_batch, port_gpio_sim_t *p_port, uint8_t pin, bool value);
+
+/**
+ * @brief Writes the pins of a batch, one write of BSRR per port, and empties it.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_gpio_sim_batch_commit(port_gpio_sim_batch_t *p_batch);
+
+/**
+ * @brief Raises an edge in an EXTI line: sets its bit of the pending register and runs the ISR of the line. The simulation calls it after changing the simulated level of the GPIO, as the edge would on the board.
+ *
+ * @param pin Line of the EXTI (0 to 15). Only the lines 10 to 15 (`EXTI15_10_IRQHandler()`) have an ISR; for the others only the bit is set.
+ */
+void port_gpio_sim_exti_edge(uint8_t pin);
+
+/**
+ * @brief ISR of the EXTI lines 10 to 15 (file `interr.c`): the button and the PIR sensor.
+ */
+void EXTI15_10_IRQHandler(void);
+
+#endif /* PORT_GPIO_SIM_H_ */
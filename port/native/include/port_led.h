@@ -0,0 +1,137 @@
+/**
+ * @file port_led.h
+ * @author agent (agent@local)
+ * @brief Header file for the LED port layer (native platform).
+ * @date 2026-10-17
+ */
+#ifndef PORT_LED_H_
+#define PORT_LED_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_timer_sim.h"
+#include "port_gpio_sim.h"
+
+/* Project includes */
+#include "timer_wheel.h"
+
+/* Defines and macros --------------------------------------------------------*/
+#define LED_OPENING_GPIO (&gpio_sim_b) /*!< GPIO port of the LED for opening in the automatic door, as on the board */
+#define LED_OPENING_PIN 3              /*!< GPIO pin of the LED for opening in the automatic door, as on the board */
+#define LED_CLOSING_GPIO (&gpio_sim_b) /*!< GPIO port of the LED for closing in the automatic door, as on the board */
+#define LED_CLOSING_PIN 4              /*!< GPIO pin of the LED for closing in the automatic door, as on the board */
+#define LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS 500 /*!< Semi-period of the blinking of the opening LED */
+#define LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS 100 /*!< Semi-period of the blinking of the closing LED */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the (simulated) HW dependencies of a LED.
+ */
+typedef struct
+{
+    port_gpio_sim_t *p_port;               /*!< Simulated GPIO port of the LED, or NULL to keep the level in `status` */
+    uint8_t pin;                           /*!< Pin of the LED in `p_port` */
+    bool status;                           /*!< Simulated level of the GPIO of the LED, if it has no `p_port` */
+    bool timer_active;                     /*!< Whether the blinking timer is running */
+    uint32_t timer_blink_semi_period_ms;   /*!< Semi-period of the blinking of the LED */
+    port_timer_sim_t *p_timer;             /*!< Simulated timer for the blinking, or NULL. Its ISR toggles the LED */
+    timer_wheel_t *p_wheel;                /*!< Timing wheel of the blinking, or NULL. Only used without a simulated timer */
+    timer_wheel_timer_t timer_wheel_blink; /*!< Periodic software timer of the blinking in `p_wheel`. Its callback toggles the LED when whoever drives the simulation advances the wheel */
+} port_led_hw_t;
+
+/**
+ * @brief Batch of changes of the LEDs, written once per GPIO port on commit.
+ */
+typedef port_gpio_sim_batch_t port_led_batch_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_led_hw_t led_opening; /*!< LED for the opening the automatic door */
+extern port_led_hw_t led_closing; /*!< LED for the closing the automatic door */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes the LED.
+ *
+ * @param p_led Pointer to the LED structure.
+ */
+void port_led_init(port_led_hw_t *p_led);
+
+/**
+ * @brief Returns the current state of the LED.
+ *
+ * @return true if the LED is on
+ * @return false if the LED is off
+ */
+bool port_led_get_status(port_led_hw_t *p_led);
+
+/**
+ * @brief Turn on the LED
+ *
+ */
+void port_led_on(port_led_hw_t *p_led);
+
+/**
+ * @brief Turn off the LED
+ *
+ */
+void port_led_off(port_led_hw_t *p_led);
+
+/**
+ * @brief Toggles the LED state.
+ *
+ */
+void port_led_toggle(port_led_hw_t *p_led);
+
+/**
+ * @brief Empties a batch of changes of the LEDs.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_led_batch_init(port_led_batch_t *p_batch);
+
+/**
+ * @brief Adds turning on a LED to a batch. A LED without a GPIO port is turned on at once.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param p_led Pointer to the LED structure.
+ */
+void port_led_batch_on(port_led_batch_t *p_batch, port_led_hw_t *p_led);
+
+/**
+ * @brief Adds turning off a LED to a batch. A LED without a GPIO port is turned off at once.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param p_led Pointer to the LED structure.
+ */
+void port_led_batch_off(port_led_batch_t *p_batch, port_led_hw_t *p_led);
+
+/**
+ * @brief Writes the changes of a batch, one write per GPIO port, and empties it.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_led_batch_commit(port_led_batch_t *p_batch);
+
+/**
+ * @brief Configures the timer for the LED.
+ *
+ */
+void port_led_timer_setup(port_led_hw_t *p_led);
+
+/**
+ * @brief Activates the timer for the LED for blinking.
+ *
+ */
+void port_led_timer_activate(port_led_hw_t *p_led);
+
+/**
+ * @brief Deactivates the timer for the LED.
+ *
+ */
+void port_led_timer_deactivate(port_led_hw_t *p_led);
+
+#endif // PORT_LED_H_
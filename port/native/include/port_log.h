@@ -0,0 +1,107 @@
+/**
+ * @file port_log.h
+ * @author agent (agent@local)
+ * @brief Header file for the port layer of the log output through a UART drained with DMA, with a mock DMA in virtual time (native platform).
+ *
+ * The log is queued in a ring (`log_ring.h`) as on the board, and a mock of the DMA stream sends it in the background: a transfer of the oldest contiguous bytes of the ring starts when the DMA is idle and ends `LOG_UART_BYTE_NS` per byte later, in the virtual time of the log. Whoever drives the simulation advances that time with `port_log_sim_advance()`, which runs the end of the transfers that are due (the role of the ISR of the DMA) and appends the bytes sent to a sink, as a terminal would get them. `port_log_sim_write_blocking()` models the synchronous backend, which sends every byte before it returns.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef PORT_LOG_H
+#define PORT_LOG_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "log_ring.h"
+
+/* Defines --------------------------------------------------------------------*/
+#define LOG_UART_BAUD_RATE 115200                                       /*!< Baud rate of the UART, 8N1, as on the board */
+#define LOG_UART_BYTE_NS (10ULL * 1000000000ULL / LOG_UART_BAUD_RATE) /*!< Time to send a byte: start bit, 8 data bits and stop bit */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the (simulated) HW dependencies of the log output.
+ */
+typedef struct
+{
+    log_ring_t ring;     /*!< Bytes waiting to be sent */
+    uint32_t dma_len;    /*!< Bytes of the transfer in course, 0 if the DMA is idle */
+    uint64_t now_ns;     /*!< Virtual time of the UART */
+    uint64_t dma_end_ns; /*!< Virtual time at which the transfer in course ends */
+    uint32_t transfers;  /*!< Number of DMA transfers started */
+    char *p_sink;        /*!< Where the bytes sent are stored, or NULL to discard them */
+    uint32_t sink_size;  /*!< Size of the sink */
+    uint32_t sink_len;   /*!< Number of bytes sent (also those that did not fit in the sink) */
+} port_log_hw_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_log_hw_t log_uart; /*!< Log output of the system */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes the log: empties the ring, the DMA is idle and the virtual time is 0. The sink is kept and emptied.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+void port_log_init(port_log_hw_t *p_log);
+
+/**
+ * @brief Queues bytes to be sent and starts a DMA transfer if none is in course. It does not wait for the UART: the virtual time does not change. If the bytes do not fit in the ring they are dropped whole and counted as lost.
+ *
+ * @param p_log Pointer to the log structure.
+ * @param p_data Bytes to send.
+ * @param len Number of bytes.
+ * @return int `len`: the bytes are either queued or dropped, never left for a retry.
+ */
+int port_log_write(port_log_hw_t *p_log, const char *p_data, int len);
+
+/**
+ * @brief Queues bytes to be sent, as `port_log_write()`, but tells whether they have been queued or dropped because the ring was full. For writers that must know it, such as the binary event log (`event_log.h`).
+ *
+ * @param p_log Pointer to the log structure.
+ * @param p_data Bytes to send.
+ * @param len Number of bytes.
+ * @return true if the bytes have been queued.
+ * @return false if they have been dropped and counted as lost.
+ */
+bool port_log_try_write(port_log_hw_t *p_log, const void *p_data, uint32_t len);
+
+/**
+ * @brief Frees the bytes of the transfer that has ended and starts the next one. The role of the ISR of the end of the transfer of the DMA stream.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+void port_log_dma_complete(port_log_hw_t *p_log);
+
+/**
+ * @brief Gets the number of bytes dropped because the ring was full.
+ *
+ * @param p_log Pointer to the log structure.
+ * @return uint32_t Number of lost bytes since `port_log_init()`.
+ */
+uint32_t port_log_get_lost(port_log_hw_t *p_log);
+
+/**
+ * @brief Advances the virtual time of the UART: the transfers that end meanwhile put their bytes in the sink and start the next ones.
+ *
+ * @param p_log Pointer to the log structure.
+ * @param ns Time to advance, in nanoseconds.
+ */
+void port_log_sim_advance(port_log_hw_t *p_log, uint64_t ns);
+
+/**
+ * @brief Sends bytes as the synchronous backend does (the ITM, or a UART polled byte by byte): each byte goes to the sink after the one before it has been sent, and the call returns when the last one has. The virtual time advances by the time it takes.
+ *
+ * @param p_log Pointer to the log structure. The DMA must be idle.
+ * @param p_data Bytes to send.
+ * @param len Number of bytes.
+ * @return uint64_t Time the caller has waited, in nanoseconds.
+ */
+uint64_t port_log_sim_write_blocking(port_log_hw_t *p_log, const char *p_data, int len);
+
+#endif /* PORT_LOG_H */
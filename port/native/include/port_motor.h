@@ -0,0 +1,175 @@
+/**
+ * @file port_motor.h
+ * @author agent (agent@local)
+ * @brief Header file for the port layer of a simulated motor (native platform).
+ * @date 2026-10-17
+ *
+ */
+#ifndef PORT_MOTOR_H
+#define PORT_MOTOR_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_timer_sim.h"
+#include "port_door_sim.h"
+
+/* Project includes */
+#include "timer_wheel.h"
+#include "event_queue.h"
+#include "motor_profile.h"
+
+/* Defines and macros --------------------------------------------------------*/
+#define MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE 800    /*!< Duty of 100 %, as on the board: ARR + 1 of a 20 kHz PWM at 16 MHz */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_MS 5000       /*!< Duration of the speed profile of the motor, as on the board */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS 10    /*!< Period of the update of the duty of the motor, as on the board */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS 1000  /*!< Duration of the acceleration and of the deceleration of the motor, as on the board */
+#define MOTOR_POSITION_OPEN 1000                   /*!< Position of the door fully open, in per mille of the travel (0 is closed) */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the (simulated) HW dependencies of a motor.
+ *
+ * If the motor has a speed profile (`p_profile`, only `motor_automatic_door`), `duty` is the compare register of its PWM channel: whoever drives the simulation runs `TIM1_UP_TIM10_IRQHandler()` every `MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS` while `pwm_update_irq` is set, as the update events of the PWM timer of the board, and the ISR loads the duty of the next step. The motors of the simulations are zero-initialized and have no PWM.
+ *
+ * If the motor moves a simulated leaf (`p_door`, see `port_door_sim.h`), the motor has position feedback: whoever drives the simulation calls `port_motor_sim_step()`, which pushes the leaf with the force of the duty in course and runs the update of the PWM every step of the profile. When the leaf reaches the end of the travel of the movement, the motor stops and pushes `EVENT_MOTOR_END_OF_TRAVEL` into `p_event_queue`, as the position sensor of the board would. No motor has a leaf by default.
+ *
+ * A motor without leaf may have end switches instead (`end_switches`), as the replay of the log of a door with position feedback needs: whoever drives the simulation presses them with `port_motor_sim_set_end_of_travel()` and pushes `EVENT_MOTOR_END_OF_TRAVEL`, as the ISR of a switch would. Starting a movement in the other direction releases the switch.
+ *
+ * If the motor has a simulated timer (`p_timer_timeout`, TIM2 for `motor_automatic_door`), it is programmed as on the board and `port_timer_sim_step()` runs its ISR when it expires. If it has a timing wheel (`p_wheel`), the timeout is a software timer whose callback sets the timeout and pushes `EVENT_MOTOR_TIMEOUT` into `p_event_queue` when whoever drives the simulation advances the wheel (the role of the SysTick ISR). Otherwise whoever drives the simulation plays the role of the timer ISR and calls `port_motor_set_timeout_status()` once `timeout_ms` have elapsed since `timer_start_ms`.
+ */
+typedef struct
+{
+    bool timer_active;                       /*!< Whether the timeout timer is running */
+    uint32_t timer_start_ms;                 /*!< System time at which the timeout timer was (re)started */
+    uint32_t timeout_ms;                     /*!< Duration of the current timeout */
+    bool timeout;                            /*!< Timeout status */
+    port_timer_sim_t *p_timer_timeout;       /*!< Simulated timer for the timeout, or NULL */
+    timer_wheel_t *p_wheel;                  /*!< Timing wheel of the timeout, or NULL. Only used without a simulated timer */
+    timer_wheel_timer_t timer_wheel_timeout; /*!< Software timer of the timeout in `p_wheel` */
+    event_queue_t *p_event_queue;            /*!< Queue where the software timer pushes `EVENT_MOTOR_TIMEOUT` when it expires, and the leaf `EVENT_MOTOR_END_OF_TRAVEL` */
+    motor_profile_t *p_profile;              /*!< Speed profile of the motor, built by `port_motor_init()`, or NULL if the motor has no PWM */
+    uint32_t profile_step;                   /*!< Step of the profile in course */
+    uint32_t duty;                           /*!< Simulated compare register of the PWM: duty of the step in course */
+    uint32_t duty_writes;                    /*!< Number of writes of the compare register */
+    bool pwm_update_irq;                     /*!< Whether the update interrupt of the PWM timer is enabled: a profile is in course */
+    bool direction_open;                     /*!< Simulated level of the direction pin: true to open the door */
+    port_door_sim_t *p_door;                 /*!< Simulated leaf moved by the motor, or NULL if the motor has no position feedback */
+    bool end_switches;                       /*!< Whether a motor without leaf has end switches, pressed by whoever drives the simulation with `port_motor_sim_set_end_of_travel()` (e.g. the replay of a log) */
+    bool at_end;                             /*!< Whether the end switch of the direction `direction_open` is pressed. Only with `end_switches` */
+    bool travel_pending;                     /*!< Whether the end of the travel of the movement in course has not been reached yet */
+    uint32_t pwm_phase_ms;                   /*!< Time since the last update of the PWM in `port_motor_sim_step()` */
+} port_motor_hw_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_motor_hw_t motor_automatic_door; /*!< Motor for the automatic door */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes the motor.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_init(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Activate the motor timer to start or stop the countdown.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param timeout_ms Time in milliseconds.
+ */
+void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeout_ms);
+
+/**
+ * @brief Deactivate the timeout timer.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_timeout_timer_deactivate(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Starts the speed profile of the motor: sets the direction and the duty of the first step and enables the update interrupt of the PWM timer. A profile in course starts again from the beginning. Nothing is done if the motor has no PWM.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param open Direction of the motor: true to open the door, false to close it.
+ */
+void port_motor_move(port_motor_hw_t *p_motor, bool open);
+
+/**
+ * @brief Stops the motor: duty 0 at once and no more updates of the profile.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_stop(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Loads the duty of the next step of the profile into the compare register. To be called from the update ISR of the PWM timer. After the last step the duty is 0 and the update interrupt is disabled.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_pwm_update(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Checks whether the motor has position feedback (a simulated leaf).
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return true If the position of the door is known.
+ */
+bool port_motor_has_position(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Gets the position of the door.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return uint32_t Position in per mille of the travel, from 0 (closed) to `MOTOR_POSITION_OPEN`. 0 if the motor has no position feedback.
+ */
+uint32_t port_motor_get_position(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Checks whether the door is at the end of the travel of the last movement: fully open after `port_motor_move()` to open, fully closed after it to close.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return true If the door is at the end of the travel. Always false if the motor has no position feedback.
+ */
+bool port_motor_is_at_end_of_travel(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Advances the simulation of the motor: moves the leaf with the force of the duty in course and updates the PWM every `MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS` of the profile, in steps of a millisecond. If the leaf reaches the end of the travel, the motor stops and pushes `EVENT_MOTOR_END_OF_TRAVEL`.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param dt_ms Time to advance, in milliseconds.
+ */
+void port_motor_sim_step(port_motor_hw_t *p_motor, uint32_t dt_ms);
+
+/**
+ * @brief Presses the end switch of the movement in course of a motor with end switches: the motor stops, and the door is at the end of the travel until a movement in the other direction starts. The caller pushes `EVENT_MOTOR_END_OF_TRAVEL`.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_sim_set_end_of_travel(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Gets the duty of the step of the profile in course.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return uint32_t Duty in counts of the compare register, 0 if the motor is stopped.
+ */
+uint32_t port_motor_get_duty(port_motor_hw_t *p_motor);
+
+/**
+ * @brief ISR of the update event of the PWM timer of `motor_automatic_door` (file `interr.c`). The simulation calls it every `MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS`.
+ */
+void TIM1_UP_TIM10_IRQHandler(void);
+
+/**
+ * @brief Set the status of the timer if has finished or not.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param timeout Status of the timeout.
+ */
+void port_motor_set_timeout_status(port_motor_hw_t *p_motor, bool timeout);
+
+#endif /* PORT_MOTOR_H */
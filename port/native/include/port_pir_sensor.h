@@ -0,0 +1,82 @@
+/**
+ * @file port_pir_sensor.h
+ * @author agent (agent@local)
+ * @brief Header file for the PIR sensor port layer (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef PORT_PIR_SENSOR_H
+#define PORT_PIR_SENSOR_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "pir_filter.h"
+
+/* Defines and macros --------------------------------------------------------*/
+#define PIR_SENSOR_AUTOMATIC_DOOR_PIN 10          /*!< EXTI line of the PIR sensor, as on the board */
+#define PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS 50 /*!< Time the output of the PIR sensor must stay high for a presence, as on the board */
+#define PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS 1000    /*!< Time a presence is held after the output of the PIR sensor falls, as on the board */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the (simulated) HW dependencies of a PIR sensor.
+ */
+typedef struct
+{
+    uint8_t pin;                           /*!< EXTI line of the PIR */
+    bool gpio_level;                       /*!< Simulated level of the GPIO of the PIR */
+    bool sensor_status;                    /*!< Wether the sensor is detecting movement or not */
+    uint32_t last_time_presence_or_button; /*!< Last time a presence was detected */
+    pir_filter_t filter;                   /*!< Filter of the edges of the output of the sensor. With both times at 0 every edge is delivered, as in the simulations, whose sensors are zero-initialized */
+} port_pir_hw_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_pir_hw_t pir_sensor_automatic_door; /*!< PIR sensor of the automatic door system */
+
+/**
+ * @brief Gets the status of the PIR sensor.
+ *
+ * @return true if the PIR sensor is detecting movement, false otherwise.
+ */
+bool port_pir_sensor_get_status(port_pir_hw_t *pir_sensor);
+
+/**
+ * @brief Sets the status of the PIR sensor.
+ *
+ * @param pir_sensor Pointer to the PIR sensor structure.
+ * @param status true if the PIR sensor is detecting movement, false otherwise.
+ */
+void port_pir_sensor_set_status(port_pir_hw_t *pir_sensor, bool status);
+
+/**
+ * @brief Whether the filtered status of the PIR sensor may change with no edge, so that the System tick has to keep polling its filter.
+ * @param pir_sensor Pointer to the PIR sensor structure.
+ * @return true if a presence is waiting for its minimum high time or in its hold.
+ * @return false otherwise.
+ */
+bool port_pir_sensor_is_filter_pending(port_pir_hw_t *pir_sensor);
+
+/**
+ * @brief Initializes the PIR sensor.
+ *
+ * @param pir_sensor Pointer to the PIR sensor structure.
+ */
+void port_pir_sensor_init(port_pir_hw_t *pir_sensor);
+
+/**
+ * @brief Reads the (simulated) GPIO of the PIR sensor.
+ *
+ * @param pir_sensor Pointer to the PIR sensor structure.
+ * @return true
+ * @return false
+ */
+bool port_pir_sensor_read_gpio(port_pir_hw_t *pir_sensor);
+
+#endif /* PORT_PIR_SENSOR_H */
@@ -0,0 +1,135 @@
+/**
+ * @file port_system.h
+ * @brief Header for port_system.c file (native platform).
+ *
+ * The native port runs the automatic door on a host computer. There is no hardware: the peripherals are plain memory and the system time is a virtual millisecond counter that only advances when the program sets it (the role of the SysTick ISR on the board) or waits with `port_system_delay_ms()`.
+ *
+ * The virtual time is per thread: a multi-threaded simulation gives each worker its own clock with `port_system_set_millis()`.
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+
+#ifndef PORT_SYSTEM_H_
+#define PORT_SYSTEM_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and enums ----------------------------------------------------------*/
+/* Defines */
+#define BIT_POS_TO_MASK(x) (0x01 << (x))                    /*!< Convert the index of a bit into a mask by left shifting */
+#define BASE_MASK_TO_POS(m, p) ((m) << (p))                 /*!< Move a mask defined in the LSBs to upper positions by shifting left p bits */
+
+/* GPIOs */
+#define HIGH true /*!< Logic 1 */
+#define LOW false /*!< Logic 0 */
+
+/* Function prototypes and explanation -------------------------------------------------*/
+/**
+ * @brief Initializes the system. On the native platform it only resets the virtual time to 0.
+ *
+ * @retval Init status
+ */
+size_t port_system_init(void);
+
+/**
+ * @brief Get the count of the (virtual) system tick in milliseconds
+ *
+ */
+uint32_t port_system_get_millis(void);
+
+/**
+ * @brief Sets the number of milliseconds since the system started.
+ *
+ * @param ms New number of milliseconds since the system started.
+ */
+void port_system_set_millis(uint32_t ms);
+
+/**
+ * @brief Wait for some milliseconds. On the native platform the virtual time is advanced and the function returns immediately.
+ *
+ * @param ms Number of milliseconds to wait
+ *
+ * @retval None
+ */
+void port_system_delay_ms(uint32_t ms);
+
+/**
+ * @brief Wait for some milliseconds from a time reference.
+ *
+ * @note It also updates the time reference to the system time at return.
+ *
+ * @param p_t Pointer to the time reference
+ * @param ms Number of milliseconds to wait
+ *
+ * @retval None
+ */
+void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms);
+
+/**
+ * @brief Initializes the cycle counter. On the native platform the cycles are nanoseconds of the monotonic clock of the host, so it does nothing.
+ *
+ */
+void port_system_cycle_counter_init(void);
+
+/**
+ * @brief Gets the value of the cycle counter. On the native platform it is the monotonic clock of the host in nanoseconds (real time, not the virtual time), truncated to 32 bits: it wraps around every ~4.3 s.
+ *
+ * @return uint32_t Nanoseconds of the monotonic clock.
+ */
+uint32_t port_system_get_cycles(void);
+
+/**
+ * @brief Gets the number of cycles per microsecond. On the native platform it is always 1000 (nanoseconds).
+ *
+ * @return uint32_t Cycles per microsecond.
+ */
+uint32_t port_system_get_cycles_per_us(void);
+
+/**
+ * @brief Masks the interrupts. There are no interrupts on the native platform: it does nothing.
+ *
+ */
+void port_system_enter_critical(void);
+
+/**
+ * @brief Unmasks the interrupts. There are no interrupts on the native platform: it does nothing.
+ *
+ */
+void port_system_exit_critical(void);
+
+/**
+ * @brief Enters sleep mode until the next interrupt. On the native platform nothing can wake the program up, so it returns immediately.
+ *
+ */
+void port_system_power_sleep(void);
+
+/**
+ * @brief Enters sleep mode with the System tick suspended. On the native platform it returns immediately.
+ *
+ */
+void port_system_power_sleep_tickless(void);
+
+/**
+ * @brief Gets the total time spent asleep since the system started. Always 0 on the native platform.
+ *
+ * @return uint32_t Milliseconds asleep.
+ */
+uint32_t port_system_get_sleep_millis(void);
+
+/**
+ * @brief Gets the total time spent awake since the system started.
+ *
+ * @return uint32_t Milliseconds since the system started minus the milliseconds asleep.
+ */
+uint32_t port_system_get_awake_millis(void);
+
+/**
+ * @brief ISR of the system tick (file `interr.c`). The system time is not advanced by it: the simulation sets the time and then calls it, every millisecond, for the work the SysTick ISR does besides counting (polling the filter of the PIR sensor).
+ */
+void SysTick_Handler(void);
+
+#endif /* PORT_SYSTEM_H_ */
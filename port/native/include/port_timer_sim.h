@@ -0,0 +1,121 @@
+/**
+ * @file port_timer_sim.h
+ * @author agent (agent@local)
+ * @brief Header file for the virtual-time simulation of the timers of the board (native platform).
+ *
+ * The timers of the STM32F446RE used by the automatic door are modelled at register level: TIM2 (timeout of the motor), TIM3 and TIM4 (blinking of the opening and closing LEDs). The port layer programs their prescaler (PSC) and auto-reload (ARR) registers with the same values as on the board, and the update event of a running timer happens every (PSC + 1) * (ARR + 1) cycles of the 16 MHz timer clock. The simulation keeps a virtual clock in cycles and jumps straight to the next update event of any timer, runs the ISR of the timer and returns, so hours of door behaviour take milliseconds of real time.
+ *
+ * The SysTick is not simulated one interrupt at a time: its only job is counting milliseconds, so the system time (`port_system_get_millis()`) is derived from the virtual clock each time it jumps, giving the same value the SysTick ISR would have produced. When several timers expire in the same cycle their ISRs run in the order of the NVIC: SysTick first (priority 0) and then TIM2, TIM3 and TIM4 (same priority 2, ordered by IRQ number).
+ *
+ * The virtual clock follows `port_system_set_millis()`: if the system time is set from outside, the clock restarts at the beginning of that millisecond.
+ * @date 2026-10-17
+ *
+ */
+#ifndef PORT_TIMER_SIM_H_
+#define PORT_TIMER_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Defines and macros --------------------------------------------------------*/
+#define PORT_TIMER_SIM_CLOCK_HZ 16000000U                             /*!< Clock of the timers: HSI at 16 MHz, as `SystemCoreClock` on the board */
+#define PORT_TIMER_SIM_CYCLES_PER_MS (PORT_TIMER_SIM_CLOCK_HZ / 1000U) /*!< Cycles of the timer clock per SysTick period */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a simulated timer.
+ */
+typedef struct
+{
+    uint32_t PSC;                /*!< Prescaler register */
+    uint32_t ARR;                /*!< Auto-reload register */
+    uint32_t period_ms;          /*!< Period PSC and ARR are set for, 0 if none. They are only computed again when the period changes, as `timer_period_ms` of the motor of the board */
+    bool enabled;                /*!< Counter enable (bit CEN of CR1) */
+    bool irq_enabled;            /*!< Update interrupt enable (bit UIE of DIER) */
+    uint64_t next_update_cycles; /*!< Virtual time of the next update event */
+    void (*p_handler)(void);     /*!< ISR of the timer */
+    uint32_t irqs;               /*!< Number of times the ISR has run */
+} port_timer_sim_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_timer_sim_t timer_sim_tim2; /*!< Simulated TIM2 (timeout of the motor) */
+extern port_timer_sim_t timer_sim_tim3; /*!< Simulated TIM3 (blinking of the opening LED) */
+extern port_timer_sim_t timer_sim_tim4; /*!< Simulated TIM4 (blinking of the closing LED) */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Programs PSC and ARR for a period in milliseconds, with the same computation as the port layer of the board.
+ *
+ * The new values take effect on the next `port_timer_sim_start()` (update generation), as with the preload of the board. The solution is kept for the last period, so re-arming a timer with the same period does not search PSC and ARR again.
+ *
+ * @param p_timer Pointer to the timer.
+ * @param period_ms Period in milliseconds.
+ */
+void port_timer_sim_set_period_ms(port_timer_sim_t *p_timer, uint32_t period_ms);
+
+/**
+ * @brief Gets the period of a timer in cycles of the timer clock: (PSC + 1) * (ARR + 1).
+ *
+ * @param p_timer Pointer to the timer.
+ * @return uint64_t Period in cycles.
+ */
+uint64_t port_timer_sim_get_period_cycles(port_timer_sim_t *p_timer);
+
+/**
+ * @brief Enables the counter of a timer and generates an update (bit UG of EGR): the counter restarts from 0 now, so the next update event is one period later.
+ *
+ * @param p_timer Pointer to the timer.
+ */
+void port_timer_sim_start(port_timer_sim_t *p_timer);
+
+/**
+ * @brief Disables the counter of a timer.
+ *
+ * @param p_timer Pointer to the timer.
+ */
+void port_timer_sim_stop(port_timer_sim_t *p_timer);
+
+/**
+ * @brief Enables or disables the update interrupt of a timer. The counter keeps running.
+ *
+ * @param p_timer Pointer to the timer.
+ * @param enable Whether the interrupt is enabled.
+ */
+void port_timer_sim_enable_irq(port_timer_sim_t *p_timer, bool enable);
+
+/**
+ * @brief Gets the virtual time in cycles of the timer clock.
+ *
+ * @return uint64_t Virtual time.
+ */
+uint64_t port_timer_sim_get_cycles(void);
+
+/**
+ * @brief Jumps to the next update event of any timer with its interrupt enabled, if it comes no later than `until_ms`, and runs the ISRs of all the timers that expire in that cycle. Otherwise the virtual time jumps to `until_ms`.
+ *
+ * The caller plays the role of the main loop: after each step it can feed the events pushed by the ISRs to the FSM.
+ *
+ * @param until_ms System time up to which the simulation may advance.
+ * @return true if at least one ISR has run.
+ * @return false if no timer expires before `until_ms`.
+ */
+bool port_timer_sim_step(uint32_t until_ms);
+
+/**
+ * @brief ISR of the simulated TIM2 (file `interr.c`): timeout of the motor.
+ */
+void TIM2_IRQHandler(void);
+
+/**
+ * @brief ISR of the simulated TIM3 (file `interr.c`): blinking of the opening LED.
+ */
+void TIM3_IRQHandler(void);
+
+/**
+ * @brief ISR of the simulated TIM4 (file `interr.c`): blinking of the closing LED.
+ */
+void TIM4_IRQHandler(void);
+
+#endif /* PORT_TIMER_SIM_H_ */
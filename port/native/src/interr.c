@@ -0,0 +1,118 @@
+/**
+ * @file interr.c
+ * @brief Interrupt service routines of the simulated timers (native platform).
+ *
+ * They do the same work as the ISRs of the board and are run by `port_timer_sim_step()` when the simulated timer expires, by `port_gpio_sim_exti_edge()` when the simulation changes the level of the button or of the PIR sensor, or by the simulation every millisecond (SysTick).
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+// Include headers of different port elements:
+#include "port_system.h"
+#include "port_button.h"
+#include "port_led.h"
+#include "port_pir_sensor.h"
+#include "port_motor.h"
+#include "port_timer_sim.h"
+#include "port_gpio_sim.h"
+#include "event_queue.h"
+#include "latency.h"
+
+//------------------------------------------------------
+// INTERRUPT SERVICE ROUTINES
+//------------------------------------------------------
+/**
+ * @brief Sets the status of the PIR sensor to the filtered status and pushes its event, as on the board.
+ *
+ * @param cycles Timestamp of the change in cycles, the start of the latency of a presence.
+ */
+static void _pir_sensor_deliver(uint32_t cycles)
+{
+  bool present = pir_sensor_automatic_door.filter.present;
+  port_pir_sensor_set_status(&pir_sensor_automatic_door, present);
+  if (present)
+  {
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    latency_start(&latency_automatic_door, cycles);
+#else
+    (void)cycles;
+#endif
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+  }
+  else
+  {
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+  }
+}
+
+void SysTick_Handler(void)
+{
+  // The system time is set by the simulation: only the filter of the PIR sensor is polled
+  if (port_pir_sensor_is_filter_pending(&pir_sensor_automatic_door) && pir_filter_poll(&pir_sensor_automatic_door.filter, port_system_get_millis()))
+  {
+    _pir_sensor_deliver(port_system_get_cycles());
+  }
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+  uint32_t cycles = port_system_get_cycles(); // Timestamp of the edge as soon as it lands in the ISR
+#else
+  uint32_t cycles = 0;
+#endif
+
+  // Button
+  if (gpio_sim_exti_pr & BIT_POS_TO_MASK(button_emergency.pin))
+  {
+    bool pressed = !port_button_read_gpio(&button_emergency);
+    if (debounce_edge(&button_emergency.debounce, port_system_get_millis(), pressed))
+    {
+      if (pressed)
+      {
+        button_emergency.flag_released = false;
+        button_emergency.flag_pressed = true;
+        event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+      }
+      else
+      {
+        button_emergency.flag_released = true;
+        event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_RELEASE);
+      }
+    }
+    gpio_sim_exti_pr &= ~BIT_POS_TO_MASK(button_emergency.pin);
+  }
+
+  // PIR sensor
+  if (gpio_sim_exti_pr & BIT_POS_TO_MASK(pir_sensor_automatic_door.pin))
+  {
+    if (pir_filter_edge(&pir_sensor_automatic_door.filter, port_system_get_millis(), port_pir_sensor_read_gpio(&pir_sensor_automatic_door)))
+    {
+      _pir_sensor_deliver(cycles);
+    }
+    gpio_sim_exti_pr &= ~BIT_POS_TO_MASK(pir_sensor_automatic_door.pin);
+  }
+}
+
+void TIM2_IRQHandler(void)
+{
+  port_motor_set_timeout_status(&motor_automatic_door, true);
+  event_queue_push(&event_queue_automatic_door, EVENT_MOTOR_TIMEOUT);
+}
+
+void TIM3_IRQHandler(void)
+{
+  port_led_toggle(&led_opening);
+}
+
+void TIM4_IRQHandler(void)
+{
+  port_led_toggle(&led_closing);
+}
+
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+  if (motor_automatic_door.pwm_update_irq)
+  {
+    port_motor_pwm_update(&motor_automatic_door);
+  }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file port_button.c
+ * @author agent (agent@local)
+ * @brief Port layer for a simulated button (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Standard C includes */
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+#include "port_button.h"
+
+/* Global variables -----------------------------------------------------------*/
+port_button_hw_t button_emergency = {.pin = BUTTON_EMERGENCY_PIN, .gpio_level = HIGH, .flag_pressed = false, .flag_released = false, .debounce = {.window_ms = BUTTON_EMERGENCY_DEBOUNCE_MS}};
+
+/* Function definitions ------------------------------------------------------*/
+void port_button_init(port_button_hw_t *p_button)
+{
+    p_button->gpio_level = HIGH;
+    p_button->flag_pressed = false;
+    p_button->flag_released = false;
+    debounce_init(&p_button->debounce, p_button->debounce.window_ms, false);
+}
+
+bool port_button_is_pressed(port_button_hw_t *p_button)
+{
+    return p_button->flag_pressed;
+}
+
+bool port_button_consume_press(port_button_hw_t *p_button)
+{
+    if (!p_button->flag_pressed)
+    {
+        return false;
+    }
+    p_button->flag_pressed = false;
+    return true;
+}
+
+uint32_t port_button_get_bounces(port_button_hw_t *p_button)
+{
+    return p_button->debounce.rejected;
+}
+
+bool port_button_read_gpio(port_button_hw_t *p_button)
+{
+    return p_button->gpio_level;
+}
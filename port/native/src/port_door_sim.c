@@ -0,0 +1,82 @@
+/**
+ * @file port_door_sim.c
+ * @author agent (agent@local)
+ * @brief Physical model of the leaf of the automatic door, driven by the simulated motor (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "port_door_sim.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define PORT_DOOR_SIM_DT_S 0.001 /*!< Integration step of the model */
+
+/* Global variables -----------------------------------------------------------*/
+port_door_sim_t door_sim_automatic_door = {.mass_kg = DOOR_SIM_AUTOMATIC_DOOR_MASS_KG, .viscous_ns_m = DOOR_SIM_AUTOMATIC_DOOR_VISCOUS_NS_M, .coulomb_n = DOOR_SIM_AUTOMATIC_DOOR_COULOMB_N, .force_n = DOOR_SIM_AUTOMATIC_DOOR_FORCE_N, .length_m = DOOR_SIM_AUTOMATIC_DOOR_LENGTH_M, .position_m = 0.0, .velocity_m_s = 0.0};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Integrates the motion of the leaf for a millisecond.
+ *
+ * @param p_door Pointer to the model of the leaf.
+ * @param force_n Force of the motor.
+ */
+static void _door_sim_step_1ms(port_door_sim_t *p_door, double force_n)
+{
+    double v = p_door->velocity_m_s;
+    double net;
+    if (v == 0.0)
+    {
+        // Static friction: the leaf stays at rest unless the motor overcomes it
+        if ((force_n <= p_door->coulomb_n) && (force_n >= -p_door->coulomb_n))
+        {
+            return;
+        }
+        net = force_n - ((force_n > 0.0) ? p_door->coulomb_n : -p_door->coulomb_n);
+    }
+    else
+    {
+        net = force_n - p_door->viscous_ns_m * v - ((v > 0.0) ? p_door->coulomb_n : -p_door->coulomb_n);
+    }
+
+    double v_next = v + (net / p_door->mass_kg) * PORT_DOOR_SIM_DT_S;
+    if ((v != 0.0) && ((v > 0.0) != (v_next > 0.0)))
+    {
+        v_next = 0.0; // Friction stops the leaf: it does not push it back
+    }
+    p_door->velocity_m_s = v_next;
+    p_door->position_m += v_next * PORT_DOOR_SIM_DT_S;
+
+    // The end stops hold the leaf
+    if (p_door->position_m <= 0.0)
+    {
+        p_door->position_m = 0.0;
+        p_door->velocity_m_s = 0.0;
+    }
+    else if (p_door->position_m >= p_door->length_m)
+    {
+        p_door->position_m = p_door->length_m;
+        p_door->velocity_m_s = 0.0;
+    }
+}
+
+/* Function definitions -------------------------------------------------------*/
+void port_door_sim_init(port_door_sim_t *p_door, double position_m)
+{
+    p_door->position_m = (position_m < 0.0) ? 0.0 : ((position_m > p_door->length_m) ? p_door->length_m : position_m);
+    p_door->velocity_m_s = 0.0;
+}
+
+void port_door_sim_step(port_door_sim_t *p_door, double force_n, uint32_t dt_ms)
+{
+    for (uint32_t i = 0; i < dt_ms; i++)
+    {
+        _door_sim_step_1ms(p_door, force_n);
+    }
+}
+
+bool port_door_sim_is_at_stop(port_door_sim_t *p_door, bool open)
+{
+    return open ? (p_door->position_m >= p_door->length_m) : (p_door->position_m <= 0.0);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file port_gpio_sim.c
+ * @author agent (agent@local)
+ * @brief Register-level simulation of the GPIO ports of the board (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "port_system.h"
+#include "port_gpio_sim.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define PORT_GPIO_SIM_SET(pin) ((uint32_t)BIT_POS_TO_MASK(pin))           /*!< Bit of BSRR that sets a pin */
+#define PORT_GPIO_SIM_RESET(pin) ((uint32_t)BIT_POS_TO_MASK(pin) << 16U) /*!< Bit of BSRR that resets a pin */
+
+/* Global variables -----------------------------------------------------------*/
+port_gpio_sim_t gpio_sim_b = {.ODR = 0, .reads = 0, .writes = 0};
+uint32_t gpio_sim_exti_pr = 0;
+
+/* Function definitions -------------------------------------------------------*/
+uint32_t port_gpio_sim_read_odr(port_gpio_sim_t *p_port)
+{
+    p_port->reads++;
+    return p_port->ODR;
+}
+
+void port_gpio_sim_write_bsrr(port_gpio_sim_t *p_port, uint32_t bsrr)
+{
+    p_port->writes++;
+    p_port->ODR = (p_port->ODR & ~(bsrr >> 16U)) | (bsrr & 0xFFFFU);
+}
+
+void port_gpio_sim_write(port_gpio_sim_t *p_port, uint8_t pin, bool value)
+{
+    port_gpio_sim_write_bsrr(p_port, value ? PORT_GPIO_SIM_SET(pin) : PORT_GPIO_SIM_RESET(pin));
+}
+
+void port_gpio_sim_toggle(port_gpio_sim_t *p_port, uint8_t pin)
+{
+    bool value = (port_gpio_sim_read_odr(p_port) & PORT_GPIO_SIM_SET(pin)) != 0;
+    port_gpio_sim_write(p_port, pin, !value);
+}
+
+void port_gpio_sim_batch_init(port_gpio_sim_batch_t *p_batch)
+{
+    p_batch->num_ports = 0;
+}
+
+void port_gpio_sim_batch_write(port_gpio_sim_batch_t *p_batch, port_gpio_sim_t *p_port, uint8_t pin, bool value)
+{
+    uint32_t bits = value ? PORT_GPIO_SIM_SET(pin) : PORT_GPIO_SIM_RESET(pin);
+    for (uint8_t i = 0; i < p_batch->num_ports; i++)
+    {
+        if (p_batch->p_ports[i] == p_port)
+        {
+            p_batch->bsrr[i] = (p_batch->bsrr[i] & ~(PORT_GPIO_SIM_SET(pin) | PORT_GPIO_SIM_RESET(pin))) | bits;
+            return;
+        }
+    }
+    if (p_batch->num_ports == PORT_GPIO_SIM_BATCH_MAX_PORTS)
+    {
+        port_gpio_sim_write_bsrr(p_port, bits);
+        return;
+    }
+    p_batch->p_ports[p_batch->num_ports] = p_port;
+    p_batch->bsrr[p_batch->num_ports] = bits;
+    p_batch->num_ports++;
+}
+
+void port_gpio_sim_batch_commit(port_gpio_sim_batch_t *p_batch)
+{
+    for (uint8_t i = 0; i < p_batch->num_ports; i++)
+    {
+        port_gpio_sim_write_bsrr(p_batch->p_ports[i], p_batch->bsrr[i]);
+    }
+    p_batch->num_ports = 0;
+}
+
+void port_gpio_sim_exti_edge(uint8_t pin)
+{
+    gpio_sim_exti_pr |= BIT_POS_TO_MASK(pin);
+    if ((pin >= 10) && (pin <= 15))
+    {
+        EXTI15_10_IRQHandler();
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file port_led.c
+ * @author agent (agent@local)
+ * @brief Port layer for a simulated LED (native platform).
+ * @date 2026-10-17
+ */
+/* HW dependent includes */
+#include "port_led.h"
+#include "port_system.h"
+
+/* Global variables -----------------------------------------------------------*/
+port_led_hw_t led_opening = {.p_port = LED_OPENING_GPIO, .pin = LED_OPENING_PIN, .status = false, .timer_active = false, .timer_blink_semi_period_ms = LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS, .p_timer = &timer_sim_tim3};
+port_led_hw_t led_closing = {.p_port = LED_CLOSING_GPIO, .pin = LED_CLOSING_PIN, .status = false, .timer_active = false, .timer_blink_semi_period_ms = LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS, .p_timer = &timer_sim_tim4};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Callback of the software timer of the blinking. It runs when the timing wheel is advanced and does what the ISR of the timer does.
+ *
+ * @param p_arg Pointer to the LED structure.
+ */
+static void _led_blink_timer_callback(void *p_arg)
+{
+    port_led_toggle((port_led_hw_t *)p_arg);
+}
+
+/* Function definitions ------------------------------------------------------*/
+bool port_led_get_status(port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        return (port_gpio_sim_read_odr(p_led->p_port) & BIT_POS_TO_MASK(p_led->pin)) != 0;
+    }
+    return p_led->status;
+}
+
+void port_led_on(port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        port_gpio_sim_write(p_led->p_port, p_led->pin, HIGH);
+        return;
+    }
+    p_led->status = true;
+}
+
+void port_led_off(port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        port_gpio_sim_write(p_led->p_port, p_led->pin, LOW);
+        return;
+    }
+    p_led->status = false;
+}
+
+void port_led_toggle(port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        port_gpio_sim_toggle(p_led->p_port, p_led->pin);
+        return;
+    }
+    p_led->status = !p_led->status;
+}
+
+void port_led_batch_init(port_led_batch_t *p_batch)
+{
+    port_gpio_sim_batch_init(p_batch);
+}
+
+void port_led_batch_on(port_led_batch_t *p_batch, port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        port_gpio_sim_batch_write(p_batch, p_led->p_port, p_led->pin, HIGH);
+        return;
+    }
+    p_led->status = true;
+}
+
+void port_led_batch_off(port_led_batch_t *p_batch, port_led_hw_t *p_led)
+{
+    if (p_led->p_port != NULL)
+    {
+        port_gpio_sim_batch_write(p_batch, p_led->p_port, p_led->pin, LOW);
+        return;
+    }
+    p_led->status = false;
+}
+
+void port_led_batch_commit(port_led_batch_t *p_batch)
+{
+    port_gpio_sim_batch_commit(p_batch);
+}
+
+void port_led_timer_setup(port_led_hw_t *p_led)
+{
+    p_led->timer_active = false;
+    if (p_led->p_timer != NULL)
+    {
+        port_timer_sim_stop(p_led->p_timer);
+        port_timer_sim_set_period_ms(p_led->p_timer, p_led->timer_blink_semi_period_ms);
+        port_timer_sim_enable_irq(p_led->p_timer, true);
+    }
+    else if (p_led->p_wheel != NULL)
+    {
+        timer_wheel_cancel(p_led->p_wheel, &p_led->timer_wheel_blink); // In case the LED is set up again while blinking
+        timer_wheel_timer_init(&p_led->timer_wheel_blink, _led_blink_timer_callback, p_led);
+    }
+}
+
+void port_led_timer_activate(port_led_hw_t *p_led)
+{
+    p_led->timer_active = true;
+    if (p_led->p_timer != NULL)
+    {
+        port_timer_sim_start(p_led->p_timer);
+    }
+    else if (p_led->p_wheel != NULL)
+    {
+        timer_wheel_arm(p_led->p_wheel, &p_led->timer_wheel_blink, p_led->timer_blink_semi_period_ms, p_led->timer_blink_semi_period_ms);
+    }
+}
+
+void port_led_timer_deactivate(port_led_hw_t *p_led)
+{
+    p_led->timer_active = false;
+    if (p_led->p_timer != NULL)
+    {
+        port_timer_sim_stop(p_led->p_timer);
+    }
+    else if (p_led->p_wheel != NULL)
+    {
+        timer_wheel_cancel(p_led->p_wheel, &p_led->timer_wheel_blink);
+    }
+}
+
+void port_led_init(port_led_hw_t *p_led)
+{
+    port_led_off(p_led);
+    port_led_timer_setup(p_led);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file port_log.c
+ * @author agent (agent@local)
+ * @brief Port layer of the log output through a UART drained with DMA, with a mock DMA in virtual time (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "port_log.h"
+
+/* Global variables -----------------------------------------------------------*/
+port_log_hw_t log_uart = {.dma_len = 0, .now_ns = 0, .p_sink = NULL};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Appends bytes sent through the UART to the sink.
+ *
+ * @param p_log Pointer to the log structure.
+ * @param p_data Bytes sent.
+ * @param len Number of bytes.
+ */
+static void _log_sink(port_log_hw_t *p_log, const uint8_t *p_data, uint32_t len)
+{
+    if ((p_log->p_sink != NULL) && (p_log->sink_len < p_log->sink_size))
+    {
+        uint32_t room = p_log->sink_size - p_log->sink_len;
+        memcpy(&p_log->p_sink[p_log->sink_len], p_data, (len < room) ? len : room);
+    }
+    p_log->sink_len += len;
+}
+
+/**
+ * @brief Starts a DMA transfer with the oldest contiguous bytes of the ring, if there is any. The DMA must be idle.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+static void _log_dma_start(port_log_hw_t *p_log)
+{
+    const uint8_t *p_data;
+    uint32_t len = log_ring_peek(&p_log->ring, &p_data);
+    p_log->dma_len = len;
+    if (len == 0)
+    {
+        return;
+    }
+    p_log->dma_end_ns = p_log->now_ns + len * LOG_UART_BYTE_NS;
+    p_log->transfers++;
+}
+
+/* Function definitions ------------------------------------------------------*/
+void port_log_init(port_log_hw_t *p_log)
+{
+    log_ring_init(&p_log->ring);
+    p_log->dma_len = 0;
+    p_log->now_ns = 0;
+    p_log->dma_end_ns = 0;
+    p_log->transfers = 0;
+    p_log->sink_len = 0;
+}
+
+bool port_log_try_write(port_log_hw_t *p_log, const void *p_data, uint32_t len)
+{
+    bool queued = log_ring_write(&p_log->ring, p_data, len);
+    if (p_log->dma_len == 0)
+    {
+        _log_dma_start(p_log);
+    }
+    return queued;
+}
+
+int port_log_write(port_log_hw_t *p_log, const char *p_data, int len)
+{
+    if (len <= 0)
+    {
+        return 0;
+    }
+    port_log_try_write(p_log, p_data, (uint32_t)len);
+    return len;
+}
+
+void port_log_dma_complete(port_log_hw_t *p_log)
+{
+    log_ring_consume(&p_log->ring, p_log->dma_len);
+    _log_dma_start(p_log);
+}
+
+uint32_t port_log_get_lost(port_log_hw_t *p_log)
+{
+    return log_ring_get_lost(&p_log->ring);
+}
+
+void port_log_sim_advance(port_log_hw_t *p_log, uint64_t ns)
+{
+    uint64_t until = p_log->now_ns + ns;
+    while ((p_log->dma_len != 0) && (p_log->dma_end_ns <= until))
+    {
+        // The UART has sent the last byte of the transfer: the interrupt of the DMA
+        const uint8_t *p_data;
+        log_ring_peek(&p_log->ring, &p_data);
+        _log_sink(p_log, p_data, p_log->dma_len);
+        p_log->now_ns = p_log->dma_end_ns;
+        port_log_dma_complete(p_log);
+    }
+    p_log->now_ns = until;
+}
+
+uint64_t port_log_sim_write_blocking(port_log_hw_t *p_log, const char *p_data, int len)
+{
+    if (len <= 0)
+    {
+        return 0;
+    }
+    _log_sink(p_log, (const uint8_t *)p_data, (uint32_t)len);
+    uint64_t wait_ns = (uint64_t)len * LOG_UART_BYTE_NS;
+    p_log->now_ns += wait_ns;
+    return wait_ns;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file port_motor.c
+ * @author agent (agent@local)
+ * @brief Port layer for a simulated motor (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Project includes */
+#include "port_motor.h"
+
+/* Global variables -----------------------------------------------------------*/
+static motor_profile_t motor_profile_automatic_door; /*!< Speed profile of the motor of the automatic door */
+
+port_motor_hw_t motor_automatic_door = {.timer_active = false, .timer_start_ms = 0, .timeout_ms = 0, .timeout = false, .p_timer_timeout = &timer_sim_tim2, .p_event_queue = &event_queue_automatic_door, .p_profile = &motor_profile_automatic_door, .p_door = NULL};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Callback of the software timer of the timeout. It runs when the timing wheel is advanced and does what the ISR of the timer does.
+ *
+ * @param p_arg Pointer to the motor structure.
+ */
+static void _motor_timeout_timer_callback(void *p_arg)
+{
+    port_motor_hw_t *p_motor = (port_motor_hw_t *)p_arg;
+    p_motor->timer_active = false; // The one-shot timer is no longer pending: it does not interrupt again
+    p_motor->timeout = true;
+    if (p_motor->p_event_queue != NULL)
+    {
+        event_queue_push(p_motor->p_event_queue, EVENT_MOTOR_TIMEOUT);
+    }
+}
+
+/**
+ * @brief The leaf has reached the end of the travel: the motor stops and tells the door, as the position sensor does.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+static void _motor_end_of_travel(port_motor_hw_t *p_motor)
+{
+    port_motor_stop(p_motor);
+    if (p_motor->p_event_queue != NULL)
+    {
+        event_queue_push(p_motor->p_event_queue, EVENT_MOTOR_END_OF_TRAVEL);
+    }
+}
+
+/* Function definitions ------------------------------------------------------*/
+void port_motor_set_timeout_status(port_motor_hw_t *p_motor, bool timeout)
+{
+    if (timeout)
+    {
+        p_motor->timer_active = false; // As in the board, the timer does not interrupt again
+        if (p_motor->p_timer_timeout != NULL)
+        {
+            port_timer_sim_enable_irq(p_motor->p_timer_timeout, false);
+        }
+        else if (p_motor->p_wheel != NULL)
+        {
+            timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout);
+        }
+    }
+    p_motor->timeout = timeout;
+}
+
+void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeout_ms)
+{
+    port_motor_set_timeout_status(p_motor, false);
+    p_motor->timer_start_ms = port_system_get_millis();
+    p_motor->timeout_ms = timeout_ms;
+    p_motor->timer_active = true;
+
+    if (p_motor->p_timer_timeout != NULL)
+    {
+        port_timer_sim_stop(p_motor->p_timer_timeout);
+        port_timer_sim_set_period_ms(p_motor->p_timer_timeout, timeout_ms);
+        port_timer_sim_start(p_motor->p_timer_timeout);
+        port_timer_sim_enable_irq(p_motor->p_timer_timeout, true);
+    }
+    else if (p_motor->p_wheel != NULL)
+    {
+        timer_wheel_arm(p_motor->p_wheel, &p_motor->timer_wheel_timeout, timeout_ms, 0);
+    }
+}
+
+void port_motor_timeout_timer_deactivate(port_motor_hw_t *p_motor)
+{
+    p_motor->timer_active = false;
+    if (p_motor->p_timer_timeout != NULL)
+    {
+        port_timer_sim_stop(p_motor->p_timer_timeout);
+    }
+    else if (p_motor->p_wheel != NULL)
+    {
+        timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout);
+    }
+}
+
+void port_motor_move(port_motor_hw_t *p_motor, bool open)
+{
+    if ((p_motor->p_profile == NULL) || (p_motor->p_profile->steps == 0))
+    {
+        return;
+    }
+    if (p_motor->direction_open != open)
+    {
+        // Leaving the end switch of the other direction
+        p_motor->at_end = false;
+    }
+    p_motor->direction_open = open;
+    if ((p_motor->p_door != NULL) && port_door_sim_is_at_stop(p_motor->p_door, open))
+    {
+        // Already there: nothing to move
+        _motor_end_of_travel(p_motor);
+        return;
+    }
+    p_motor->profile_step = 0;
+    p_motor->duty = p_motor->p_profile->duty[0];
+    p_motor->duty_writes++;
+    p_motor->pwm_update_irq = true;
+    p_motor->travel_pending = (p_motor->p_door != NULL);
+    p_motor->pwm_phase_ms = 0;
+}
+
+void port_motor_stop(port_motor_hw_t *p_motor)
+{
+    if (p_motor->p_profile == NULL)
+    {
+        return;
+    }
+    p_motor->pwm_update_irq = false;
+    p_motor->duty = 0;
+    p_motor->duty_writes++;
+    p_motor->profile_step = p_motor->p_profile->steps;
+    p_motor->travel_pending = false;
+}
+
+void port_motor_pwm_update(port_motor_hw_t *p_motor)
+{
+    // An index and a store, whatever the step: the profile has been computed by port_motor_init()
+    uint32_t step = ++p_motor->profile_step;
+    if (step < p_motor->p_profile->steps)
+    {
+        p_motor->duty = p_motor->p_profile->duty[step];
+    }
+    else
+    {
+        p_motor->duty = 0;
+        p_motor->pwm_update_irq = false;
+    }
+    p_motor->duty_writes++;
+}
+
+uint32_t port_motor_get_duty(port_motor_hw_t *p_motor)
+{
+    return p_motor->duty;
+}
+
+bool port_motor_has_position(port_motor_hw_t *p_motor)
+{
+    return (p_motor->p_door != NULL) || p_motor->end_switches;
+}
+
+uint32_t port_motor_get_position(port_motor_hw_t *p_motor)
+{
+    if (p_motor->p_door == NULL)
+    {
+        return 0;
+    }
+    return (uint32_t)(p_motor->p_door->position_m / p_motor->p_door->length_m * MOTOR_POSITION_OPEN + 0.5);
+}
+
+bool port_motor_is_at_end_of_travel(port_motor_hw_t *p_motor)
+{
+    if (p_motor->p_door != NULL)
+    {
+        return port_door_sim_is_at_stop(p_motor->p_door, p_motor->direction_open);
+    }
+    return p_motor->end_switches && p_motor->at_end;
+}
+
+void port_motor_sim_set_end_of_travel(port_motor_hw_t *p_motor)
+{
+    port_motor_stop(p_motor);
+    p_motor->at_end = true;
+}
+
+void port_motor_sim_step(port_motor_hw_t *p_motor, uint32_t dt_ms)
+{
+    if (p_motor->p_profile == NULL)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < dt_ms; i++)
+    {
+        if (p_motor->p_door != NULL)
+        {
+            double force = p_motor->p_door->force_n * (double)p_motor->duty / (double)p_motor->p_profile->full_scale;
+            port_door_sim_step(p_motor->p_door, p_motor->direction_open ? force : -force, 1);
+            if (p_motor->travel_pending && port_door_sim_is_at_stop(p_motor->p_door, p_motor->direction_open))
+            {
+                _motor_end_of_travel(p_motor);
+            }
+        }
+
+        // Update event of the PWM timer at the end of every step of the profile
+        if (p_motor->pwm_update_irq && (++p_motor->pwm_phase_ms == p_motor->p_profile->step_ms))
+        {
+            p_motor->pwm_phase_ms = 0;
+            port_motor_pwm_update(p_motor);
+        }
+    }
+}
+
+void port_motor_init(port_motor_hw_t *p_motor)
+{
+    p_motor->timer_active = false;
+    p_motor->timeout = false;
+    p_motor->at_end = false;
+    if (p_motor->p_profile != NULL)
+    {
+        // The table only depends on constants: it is computed the first time, not every time a door is created
+        if (p_motor->p_profile->steps == 0)
+        {
+            motor_profile_build(p_motor->p_profile, MOTOR_AUTOMATIC_DOOR_PROFILE_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS, MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE);
+        }
+        p_motor->profile_step = 0;
+        p_motor->duty = 0;
+        p_motor->duty_writes = 0;
+        p_motor->pwm_update_irq = false;
+        p_motor->travel_pending = false;
+        p_motor->pwm_phase_ms = 0;
+    }
+    if (p_motor->p_timer_timeout != NULL)
+    {
+        port_timer_sim_stop(p_motor->p_timer_timeout);
+        port_timer_sim_enable_irq(p_motor->p_timer_timeout, false);
+    }
+    else if (p_motor->p_wheel != NULL)
+    {
+        timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout); // In case the motor is initialized again with the timer pending
+        timer_wheel_timer_init(&p_motor->timer_wheel_timeout, _motor_timeout_timer_callback, p_motor);
+    }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file port_pir_sensor.c
+ * @author agent (agent@local)
+ * @brief Port layer for a simulated PIR sensor (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Standard C includes */
+#include <stdint.h>
+
+/* HW dependent includes */
+#include "port_pir_sensor.h"
+#include "port_system.h"
+
+/* Global variables -----------------------------------------------------------*/
+port_pir_hw_t pir_sensor_automatic_door = {.pin = PIR_SENSOR_AUTOMATIC_DOOR_PIN, .gpio_level = LOW, .sensor_status = false, .last_time_presence_or_button = 0, .filter = {.min_high_ms = PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS, .hold_ms = PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS}};
+
+/* Function definitions ------------------------------------------------------*/
+bool port_pir_sensor_get_status(port_pir_hw_t *p_pir)
+{
+    return p_pir->sensor_status;
+}
+
+void port_pir_sensor_set_status(port_pir_hw_t *p_pir, bool status)
+{
+    p_pir->sensor_status = status;
+}
+
+bool port_pir_sensor_is_filter_pending(port_pir_hw_t *p_pir)
+{
+    return pir_filter_is_pending(&p_pir->filter);
+}
+
+bool port_pir_sensor_read_gpio(port_pir_hw_t *p_pir)
+{
+    return p_pir->gpio_level;
+}
+
+void port_pir_sensor_init(port_pir_hw_t *p_pir)
+{
+    p_pir->gpio_level = LOW;
+    p_pir->sensor_status = false;
+    pir_filter_init(&p_pir->filter, p_pir->filter.min_high_ms, p_pir->filter.hold_ms, LOW);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file port_system.c
+ * @brief File that defines the functions related to the system of the native platform.
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+#include "port_system.h"
+
+/* GLOBAL VARIABLES */
+static _Thread_local uint32_t msTicks = 0; /*!< Variable to store the virtual millisecond ticks. One per thread, so that each thread of a simulation runs on its own virtual clock */
+
+size_t port_system_init()
+{
+  msTicks = 0;
+  return 0;
+}
+
+//------------------------------------------------------
+// TIMER RELATED FUNCTIONS
+//------------------------------------------------------
+uint32_t port_system_get_millis()
+{
+  return msTicks;
+}
+
+void port_system_set_millis(uint32_t ms)
+{
+  msTicks = ms;
+}
+
+void port_system_delay_ms(uint32_t ms)
+{
+  msTicks += ms;
+}
+
+void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms)
+{
+  uint32_t until = *p_t + ms;
+  uint32_t now = port_system_get_millis();
+  if (until > now)
+  {
+    port_system_delay_ms(until - now);
+  }
+  *p_t = port_system_get_millis();
+}
+
+void port_system_cycle_counter_init(void)
+{
+}
+
+uint32_t port_system_get_cycles(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t port_system_get_cycles_per_us(void)
+{
+  return 1000U;
+}
+
+// ------------------------------------------------------
+// POWER RELATED FUNCTIONS
+// ------------------------------------------------------
+void port_system_enter_critical(void)
+{
+}
+
+void port_system_exit_critical(void)
+{
+}
+
+void port_system_power_sleep(void)
+{
+}
+
+void port_system_power_sleep_tickless(void)
+{
+}
+
+uint32_t port_system_get_sleep_millis(void)
+{
+  return 0;
+}
+
+uint32_t port_system_get_awake_millis(void)
+{
+  return port_system_get_millis() - port_system_get_sleep_millis();
+}
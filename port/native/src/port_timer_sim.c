@@ -0,0 +1,141 @@
+/**
+ * @file port_timer_sim.c
+ * @author agent (agent@local)
+ * @brief Virtual-time simulation of the timers of the board (native platform).
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "port_system.h"
+#include "port_timer_sim.h"
+#include "timer_psc_arr.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define PORT_TIMER_SIM_NUM_TIMERS 3 /*!< Number of simulated timers */
+
+/* Global variables -----------------------------------------------------------*/
+port_timer_sim_t timer_sim_tim2 = {.PSC = 0, .ARR = 0xFFFF, .p_handler = TIM2_IRQHandler};
+port_timer_sim_t timer_sim_tim3 = {.PSC = 0, .ARR = 0xFFFF, .p_handler = TIM3_IRQHandler};
+port_timer_sim_t timer_sim_tim4 = {.PSC = 0, .ARR = 0xFFFF, .p_handler = TIM4_IRQHandler};
+
+static port_timer_sim_t *const p_timers[PORT_TIMER_SIM_NUM_TIMERS] = {&timer_sim_tim2, &timer_sim_tim3, &timer_sim_tim4}; /*!< Timers in NVIC order (IRQ number) */
+static _Thread_local uint64_t cycles = 0;                                                                                   /*!< Virtual time in cycles. One per thread, as the system time */
+
+/* Private functions ----------------------------------------------------------*/
+/**
+ * @brief Gets the virtual time, restarting it at the system time if this has been set from outside.
+ *
+ * @return uint64_t Virtual time in cycles.
+ */
+static uint64_t _now(void)
+{
+    uint32_t millis = port_system_get_millis();
+    if ((uint32_t)(cycles / PORT_TIMER_SIM_CYCLES_PER_MS) != millis)
+    {
+        cycles = (uint64_t)millis * PORT_TIMER_SIM_CYCLES_PER_MS;
+    }
+    return cycles;
+}
+
+/**
+ * @brief Moves the virtual time forward, and the system time with it (the work of the SysTick ISR).
+ *
+ * @param now New virtual time in cycles.
+ */
+static void _advance(uint64_t now)
+{
+    cycles = now;
+    port_system_set_millis((uint32_t)(now / PORT_TIMER_SIM_CYCLES_PER_MS));
+}
+
+/* Function definitions ------------------------------------------------------*/
+void port_timer_sim_set_period_ms(port_timer_sim_t *p_timer, uint32_t period_ms)
+{
+    // Same computation as port_motor_timeout_timer_activate() and port_led_timer_setup() of the board
+    if (period_ms != p_timer->period_ms)
+    {
+        timer_psc_arr_t psc_arr;
+        timer_psc_arr_solve(PORT_TIMER_SIM_CLOCK_HZ, period_ms, &psc_arr);
+        p_timer->ARR = psc_arr.arr;
+        p_timer->PSC = psc_arr.psc;
+        p_timer->period_ms = period_ms;
+    }
+}
+
+uint64_t port_timer_sim_get_period_cycles(port_timer_sim_t *p_timer)
+{
+    return ((uint64_t)p_timer->PSC + 1) * ((uint64_t)p_timer->ARR + 1);
+}
+
+void port_timer_sim_start(port_timer_sim_t *p_timer)
+{
+    p_timer->enabled = true;
+    p_timer->next_update_cycles = _now() + port_timer_sim_get_period_cycles(p_timer);
+}
+
+void port_timer_sim_stop(port_timer_sim_t *p_timer)
+{
+    p_timer->enabled = false;
+}
+
+void port_timer_sim_enable_irq(port_timer_sim_t *p_timer, bool enable)
+{
+    p_timer->irq_enabled = enable;
+}
+
+uint64_t port_timer_sim_get_cycles(void)
+{
+    return _now();
+}
+
+bool port_timer_sim_step(uint32_t until_ms)
+{
+    uint64_t now = _now();
+    uint64_t until = (uint64_t)until_ms * PORT_TIMER_SIM_CYCLES_PER_MS;
+    uint64_t next = UINT64_MAX;
+
+    // Counters without interrupt keep running: catch their update events up to now
+    for (uint32_t i = 0; i < PORT_TIMER_SIM_NUM_TIMERS; i++)
+    {
+        port_timer_sim_t *p_timer = p_timers[i];
+        if (p_timer->enabled)
+        {
+            uint64_t period = port_timer_sim_get_period_cycles(p_timer);
+            if (!p_timer->irq_enabled && (p_timer->next_update_cycles <= now))
+            {
+                p_timer->next_update_cycles += ((now - p_timer->next_update_cycles) / period + 1) * period;
+            }
+            if (p_timer->irq_enabled && (p_timer->next_update_cycles < next))
+            {
+                next = p_timer->next_update_cycles;
+            }
+        }
+    }
+
+    if (next > until)
+    {
+        if (until > now)
+        {
+            _advance(until);
+        }
+        return false;
+    }
+    if (next > now)
+    {
+        _advance(next);
+    }
+
+    // The timers that expire in this cycle, in NVIC order. A timer reprogrammed by an earlier ISR is not due anymore
+    for (uint32_t i = 0; i < PORT_TIMER_SIM_NUM_TIMERS; i++)
+    {
+        port_timer_sim_t *p_timer = p_timers[i];
+        if (p_timer->enabled && p_timer->irq_enabled && (p_timer->next_update_cycles == next))
+        {
+            p_timer->next_update_cycles += port_timer_sim_get_period_cycles(p_timer);
+            p_timer->irqs++;
+            p_timer->p_handler();
+        }
+    }
+    return true;
+}
@@ -17,10 +17,14 @@
 /* HW dependent includes */
 #include "port_system.h"
 
+/* Project includes */
+#include "debounce.h"
+
 /* Defines --------------------------------------------------------------------*/
 // HW Nucleo-STM32F446RE:
 #define BUTTON_EMERGENCY_GPIO GPIOC /*!< GPIO port of the button in the Nucleo board */
 #define BUTTON_EMERGENCY_PIN  13    /*!< GPIO pin of the button in the Nucleo board */
+#define BUTTON_EMERGENCY_DEBOUNCE_MS 50 /*!< Debouncing window of the button: the edges less than this after an accepted edge are bounces */
 
 /* Typedefs --------------------------------------------------------------------*/
 /**
@@ -30,8 +34,9 @@ typedef struct
 {
     GPIO_TypeDef *p_port; /*!< GPIO where the button is connected */
     uint8_t pin;          /*!< Pin/line where the button is connected */
-    bool flag_pressed;    /*!< Flag to indicate that the button has been pressed */
+    bool flag_pressed;    /*!< Flag to indicate that the button has been pressed and the press has not been consumed yet */
     bool flag_released;   /*!< Flag to indicate that the button has been released */
+    debounce_t debounce;  /*!< Debouncer of the edges of the button. Its level is true when the button is pressed */
 } port_button_hw_t;
 
 /* Global variables -----------------------------------------------------------*/
@@ -53,11 +58,27 @@ void port_button_init(port_button_hw_t *p_button);
 bool port_button_read_gpio(port_button_hw_t *p_button);
 
 /**
- * @brief Gets the status of the button. The button is considered pressed when it has been both pressed; it is not necessary to be released.
+ * @brief Gets the status of the button. The button is considered pressed when it has been pressed and the press has not been consumed yet; it is not necessary to be released.
  *
  * @param p_button Pointer to the button structure.
  * @return true if the button is pressed, false otherwise.
  */
 bool port_button_is_pressed(port_button_hw_t *p_button);
 
+/**
+ * @brief Consumes the press of the button: returns it once and clears it. The presses that happen before it is consumed count as one.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return true if the button has been pressed since the last time a press was consumed, false otherwise.
+ */
+bool port_button_consume_press(port_button_hw_t *p_button);
+
+/**
+ * @brief Gets the number of edges of the button rejected as bounces since the button was initialized.
+ *
+ * @param p_button Pointer to the button structure.
+ * @return uint32_t Number of bounces.
+ */
+uint32_t port_button_get_bounces(port_button_hw_t *p_button);
+
 #endif /* PORT_BUTTON_H */
\ No newline at end of file
@@ -14,29 +14,61 @@
 /* HW dependent includes */
 #include "port_system.h"
 
+/* Project includes */
+#include "timer_psc_arr.h"
+#include "timer_wheel.h"
+
 /* Defines and macros --------------------------------------------------------*/
 // HW Nucleo-STM32F446RE:
-#define LED_OPENING_GPIO  /*!< GPIO port of the LED for opening in the automatic door */
-#define LED_OPENING_PIN       /*!< GPIO pin of the LED for opening in the automatic door */
-#define LED_CLOSING_GPIO  /*!< GPIO port of the LED for closing in the automatic door */
-#define LED_CLOSING_PIN       /*!< GPIO pin of the LED for closing in the automatic door */
-#define LED_OPENING_TIMER  /*!< Timer to control the blinking of the opening LED */
-#define LED_CLOSING_TIMER  /*!< Timer to control the blinking of the closing LED */
-#define LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS  /*!< Semi-period of the blinking of the opening LED */
-#define LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS  /*!< Semi-period of the blinking of the closing LED */
+#define LED_OPENING_GPIO GPIOB /*!< GPIO port of the LED for opening in the automatic door */
+#define LED_OPENING_PIN 3      /*!< GPIO pin of the LED for opening in the automatic door */
+#define LED_CLOSING_GPIO GPIOB /*!< GPIO port of the LED for closing in the automatic door */
+#define LED_CLOSING_PIN 4      /*!< GPIO pin of the LED for closing in the automatic door */
+#if defined(PORT_LED_OUTPUT_COMPARE)
+// The timers blink the LEDs by themselves (toggle on compare) through the pins: PB3 is TIM2_CH2 and PB4 is TIM3_CH1
+#define LED_OPENING_TIMER TIM2        /*!< Timer to control the blinking of the opening LED */
+#define LED_OPENING_TIMER_CHANNEL 2   /*!< Channel of the timer wired to the opening LED (PB3: TIM2_CH2) */
+#define LED_OPENING_ALTERNATE 1       /*!< Alternate function of the opening LED pin for its timer channel (AF1) */
+#define LED_CLOSING_TIMER TIM3        /*!< Timer to control the blinking of the closing LED */
+#define LED_CLOSING_TIMER_CHANNEL 1   /*!< Channel of the timer wired to the closing LED (PB4: TIM3_CH1) */
+#define LED_CLOSING_ALTERNATE 2       /*!< Alternate function of the closing LED pin for its timer channel (AF2) */
+#define LED_TIMER_WHEEL NULL          /*!< The blinking is done by the timers, not by software timers */
+#else
+#define LED_OPENING_TIMER TIM3        /*!< Timer to control the blinking of the opening LED */
+#define LED_OPENING_TIMER_CHANNEL 0   /*!< No channel: the ISR of the timer toggles the opening LED */
+#define LED_OPENING_ALTERNATE 0       /*!< No alternate function: the pin is a GPIO output */
+#define LED_CLOSING_TIMER TIM4        /*!< Timer to control the blinking of the closing LED */
+#define LED_CLOSING_TIMER_CHANNEL 0   /*!< No channel: the ISR of the timer toggles the closing LED */
+#define LED_CLOSING_ALTERNATE 0       /*!< No alternate function: the pin is a GPIO output */
+#define LED_TIMER_WHEEL PORT_TIMER_WHEEL_SYSTEM /*!< Timing wheel of the blinking of the LEDs. If it is not NULL, the blinking is a software timer and TIM3 and TIM4 are not used */
+#endif
+#define LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS 500 /*!< Semi-period of the blinking of the opening LED */
+#define LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS 100 /*!< Semi-period of the blinking of the closing LED */
 
 /* Typedefs --------------------------------------------------------------------*/
 /**
  * @brief Structure to define the HW dependencies of a LED.
+ *
+ * The LED blinks in one of three ways: a software timer of a timing wheel toggles it (`p_wheel`), the timer drives the pin by itself with an output-compare channel in toggle mode (`timer_channel`, no interrupt at all), or the ISR of the timer toggles it (neither).
  */
 typedef struct
 {
-    GPIO_TypeDef *p_port; /*!< GPIO where the LED is connected */
-    uint8_t pin;          /*!< Pin/line where the LED is connected */
-    TIM_TypeDef *p_timer; /*!< Timer to control the blinking of the LED */
-    uint32_t timer_blink_semi_period_ms; /*!< Semi-period of the blinking of the LED */
+    GPIO_TypeDef *p_port;                  /*!< GPIO where the LED is connected */
+    uint8_t pin;                           /*!< Pin/line where the LED is connected */
+    TIM_TypeDef *p_timer;                  /*!< Timer to control the blinking of the LED */
+    uint32_t timer_blink_semi_period_ms;   /*!< Semi-period of the blinking of the LED */
+    timer_psc_arr_t timer_blink_psc_arr;   /*!< PSC and ARR of `p_timer` for `timer_blink_semi_period_ms`, computed at compile time */
+    timer_wheel_t *p_wheel;                /*!< Timing wheel of the blinking, or NULL to use the hardware timer `p_timer` */
+    timer_wheel_timer_t timer_wheel_blink; /*!< Periodic software timer of the blinking in `p_wheel`. Its callback toggles the LED */
+    uint8_t timer_channel;                 /*!< Channel (1 to 4) of `p_timer` that blinks the pin in toggle-on-compare mode, or 0 if the ISR of `p_timer` toggles the LED */
+    uint8_t alternate;                     /*!< Alternate function of the pin for `timer_channel` */
 } port_led_hw_t;
 
+/**
+ * @brief Batch of changes of the LEDs, written once per GPIO port on commit.
+ */
+typedef port_system_gpio_batch_t port_led_batch_t;
+
 /* Global variables -----------------------------------------------------------*/
 extern port_led_hw_t led_opening; /*!< LED for the opening the automatic door. Public for access to interrupt handlers. */
 extern port_led_hw_t led_closing; /*!< LED for the closing the automatic door. Public for access to interrupt handlers. */
@@ -75,6 +107,36 @@ void port_led_off(port_led_hw_t *p_led);
  */
 void port_led_toggle(port_led_hw_t *p_led);
 
+/**
+ * @brief Empties a batch of changes of the LEDs.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_led_batch_init(port_led_batch_t *p_batch);
+
+/**
+ * @brief Adds turning on a LED to a batch. A LED blinked by a timer channel is turned on at once.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param p_led Pointer to the LED structure.
+ */
+void port_led_batch_on(port_led_batch_t *p_batch, port_led_hw_t *p_led);
+
+/**
+ * @brief Adds turning off a LED to a batch. A LED blinked by a timer channel is turned off at once.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param p_led Pointer to the LED structure.
+ */
+void port_led_batch_off(port_led_batch_t *p_batch, port_led_hw_t *p_led);
+
+/**
+ * @brief Writes the changes of a batch, one write per GPIO port, and empties it.
+ *
+ * @param p_batch Pointer to the batch.
+ */
+void port_led_batch_commit(port_led_batch_t *p_batch);
+
 /**
  * @brief Configures the timer for the LED.
  *
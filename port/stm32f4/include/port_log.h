@@ -0,0 +1,98 @@
+/**
+ * @file port_log.h
+ * @author agent (agent@local)
+ * @brief Header file for the port layer of the log output (`printf`) through a UART drained with DMA.
+ *
+ * With `PORT_LOG_UART` (CMake option `USE_LOG_UART`) `_write()` does not send the text itself: it copies it into a ring (`log_ring.h`) and returns, and DMA1 stream 6 sends it through USART2, which the ST-LINK of the Nucleo board exposes as a virtual COM port. The ISR of the end of each transfer frees the bytes sent and starts the next transfer, so the main loop never waits for the UART. Otherwise `_write()` sends the text through the ITM (SWO), byte by byte.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef PORT_LOG_H
+#define PORT_LOG_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Standard C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HW dependent includes */
+#include "port_system.h"
+
+/* Project includes */
+#include "log_ring.h"
+
+/* Defines --------------------------------------------------------------------*/
+// HW Nucleo-STM32F446RE:
+#define LOG_UART_USART USART2             /*!< UART of the log: the virtual COM port of the ST-LINK */
+#define LOG_UART_GPIO GPIOA               /*!< GPIO port of the TX pin of the UART */
+#define LOG_UART_PIN 2                    /*!< GPIO pin of the TX pin of the UART (PA2) */
+#define LOG_UART_ALTERNATE 7              /*!< Alternate function of the TX pin: AF7 (USART2) */
+#define LOG_UART_BAUD_RATE 115200         /*!< Baud rate of the UART, 8N1 */
+#define LOG_UART_DMA_STREAM DMA1_Stream6  /*!< DMA stream of the TX of USART2 */
+#define LOG_UART_DMA_CHANNEL 4            /*!< DMA channel of the TX of USART2 in stream 6 */
+
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define the HW dependencies of the log output.
+ */
+typedef struct
+{
+    USART_TypeDef *p_uart;             /*!< UART of the log */
+    GPIO_TypeDef *p_port;              /*!< GPIO where the TX pin is connected */
+    uint8_t pin;                       /*!< TX pin */
+    uint8_t alternate;                 /*!< Alternate function of the TX pin */
+    DMA_Stream_TypeDef *p_dma_stream;  /*!< DMA stream that feeds the UART */
+    uint8_t dma_channel;               /*!< Channel of the UART in the DMA stream */
+    log_ring_t ring;                   /*!< Bytes waiting to be sent */
+    volatile uint32_t dma_len;         /*!< Bytes of the transfer in course, 0 if the DMA is idle */
+} port_log_hw_t;
+
+/* Global variables -----------------------------------------------------------*/
+extern port_log_hw_t log_uart; /*!< Log output of the system. Public for access to interrupt handlers. */
+
+/* Function prototypes and explanations ---------------------------------------*/
+/**
+ * @brief Initializes the UART, its TX pin and its DMA stream, and empties the ring.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+void port_log_init(port_log_hw_t *p_log);
+
+/**
+ * @brief Queues bytes to be sent and starts a DMA transfer if none is in course. It does not wait for the UART. If the bytes do not fit in the ring they are dropped whole and counted as lost.
+ *
+ * @param p_log Pointer to the log structure.
+ * @param p_data Bytes to send.
+ * @param len Number of bytes.
+ * @return int `len`: the bytes are either queued or dropped, never left for a retry.
+ */
+int port_log_write(port_log_hw_t *p_log, const char *p_data, int len);
+
+/**
+ * @brief Queues bytes to be sent, as `port_log_write()`, but tells whether they have been queued or dropped because the ring was full. For writers that must know it, such as the binary event log (`event_log.h`).
+ *
+ * @param p_log Pointer to the log structure.
+ * @param p_data Bytes to send.
+ * @param len Number of bytes.
+ * @return true if the bytes have been queued.
+ * @return false if they have been dropped and counted as lost.
+ */
+bool port_log_try_write(port_log_hw_t *p_log, const void *p_data, uint32_t len);
+
+/**
+ * @brief Frees the bytes of the transfer that has ended and starts the next one. To be called from the ISR of the end of the transfer of the DMA stream.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+void port_log_dma_complete(port_log_hw_t *p_log);
+
+/**
+ * @brief Gets the number of bytes dropped because the ring was full.
+ *
+ * @param p_log Pointer to the log structure.
+ * @return uint32_t Number of lost bytes since `port_log_init()`.
+ */
+uint32_t port_log_get_lost(port_log_hw_t *p_log);
+
+#endif /* PORT_LOG_H */
@@ -16,23 +16,64 @@
 /* HW dependent includes */
 #include "port_system.h"
 
+/* Project includes */
+#include "timer_wheel.h"
+#include "event_queue.h"
+#include "motor_profile.h"
+
 /* Defines and macros --------------------------------------------------------*/
 // HW Nucleo-STM32F446RE:
-#define MOTOR_AUTOMATIC_DOOR_GPIO NULL          /*!< TO-DO: GPIO port of the motor of the automatic door */
-#define MOTOR_AUTOMATIC_DOOR_PIN 0              /*!< TO-DO: GPIO pin of the motor of the automatic door */
+#define MOTOR_AUTOMATIC_DOOR_GPIO GPIOA         /*!< GPIO port of the direction of the motor of the automatic door */
+#define MOTOR_AUTOMATIC_DOOR_PIN 9              /*!< GPIO pin of the direction of the motor of the automatic door: high to open, low to close (PA9, D8 on Nucleo) */
+#define MOTOR_AUTOMATIC_DOOR_PWM_GPIO GPIOA     /*!< GPIO port of the PWM of the motor of the automatic door */
+#define MOTOR_AUTOMATIC_DOOR_PWM_PIN 8          /*!< GPIO pin of the PWM of the motor of the automatic door (PA8, D7 on Nucleo): TIM1_CH1 */
+#define MOTOR_AUTOMATIC_DOOR_PWM_ALTERNATE 1    /*!< Alternate function of the PWM pin: AF1 (TIM1) */
+#define MOTOR_AUTOMATIC_DOOR_PWM_TIMER TIM1     /*!< Timer of the PWM of the motor (channel 1). Its repetition counter spaces the update events by a step of the profile */
+#define MOTOR_AUTOMATIC_DOOR_PWM_FREQUENCY_HZ 20000 /*!< Frequency of the PWM of the motor: out of the audible range */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_MS 5000    /*!< Duration of the speed profile of the motor: the opening and closing timeout of the door */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS 10 /*!< Period of the update of the duty of the motor: 200 periods of the PWM, within the 8-bit repetition counter of TIM1 */
+#define MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS 1000 /*!< Duration of the acceleration and of the deceleration of the motor */
+#define MOTOR_PROFILE_SCALE_BITS 16               /*!< Fractional bits of the scale of the profile to the travel left */
+#define MOTOR_POSITION_OPEN 1000                /*!< Position of the door fully open, in per mille of the travel (0 is closed) */
+#if defined(PORT_LED_OUTPUT_COMPARE)
+#define MOTOR_AUTOMATIC_DOOR_TIMEOUT_TIMER TIM4 /*!< Timer to control the timeout of the automatic door (TIM2 blinks the opening LED through PB3) */
+#else
 #define MOTOR_AUTOMATIC_DOOR_TIMEOUT_TIMER TIM2 /*!< Timer to control the timeout of the automatic door */
+#endif
+#define MOTOR_AUTOMATIC_DOOR_TIMEOUT_WHEEL PORT_TIMER_WHEEL_SYSTEM /*!< Timing wheel of the timeout of the automatic door. If it is not NULL, the timeout is a software timer and TIM2 is not used */
 
 /* Typedefs --------------------------------------------------------------------*/
 /**
  * @brief Structure to define the HW dependencies of a motor.
+ *
+ * The timeout is counted either by a hardware timer, whose ISR sets the timeout and pushes the event, or by a software timer of a timing wheel (`p_wheel`), whose callback does the same. With the timing wheel any number of motors share the SysTick.
+ *
+ * The speed of the motor is the duty of a PWM channel, which follows the trapezoidal profile `p_profile` (see `motor_profile.h`) while the door moves. The repetition counter of the PWM timer raises an update event every `MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS`, and its ISR (`port_motor_pwm_update()`) loads the duty of the next step from the table into the preload of the compare register, which the timer applies at the next update event.
+ *
+ * The position of the door is estimated by dead reckoning in the same ISR: the speed of the door follows the duty, so every step that ends moves the door by its duty, up to `travel` (the sum of the duties of the profile, a full travel from the closed door at reset). Every movement scales the duties of the profile to the travel left (`profile_scale`), so that after a reversal the door accelerates, cruises slower and decelerates where its travel ends, and the position is set to the end when the profile ends. The step in course when the motor is stopped is not counted, so the estimate drifts by less than a step per reversal.
+ *
+ * The estimate is not position feedback: it cannot tell a blocked leaf from a moving one, so `port_motor_has_position()` is false and the movements end on the timeout, which is then the whole profile. An encoder or end switches would replace the count in the ISR and push `EVENT_MOTOR_END_OF_TRAVEL`.
  */
 typedef struct
 {
-    GPIO_TypeDef *p_port;         /*!< GPIO where the LED is connected */
-    uint8_t pin;                  /*!< Pin/line where the LED is connected */
-    TIM_TypeDef *p_timer_timeout; /*!< Timer to control the timeout of the motor */
-    bool timeout;                 /*!< Timeout status */
-    // TO-DO: Add timer to control the PWM of the motor
+    GPIO_TypeDef *p_port;                    /*!< GPIO where the direction of the motor is connected */
+    uint8_t pin;                             /*!< Pin where the direction of the motor is connected */
+    TIM_TypeDef *p_timer_timeout;            /*!< Timer to control the timeout of the motor */
+    uint32_t timer_period_ms;                /*!< Timeout PSC and ARR of the timer are set for, 0 if none. They are only computed again when the timeout changes */
+    bool timeout;                            /*!< Timeout status */
+    timer_wheel_t *p_wheel;                  /*!< Timing wheel of the timeout, or NULL to use the hardware timer `p_timer_timeout` */
+    timer_wheel_timer_t timer_wheel_timeout; /*!< Software timer of the timeout in `p_wheel` */
+    event_queue_t *p_event_queue;            /*!< Queue where the software timer pushes `EVENT_MOTOR_TIMEOUT` when it expires (the role of the ISR of the hardware timer) */
+    TIM_TypeDef *p_timer_pwm;                /*!< Timer of the PWM of the motor (channel 1), or NULL if the motor has no PWM */
+    GPIO_TypeDef *p_port_pwm;                /*!< GPIO where the PWM of the motor is connected */
+    uint8_t pin_pwm;                         /*!< Pin where the PWM of the motor is connected */
+    uint8_t alternate_pwm;                   /*!< Alternate function of the PWM pin */
+    motor_profile_t *p_profile;              /*!< Speed profile of the motor, built by `port_motor_init()` */
+    uint32_t profile_step;                   /*!< Step of the profile whose duty is in the preload of the compare register */
+    bool direction_open;                     /*!< Direction of the movement in course or of the last one: true to open the door */
+    uint32_t position;                       /*!< Position of the door by dead reckoning, in counts of duty times steps: 0 closed, `travel` open */
+    uint32_t travel;                         /*!< Position of the door fully open: the sum of the duties of the profile */
+    uint32_t profile_scale;                  /*!< Scale of the duties of the movement in course, in 1/2^`MOTOR_PROFILE_SCALE_BITS`: the travel left when it started over the full travel */
 } port_motor_hw_t;
 
 /* Global variables -----------------------------------------------------------*/
@@ -61,6 +102,52 @@ void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeou
  */
 void port_motor_timeout_timer_deactivate(port_motor_hw_t *p_motor);
 
+/**
+ * @brief Starts the speed profile of the motor, scaled to the travel left in the direction: sets the direction and the duty of the first step and enables the update interrupt of the PWM timer. A profile in course starts again from the beginning. Nothing is done if the motor has no PWM, and the motor stays stopped if the door is already at the end.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param open Direction of the motor: true to open the door, false to close it.
+ */
+void port_motor_move(port_motor_hw_t *p_motor, bool open);
+
+/**
+ * @brief Stops the motor: duty 0 at once and no more updates of the profile.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_stop(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Counts the travel of the step of the profile that has just ended and loads the scaled duty of the next step into the compare register. To be called from the update ISR of the PWM timer. After the last step the duty is 0, the update interrupt is disabled and the door is taken to be at the end of its travel.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+void port_motor_pwm_update(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Checks whether the motor has position feedback. The dead reckoning of the PWM is only an estimate, so it is always false on this board, which has no encoder nor end switches.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return true If the position of the door is measured.
+ */
+bool port_motor_has_position(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Gets the position of the door.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return uint32_t Position estimated by dead reckoning, in per mille of the travel, from 0 (closed) to `MOTOR_POSITION_OPEN`. 0 if the motor has no PWM.
+ */
+uint32_t port_motor_get_position(port_motor_hw_t *p_motor);
+
+/**
+ * @brief Checks whether the door is at the end of the travel of the last movement: fully open after `port_motor_move()` to open, fully closed after it to close.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @return true If the door is at the end of the travel. Always false if the motor has no position feedback.
+ */
+bool port_motor_is_at_end_of_travel(port_motor_hw_t *p_motor);
+
 /**
  * @brief Set the status of the timer if has finished or not.
  *
@@ -17,10 +17,15 @@
 /* HW dependent includes */
 #include "port_system.h"
 
+/* Project includes */
+#include "pir_filter.h"
+
 /* Defines and macros --------------------------------------------------------*/
 // HW Nucleo-STM32F446RE:
 #define PIR_SENSOR_AUTOMATIC_DOOR_GPIO GPIOA /*!< GPIO port of the PIR sensor of the automatic door */
 #define PIR_SENSOR_AUTOMATIC_DOOR_PIN 10     /*!< GPIO pin of the PIR sensor of the automatic door */
+#define PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS 50 /*!< Time the output of the PIR sensor must stay high for a presence: shorter pulses are glitches */
+#define PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS 1000    /*!< Time a presence is held after the output of the PIR sensor falls: a new rising edge inside it continues the same presence */
 
 /* Typedefs --------------------------------------------------------------------*/
 /**
@@ -32,6 +37,7 @@ typedef struct
     uint8_t pin;                           /*!< Pin/line where the PIR is connected */
     bool sensor_status;                    /*!< Wether the sensor is detecting movement or not */
     uint32_t last_time_presence_or_button; /*!< Last time a presence was detected */
+    pir_filter_t filter;                   /*!< Filter of the edges of the output of the sensor. `sensor_status` follows its filtered status */
 } port_pir_hw_t;
 
 /* Global variables -----------------------------------------------------------*/
@@ -52,6 +58,14 @@ bool port_pir_sensor_get_status(port_pir_hw_t *pir_sensor);
  */
 void port_pir_sensor_set_status(port_pir_hw_t *pir_sensor, bool status);
 
+/**
+ * @brief Whether the filtered status of the PIR sensor may change with no edge, so that the System tick has to keep polling its filter.
+ * @param pir_sensor Pointer to the PIR sensor structure.
+ * @return true if a presence is waiting for its minimum high time or in its hold.
+ * @return false otherwise.
+ */
+bool port_pir_sensor_is_filter_pending(port_pir_hw_t *pir_sensor);
+
 /**
  * @brief Initializes the PIR sensor.
  *
@@ -17,6 +17,9 @@
 /* HW dependent includes */
 #include "stm32f4xx.h"
 
+/* Project includes */
+#include "timer_wheel.h"
+
 /* Defines and enums ----------------------------------------------------------*/
 /* Defines */
 #define BIT_POS_TO_MASK(x) (0x01 << (x))                                                                /*!< Convert the index of a bit into a mask by left shifting */
@@ -26,6 +29,7 @@
 /* Microcontroller STM32F446RE */
 /* Timer configuration */
 #define RCC_HSI_CALIBRATION_DEFAULT 0x10U            /*!< Default HSI calibration trimming value */
+#define PORT_SYSTEM_HSI_CLOCK_HZ 16000000U           /*!< Frequency of the HSI, the clock of the system and of the timers (no AHB nor APB prescaler) */
 #define TICK_FREQ_1KHZ 1U                            /*!< Freqency in kHz of the System tick */
 #define NVIC_PRIORITY_GROUP_0 ((uint32_t)0x00000007) /*!< 0 bit  for pre-emption priority, \
                                                          4 bits for subpriority */
@@ -34,6 +38,16 @@
 
 /* Power */
 #define POWER_REGULATOR_VOLTAGE_SCALE3 0x01 /*!< Scale 3 mode: the maximum value of fHCLK is 120 MHz. */
+#define SLEEP_TIMER TIM5                    /*!< Free-running 32-bit timer that measures the time spent asleep */
+#define SLEEP_TIMER_FREQ_HZ 10000U          /*!< Frequency of the sleep timer: 100 us resolution, it wraps around every ~5 days */
+#define SLEEP_TIMER_TICKS_PER_MS (SLEEP_TIMER_FREQ_HZ / 1000U) /*!< Ticks of the sleep timer per millisecond */
+
+/* Software timers */
+#if defined(PORT_TIMER_WHEEL)
+#define PORT_TIMER_WHEEL_SYSTEM (&timer_wheel_system) /*!< Timing wheel of the timers of the peripherals: software timers advanced by the SysTick */
+#else
+#define PORT_TIMER_WHEEL_SYSTEM NULL /*!< Timing wheel of the timers of the peripherals: none, each one uses its hardware timer */
+#endif
 
 /* GPIOs */
 #define HIGH true /*!< Logic 1 */
@@ -48,6 +62,10 @@
 #define GPIO_PUPDR_PUP 0x01    /*!< GPIO pull up */
 #define GPIO_PUPDR_PDOWN 0x02  /*!< GPIO pull down */
 
+#define GPIO_BSRR_SET(pin) ((uint32_t)BIT_POS_TO_MASK(pin))           /*!< Bit of BSRR that sets a pin */
+#define GPIO_BSRR_RESET(pin) ((uint32_t)BIT_POS_TO_MASK(pin) << 16U) /*!< Bit of BSRR that resets a pin */
+#define GPIO_BATCH_MAX_PORTS 2                                       /*!< Number of GPIO ports a batch of writes can hold. The writes to other ports are not batched */
+
 /* Interruption */
 #define TRIGGER_RISING_EDGE 0x01U                                      /*!< Interrupt mask for detecting rising edge */
 #define TRIGGER_FALLING_EDGE 0x02U                                     /*!< Interrupt mask for detecting falling edge */
@@ -55,6 +73,22 @@
 #define TRIGGER_ENABLE_EVENT_REQ 0x04U                                 /*!< Interrupt mask to enable event requests */
 #define TRIGGER_ENABLE_INTERR_REQ 0x08U                                /*!< Interrupt mask to enable interrupt request */
 
+/* Typedefs --------------------------------------------------------------------*/
+/**
+ * @brief Structure to define a batch of writes to the pins of GPIO ports: the levels of several pins of a port are composed into one value of BSRR, written once per port.
+ */
+typedef struct
+{
+    GPIO_TypeDef *p_ports[GPIO_BATCH_MAX_PORTS]; /*!< Ports with pending writes */
+    uint32_t bsrr[GPIO_BATCH_MAX_PORTS];         /*!< Value of BSRR to write in each port */
+    uint8_t num_ports;                           /*!< Number of ports with pending writes */
+} port_system_gpio_batch_t;
+
+/* Global variables -----------------------------------------------------------*/
+#if defined(PORT_TIMER_WHEEL)
+extern timer_wheel_t timer_wheel_system; /*!< Timing wheel of the software timers of the peripherals, advanced by the SysTick ISR. Public for access to interrupt handlers. */
+#endif
+
 /* Function prototypes and explanation -------------------------------------------------*/
 
 /**
@@ -112,6 +146,30 @@ void port_system_delay_ms(uint32_t ms);
  */
 void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms);
 
+/**
+ * @brief Enables the cycle counter of the core (DWT CYCCNT) and resets it to 0.
+ *
+ * > 1. Enable the trace and debug blocks (bit TRCENA of CoreDebug DEMCR), that contain the DWT. \n
+ * > 2. Reset the counter and enable it (bit CYCCNTENA of DWT CTRL).
+ *
+ * @retval None
+ */
+void port_system_cycle_counter_init(void);
+
+/**
+ * @brief Gets the cycles of the core counted by the DWT since `port_system_cycle_counter_init()`. It wraps around every 2^32 cycles (~4.5 minutes at 16 MHz).
+ *
+ * @return uint32_t Value of DWT CYCCNT.
+ */
+uint32_t port_system_get_cycles(void);
+
+/**
+ * @brief Gets the number of cycles of the core per microsecond.
+ *
+ * @return uint32_t `SystemCoreClock` in MHz.
+ */
+uint32_t port_system_get_cycles_per_us(void);
+
 /** @verbatim
       ==============================================================================
                               ##### How to use GPIOs #####
@@ -235,4 +293,121 @@ void port_system_gpio_exti_enable(uint8_t pin, uint8_t priority, uint8_t subprio
  */
 void port_system_gpio_exti_disable(uint8_t pin);
 
+/**
+ * @brief Set the level of a GPIO configured as output
+ *
+ * > The pin is set or reset with a single write of the bit set/reset register (BSRR) instead of a read-modify-write of ODR. The write is atomic: an ISR that changes another pin of the same port in between cannot be undone by it.
+ *
+ * @param p_port Port of the GPIO (CMSIS struct like)
+ * @param pin Pin/line of the GPIO (index from 0 to 15)
+ * @param value Level of the pin: `HIGH` or `LOW`
+ *
+ * @retval None
+ */
+void port_system_gpio_write(GPIO_TypeDef *p_port, uint8_t pin, bool value);
+
+/**
+ * @brief Toggle the level of a GPIO configured as output
+ *
+ * > ODR is read to know the level of the pin and the opposite level is written in BSRR. Only the given pin is written.
+ *
+ * @param p_port Port of the GPIO (CMSIS struct like)
+ * @param pin Pin/line of the GPIO (index from 0 to 15)
+ *
+ * @retval None
+ */
+void port_system_gpio_toggle(GPIO_TypeDef *p_port, uint8_t pin);
+
+/**
+ * @brief Empty a batch of writes to GPIOs
+ *
+ * @param p_batch Pointer to the batch
+ *
+ * @retval None
+ */
+void port_system_gpio_batch_init(port_system_gpio_batch_t *p_batch);
+
+/**
+ * @brief Add the level of a GPIO to a batch of writes
+ *
+ * > A later level of the same pin replaces it. If the batch has no room for another port, the pin is written at once.
+ *
+ * @param p_batch Pointer to the batch
+ * @param p_port Port of the GPIO (CMSIS struct like)
+ * @param pin Pin/line of the GPIO (index from 0 to 15)
+ * @param value Level of the pin: `HIGH` or `LOW`
+ *
+ * @retval None
+ */
+void port_system_gpio_batch_write(port_system_gpio_batch_t *p_batch, GPIO_TypeDef *p_port, uint8_t pin, bool value);
+
+/**
+ * @brief Write the levels of a batch, one write of BSRR per port, and empty it
+ *
+ * @param p_batch Pointer to the batch
+ *
+ * @retval None
+ */
+void port_system_gpio_batch_commit(port_system_gpio_batch_t *p_batch);
+
+/**
+ * @brief Masks all the configurable interrupts (PRIMASK).
+ *
+ * Used to check whether there is pending work and go to sleep atomically: an interrupt that arrives in between stays pending and wakes up the core as soon as the WFI is executed, instead of being served before the WFI and leaving the core asleep.
+ *
+ */
+void port_system_enter_critical(void);
+
+/**
+ * @brief Unmasks the interrupts masked by `port_system_enter_critical()`. Pending interrupts are served right after.
+ *
+ */
+void port_system_exit_critical(void);
+
+/**
+ * @brief Suspends the System tick interrupt and stops its counter.
+ *
+ */
+void port_system_systick_suspend(void);
+
+/**
+ * @brief Restarts the System tick counter and its interrupt.
+ *
+ */
+void port_system_systick_resume(void);
+
+/**
+ * @brief Enters sleep mode (WFI) until the next interrupt. The System tick keeps running and waking up the core every millisecond.
+ *
+ * The time asleep is measured with `SLEEP_TIMER` and added to the sleep counter.
+ *
+ * @warning It must be called between `port_system_enter_critical()` and `port_system_exit_critical()`, after checking that there is no pending work.
+ *
+ */
+void port_system_power_sleep(void);
+
+/**
+ * @brief Enters sleep mode (WFI) with the System tick suspended, until the next interrupt.
+ *
+ * Use it when nothing needs the millisecond tick to advance while asleep (*e.g.*, no timeout is armed): the core only wakes up for a real event. On wake up the time asleep, measured with `SLEEP_TIMER`, is added to the system time (`port_system_get_millis()`) and to the sleep counter, and the System tick is resumed.
+ *
+ * @warning It must be called between `port_system_enter_critical()` and `port_system_exit_critical()`, after checking that there is no pending work.
+ *
+ */
+void port_system_power_sleep_tickless(void);
+
+/**
+ * @brief Gets the total time spent asleep since the system started.
+ *
+ * @return uint32_t Milliseconds spent in `port_system_power_sleep()` or `port_system_power_sleep_tickless()`.
+ */
+uint32_t port_system_get_sleep_millis(void);
+
+/**
+ * @brief Gets the total time spent awake since the system started.
+ *
+ * @return uint32_t Milliseconds since the system started minus the milliseconds asleep.
+ */
+uint32_t port_system_get_awake_millis(void);
+
 #endif /* PORT_SYSTEM_H_ */
\ No newline at end of file
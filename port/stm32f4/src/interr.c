@@ -11,10 +11,37 @@
 #include "port_led.h"
 #include "port_pir_sensor.h"
 #include "port_motor.h"
+#include "port_log.h"
+#include "event_queue.h"
+#include "latency.h"
 
 //------------------------------------------------------
 // INTERRUPT SERVICE ROUTINES
 //------------------------------------------------------
+/**
+ * @brief Sets the status of the PIR sensor to the filtered status and pushes its event.
+ *
+ * @param cycles Timestamp of the change in cycles, the start of the latency of a presence.
+ */
+static void _pir_sensor_deliver(uint32_t cycles)
+{
+  bool present = pir_sensor_automatic_door.filter.present;
+  port_pir_sensor_set_status(&pir_sensor_automatic_door, present);
+  if (present)
+  {
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    latency_start(&latency_automatic_door, cycles);
+#else
+    (void)cycles;
+#endif
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+  }
+  else
+  {
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+  }
+}
+
 /**
  * @brief Interrupt service routine for the System tick timer (SysTick).
  *
@@ -28,32 +55,52 @@
 void SysTick_Handler(void)
 {
   port_system_set_millis(port_system_get_millis() + 1);
+#if defined(PORT_TIMER_WHEEL)
+  // Software timers of the peripherals. After a tickless sleep the wheel catches up with the time slept
+  timer_wheel_advance(&timer_wheel_system, port_system_get_millis());
+#endif
+
+  // Presence of the PIR sensor waiting for its minimum high time, or in its hold. The system tick runs while there is one (no tickless sleep)
+  if (port_pir_sensor_is_filter_pending(&pir_sensor_automatic_door) && pir_filter_poll(&pir_sensor_automatic_door.filter, port_system_get_millis()))
+  {
+    _pir_sensor_deliver(port_system_get_cycles());
+  }
 }
 
 /**
  * @brief  This function handles Px10-Px15 global interrupts.
  *
- * First, this function identifies the line/ pin which has raised the interruption. Then, perform the desired action. Before leaving it cleans the interrupt pending register.
+ * First, this function identifies the line/ pin which has raised the interruption. Then, perform the desired action and push the corresponding event into `event_queue_automatic_door`. Before leaving it cleans the interrupt pending register.
  *
  */
 void EXTI15_10_IRQHandler(void)
 {
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+  uint32_t cycles = port_system_get_cycles(); // Timestamp of the edge as soon as it lands in the ISR
+#else
+  uint32_t cycles = 0;
+#endif
+
   // Button
   if (EXTI->PR & BIT_POS_TO_MASK(button_emergency.pin))
   {
-    if (port_button_read_gpio(&button_emergency)) // If the button is released (not pressed)
+    bool pressed = !port_button_read_gpio(&button_emergency); // The button is pressed when the GPIO is low
+
+    // The bounces of the contact are rejected here: no flag changes and no event is pushed for them
+    if (debounce_edge(&button_emergency.debounce, port_system_get_millis(), pressed))
     {
-      if (button_emergency.flag_pressed) // If the button was pressed before
+      if (pressed)
+      {
+        button_emergency.flag_released = false; // Reset the flag
+        button_emergency.flag_pressed = true;   // Set the flag: the press is pending until the FSM consumes it
+        event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+      }
+      else
       {
         button_emergency.flag_released = true; // Set the flag
-        button_emergency.flag_pressed = false; // Reset the flag
+        event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_RELEASE);
       }
     }
-    else // If the button is pressed
-    {
-      button_emergency.flag_released = false; // Reset the flag
-      button_emergency.flag_pressed = true;   // Set the flag
-    }
 
     EXTI->PR |= BIT_POS_TO_MASK(button_emergency.pin); // Para limpiar el flag que se encuentre a ‘1’ hay que escribir un ‘1’ en dicho bit. Escribir ‘0’ no afecta al estado del bit
   }
@@ -61,13 +108,13 @@ void EXTI15_10_IRQHandler(void)
   // PIR sensor
   if (EXTI->PR & BIT_POS_TO_MASK(pir_sensor_automatic_door.pin))
   {
-    if (port_pir_sensor_read_gpio(&pir_sensor_automatic_door))
+    // Glitches and the chatter of a presence are dropped by the filter: the SysTick delivers what waits for a time
+    port_system_enter_critical(); // The SysTick (higher priority) polls the same filter
+    bool changed = pir_filter_edge(&pir_sensor_automatic_door.filter, port_system_get_millis(), port_pir_sensor_read_gpio(&pir_sensor_automatic_door));
+    port_system_exit_critical();
+    if (changed)
     {
-      port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
-    }
-    else
-    {
-      port_pir_sensor_set_status(&pir_sensor_automatic_door, false);
+      _pir_sensor_deliver(cycles);
     }
 
     EXTI->PR |= BIT_POS_TO_MASK(pir_sensor_automatic_door.pin);
@@ -75,22 +122,46 @@ void EXTI15_10_IRQHandler(void)
 }
 
 /**
- * @brief Interrupt service routine for the TIM2 timer.
- *
- * @note This ISR is called when the TIM2 timer generates an interrupt.
- * The program flow jumps to this ISR and toggles the LED.
+ * @brief Handles the update interrupt of the timer of the timeout of the motor: sets the timeout flag and pushes the event.
  *
+ * @param p_timer Timer of the timeout of the motor (`MOTOR_AUTOMATIC_DOOR_TIMEOUT_TIMER`).
  */
-void TIM2_IRQHandler(void)
+static void _motor_timeout_irq(TIM_TypeDef *p_timer)
 {
   // Ensure that the interrupt is generated by an update event
-  if ((TIM2->SR & TIM_SR_UIF))
+  if ((p_timer->SR & TIM_SR_UIF))
   {
     port_motor_set_timeout_status(&motor_automatic_door, true);
-    TIM2->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
+    event_queue_push(&event_queue_automatic_door, EVENT_MOTOR_TIMEOUT);
+    p_timer->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
   }
 }
 
+#if defined(PORT_LED_OUTPUT_COMPARE)
+/**
+ * @brief Interrupt service routine for the TIM4 timer.
+ *
+ * @note This ISR is called when the TIM4 timer generates an interrupt.
+ * The program flow jumps to this ISR and sets the timeout flag of the motor. TIM2 and TIM3 blink the LEDs by themselves (toggle on compare) and do not interrupt.
+ *
+ */
+void TIM4_IRQHandler(void)
+{
+  _motor_timeout_irq(TIM4);
+}
+#else
+/**
+ * @brief Interrupt service routine for the TIM2 timer.
+ *
+ * @note This ISR is called when the TIM2 timer generates an interrupt.
+ * The program flow jumps to this ISR and sets the timeout flag of the motor.
+ *
+ */
+void TIM2_IRQHandler(void)
+{
+  _motor_timeout_irq(TIM2);
+}
+
 /**
  * @brief Interrupt service routine for the TIM3 timer.
  *
@@ -108,11 +179,56 @@ void TIM3_IRQHandler(void)
  * @brief Interrupt service routine for the TIM4 timer.
  *
  * @note This ISR is called when the TIM4 timer generates an interrupt.
- * The program flow jumps to this ISR and sets the timeout flag of the motor.
+ * The program flow jumps to this ISR and toggles the LED.
  *
  */
 void TIM4_IRQHandler(void)
 {
   port_led_toggle(&led_closing);
   TIM4->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
-}
\ No newline at end of file
+}
+#endif
+
+/**
+ * @brief Interrupt service routine for the update event of the TIM1 timer (PWM of the motor).
+ *
+ * @note This ISR is called every step of the speed profile of the motor (the repetition counter of TIM1 spaces the update events), while the door is opening or closing. It counts the travel of the step that has ended and loads the duty of the next step from the precomputed table.
+ *
+ */
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+  // The flag is set at every update event of the PWM: the profile is only in course while the interrupt is enabled
+  if ((TIM1->SR & TIM_SR_UIF) && (TIM1->DIER & TIM_DIER_UIE))
+  {
+    TIM1->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
+    port_motor_pwm_update(&motor_automatic_door);
+  }
+}
+
+/**
+ * @brief Interrupt service routine for the TIM5 timer (sleep timer).
+ *
+ * @note This ISR is called when the free-running sleep timer wraps around. It does nothing but clearing the flag: its only purpose is to wake the core up so that a tickless sleep never lasts more than a lap of the counter.
+ *
+ */
+void TIM5_IRQHandler(void)
+{
+  SLEEP_TIMER->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
+}
+
+#if defined(PORT_LOG_UART)
+/**
+ * @brief Interrupt service routine for the end of a transfer of DMA1 stream 6 (log output through USART2).
+ *
+ * @note This ISR is called when the DMA has handed the last byte of a chunk of the log to the UART. It frees the chunk in the ring and starts the transfer of the next one, if any.
+ *
+ */
+void DMA1_Stream6_IRQHandler(void)
+{
+  if (DMA1->HISR & DMA_HISR_TCIF6)
+  {
+    DMA1->HIFCR = DMA_HIFCR_CTCIF6; // Clear the transfer complete interrupt flag
+    port_log_dma_complete(&log_uart);
+  }
+}
+#endif
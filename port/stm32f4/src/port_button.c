@@ -16,7 +16,7 @@
 #include "port_button.h"
 
 /* Global variables -----------------------------------------------------------*/
-port_button_hw_t button_emergency = {.p_port = BUTTON_EMERGENCY_GPIO, .pin = BUTTON_EMERGENCY_PIN, .flag_pressed = false, .flag_released = false};
+port_button_hw_t button_emergency = {.p_port = BUTTON_EMERGENCY_GPIO, .pin = BUTTON_EMERGENCY_PIN, .flag_pressed = false, .flag_released = false, .debounce = {.window_ms = BUTTON_EMERGENCY_DEBOUNCE_MS}};
 
 /* Function definitions ------------------------------------------------------*/
 void port_button_init(port_button_hw_t *p_button)
@@ -25,6 +25,8 @@ void port_button_init(port_button_hw_t *p_button)
     port_system_gpio_config(p_button->p_port, p_button->pin, GPIO_MODE_IN, GPIO_PUPDR_NOPULL);
     port_system_gpio_config_exti(p_button->p_port, p_button->pin, TRIGGER_BOTH_EDGE | TRIGGER_ENABLE_INTERR_REQ); /* EXTI both edges */
 
+    debounce_init(&p_button->debounce, p_button->debounce.window_ms, !port_button_read_gpio(p_button));
+
     port_system_gpio_exti_enable(p_button->pin, 3, 0);
 }
 
@@ -33,6 +35,22 @@ bool port_button_is_pressed(port_button_hw_t *p_button)
     return p_button->flag_pressed;
 }
 
+bool port_button_consume_press(port_button_hw_t *p_button)
+{
+    // A press set by the ISR between the read and the clear is merged with the one returned
+    if (!p_button->flag_pressed)
+    {
+        return false;
+    }
+    p_button->flag_pressed = false;
+    return true;
+}
+
+uint32_t port_button_get_bounces(port_button_hw_t *p_button)
+{
+    return p_button->debounce.rejected;
+}
+
 bool port_button_read_gpio(port_button_hw_t *p_button)
 {    
     return (p_button->p_port->IDR & BIT_POS_TO_MASK(p_button->pin)) != 0;
@@ -6,17 +6,50 @@
  */
 /* Standard C includes */
 #include <stdio.h>
-#include <math.h>
 
 /* HW dependent includes */
 #include "stm32f4xx.h"
 #include "port_led.h"
 #include "port_system.h"
+#include "timer_psc_arr.h"
+
+/* Defines -------------------------------------------------------------------*/
+/* Output compare modes (OCxM) of a timer channel */
+#define LED_OC_MODE_FROZEN 0x00U         /*!< The output keeps its level */
+#define LED_OC_MODE_TOGGLE 0x03U         /*!< The output toggles when the counter matches CCRx */
+#define LED_OC_MODE_FORCE_INACTIVE 0x04U /*!< The output is forced low */
+#define LED_OC_MODE_FORCE_ACTIVE 0x05U   /*!< The output is forced high */
 
 /* Global variables -----------------------------------------------------------*/
-port_led_hw_t led_opening = {.p_port = LED_OPENING_GPIO, .pin = LED_OPENING_PIN, .p_timer = LED_OPENING_TIMER, .timer_blink_semi_period_ms = LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS};
-port_led_hw_t led_closing = {.p_port = LED_CLOSING_GPIO, .pin = LED_CLOSING_PIN, .p_timer = LED_CLOSING_TIMER, .timer_blink_semi_period_ms = LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS};
+port_led_hw_t led_opening = {.p_port = LED_OPENING_GPIO, .pin = LED_OPENING_PIN, .p_timer = LED_OPENING_TIMER, .timer_blink_semi_period_ms = LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS, .timer_blink_psc_arr = TIMER_PSC_ARR_CONST(PORT_SYSTEM_HSI_CLOCK_HZ, LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS), .p_wheel = LED_TIMER_WHEEL, .timer_channel = LED_OPENING_TIMER_CHANNEL, .alternate = LED_OPENING_ALTERNATE};
+port_led_hw_t led_closing = {.p_port = LED_CLOSING_GPIO, .pin = LED_CLOSING_PIN, .p_timer = LED_CLOSING_TIMER, .timer_blink_semi_period_ms = LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS, .timer_blink_psc_arr = TIMER_PSC_ARR_CONST(PORT_SYSTEM_HSI_CLOCK_HZ, LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS), .p_wheel = LED_TIMER_WHEEL, .timer_channel = LED_CLOSING_TIMER_CHANNEL, .alternate = LED_CLOSING_ALTERNATE};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Callback of the software timer of the blinking. It runs in the ISR that advances the timing wheel and does what the ISR of the hardware timer does.
+ *
+ * @param p_arg Pointer to the LED structure.
+ */
+static void _led_blink_timer_callback(void *p_arg)
+{
+    port_led_toggle((port_led_hw_t *)p_arg);
+}
+
+/**
+ * @brief Sets the output compare mode of the channel of the timer wired to the LED.
+ *
+ * @param p_led Pointer to the LED structure.
+ * @param mode Output compare mode (OCxM), one of `LED_OC_MODE_*`.
+ */
+static void _led_set_output_compare_mode(port_led_hw_t *p_led, uint32_t mode)
+{
+    // Channels 1 and 3 are in the low byte of CCMR1 and CCMR2, channels 2 and 4 in the high byte
+    volatile uint32_t *p_ccmr = (p_led->timer_channel <= 2) ? &p_led->p_timer->CCMR1 : &p_led->p_timer->CCMR2;
+    uint32_t shift = ((p_led->timer_channel - 1U) % 2U) * 8U + TIM_CCMR1_OC1M_Pos;
+    *p_ccmr = (*p_ccmr & ~BASE_MASK_TO_POS(0x07U, shift)) | BASE_MASK_TO_POS(mode, shift);
+}
 
+/* Function definitions ------------------------------------------------------*/
 bool port_led_get_status(port_led_hw_t *p_led)
 {
     return (p_led->p_port->IDR & BIT_POS_TO_MASK(p_led->pin)) != 0;
@@ -24,23 +57,83 @@ bool port_led_get_status(port_led_hw_t *p_led)
 
 void port_led_on(port_led_hw_t *p_led)
 {
-    p_led->p_port->ODR |= BIT_POS_TO_MASK(p_led->pin);
+    if (p_led->timer_channel != 0)
+    {
+        // The pin is driven by the timer channel, not by ODR
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FORCE_ACTIVE);
+        return;
+    }
+    port_system_gpio_write(p_led->p_port, p_led->pin, HIGH);
 }
 
 void port_led_off(port_led_hw_t *p_led)
 {
-    p_led->p_port->ODR &= ~BIT_POS_TO_MASK(p_led->pin);
+    if (p_led->timer_channel != 0)
+    {
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FORCE_INACTIVE);
+        return;
+    }
+    port_system_gpio_write(p_led->p_port, p_led->pin, LOW);
 }
 
 void port_led_toggle(port_led_hw_t *p_led)
 {
-    p_led->p_port->ODR ^= BIT_POS_TO_MASK(p_led->pin);
+    if (p_led->timer_channel != 0)
+    {
+        _led_set_output_compare_mode(p_led, port_led_get_status(p_led) ? LED_OC_MODE_FORCE_INACTIVE : LED_OC_MODE_FORCE_ACTIVE);
+        return;
+    }
+    port_system_gpio_toggle(p_led->p_port, p_led->pin); // Atomic: the ISR of the other LED of the port may toggle it in between
+}
+
+void port_led_batch_init(port_led_batch_t *p_batch)
+{
+    port_system_gpio_batch_init(p_batch);
+}
+
+void port_led_batch_on(port_led_batch_t *p_batch, port_led_hw_t *p_led)
+{
+    if (p_led->timer_channel != 0)
+    {
+        // Nothing to batch: the level is forced in the timer channel
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FORCE_ACTIVE);
+        return;
+    }
+    port_system_gpio_batch_write(p_batch, p_led->p_port, p_led->pin, HIGH);
+}
+
+void port_led_batch_off(port_led_batch_t *p_batch, port_led_hw_t *p_led)
+{
+    if (p_led->timer_channel != 0)
+    {
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FORCE_INACTIVE);
+        return;
+    }
+    port_system_gpio_batch_write(p_batch, p_led->p_port, p_led->pin, LOW);
+}
+
+void port_led_batch_commit(port_led_batch_t *p_batch)
+{
+    port_system_gpio_batch_commit(p_batch);
 }
 
 void port_led_timer_setup(port_led_hw_t *p_led)
 {
+    if (p_led->p_wheel != NULL)
+    {
+        port_system_enter_critical();
+        timer_wheel_cancel(p_led->p_wheel, &p_led->timer_wheel_blink); // In case the LED is set up again while blinking
+        timer_wheel_timer_init(&p_led->timer_wheel_blink, _led_blink_timer_callback, p_led);
+        port_system_exit_critical();
+        return;
+    }
+
     // Enable the peripheral clock
-    if (p_led->p_timer == TIM3)
+    if (p_led->p_timer == TIM2)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+    }
+    else if (p_led->p_timer == TIM3)
     {
         RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
     }
@@ -59,23 +152,26 @@ void port_led_timer_setup(port_led_hw_t *p_led)
     p_led->p_timer->CNT = 0;
 
     // Set the timeout value
-    // Compute ARR and PSC to match the duration in milliseconds. Check if the duration is too long and adapt prescaler and ARR
-    double sec = (double)p_led->timer_blink_semi_period_ms / 1000.0;
-    double scc = (double)SystemCoreClock;
-    double psc = round(((scc * sec) / (65535.0 + 1.0)) - 1.0);
-    double arr = round(((scc * sec) / (psc + 1.0)) - 1.0);
+    // ARR and PSC of the semi-period are constants: a blink does not need the exact period that the solver searches for the motor timeout
+    timer_psc_arr_t psc_arr = p_led->timer_blink_psc_arr;
 
-    // Adjust psc and arr if necessary
-    if (arr > 0xFFFF)
+    // Load the values
+    p_led->p_timer->ARR = psc_arr.arr;
+    p_led->p_timer->PSC = psc_arr.psc;
+
+    if (p_led->timer_channel != 0)
     {
-        psc += 1.0;
-        arr = round((scc * sec) / (psc + 1.0) - 1.0);
+        // Toggle on compare: the channel toggles the pin when the counter reaches ARR, i.e. at the end of every semi-period, with no interrupt.
+        // The pin starts low, as a GPIO output after reset
+        (&p_led->p_timer->CCR1)[p_led->timer_channel - 1U] = psc_arr.arr;
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FORCE_INACTIVE);
+        p_led->p_timer->CCER &= ~BIT_POS_TO_MASK(4U * (p_led->timer_channel - 1U) + 1U); // Active high (CCxP = 0)
+        p_led->p_timer->CCER |= BIT_POS_TO_MASK(4U * (p_led->timer_channel - 1U));       // Output enabled (CCxE = 1)
+        p_led->p_timer->EGR |= TIM_EGR_UG;                                                // Load PSC and ARR
+        p_led->p_timer->SR &= ~TIM_SR_UIF;
+        return;
     }
 
-    // Load the values
-    p_led->p_timer->ARR = (uint32_t)(round(arr));
-    p_led->p_timer->PSC = (uint32_t)(round(psc));
-
     // Clean interrupt flags
     p_led->p_timer->SR &= ~TIM_SR_UIF;
 
@@ -98,6 +194,24 @@ void port_led_timer_setup(port_led_hw_t *p_led)
 
 void port_led_timer_activate(port_led_hw_t *p_led)
 {
+    if (p_led->p_wheel != NULL)
+    {
+        // Toggle every semi-period from now on, as the hardware timer after the update event. The SysTick ISR must not see the wheel halfway
+        port_system_enter_critical();
+        timer_wheel_arm(p_led->p_wheel, &p_led->timer_wheel_blink, p_led->timer_blink_semi_period_ms, p_led->timer_blink_semi_period_ms);
+        port_system_exit_critical();
+        return;
+    }
+
+    if (p_led->timer_channel != 0)
+    {
+        // The first toggle comes a whole semi-period after the activation, as with the update interrupt
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_TOGGLE);
+        p_led->p_timer->EGR |= TIM_EGR_UG; // Restart the count
+        p_led->p_timer->CR1 |= TIM_CR1_CEN;
+        return;
+    }
+
     // Enable the timer
     p_led->p_timer->CR1 |= TIM_CR1_CEN;
 
@@ -108,12 +222,32 @@ void port_led_timer_activate(port_led_hw_t *p_led)
 
 void port_led_timer_deactivate(port_led_hw_t *p_led)
 {
+    if (p_led->p_wheel != NULL)
+    {
+        port_system_enter_critical();
+        timer_wheel_cancel(p_led->p_wheel, &p_led->timer_wheel_blink);
+        port_system_exit_critical();
+        return;
+    }
+
     // Disable the timer
     p_led->p_timer->CR1 &= ~TIM_CR1_CEN;
+    if (p_led->timer_channel != 0)
+    {
+        _led_set_output_compare_mode(p_led, LED_OC_MODE_FROZEN); // The LED keeps its current level
+    }
 }
 
 void port_led_init(port_led_hw_t *p_led)
 {
+    if (p_led->timer_channel != 0)
+    {
+        // The channel is set up (and forced low) before it drives the pin
+        port_led_timer_setup(p_led);
+        port_system_gpio_config(p_led->p_port, p_led->pin, GPIO_MODE_ALTERNATE, GPIO_PUPDR_NOPULL);
+        port_system_gpio_config_alternate(p_led->p_port, p_led->pin, p_led->alternate);
+        return;
+    }
     port_system_gpio_config(p_led->p_port, p_led->pin, GPIO_MODE_OUT, GPIO_PUPDR_NOPULL);
     port_led_timer_setup(p_led);
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file port_log.c
+ * @author agent (agent@local)
+ * @brief Port layer of the log output (`printf`) through a UART drained with DMA.
+ * @date 2026-10-17
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "port_log.h"
+
+#if defined(PORT_LOG_UART)
+/* Global variables -----------------------------------------------------------*/
+port_log_hw_t log_uart = {.p_uart = LOG_UART_USART, .p_port = LOG_UART_GPIO, .pin = LOG_UART_PIN, .alternate = LOG_UART_ALTERNATE, .p_dma_stream = LOG_UART_DMA_STREAM, .dma_channel = LOG_UART_DMA_CHANNEL, .dma_len = 0};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Starts a DMA transfer with the oldest contiguous bytes of the ring, if there is any. The DMA must be idle.
+ *
+ * @param p_log Pointer to the log structure.
+ */
+static void _log_dma_start(port_log_hw_t *p_log)
+{
+    const uint8_t *p_data;
+    uint32_t len = log_ring_peek(&p_log->ring, &p_data);
+    p_log->dma_len = len;
+    if (len == 0)
+    {
+        return;
+    }
+
+    // Clear the flags of stream 6 and program the transfer: memory to peripheral, incrementing the memory address
+    DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+    p_log->p_dma_stream->M0AR = (uint32_t)(uintptr_t)p_data;
+    p_log->p_dma_stream->NDTR = len;
+    p_log->p_dma_stream->CR |= DMA_SxCR_EN;
+}
+
+/* Function definitions ------------------------------------------------------*/
+void port_log_init(port_log_hw_t *p_log)
+{
+    log_ring_init(&p_log->ring);
+    p_log->dma_len = 0;
+
+    // TX pin
+    port_system_gpio_config(p_log->p_port, p_log->pin, GPIO_MODE_ALTERNATE, GPIO_PUPDR_NOPULL);
+    port_system_gpio_config_alternate(p_log->p_port, p_log->pin, p_log->alternate);
+
+    // Enable the peripheral clocks
+    RCC->APB1ENR |= RCC_APB1ENR_USART2EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+    // UART: 8N1, TX only, with the requests of the DMA. The APB1 clock is the system clock
+    p_log->p_uart->CR1 = 0;
+    p_log->p_uart->BRR = (SystemCoreClock + LOG_UART_BAUD_RATE / 2U) / LOG_UART_BAUD_RATE;
+    p_log->p_uart->CR3 = USART_CR3_DMAT;
+    p_log->p_uart->CR1 = USART_CR1_UE | USART_CR1_TE;
+
+    // DMA stream: the address of the data register of the UART is fixed, the interrupt at the end of every transfer
+    p_log->p_dma_stream->CR &= ~DMA_SxCR_EN;
+    while (p_log->p_dma_stream->CR & DMA_SxCR_EN)
+    {
+    }
+    p_log->p_dma_stream->PAR = (uint32_t)(uintptr_t)&p_log->p_uart->DR;
+    p_log->p_dma_stream->CR = ((uint32_t)p_log->dma_channel << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_TCIE;
+    p_log->p_dma_stream->FCR = 0; // Direct mode
+
+    // Lowest priority but the sleep timer: the log can wait for anything else
+    NVIC_SetPriority(DMA1_Stream6_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 14, 0)); /* Priority 14, sub-priority 0 */
+    NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+}
+
+bool port_log_try_write(port_log_hw_t *p_log, const void *p_data, uint32_t len)
+{
+    bool queued = log_ring_write(&p_log->ring, p_data, len);
+
+    // Start the DMA if it is idle. The ISR of the end of a transfer also starts it: it must not see it halfway
+    port_system_enter_critical();
+    if (p_log->dma_len == 0)
+    {
+        _log_dma_start(p_log);
+    }
+    port_system_exit_critical();
+    return queued;
+}
+
+int port_log_write(port_log_hw_t *p_log, const char *p_data, int len)
+{
+    if (len <= 0)
+    {
+        return 0;
+    }
+    port_log_try_write(p_log, p_data, (uint32_t)len);
+    return len;
+}
+
+void port_log_dma_complete(port_log_hw_t *p_log)
+{
+    log_ring_consume(&p_log->ring, p_log->dma_len);
+    _log_dma_start(p_log);
+}
+
+uint32_t port_log_get_lost(port_log_hw_t *p_log)
+{
+    return log_ring_get_lost(&p_log->ring);
+}
+#endif /* PORT_LOG_UART */
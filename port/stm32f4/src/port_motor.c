@@ -9,15 +9,29 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdlib.h>
-#include <math.h>
 
 /* Project includes */
 #include "port_motor.h"
+#include "timer_psc_arr.h"
 
 /* Global variables -----------------------------------------------------------*/
-port_motor_hw_t motor_automatic_door = {.p_port = MOTOR_AUTOMATIC_DOOR_GPIO, .pin = MOTOR_AUTOMATIC_DOOR_PIN, .p_timer_timeout = MOTOR_AUTOMATIC_DOOR_TIMEOUT_TIMER, .timeout = false};
+static motor_profile_t motor_profile_automatic_door; /*!< Speed profile of the motor of the automatic door */
+
+port_motor_hw_t motor_automatic_door = {.p_port = MOTOR_AUTOMATIC_DOOR_GPIO, .pin = MOTOR_AUTOMATIC_DOOR_PIN, .p_timer_timeout = MOTOR_AUTOMATIC_DOOR_TIMEOUT_TIMER, .timeout = false, .p_wheel = MOTOR_AUTOMATIC_DOOR_TIMEOUT_WHEEL, .p_event_queue = &event_queue_automatic_door, .p_timer_pwm = MOTOR_AUTOMATIC_DOOR_PWM_TIMER, .p_port_pwm = MOTOR_AUTOMATIC_DOOR_PWM_GPIO, .pin_pwm = MOTOR_AUTOMATIC_DOOR_PWM_PIN, .alternate_pwm = MOTOR_AUTOMATIC_DOOR_PWM_ALTERNATE, .p_profile = &motor_profile_automatic_door};
 
 /* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Callback of the software timer of the timeout. It runs in the ISR that advances the timing wheel and does what the ISR of the hardware timer does.
+ *
+ * @param p_arg Pointer to the motor structure.
+ */
+static void _motor_timeout_timer_callback(void *p_arg)
+{
+    port_motor_hw_t *p_motor = (port_motor_hw_t *)p_arg;
+    p_motor->timeout = true; // The one-shot timer is no longer pending: it does not interrupt again
+    event_queue_push(p_motor->p_event_queue, EVENT_MOTOR_TIMEOUT);
+}
+
 
 /**
  * @brief Initializes the timer for the timeout of the motor.
@@ -26,11 +40,24 @@ port_motor_hw_t motor_automatic_door = {.p_port = MOTOR_AUTOMATIC_DOOR_GPIO, .pi
  */
 static void _motor_timeout_timer_init(port_motor_hw_t *p_motor)
 {
+    if (p_motor->p_wheel != NULL)
+    {
+        port_system_enter_critical();
+        timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout); // In case the motor is initialized again with the timer pending
+        timer_wheel_timer_init(&p_motor->timer_wheel_timeout, _motor_timeout_timer_callback, p_motor);
+        port_system_exit_critical();
+        return;
+    }
+
     // Enable the peripheral clock
     if (p_motor->p_timer_timeout == TIM2)
     {
         RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
     }
+    else if (p_motor->p_timer_timeout == TIM4)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;
+    }
 
     // Disable the timer
     p_motor->p_timer_timeout->CR1 &= ~TIM_CR1_CEN;
@@ -41,6 +68,7 @@ static void _motor_timeout_timer_init(port_motor_hw_t *p_motor)
     // Set the prescaler and the auto-reload register with any value
     p_motor->p_timer_timeout->PSC = 0;
     p_motor->p_timer_timeout->ARR = 0xFFFF;
+    p_motor->timer_period_ms = 0;
 
     // Clean interrupt flags
     p_motor->p_timer_timeout->SR = 0;
@@ -51,14 +79,188 @@ static void _motor_timeout_timer_init(port_motor_hw_t *p_motor)
         NVIC_SetPriority(TIM2_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 2, 0)); /* Priority 2, sub-priority 0 */
         NVIC_EnableIRQ(TIM2_IRQn);
     }
+    else if (p_motor->p_timer_timeout == TIM4)
+    {
+        // Enable the interrupt in the NVIC
+        NVIC_SetPriority(TIM4_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 2, 0)); /* Priority 2, sub-priority 0 */
+        NVIC_EnableIRQ(TIM4_IRQn);
+    }
+}
+
+/**
+ * @brief Initializes the GPIOs of the motor, its PWM timer and its speed profile. The PWM runs from now on with a duty of 0.
+ *
+ * @param p_motor Pointer to the motor structure.
+ */
+static void _motor_pwm_init(port_motor_hw_t *p_motor)
+{
+    // The table of duties is computed here once: the update ISR only indexes it. A door created again keeps it unless the clock has changed
+    uint32_t full_scale = SystemCoreClock / MOTOR_AUTOMATIC_DOOR_PWM_FREQUENCY_HZ;
+    if ((p_motor->p_profile->steps == 0) || (p_motor->p_profile->full_scale != full_scale))
+    {
+        motor_profile_build(p_motor->p_profile, MOTOR_AUTOMATIC_DOOR_PROFILE_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS, full_scale);
+    }
+    p_motor->profile_step = 0;
+
+    // The door is closed at reset
+    p_motor->travel = (uint32_t)(motor_profile_get_travel(p_motor->p_profile, p_motor->p_profile->steps) / MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS);
+    p_motor->position = 0;
+    p_motor->direction_open = false;
+    p_motor->profile_scale = 1U << MOTOR_PROFILE_SCALE_BITS;
+
+    // Direction and PWM pins
+    port_system_gpio_config(p_motor->p_port, p_motor->pin, GPIO_MODE_OUT, GPIO_PUPDR_NOPULL);
+    port_system_gpio_write(p_motor->p_port, p_motor->pin, LOW);
+    port_system_gpio_config(p_motor->p_port_pwm, p_motor->pin_pwm, GPIO_MODE_ALTERNATE, GPIO_PUPDR_NOPULL);
+    port_system_gpio_config_alternate(p_motor->p_port_pwm, p_motor->pin_pwm, p_motor->alternate_pwm);
+
+    // Enable the peripheral clock
+    RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+
+    // Disable the timer
+    p_motor->p_timer_pwm->CR1 &= ~TIM_CR1_CEN;
+    p_motor->p_timer_pwm->CR1 |= TIM_CR1_ARPE;
+
+    // PWM period at full clock, and an update event every step of the profile (RCR + 1 periods)
+    p_motor->p_timer_pwm->PSC = 0;
+    p_motor->p_timer_pwm->ARR = full_scale - 1;
+    p_motor->p_timer_pwm->RCR = (MOTOR_AUTOMATIC_DOOR_PWM_FREQUENCY_HZ / 1000U) * MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS - 1U;
+
+    // Channel 1 in PWM mode 1 with preload: a new duty takes effect at the next update event
+    p_motor->p_timer_pwm->CCMR1 = (p_motor->p_timer_pwm->CCMR1 & ~(TIM_CCMR1_OC1M | TIM_CCMR1_CC1S)) | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE;
+    p_motor->p_timer_pwm->CCR1 = 0;
+    p_motor->p_timer_pwm->CCER &= ~TIM_CCER_CC1P; // Active high
+    p_motor->p_timer_pwm->CCER |= TIM_CCER_CC1E;  // Output enabled
+    p_motor->p_timer_pwm->BDTR |= TIM_BDTR_MOE;   // Main output enable of the advanced timer
+
+    // Update events only on overflow of the repetition counter, and not from the UG bit
+    p_motor->p_timer_pwm->CR1 |= TIM_CR1_URS;
+    p_motor->p_timer_pwm->EGR |= TIM_EGR_UG; // Load the prescaler, ARR, RCR and CCR1
+    p_motor->p_timer_pwm->SR = 0;
+    p_motor->p_timer_pwm->CR1 |= TIM_CR1_CEN;
+
+    // Enable the interrupt in the NVIC. The update interrupt of the timer is only enabled while a profile is in course
+    NVIC_SetPriority(TIM1_UP_TIM10_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 2, 0)); /* Priority 2, sub-priority 0 */
+    NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+}
+
+/**
+ * @brief Gets the duty of a step of the profile, scaled to the travel of the movement in course.
+ *
+ * @param p_motor Pointer to the motor structure.
+ * @param step Step of the profile.
+ * @return uint32_t Duty of the step, in counts of the PWM timer.
+ */
+static inline uint32_t _motor_duty(port_motor_hw_t *p_motor, uint32_t step)
+{
+    return ((uint32_t)p_motor->p_profile->duty[step] * p_motor->profile_scale) >> MOTOR_PROFILE_SCALE_BITS;
 }
 
 /* Function definitions ------------------------------------------------------*/
-// TO-DO: Implement the functions related to the PWM of the motor
+void port_motor_move(port_motor_hw_t *p_motor, bool open)
+{
+    if ((p_motor->p_timer_pwm == NULL) || (p_motor->p_profile->steps == 0))
+    {
+        return;
+    }
+    p_motor->p_timer_pwm->DIER &= ~TIM_DIER_UIE;
+    port_system_gpio_write(p_motor->p_port, p_motor->pin, open);
+    p_motor->direction_open = open;
+
+    // The whole profile is scaled to the travel left, so that after a reversal the door still decelerates where the travel ends instead of reaching the end stop at cruise speed
+    uint32_t left = open ? p_motor->travel - p_motor->position : p_motor->position;
+    if (left == 0)
+    {
+        // Already there: nothing to move, the timeout ends the movement
+        port_motor_stop(p_motor);
+        return;
+    }
+    p_motor->profile_scale = (uint32_t)(((uint64_t)left << MOTOR_PROFILE_SCALE_BITS) / p_motor->travel);
+
+    // The first duty is applied at once, and the second one waits in the preload for the end of the first step
+    p_motor->p_timer_pwm->CCR1 = _motor_duty(p_motor, 0);
+    p_motor->p_timer_pwm->EGR |= TIM_EGR_UG; // Restart the counters and load CCR1
+    p_motor->profile_step = 1;
+    p_motor->p_timer_pwm->CCR1 = (p_motor->p_profile->steps > 1) ? _motor_duty(p_motor, 1) : 0;
+
+    p_motor->p_timer_pwm->SR &= ~TIM_SR_UIF; // Clear the update interrupt flag
+    p_motor->p_timer_pwm->DIER |= TIM_DIER_UIE;
+}
+
+void port_motor_stop(port_motor_hw_t *p_motor)
+{
+    if (p_motor->p_timer_pwm == NULL)
+    {
+        return;
+    }
+    p_motor->p_timer_pwm->DIER &= ~TIM_DIER_UIE;
+    p_motor->p_timer_pwm->CCR1 = 0;
+    p_motor->p_timer_pwm->EGR |= TIM_EGR_UG; // Apply the duty of 0 now, not at the end of the step
+    p_motor->profile_step = p_motor->p_profile->steps;
+}
+
+void port_motor_pwm_update(port_motor_hw_t *p_motor)
+{
+    // Dead reckoning: the step that has just ended has moved the door by its duty
+    uint32_t done = (p_motor->profile_step - 1U < p_motor->p_profile->steps) ? _motor_duty(p_motor, p_motor->profile_step - 1U) : 0U;
+    if (p_motor->direction_open)
+    {
+        p_motor->position = (p_motor->travel - p_motor->position > done) ? p_motor->position + done : p_motor->travel;
+    }
+    else
+    {
+        p_motor->position = (p_motor->position > done) ? p_motor->position - done : 0U;
+    }
+
+    // An index, a multiplication and a store, whatever the step: the profile has been computed by port_motor_init()
+    uint32_t step = ++p_motor->profile_step;
+    if (step < p_motor->p_profile->steps)
+    {
+        p_motor->p_timer_pwm->CCR1 = _motor_duty(p_motor, step);
+    }
+    else if (step == p_motor->p_profile->steps)
+    {
+        // The last step runs with the duty already loaded: its end is still counted
+        p_motor->p_timer_pwm->CCR1 = 0;
+    }
+    else
+    {
+        // The motor stops at the end of the last step. The profile was scaled to the travel left: the door is at its end, which drops the rounding of the count
+        p_motor->p_timer_pwm->CCR1 = 0;
+        p_motor->p_timer_pwm->DIER &= ~TIM_DIER_UIE;
+        p_motor->position = p_motor->direction_open ? p_motor->travel : 0U;
+    }
+}
+
+bool port_motor_has_position(port_motor_hw_t *p_motor)
+{
+    // The dead reckoning is not feedback: it cannot tell a blocked leaf from a moving one. There is no encoder nor end switch on this board
+    return false;
+}
+
+uint32_t port_motor_get_position(port_motor_hw_t *p_motor)
+{
+    if ((p_motor->p_timer_pwm == NULL) || (p_motor->travel == 0))
+    {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)p_motor->position * MOTOR_POSITION_OPEN) / p_motor->travel);
+}
+
+bool port_motor_is_at_end_of_travel(port_motor_hw_t *p_motor)
+{
+    return port_motor_has_position(p_motor) && (p_motor->position == (p_motor->direction_open ? p_motor->travel : 0U));
+}
 
 void port_motor_set_timeout_status(port_motor_hw_t *p_motor, bool timeout)
 {
-    if (timeout)
+    if (timeout && (p_motor->p_wheel != NULL))
+    {
+        port_system_enter_critical();
+        timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout);
+        port_system_exit_critical();
+    }
+    else if (timeout)
     {
         p_motor->p_timer_timeout->DIER &= ~TIM_DIER_UIE; // Disable the timer so that it does not interrupt again
     }
@@ -67,6 +269,16 @@ void port_motor_set_timeout_status(port_motor_hw_t *p_motor, bool timeout)
 
 void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeout_ms)
 {
+    if (p_motor->p_wheel != NULL)
+    {
+        // Re-arming is O(1): the timer is moved to the slot of the new expiry. The SysTick ISR must not see the wheel halfway
+        port_system_enter_critical();
+        p_motor->timeout = false;
+        timer_wheel_arm(p_motor->p_wheel, &p_motor->timer_wheel_timeout, timeout_ms, 0);
+        port_system_exit_critical();
+        return;
+    }
+
     // Disable the timer
     p_motor->p_timer_timeout->CR1 &= ~TIM_CR1_CEN;
 
@@ -76,22 +288,18 @@ void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeou
     p_motor->p_timer_timeout->CNT = 0;
     
     // Set the timeout value
-    // Compute ARR and PSC to match the duration in milliseconds. Check if the duration is too long and adapt prescaler and ARR
-    double sec = (double)timeout_ms / 1000.0;
-    double scc = (double)SystemCoreClock;
-    double psc = round(((scc * sec) / (65535.0 + 1.0)) - 1.0);
-    double arr = round(((scc * sec) / (psc + 1.0)) - 1.0);
-
-    // Adjust psc and arr if necessary
-    if (arr > 0xFFFF)
+    // Compute ARR and PSC to match the duration in milliseconds (integer solver, no floating point). The door re-arms the
+    // timer with the same timeout on every fire while someone stands in the doorway: then the registers already hold them
+    if (timeout_ms != p_motor->timer_period_ms)
     {
-        psc += 1.0;
-        arr = round((scc * sec) / (psc + 1.0) - 1.0);
-    }
+        timer_psc_arr_t psc_arr;
+        timer_psc_arr_solve(SystemCoreClock, timeout_ms, &psc_arr);
 
-    // Load the values
-    p_motor->p_timer_timeout->ARR = (uint32_t)(round(arr));
-    p_motor->p_timer_timeout->PSC = (uint32_t)(round(psc));
+        // Load the values
+        p_motor->p_timer_timeout->ARR = psc_arr.arr;
+        p_motor->p_timer_timeout->PSC = psc_arr.psc;
+        p_motor->timer_period_ms = timeout_ms;
+    }
 
     // Enable the timer
     p_motor->p_timer_timeout->CR1 |= TIM_CR1_CEN;
@@ -116,17 +324,25 @@ void port_motor_timeout_timer_activate(port_motor_hw_t *p_motor, uint32_t timeou
 
 void port_motor_timeout_timer_deactivate(port_motor_hw_t *p_motor)
 {
+    if (p_motor->p_wheel != NULL)
+    {
+        port_system_enter_critical();
+        timer_wheel_cancel(p_motor->p_wheel, &p_motor->timer_wheel_timeout);
+        port_system_exit_critical();
+        return;
+    }
+
     // Disable the timer
     p_motor->p_timer_timeout->CR1 &= ~TIM_CR1_CEN;
 }
 
 void port_motor_init(port_motor_hw_t *p_motor)
 {
-    // Initialize the GPIO if the motor is connected to the Nucleo board
-    // TO-DO: Implement the initialization of the GPIO
-
-    // Initialize the PWM if the motor is connected to the Nucleo board
-    // TO-DO: Implement the initialization of the PWM
+    // Initialize the GPIOs and the PWM if the motor is connected to the Nucleo board
+    if (p_motor->p_timer_pwm != NULL)
+    {
+        _motor_pwm_init(p_motor);
+    }
 
     // Initialize the timeout timer
     _motor_timeout_timer_init(p_motor);
@@ -16,7 +16,7 @@
 #include "port_system.h"
 
 /* Global variables -----------------------------------------------------------*/
-port_pir_hw_t pir_sensor_automatic_door = {.p_port = PIR_SENSOR_AUTOMATIC_DOOR_GPIO, .pin = PIR_SENSOR_AUTOMATIC_DOOR_PIN, .sensor_status = false, .last_time_presence_or_button = 0};
+port_pir_hw_t pir_sensor_automatic_door = {.p_port = PIR_SENSOR_AUTOMATIC_DOOR_GPIO, .pin = PIR_SENSOR_AUTOMATIC_DOOR_PIN, .sensor_status = false, .last_time_presence_or_button = 0, .filter = {.min_high_ms = PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS, .hold_ms = PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS}};
 
 /* Function definitions ------------------------------------------------------*/
 bool port_pir_sensor_get_status(port_pir_hw_t* p_pir)
@@ -29,6 +29,11 @@ void port_pir_sensor_set_status(port_pir_hw_t* p_pir, bool status)
     p_pir->sensor_status = status;
 }
 
+bool port_pir_sensor_is_filter_pending(port_pir_hw_t *p_pir)
+{
+    return pir_filter_is_pending(&p_pir->filter);
+}
+
 bool port_pir_sensor_read_gpio(port_pir_hw_t *p_pir)
 {    
     return (p_pir->p_port->IDR & BIT_POS_TO_MASK(p_pir->pin));
@@ -39,6 +44,7 @@ void port_pir_sensor_init(port_pir_hw_t* p_pir)
     // Initialize the GPIO
     port_system_gpio_config(p_pir->p_port, p_pir->pin, GPIO_MODE_IN, GPIO_PUPDR_NOPULL);
     port_system_gpio_config_exti(p_pir->p_port, p_pir->pin, TRIGGER_BOTH_EDGE | TRIGGER_ENABLE_INTERR_REQ);
+    pir_filter_init(&p_pir->filter, p_pir->filter.min_high_ms, p_pir->filter.hold_ms, port_pir_sensor_read_gpio(p_pir));
     
     port_system_gpio_exti_enable(p_pir->pin, 1, 0);
 }
\ No newline at end of file
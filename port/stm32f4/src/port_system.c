@@ -7,12 +7,20 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "port_system.h"
+#if defined(PORT_LOG_UART)
+#include "port_log.h"
+#endif
 
 /* Defines -------------------------------------------------------------------*/
-#define HSI_VALUE ((uint32_t)16000000) /*!< Value of the Internal oscillator in Hz */
+#define HSI_VALUE ((uint32_t)PORT_SYSTEM_HSI_CLOCK_HZ) /*!< Value of the Internal oscillator in Hz */
 
 /* GLOBAL VARIABLES */
 static volatile uint32_t msTicks = 0; /*!< Variable to store millisecond ticks. @warning **It must be declared volatile!** Just because it is modified in an ISR. **Add it to the definition** after *static*. */
+static uint64_t sleep_ticks = 0;            /*!< Total time spent asleep, in ticks of `SLEEP_TIMER` */
+static uint32_t tickless_ticks_pending = 0; /*!< Ticks slept with the System tick suspended that do not make a whole millisecond yet */
+#if defined(PORT_TIMER_WHEEL)
+timer_wheel_t timer_wheel_system; /*!< Empty at time 0 (zero-initialized) */
+#endif
 
 /* These variables are declared extern in CMSIS (system_stm32f4xx.h) */
 uint32_t SystemCoreClock = HSI_VALUE;                                               /*!< Frequency of the System clock */
@@ -86,6 +94,30 @@ void system_clock_config(void)
   SysTick_Config(SystemCoreClock / (1000U / TICK_FREQ_1KHZ)); /* Set Systick to 1 ms */
 }
 
+/**
+ * @brief Starts `SLEEP_TIMER` as a free-running 32-bit counter at `SLEEP_TIMER_FREQ_HZ`.
+ *
+ * The update interrupt is enabled only to wake up the core when the counter wraps around, so that a single sleep is never longer than a full lap of the counter.
+ */
+static void _sleep_timer_init(void)
+{
+  RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+
+  SLEEP_TIMER->CR1 &= ~TIM_CR1_CEN;
+  SLEEP_TIMER->PSC = (SystemCoreClock / SLEEP_TIMER_FREQ_HZ) - 1;
+  SLEEP_TIMER->ARR = 0xFFFFFFFF;
+  SLEEP_TIMER->CNT = 0;
+  SLEEP_TIMER->EGR |= TIM_EGR_UG; // Load the prescaler
+  SLEEP_TIMER->SR &= ~TIM_SR_UIF;
+  SLEEP_TIMER->CR1 |= TIM_CR1_URS; // Only the overflow sets the update flag
+  SLEEP_TIMER->DIER |= TIM_DIER_UIE;
+
+  NVIC_SetPriority(TIM5_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 15, 0)); /* Lowest priority: it only wakes the core up */
+  NVIC_EnableIRQ(TIM5_IRQn);
+
+  SLEEP_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
 size_t port_system_init()
 {
   /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
@@ -116,6 +148,14 @@ size_t port_system_init()
   /* Configure the system clock */
   system_clock_config();
 
+  /* Start the timer that measures the time asleep */
+  _sleep_timer_init();
+
+#if defined(PORT_LOG_UART)
+  /* Log output (printf) through the UART with DMA */
+  port_log_init(&log_uart);
+#endif
+
   return 0;
 }
 
@@ -152,6 +192,23 @@ void port_system_delay_until_ms(uint32_t *p_t, uint32_t ms)
   *p_t = port_system_get_millis();
 }
 
+void port_system_cycle_counter_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; /* Enable the DWT */
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t port_system_get_cycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+uint32_t port_system_get_cycles_per_us(void)
+{
+  return SystemCoreClock / 1000000U;
+}
+
 //------------------------------------------------------
 // GPIO RELATED FUNCTIONS
 //------------------------------------------------------
@@ -255,6 +312,112 @@ void port_system_gpio_config_alternate(GPIO_TypeDef *p_port, uint8_t pin, uint8_
   p_port->AFR[(uint8_t)(pin / 8)] |= (alternate << displacement);
 }
 
+void port_system_gpio_write(GPIO_TypeDef *p_port, uint8_t pin, bool value)
+{
+  p_port->BSRR = value ? GPIO_BSRR_SET(pin) : GPIO_BSRR_RESET(pin);
+}
+
+void port_system_gpio_toggle(GPIO_TypeDef *p_port, uint8_t pin)
+{
+  p_port->BSRR = (p_port->ODR & GPIO_BSRR_SET(pin)) ? GPIO_BSRR_RESET(pin) : GPIO_BSRR_SET(pin);
+}
+
+void port_system_gpio_batch_init(port_system_gpio_batch_t *p_batch)
+{
+  p_batch->num_ports = 0;
+}
+
+void port_system_gpio_batch_write(port_system_gpio_batch_t *p_batch, GPIO_TypeDef *p_port, uint8_t pin, bool value)
+{
+  uint32_t bits = value ? GPIO_BSRR_SET(pin) : GPIO_BSRR_RESET(pin);
+  for (uint8_t i = 0; i < p_batch->num_ports; i++)
+  {
+    if (p_batch->p_ports[i] == p_port)
+    {
+      p_batch->bsrr[i] = (p_batch->bsrr[i] & ~(GPIO_BSRR_SET(pin) | GPIO_BSRR_RESET(pin))) | bits;
+      return;
+    }
+  }
+  if (p_batch->num_ports == GPIO_BATCH_MAX_PORTS)
+  {
+    p_port->BSRR = bits; // No room for another port: write it now
+    return;
+  }
+  p_batch->p_ports[p_batch->num_ports] = p_port;
+  p_batch->bsrr[p_batch->num_ports] = bits;
+  p_batch->num_ports++;
+}
+
+void port_system_gpio_batch_commit(port_system_gpio_batch_t *p_batch)
+{
+  for (uint8_t i = 0; i < p_batch->num_ports; i++)
+  {
+    p_batch->p_ports[i]->BSRR = p_batch->bsrr[i];
+  }
+  p_batch->num_ports = 0;
+}
+
 // ------------------------------------------------------
 // POWER RELATED FUNCTIONS
-// ------------------------------------------------------
\ No newline at end of file
+// ------------------------------------------------------
+void port_system_enter_critical(void)
+{
+  __disable_irq();
+}
+
+void port_system_exit_critical(void)
+{
+  __enable_irq();
+}
+
+void port_system_systick_suspend(void)
+{
+  SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+}
+
+void port_system_systick_resume(void)
+{
+  SysTick->VAL = 0;
+  SysTick->CTRL |= (SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+}
+
+void port_system_power_sleep(void)
+{
+  uint32_t start = SLEEP_TIMER->CNT;
+
+  SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk; // Sleep mode (not stop mode): the peripherals keep running
+  __DSB();
+  __WFI();
+
+  sleep_ticks += SLEEP_TIMER->CNT - start;
+}
+
+void port_system_power_sleep_tickless(void)
+{
+  uint32_t start = SLEEP_TIMER->CNT;
+
+  port_system_systick_suspend();
+  SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+  __DSB();
+  __WFI();
+
+  // The interrupts are still masked: correct the system time before any ISR can read it
+  uint32_t elapsed = SLEEP_TIMER->CNT - start;
+  sleep_ticks += elapsed;
+
+  uint32_t ticks = tickless_ticks_pending + elapsed;
+  msTicks += ticks / SLEEP_TIMER_TICKS_PER_MS;
+  tickless_ticks_pending = ticks % SLEEP_TIMER_TICKS_PER_MS;
+
+  port_system_systick_resume();
+}
+
+uint32_t port_system_get_sleep_millis(void)
+{
+  return (uint32_t)(sleep_ticks / SLEEP_TIMER_TICKS_PER_MS);
+}
+
+uint32_t port_system_get_awake_millis(void)
+{
+  return port_system_get_millis() - port_system_get_sleep_millis();
+}
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include <sys/times.h>
 
 #include "stm32f4xx.h"
+#include "port_log.h"
 
 /* Variables */
 #undef errno
@@ -70,6 +71,8 @@ void _exit (int status)
 /**
  * @brief Function able to use printf via SWO:ITM. It prints the messages on a terminal in VSCode.
  *
+ * With `PORT_LOG_UART` the messages go to the virtual COM port of the ST-LINK instead: they are queued in the ring of `log_uart` and sent by the DMA in the background, so `printf` does not wait for the UART (see `port_log.h`).
+ *
  * @param file
  * @param ptr
  * @param len
@@ -77,14 +80,19 @@ void _exit (int status)
  */
 int _write(int file, char *ptr, int len)
 {
+#if defined(PORT_LOG_UART)
+    return port_log_write(&log_uart, ptr, len);
+#else
     int i = 0;
     for (i = 0; i < len; i++)
     {
         ITM_SendChar((*ptr++));
     }
     return len;
+#endif
 }
 
+#if !defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) || (FSM_AUTOMATIC_DOOR_POOL_SIZE == 0)
 caddr_t _sbrk(int incr)
 {
 	extern char end asm("end");
@@ -107,6 +115,7 @@ caddr_t _sbrk(int incr)
 
 	return (caddr_t) prev_heap_end;
 }
+#endif /* No heap with the static pool of automatic doors */
 
 int _close(int file)
 {
@@ -0,0 +1,289 @@
+/**
+ * @file bench_fsm.c
+ * @brief Microbenchmark of the automatic door: ns per `fsm_fire()` in each state with all the guards false and with each guard true, ns per action function and ns per `fsm_automatic_door_new()` (with its `fsm_automatic_door_delete()`).
+ *
+ * Each measurement is repeated `BENCH_REPEATS` times and the fastest one is kept, which filters most of the noise of the host. To fire a transition again and again, the state and the inputs are set before every fire; the cost of setting them is measured on its own and subtracted.
+ *
+ * The results are printed as JSON. With `--baseline <file>` they are compared with a previous run (the JSON written by `--output <file>`), and the program fails if any of them is more than `--margin <percent>` (default `BENCH_DEFAULT_MARGIN`) slower than in the baseline:
+ *
+ *     bench_fsm [--output <file>] [--baseline <file> [--margin <percent>]]
+ *
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fsm_automatic_door.h"
+#include "port_motor.h"
+#include "port_pir_sensor.h"
+
+#define BENCH_FIRES 1000000         /*!< Number of fires (or action calls) per measurement */
+#define BENCH_NEWS 100000           /*!< Number of doors created and destroyed per measurement */
+#define BENCH_REPEATS 5             /*!< Number of measurements of each benchmark; the fastest one is kept */
+#define BENCH_DEFAULT_MARGIN 100    /*!< Default margin of the comparison with the baseline, in percent */
+#define BENCH_MIN_REGRESSION_NS 1.0 /*!< Results slower than the baseline by less than this are never a regression, whatever the margin: it is below the resolution of the host */
+#define BENCH_MAX_RESULTS 32        /*!< Maximum number of results */
+#define BENCH_NAME_SIZE 48          /*!< Maximum length of the name of a result */
+
+/**
+ * @brief Inputs of the door for a benchmark of `fsm_fire()`.
+ */
+typedef struct
+{
+    const char *name; /*!< Name of the result */
+    int state;        /*!< State the door is in before the fire */
+    bool presence;    /*!< Status of the PIR sensor */
+    bool timeout;     /*!< Status of the motor timeout */
+} bench_fire_t;
+
+/**
+ * @brief Result of a benchmark.
+ */
+typedef struct
+{
+    char name[BENCH_NAME_SIZE]; /*!< Name of the result */
+    double ns;                  /*!< Time per operation */
+} bench_result_t;
+
+/**
+ * @brief Fires with no guard true (the common case in the main loop) and with the guard of each arc of `fsm_trans_automatic_door` true, in the order of the table.
+ */
+static const bench_fire_t bench_fires[] = {
+    {"fire_CLOSED_idle", CLOSED, false, false},
+    {"fire_OPENING_idle", OPENING, false, false},
+    {"fire_OPEN_idle", OPEN, false, false},
+    {"fire_CLOSING_idle", CLOSING, false, false},
+    {"fire_CLOSED_to_OPENING", CLOSED, true, false},
+    {"fire_OPENING_to_OPEN", OPENING, false, true},
+    {"fire_OPEN_to_OPEN", OPEN, true, false},
+    {"fire_OPEN_to_CLOSING", OPEN, false, true},
+    {"fire_CLOSING_to_OPENING", CLOSING, true, false},
+    {"fire_CLOSING_to_CLOSED", CLOSING, false, true},
+};
+
+/**
+ * @brief Names of the actions of the arcs of `fsm_trans_automatic_door`, in the order of the table.
+ */
+static const char *bench_actions[] = {"do_open_door", "do_stay_open", "do_keep_open", "do_close_door", "do_stop_closing_door", "do_stay_closed"};
+
+static bench_result_t bench_results[BENCH_MAX_RESULTS]; /*!< Results of the run */
+static uint32_t bench_num_results = 0;                  /*!< Number of results of the run */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void _add_result(const char *name, double ns)
+{
+    bench_result_t *p_result = &bench_results[bench_num_results++];
+    snprintf(p_result->name, sizeof(p_result->name), "%s", name);
+    p_result->ns = ns > 0.0 ? ns : 0.0;
+}
+
+/**
+ * @brief Measures the time per fire of `fsm_fire()` with the given state and inputs, set again before every fire.
+ *
+ * @param p_fsm Pointer to the door.
+ * @param p_bench Benchmark.
+ * @param fire Whether to fire the FSM: with false only the cost of setting the state and the inputs is measured.
+ * @return double Fastest time per iteration in ns.
+ */
+static double bench_fire(fsm_t *p_fsm, const bench_fire_t *p_bench, bool fire)
+{
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = now_ns();
+        for (uint32_t i = 0; i < BENCH_FIRES; i++)
+        {
+            fsm_set_state(p_fsm, p_bench->state);
+            port_pir_sensor_set_status(&pir_sensor_automatic_door, p_bench->presence);
+            port_motor_set_timeout_status(&motor_automatic_door, p_bench->timeout);
+            if (fire)
+            {
+                fsm_fire(p_fsm);
+            }
+        }
+        double ns = (now_ns() - t0) / BENCH_FIRES;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+/**
+ * @brief Measures the time per call of an action function.
+ *
+ * @param p_fsm Pointer to the door.
+ * @param action Action function.
+ * @return double Fastest time per call in ns.
+ */
+static double bench_action(fsm_t *p_fsm, fsm_output_func_t action)
+{
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = now_ns();
+        for (uint32_t i = 0; i < BENCH_FIRES; i++)
+        {
+            action(p_fsm);
+        }
+        double ns = (now_ns() - t0) / BENCH_FIRES;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+/**
+ * @brief Measures the time to create a door with `fsm_automatic_door_new()` and destroy it with `fsm_automatic_door_delete()`.
+ *
+ * @return double Fastest time per door in ns.
+ */
+static double bench_new(void)
+{
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = now_ns();
+        for (uint32_t i = 0; i < BENCH_NEWS; i++)
+        {
+            fsm_t *p_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+            fsm_automatic_door_delete(p_door);
+        }
+        double ns = (now_ns() - t0) / BENCH_NEWS;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+static void _print_json(FILE *p_file)
+{
+    fprintf(p_file, "{\n  \"benchmark\": \"bench_fsm\",\n  \"unit\": \"ns\",\n  \"results\": {\n");
+    for (uint32_t i = 0; i < bench_num_results; i++)
+    {
+        fprintf(p_file, "    \"%s\": %.3f%s\n", bench_results[i].name, bench_results[i].ns, i + 1 < bench_num_results ? "," : "");
+    }
+    fprintf(p_file, "  }\n}\n");
+}
+
+/**
+ * @brief Compares the results with a baseline written by `--output`. Only the `"name": value` lines of the results are read.
+ *
+ * @param path Path of the baseline.
+ * @param margin Margin in percent.
+ * @return int Number of regressions, or -1 if the baseline cannot be read.
+ */
+static int _check_baseline(const char *path, double margin)
+{
+    FILE *p_file = fopen(path, "r");
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "Cannot open the baseline %s\n", path);
+        return -1;
+    }
+
+    int regressions = 0;
+    uint32_t compared = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), p_file) != NULL)
+    {
+        char name[BENCH_NAME_SIZE];
+        double baseline_ns;
+        if (sscanf(line, " \"%47[^\"]\" : %lf", name, &baseline_ns) != 2)
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < bench_num_results; i++)
+        {
+            if (strcmp(name, bench_results[i].name) != 0)
+            {
+                continue;
+            }
+            double limit = baseline_ns * (1.0 + margin / 100.0);
+            bool regression = (bench_results[i].ns > limit) && (bench_results[i].ns - baseline_ns > BENCH_MIN_REGRESSION_NS);
+            if (regression)
+            {
+                fprintf(stderr, "Regression in %s: %.3f ns, baseline %.3f ns (limit %.3f ns)\n", name, bench_results[i].ns, baseline_ns, limit);
+                regressions++;
+            }
+            compared++;
+        }
+    }
+    fclose(p_file);
+
+    if (compared == 0)
+    {
+        fprintf(stderr, "No result of the baseline %s matches this run\n", path);
+        return -1;
+    }
+    fprintf(stderr, "%" PRIu32 " results compared with %s (margin %.0f %%): %d regressions\n", compared, path, margin, regressions);
+    return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *output = NULL;
+    const char *baseline = NULL;
+    double margin = BENCH_DEFAULT_MARGIN;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+        {
+            baseline = argv[++i];
+        }
+        else if (strcmp(argv[i], "--margin") == 0 && i + 1 < argc)
+        {
+            margin = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--output <file>] [--baseline <file> [--margin <percent>]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    port_system_init();
+    fsm_t *p_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+
+    // Cost of setting the state and the inputs before every fire (the same for all the fires)
+    double setup_ns = bench_fire(p_door, &bench_fires[0], false);
+    for (uint32_t b = 0; b < sizeof(bench_fires) / sizeof(bench_fires[0]); b++)
+    {
+        _add_result(bench_fires[b].name, bench_fire(p_door, &bench_fires[b], true) - setup_ns);
+    }
+    for (uint32_t a = 0; a < sizeof(bench_actions) / sizeof(bench_actions[0]); a++)
+    {
+        _add_result(bench_actions[a], bench_action(p_door, fsm_trans_automatic_door[a].out));
+    }
+    fsm_automatic_door_delete(p_door);
+    _add_result("fsm_automatic_door_new", bench_new());
+
+    _print_json(stdout);
+    if (output != NULL)
+    {
+        FILE *p_file = fopen(output, "w");
+        if (p_file == NULL)
+        {
+            fprintf(stderr, "Cannot write %s\n", output);
+            return 1;
+        }
+        _print_json(p_file);
+        fclose(p_file);
+    }
+
+    if (baseline != NULL)
+    {
+        return _check_baseline(baseline, margin) == 0 ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file bench_fsm_automatic_door_fleet.c
+ * @brief Benchmark of the fleet of automatic doors: doors advanced per second by `fsm_automatic_door_fleet_fire_all()` and memory per door.
+ *
+ * Usage: `bench_fsm_automatic_door_fleet [num_doors] [num_fires]`. Between two fires the virtual time advances 10 ms and the inputs of 1 % of the doors change randomly (not measured).
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "fsm_automatic_door_fleet.h"
+
+#define BENCH_DEFAULT_DOORS 100000 /*!< Default number of doors */
+#define BENCH_DEFAULT_FIRES 2000   /*!< Default number of fires of the whole fleet */
+#define BENCH_STEP_MS 10           /*!< Virtual time between two fires */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t num_doors = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_DOORS;
+    uint32_t num_fires = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_FIRES;
+
+    fsm_automatic_door_fleet_t *p_fleet = fsm_automatic_door_fleet_new(num_doors);
+    if (p_fleet == NULL)
+    {
+        printf("Not enough memory for %u doors\n", num_doors);
+        return 1;
+    }
+
+    uint32_t seed = 1;
+    uint64_t num_transitions = 0;
+    double t_fire = 0;
+    for (uint32_t fire = 0; fire < num_fires; fire++)
+    {
+        for (uint32_t i = 0; i < num_doors / 100; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            uint32_t door = (seed >> 8) % num_doors;
+            fsm_automatic_door_fleet_set_inputs(p_fleet, door, ((seed >> 4) & 0x07) == 0, ((seed >> 5) & 0x0F) == 0);
+        }
+
+        double t0 = now_ns();
+        num_transitions += fsm_automatic_door_fleet_fire_all(p_fleet, fire * BENCH_STEP_MS);
+        t_fire += now_ns() - t0;
+    }
+
+    uint32_t states[4] = {0};
+    for (uint32_t i = 0; i < num_doors; i++)
+    {
+        states[p_fleet->p_state[i]]++;
+    }
+
+    double door_fires = (double)num_doors * num_fires;
+    printf("{\"doors\": %u, \"fires\": %u, \"bytes_per_door\": %zu, \"ns_per_door\": %.3f, \"doors_per_second\": %.0f, \"transitions\": %llu, "
+           "\"final_states\": {\"CLOSED\": %u, \"OPENING\": %u, \"OPEN\": %u, \"CLOSING\": %u}}\n",
+           num_doors, num_fires, fsm_automatic_door_fleet_bytes_per_door(), t_fire / door_fires, door_fires / (t_fire / 1e9),
+           (unsigned long long)num_transitions, states[CLOSED], states[OPENING], states[OPEN], states[CLOSING]);
+
+    fsm_automatic_door_fleet_delete(p_fleet);
+    return 0;
+}
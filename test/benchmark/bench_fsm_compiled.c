@@ -0,0 +1,158 @@
+/**
+ * @file bench_fsm_compiled.c
+ * @brief Benchmark of the compiled fire function of the automatic door (`fsm_automatic_door_fire()`, see `fsm_compiled.h`) against the `fsm_trans_t` function-pointer table (`fsm_fire()` and `fsm_indexed_fire()`).
+ *
+ * Every fire is done with all the guards returning false, which is the common case in the main loop. The instructions per fire are counted with the hardware counters of Linux (`perf_event_open()`); if they are not available (other host, or no permission) only the time per fire is reported.
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "fsm_indexed.h"
+#include "fsm_automatic_door.h"
+
+#define BENCH_FIRES 10000000 /*!< Number of fires per measurement */
+
+/**
+ * @brief Dispatchers under test.
+ */
+enum BENCH_DISPATCHERS
+{
+    BENCH_STOCK = 0, /*!< `fsm_fire()` on the table */
+    BENCH_INDEXED,   /*!< `fsm_indexed_fire()` on the per-state index of the table */
+    BENCH_COMPILED,  /*!< `fsm_automatic_door_fire()` */
+    BENCH_NUM_DISPATCHERS
+};
+
+static const char *bench_names[BENCH_NUM_DISPATCHERS] = {"fsm_fire", "indexed", "compiled"};
+
+static fsm_indexed_t bench_index; /*!< Per-state index of the table of the automatic door */
+
+static int bench_counter_fd = -1; /*!< File descriptor of the instruction counter, -1 if not available */
+
+static void _counter_open(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    bench_counter_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void _counter_start(void)
+{
+#ifdef __linux__
+    if (bench_counter_fd >= 0)
+    {
+        ioctl(bench_counter_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(bench_counter_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static uint64_t _counter_stop(void)
+{
+    uint64_t count = 0;
+#ifdef __linux__
+    if (bench_counter_fd >= 0)
+    {
+        ioctl(bench_counter_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(bench_counter_fd, &count, sizeof(count)) != sizeof(count))
+        {
+            count = 0;
+        }
+    }
+#endif
+    return count;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void bench(fsm_t *p_fsm, int state, int dispatcher, double *p_ns, double *p_instructions)
+{
+    fsm_set_state(p_fsm, state);
+    double t0 = now_ns();
+    _counter_start();
+    switch (dispatcher)
+    {
+    case BENCH_STOCK:
+        for (uint32_t i = 0; i < BENCH_FIRES; i++)
+        {
+            fsm_fire(p_fsm);
+        }
+        break;
+    case BENCH_INDEXED:
+        for (uint32_t i = 0; i < BENCH_FIRES; i++)
+        {
+            fsm_indexed_fire(&bench_index, p_fsm);
+        }
+        break;
+    default:
+        for (uint32_t i = 0; i < BENCH_FIRES; i++)
+        {
+            fsm_automatic_door_fire(p_fsm);
+        }
+        break;
+    }
+    *p_instructions = (double)_counter_stop() / BENCH_FIRES;
+    *p_ns = (now_ns() - t0) / BENCH_FIRES;
+}
+
+int main()
+{
+    static const char *door_states[] = {"CLOSED", "OPENING", "OPEN", "CLOSING"};
+
+    port_system_init();
+    fsm_t *p_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    fsm_indexed_init(&bench_index, fsm_trans_automatic_door);
+    _counter_open();
+
+    printf("Automatic door (%u transitions), per fire with no guard true%s\n", bench_index.num_trans, bench_counter_fd < 0 ? " (instruction counter not available)" : "");
+    printf("%-10s", "state");
+    for (int d = 0; d < BENCH_NUM_DISPATCHERS; d++)
+    {
+        printf(" %10s ns %10s ins", bench_names[d], bench_names[d]);
+    }
+    printf("\n");
+
+    for (int state = CLOSED; state <= CLOSING; state++)
+    {
+        printf("%-10s", door_states[state]);
+        for (int d = 0; d < BENCH_NUM_DISPATCHERS; d++)
+        {
+            double ns, instructions;
+            bench(p_door, state, d, &ns, &instructions);
+            if (bench_counter_fd >= 0)
+            {
+                printf(" %13.2f %14.1f", ns, instructions);
+            }
+            else
+            {
+                printf(" %13.2f %14s", ns, "n/a");
+            }
+        }
+        printf("\n");
+    }
+
+    fsm_automatic_door_delete(p_door);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file bench_fsm_indexed.c
+ * @brief Benchmark of the indexed transition dispatcher (`fsm_indexed_fire()`) against the stock `fsm_fire()`.
+ *
+ * Every fire is done with all the guards returning false, which is the common case in the main loop and the worst case for the table scan.
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "fsm_indexed.h"
+#include "fsm_automatic_door.h"
+
+#define BENCH_FIRES 10000000 /*!< Number of fires per measurement */
+
+/* Synthetic FSM with the maximum size supported by the index: a ring of states with 2 arcs each */
+static volatile bool bench_input = false; /*!< Input of all the guards of the synthetic FSM */
+
+static bool bench_check(fsm_t *p_this)
+{
+    return bench_input;
+}
+
+static fsm_trans_t bench_trans[FSM_INDEXED_MAX_TRANSITIONS + 1]; /*!< Transitions table of the synthetic FSM (filled in main) */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_stock(fsm_t *p_fsm, int state)
+{
+    fsm_set_state(p_fsm, state);
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_FIRES; i++)
+    {
+        fsm_fire(p_fsm);
+    }
+    return (now_ns() - t0) / BENCH_FIRES;
+}
+
+static double bench_indexed(const fsm_indexed_t *p_index, fsm_t *p_fsm, int state)
+{
+    fsm_set_state(p_fsm, state);
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_FIRES; i++)
+    {
+        fsm_indexed_fire(p_index, p_fsm);
+    }
+    return (now_ns() - t0) / BENCH_FIRES;
+}
+
+int main()
+{
+    static const char *door_states[] = {"CLOSED", "OPENING", "OPEN", "CLOSING"};
+
+    port_system_init();
+
+    // Automatic door
+    fsm_t *p_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    fsm_indexed_t door_index;
+    fsm_indexed_init(&door_index, fsm_trans_automatic_door);
+
+    printf("Automatic door (%u transitions), ns/fire with no guard true\n", door_index.num_trans);
+    printf("%-10s %10s %10s %8s\n", "state", "fsm_fire", "indexed", "speedup");
+    for (int state = CLOSED; state <= CLOSING; state++)
+    {
+        double t_stock = bench_stock(p_door, state);
+        double t_indexed = bench_indexed(&door_index, p_door, state);
+        printf("%-10s %10.2f %10.2f %7.2fx\n", door_states[state], t_stock, t_indexed, t_stock / t_indexed);
+    }
+
+    // Synthetic FSM
+    for (int i = 0; i < FSM_INDEXED_MAX_TRANSITIONS; i++)
+    {
+        int state = i / 2;
+        bench_trans[i] = (fsm_trans_t){state, bench_check, (state + 1) % FSM_INDEXED_MAX_STATES, NULL};
+    }
+    bench_trans[FSM_INDEXED_MAX_TRANSITIONS] = (fsm_trans_t){-1, NULL, -1, NULL};
+    fsm_t *p_synthetic = fsm_new(bench_trans);
+    fsm_indexed_t synthetic_index;
+    fsm_indexed_init(&synthetic_index, bench_trans);
+
+    printf("\nSynthetic FSM (%u transitions), ns/fire with no guard true\n", synthetic_index.num_trans);
+    printf("%-10s %10s %10s %8s\n", "state", "fsm_fire", "indexed", "speedup");
+    for (int state = 0; state < FSM_INDEXED_MAX_STATES; state++)
+    {
+        double t_stock = bench_stock(p_synthetic, state);
+        double t_indexed = bench_indexed(&synthetic_index, p_synthetic, state);
+        printf("%-10d %10.2f %10.2f %7.2fx\n", state, t_stock, t_indexed, t_stock / t_indexed);
+    }
+
+    return 0;
+}
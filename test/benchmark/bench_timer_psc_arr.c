@@ -0,0 +1,104 @@
+/**
+ * @file bench_timer_psc_arr.c
+ * @brief Benchmark of the integer PSC/ARR solver (`timer_psc_arr_solve()`) against the `double` computation it replaced, over every period from 1 ms to 60 s at 16 MHz.
+ *
+ * For each of them it reports the time per solve, the mean and worst period error, and how many periods are exact. The host has a hardware double-precision FPU, so it favours the `double` computation: on the STM32F446RE (single-precision FPU) every `double` operation is a call to the software floating point library, while the solver only uses 32-bit divisions (UDIV).
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "timer_psc_arr.h"
+
+#define BENCH_CLOCK_HZ 16000000U  /*!< Clock of the timers of the board */
+#define BENCH_MAX_PERIOD_MS 60000 /*!< Longest period of the sweep */
+#define BENCH_REPEATS 20          /*!< Number of sweeps timed */
+
+typedef bool (*bench_solver_t)(uint32_t clock_hz, uint32_t period_ms, timer_psc_arr_t *p_psc_arr);
+
+static volatile uint32_t bench_sink; /*!< Keeps the results alive */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Nearest integer, halfway cases away from zero, as round() (without libm) */
+static double _round(double x)
+{
+    return (double)(int64_t)(x >= 0.0 ? x + 0.5 : x - 0.5);
+}
+
+/* Computation replaced by the solver, as it was in port_motor_timeout_timer_activate() and port_led_timer_setup() */
+static bool _double_solve(uint32_t clock_hz, uint32_t period_ms, timer_psc_arr_t *p_psc_arr)
+{
+    double sec = (double)period_ms / 1000.0;
+    double scc = (double)clock_hz;
+    double psc = _round(((scc * sec) / (65535.0 + 1.0)) - 1.0);
+    double arr = _round(((scc * sec) / (psc + 1.0)) - 1.0);
+    if (arr > 0xFFFF)
+    {
+        psc += 1.0;
+        arr = _round((scc * sec) / (psc + 1.0) - 1.0);
+    }
+    if (psc < 0.0 || arr < 0.0)
+    {
+        return false;
+    }
+    p_psc_arr->psc = (uint32_t)psc;
+    p_psc_arr->arr = (uint32_t)arr;
+    return true;
+}
+
+static void bench(const char *name, bench_solver_t solver)
+{
+    uint32_t exact = 0;
+    uint32_t invalid = 0;
+    double error_sum_ppm = 0.0;
+    double error_max_ppm = 0.0;
+    for (uint32_t ms = 1; ms <= BENCH_MAX_PERIOD_MS; ms++)
+    {
+        timer_psc_arr_t psc_arr;
+        if (!solver(BENCH_CLOCK_HZ, ms, &psc_arr))
+        {
+            invalid++;
+            continue;
+        }
+        uint64_t ticks = (uint64_t)(BENCH_CLOCK_HZ / 1000U) * ms;
+        uint64_t period = timer_psc_arr_get_ticks(&psc_arr);
+        uint64_t error = period > ticks ? period - ticks : ticks - period;
+        double error_ppm = (double)error * 1e6 / (double)ticks;
+        exact += (error == 0);
+        error_sum_ppm += error_ppm;
+        error_max_ppm = error_ppm > error_max_ppm ? error_ppm : error_max_ppm;
+    }
+
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double t0 = now_ns();
+        for (uint32_t ms = 1; ms <= BENCH_MAX_PERIOD_MS; ms++)
+        {
+            timer_psc_arr_t psc_arr;
+            solver(BENCH_CLOCK_HZ, ms, &psc_arr);
+            bench_sink += psc_arr.psc + psc_arr.arr;
+        }
+        double ns = (now_ns() - t0) / BENCH_MAX_PERIOD_MS;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+
+    printf("%-10s %10.1f %10u %10u %14.3f %14.3f\n", name, best, exact, invalid, error_sum_ppm / (BENCH_MAX_PERIOD_MS - invalid), error_max_ppm);
+}
+
+int main()
+{
+    printf("PSC/ARR for every period from 1 ms to %u ms at %u Hz (search of %u prescalers)\n", BENCH_MAX_PERIOD_MS, BENCH_CLOCK_HZ, TIMER_PSC_ARR_SEARCH);
+    printf("%-10s %10s %10s %10s %14s %14s\n", "solver", "ns/solve", "exact", "invalid", "mean err ppm", "max err ppm");
+    bench("double", _double_solve);
+    bench("integer", timer_psc_arr_solve);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file bench_timer_wheel.c
+ * @brief Benchmark of the timing wheel (`timer_wheel.h`) as the number of pending timers grows: ns per arm, per cancel and per expiry, against a plain array of deadlines scanned on every tick.
+ *
+ * The timers are periodic with periods from 100 ms to 10 s (the blinking semi-periods and the door timeouts), so the expiries per tick grow with the number of timers but their cost should not. Usage: `bench_timer_wheel [max_timers]`.
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "timer_wheel.h"
+
+#define BENCH_DEFAULT_MAX_TIMERS 65536 /*!< Default largest number of timers */
+#define BENCH_MIN_TIMERS 64            /*!< Smallest number of timers */
+#define BENCH_OPS 1000000              /*!< Number of arms and of cancels measured */
+#define BENCH_TICKS 20000              /*!< Number of ticks measured (20 s of 1 ms) */
+#define BENCH_MIN_PERIOD 100           /*!< Shortest period of the timers */
+#define BENCH_MAX_PERIOD 10000         /*!< Longest period of the timers */
+
+static uint64_t bench_expiries; /*!< Number of callbacks run */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint32_t _rand(uint32_t *p_seed)
+{
+    *p_seed = *p_seed * 1103515245 + 12345;
+    return *p_seed >> 8;
+}
+
+static void _count(void *p_arg)
+{
+    bench_expiries++;
+}
+
+/* Reference: every tick scans the deadlines of all the timers (as a main loop that checks each timer) */
+static double _bench_scan(uint32_t num_timers, const uint32_t *p_periods)
+{
+    uint32_t *p_deadlines = malloc(num_timers * sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_timers; i++)
+    {
+        p_deadlines[i] = p_periods[i];
+    }
+    uint64_t expiries = 0;
+    double t0 = now_ns();
+    for (uint32_t now = 1; now <= BENCH_TICKS; now++)
+    {
+        for (uint32_t i = 0; i < num_timers; i++)
+        {
+            if (p_deadlines[i] == now)
+            {
+                p_deadlines[i] += p_periods[i];
+                expiries++;
+            }
+        }
+    }
+    double ns = (now_ns() - t0) / BENCH_TICKS;
+    bench_expiries += expiries;
+    free(p_deadlines);
+    return ns;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t max_timers = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_MAX_TIMERS;
+
+    printf("%10s %10s %10s %12s %10s %12s %14s\n", "timers", "ns/arm", "ns/cancel", "ns/expiry", "ns/tick", "expiry/tick", "ns/tick scan");
+    for (uint32_t num_timers = BENCH_MIN_TIMERS; num_timers <= max_timers; num_timers *= 4)
+    {
+        timer_wheel_t *p_wheel = malloc(sizeof(timer_wheel_t));
+        timer_wheel_timer_t *p_timers = malloc(num_timers * sizeof(timer_wheel_timer_t));
+        uint32_t *p_periods = malloc(num_timers * sizeof(uint32_t));
+        uint32_t *p_picks = malloc(BENCH_OPS * sizeof(uint32_t));
+        if (p_wheel == NULL || p_timers == NULL || p_periods == NULL || p_picks == NULL)
+        {
+            printf("Not enough memory for %u timers\n", num_timers);
+            return 1;
+        }
+
+        uint32_t seed = 1;
+        timer_wheel_init(p_wheel, 0);
+        for (uint32_t i = 0; i < num_timers; i++)
+        {
+            p_periods[i] = BENCH_MIN_PERIOD + _rand(&seed) % (BENCH_MAX_PERIOD - BENCH_MIN_PERIOD + 1);
+            timer_wheel_timer_init(&p_timers[i], _count, NULL);
+            timer_wheel_arm(p_wheel, &p_timers[i], p_periods[i], p_periods[i]);
+        }
+        // Random timers to re-arm, drawn beforehand so that the generator is not measured
+        for (uint32_t op = 0; op < BENCH_OPS; op++)
+        {
+            p_picks[op] = _rand(&seed) % num_timers;
+        }
+
+        // Re-arm pending timers at random
+        double t0 = now_ns();
+        for (uint32_t op = 0; op < BENCH_OPS; op++)
+        {
+            timer_wheel_timer_t *p_timer = &p_timers[p_picks[op]];
+            timer_wheel_arm(p_wheel, p_timer, p_periods[p_picks[op]], p_timer->period);
+        }
+        double ns_arm = (now_ns() - t0) / BENCH_OPS;
+
+        // Cancel every timer and arm them again (the arms are not measured)
+        double ns_cancel = 0;
+        for (uint32_t done = 0; done < BENCH_OPS; done += num_timers)
+        {
+            t0 = now_ns();
+            for (uint32_t i = 0; i < num_timers; i++)
+            {
+                timer_wheel_cancel(p_wheel, &p_timers[i]);
+            }
+            ns_cancel += now_ns() - t0;
+            for (uint32_t i = 0; i < num_timers; i++)
+            {
+                timer_wheel_arm(p_wheel, &p_timers[i], p_periods[i], p_periods[i]);
+            }
+        }
+        ns_cancel /= ((BENCH_OPS + num_timers - 1) / num_timers) * num_timers;
+
+        // Ticks: cascades, expiries and periodic re-arms
+        bench_expiries = 0;
+        t0 = now_ns();
+        for (uint32_t tick = 1; tick <= BENCH_TICKS; tick++)
+        {
+            timer_wheel_advance(p_wheel, p_wheel->now + 1);
+        }
+        double ns_ticks = now_ns() - t0;
+        uint64_t expiries = bench_expiries;
+
+        double ns_scan = _bench_scan(num_timers, p_periods);
+
+        printf("%10u %10.1f %10.1f %12.1f %10.1f %12.1f %14.1f\n", num_timers, ns_arm, ns_cancel, ns_ticks / (double)(expiries > 0 ? expiries : 1), ns_ticks / BENCH_TICKS, (double)expiries / BENCH_TICKS, ns_scan);
+
+        free(p_picks);
+        free(p_periods);
+        free(p_timers);
+        free(p_wheel);
+    }
+    return 0;
+}
@@ -9,12 +9,12 @@
 int main()
 {
     port_system_init();                 // inicializamos el sistema
-    port_led_gpio_setup(); // Configuramos el GPIO para el LED
+    port_led_init(&led_opening); // Configuramos el GPIO para el LED
 
     uint32_t t = port_system_get_millis(); // en t llevamos cuenta del tiempo actual
     while (1)
     {
-        port_led_toggle(); // Hacemos parpadear el LED
+        port_led_toggle(&led_opening); // Hacemos parpadear el LED
         port_system_delay_until_ms(&t, BLINK_T_MS / 2); // Y esperamos el periodo de la FSM
     }
     return 0;
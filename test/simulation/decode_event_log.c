@@ -0,0 +1,520 @@
+/**
+ * @file decode_event_log.c
+ * @brief Decoder of the binary log of the events of the automatic door (native platform).
+ *
+ * A capture of the binary log (`event_log.h`, e.g. the bytes received from the UART of the board with `-DUSE_EVENT_LOG=true`) is read in chunks of `DECODE_CHUNK_SIZE` bytes, so that captures of any size are decoded in constant memory, and every record that passes the filters is printed as a line of text: time since the start of the capture, event, state and payload. With `--count` nothing is printed but the number of records of each event, and the decoder runs as fast as the file is read.
+ *
+ * `--generate` writes a synthetic capture: doors that open and close at random arrivals, logging the input events, the presences and the changes of state, with some records lost now and then. `--self-test` encodes such traffic in memory both as binary records and as the lines of text that `printf()` would write, and fails if the binary log does not take at least `DECODE_MIN_GAIN` times fewer bytes and (in an optimized build) less CPU time per event, or if the decoder does not read back every record.
+ *
+ * Usage:
+ * - `decode_event_log [--event <name>] [--state <name>] [--from <ms>] [--to <ms>] [--count] <log_file>`: decode a capture (`-` reads the standard input)
+ * - `decode_event_log --generate <records> <log_file> [seed]`: write a synthetic capture
+ * - `decode_event_log --self-test [records]`
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+#include "event_queue.h"
+#include "event_log.h"
+
+#define DECODE_CHUNK_SIZE (1024U * 1024U) /*!< Bytes read from the capture at a time */
+#define DECODE_MIN_GAIN 10.0              /*!< Minimum ratio of bytes and CPU time of the text over the binary log required by the self-test */
+#define DECODE_LINE_SIZE 96               /*!< Size of a line of text of the self-test */
+#define DECODE_RATE_PER_HOUR 240.0        /*!< Arrivals per hour of the synthetic traffic */
+#define DECODE_LOST_PERIOD 1000U          /*!< Mean number of openings between two losses of the synthetic traffic */
+#define DECODE_ANY 0xFFU                  /*!< Filter that matches any event or state */
+
+static const char *const p_event_names[] = {"NONE", "PIR_RISING", "PIR_FALLING", "BUTTON_PRESS", "BUTTON_RELEASE", "MOTOR_TIMEOUT", "END_OF_TRAVEL", "CODE_7",
+                                            "PRESENCE", "STATE", "LOST", "CODE_11", "CODE_12", "CODE_13", "CODE_14", "CODE_15"};
+static const char *const p_state_names[] = {"CLOSED", "OPENING", "OPEN", "CLOSING", "STATE_4", "STATE_5", "STATE_6", "STATE_7"};
+
+/**
+ * @brief A record of the synthetic traffic, relative to the previous one.
+ */
+typedef struct
+{
+    uint32_t delta_ms; /*!< Time since the previous record */
+    uint8_t event;     /*!< Event code */
+    uint8_t state;     /*!< State code */
+} decode_step_t;
+
+/* A door that opens and closes on every arrival: the arrival is the first record, the others follow it at fixed times */
+static const decode_step_t opening_and_closing[] = {
+    {0, EVENT_PIR_RISING, 0}, {0, EVENT_LOG_PRESENCE, 0}, {0, EVENT_LOG_STATE, 1}, {2000, EVENT_PIR_FALLING, 1}, {3000, EVENT_MOTOR_TIMEOUT, 1},
+    {0, EVENT_LOG_STATE, 2}, {5000, EVENT_MOTOR_TIMEOUT, 2}, {0, EVENT_LOG_STATE, 3}, {5000, EVENT_MOTOR_TIMEOUT, 3}, {0, EVENT_LOG_STATE, 0},
+};
+#define DECODE_STEPS (sizeof(opening_and_closing) / sizeof(opening_and_closing[0])) /*!< Records of an opening and closing */
+
+/**
+ * @brief Generator of synthetic traffic.
+ */
+typedef struct
+{
+    uint64_t rng;       /*!< State of the random numbers */
+    uint32_t now_ms;    /*!< System time of the last record */
+    uint32_t step;      /*!< Next step of the opening and closing */
+    uint32_t lost;      /*!< Bytes lost so far */
+    bool report_lost;   /*!< Whether the next record reports a loss */
+} decode_traffic_t;
+
+/**
+ * @brief A record of the synthetic traffic, with its absolute time.
+ */
+typedef struct
+{
+    uint32_t timestamp_ms; /*!< System time */
+    uint8_t event;         /*!< Event code */
+    uint8_t state;         /*!< State code */
+    bool has_payload;      /*!< Whether the record has a payload */
+    uint32_t payload;      /*!< Payload (bytes lost so far) */
+} decode_record_t;
+
+/**
+ * @brief Filters of the records to print.
+ */
+typedef struct
+{
+    uint8_t event;    /*!< Event code, or `DECODE_ANY` */
+    uint8_t state;    /*!< State code, or `DECODE_ANY` */
+    uint64_t from_ms; /*!< Lowest time */
+    uint64_t to_ms;   /*!< Highest time */
+    bool count_only;  /*!< Whether only the number of records of each event is printed */
+} decode_filter_t;
+
+/* Helpers ----------------------------------------------------------------------*/
+static double _now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Random numbers (xorshift64*) */
+static double _uniform(uint64_t *p_state)
+{
+    uint64_t x = *p_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *p_state = x;
+    return (double)(((x * 0x2545F4914F6CDD1DULL) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+static uint8_t _parse_name(const char *p_name, const char *const *p_names, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (strcmp(p_name, p_names[i]) == 0)
+        {
+            return (uint8_t)i;
+        }
+    }
+    return DECODE_ANY;
+}
+
+/* Synthetic traffic ------------------------------------------------------------*/
+static void _traffic_init(decode_traffic_t *p_traffic, uint64_t seed)
+{
+    *p_traffic = (decode_traffic_t){.rng = seed * 0x9E3779B97F4A7C15ULL + 1};
+}
+
+/* Next record of the traffic. Returns whether it has a payload (the bytes lost so far) */
+static bool _traffic_next(decode_traffic_t *p_traffic, uint32_t *p_timestamp_ms, uint8_t *p_event, uint8_t *p_state)
+{
+    if (p_traffic->report_lost)
+    {
+        p_traffic->report_lost = false;
+        *p_timestamp_ms = p_traffic->now_ms;
+        *p_event = EVENT_LOG_LOST;
+        *p_state = 0;
+        return true;
+    }
+
+    const decode_step_t *p_step = &opening_and_closing[p_traffic->step];
+    uint32_t delta_ms = p_step->delta_ms;
+    if (p_traffic->step == 0)
+    {
+        // The next arrival comes once the door is closed
+        double dt = -log(_uniform(&p_traffic->rng)) * 3600000.0 / DECODE_RATE_PER_HOUR;
+        delta_ms = (dt < 1.0) ? 1 : (uint32_t)dt;
+    }
+    p_traffic->now_ms += delta_ms;
+    p_traffic->step = (p_traffic->step + 1) % DECODE_STEPS;
+    if ((p_traffic->step == 0) && (_uniform(&p_traffic->rng) * DECODE_LOST_PERIOD < 1.0))
+    {
+        p_traffic->lost += 1 + (uint32_t)(_uniform(&p_traffic->rng) * 1000.0);
+        p_traffic->report_lost = true;
+    }
+    *p_timestamp_ms = p_traffic->now_ms;
+    *p_event = p_step->event;
+    *p_state = p_step->state;
+    return false;
+}
+
+/* Fill `p_records` with `num` records of traffic */
+static void _make_traffic(decode_record_t *p_records, uint64_t num, uint64_t seed)
+{
+    decode_traffic_t traffic;
+    _traffic_init(&traffic, seed);
+    for (uint64_t i = 0; i < num; i++)
+    {
+        decode_record_t *p_record = &p_records[i];
+        p_record->has_payload = _traffic_next(&traffic, &p_record->timestamp_ms, &p_record->event, &p_record->state);
+        p_record->payload = p_record->has_payload ? traffic.lost : 0;
+    }
+}
+
+/* Encode the records into `p_buffer`. Returns the bytes written */
+static uint64_t _encode_records(uint8_t *p_buffer, const decode_record_t *p_records, uint64_t num)
+{
+    event_log_t event_log;
+    uint64_t length = 0;
+
+    event_log_init(&event_log);
+    for (uint64_t i = 0; i < num; i++)
+    {
+        const decode_record_t *p_record = &p_records[i];
+        length += p_record->has_payload ? event_log_encode_payload(&event_log, &p_buffer[length], p_record->timestamp_ms, p_record->event, p_record->state, p_record->payload)
+                                        : event_log_encode(&event_log, &p_buffer[length], p_record->timestamp_ms, p_record->event, p_record->state);
+        event_log_commit(&event_log, p_record->timestamp_ms);
+    }
+    return length;
+}
+
+/* Write the records as the lines of text that `printf()` would write. Returns the bytes written */
+static uint64_t _print_records(char *p_buffer, const decode_record_t *p_records, uint64_t num)
+{
+    uint64_t length = 0;
+
+    for (uint64_t i = 0; i < num; i++)
+    {
+        const decode_record_t *p_record = &p_records[i];
+        char line[DECODE_LINE_SIZE];
+        int len;
+        if (p_record->has_payload)
+        {
+            len = snprintf(line, sizeof(line), "Lost %" PRIu32 " bytes of the log at %" PRIu32 "\n", p_record->payload, p_record->timestamp_ms);
+        }
+        else if (p_record->event == EVENT_LOG_PRESENCE)
+        {
+            len = snprintf(line, sizeof(line), "PRESENCE!!! Presence detected at %" PRIu32 ". Opening door...\n", p_record->timestamp_ms);
+        }
+        else if (p_record->event == EVENT_LOG_STATE)
+        {
+            len = snprintf(line, sizeof(line), "Door %s at %" PRIu32 "\n", p_state_names[p_record->state], p_record->timestamp_ms);
+        }
+        else
+        {
+            len = snprintf(line, sizeof(line), "Event %s in state %s at %" PRIu32 "\n", p_event_names[p_record->event], p_state_names[p_record->state], p_record->timestamp_ms);
+        }
+        memcpy(&p_buffer[length], line, (size_t)len);
+        length += (uint64_t)len;
+    }
+    return length;
+}
+
+/* Decoding ---------------------------------------------------------------------*/
+static void _print_entry(const event_log_entry_t *p_entry)
+{
+    if (p_entry->has_payload)
+    {
+        printf("%12" PRIu64 " ms  %-14s  %-7s  %" PRIu32 "\n", p_entry->time_ms, p_event_names[p_entry->event], p_state_names[p_entry->state], p_entry->payload);
+    }
+    else
+    {
+        printf("%12" PRIu64 " ms  %-14s  %s\n", p_entry->time_ms, p_event_names[p_entry->event], p_state_names[p_entry->state]);
+    }
+}
+
+/* Decode the records of a chunk that pass the filter. Returns the number of records read */
+static uint64_t _decode_chunk(event_log_reader_t *p_reader, const decode_filter_t *p_filter, uint64_t *p_counts)
+{
+    event_log_entry_t entry;
+    uint64_t records = 0;
+    while (event_log_read(p_reader, &entry))
+    {
+        records++;
+        if (((p_filter->event != DECODE_ANY) && (entry.event != p_filter->event)) || ((p_filter->state != DECODE_ANY) && (entry.state != p_filter->state)) ||
+            (entry.time_ms < p_filter->from_ms) || (entry.time_ms > p_filter->to_ms))
+        {
+            continue;
+        }
+        p_counts[entry.event]++;
+        if (!p_filter->count_only)
+        {
+            _print_entry(&entry);
+        }
+    }
+    return records;
+}
+
+/* Commands ---------------------------------------------------------------------*/
+static int _cmd_decode(const char *p_path, const decode_filter_t *p_filter)
+{
+    FILE *p_file = (strcmp(p_path, "-") == 0) ? stdin : fopen(p_path, "rb");
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "Cannot open log file %s\n", p_path);
+        return EXIT_FAILURE;
+    }
+
+    // The chunk is read after the record cut at the end of the previous one
+    uint8_t *p_buffer = malloc(DECODE_CHUNK_SIZE + EVENT_LOG_MAX_SIZE);
+    uint64_t counts[EVENT_LOG_MAX_EVENT + 1] = {0};
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    uint32_t kept = 0;
+    bool corrupt = false;
+    event_log_reader_t reader;
+    event_log_reader_init(&reader, p_buffer, 0);
+
+    double start = _now_s();
+    size_t len;
+    while ((len = fread(&p_buffer[kept], 1, DECODE_CHUNK_SIZE, p_file)) > 0)
+    {
+        bytes += len;
+        event_log_reader_refill(&reader, p_buffer, kept + (uint32_t)len);
+        records += _decode_chunk(&reader, p_filter, counts);
+        kept = reader.length - reader.pos;
+        if (kept >= EVENT_LOG_MAX_SIZE)
+        {
+            corrupt = true;
+            break;
+        }
+        memmove(p_buffer, &p_buffer[reader.pos], kept);
+    }
+    double wall_s = _now_s() - start;
+    if (p_file != stdin)
+    {
+        fclose(p_file);
+    }
+    free(p_buffer);
+
+    if (p_filter->count_only)
+    {
+        for (uint32_t i = 0; i <= EVENT_LOG_MAX_EVENT; i++)
+        {
+            if (counts[i] != 0)
+            {
+                printf("%-14s  %" PRIu64 "\n", p_event_names[i], counts[i]);
+            }
+        }
+    }
+    fprintf(stderr, "%" PRIu64 " records in %" PRIu64 " bytes (%.2f bytes/record), %.2f h, decoded in %.3f s (%.0f MB/s)\n", records, bytes, records ? (double)bytes / records : 0.0,
+            reader.time_ms / 3600000.0, wall_s, bytes / 1e6 / wall_s);
+    if (corrupt)
+    {
+        fprintf(stderr, "The log has a record that is not valid at byte %" PRIu64 "\n", bytes - (reader.length - reader.pos));
+        return EXIT_FAILURE;
+    }
+    if (kept != 0)
+    {
+        fprintf(stderr, "The log ends with a truncated record\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int _cmd_generate(uint64_t num, const char *p_path, uint64_t seed)
+{
+    FILE *p_file = fopen(p_path, "wb");
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "Cannot write log file %s\n", p_path);
+        return EXIT_FAILURE;
+    }
+
+    // In blocks, so that captures of any size are written in constant memory
+    const uint64_t block = DECODE_CHUNK_SIZE / EVENT_LOG_MAX_SIZE;
+    uint8_t *p_buffer = malloc(DECODE_CHUNK_SIZE);
+    decode_traffic_t traffic;
+    event_log_t event_log;
+    uint64_t bytes = 0;
+    bool ok = true;
+    _traffic_init(&traffic, seed);
+    event_log_init(&event_log);
+    for (uint64_t done = 0; ok && (done < num); done += block)
+    {
+        uint32_t length = 0;
+        for (uint64_t i = done; (i < done + block) && (i < num); i++)
+        {
+            uint32_t timestamp_ms;
+            uint8_t event, state;
+            bool has_payload = _traffic_next(&traffic, &timestamp_ms, &event, &state);
+            length += has_payload ? event_log_encode_payload(&event_log, &p_buffer[length], timestamp_ms, event, state, traffic.lost)
+                                  : event_log_encode(&event_log, &p_buffer[length], timestamp_ms, event, state);
+            event_log_commit(&event_log, timestamp_ms);
+        }
+        ok = fwrite(p_buffer, 1, length, p_file) == length;
+        bytes += length;
+    }
+    ok = (fclose(p_file) == 0) && ok;
+    free(p_buffer);
+    if (!ok)
+    {
+        fprintf(stderr, "Cannot write log file %s\n", p_path);
+        return EXIT_FAILURE;
+    }
+    printf("Log: %" PRIu64 " records in %" PRIu64 " bytes (%.2f bytes/record)\n", num, bytes, (double)bytes / num);
+    return EXIT_SUCCESS;
+}
+
+static int _cmd_self_test(uint64_t num)
+{
+    decode_record_t *p_records = malloc(num * sizeof(decode_record_t));
+    uint8_t *p_binary = malloc(num * EVENT_LOG_MAX_SIZE);
+    char *p_text = malloc(num * DECODE_LINE_SIZE);
+    int rc = EXIT_SUCCESS;
+    _make_traffic(p_records, num, 1);
+
+    // The best of a few runs of each, to leave out the noise of the host
+    double binary_s = INFINITY, text_s = INFINITY;
+    uint64_t binary_bytes = 0, text_bytes = 0;
+    for (uint32_t run = 0; run < 3; run++)
+    {
+        double start = _now_s();
+        binary_bytes = _encode_records(p_binary, p_records, num);
+        double middle = _now_s();
+        text_bytes = _print_records(p_text, p_records, num);
+        double end = _now_s();
+        binary_s = fmin(binary_s, middle - start);
+        text_s = fmin(text_s, end - middle);
+    }
+    double bytes_gain = (double)text_bytes / binary_bytes;
+    double cpu_gain = text_s / binary_s;
+    printf("Binary: %.2f bytes/event, %.1f ns/event\n", (double)binary_bytes / num, binary_s * 1e9 / num);
+    printf("Text:   %.2f bytes/event, %.1f ns/event\n", (double)text_bytes / num, text_s * 1e9 / num);
+    printf("Gain:   %.1fx fewer bytes, %.1fx less CPU\n", bytes_gain, cpu_gain);
+
+    // Read back in chunks, as from a file
+    event_log_reader_t reader;
+    event_log_entry_t entry;
+    uint64_t records = 0;
+    uint64_t wraps = 0;
+    bool same = true;
+    event_log_reader_init(&reader, p_binary, 0);
+    double start = _now_s();
+    for (uint64_t offset = 0; offset < binary_bytes; offset += reader.pos)
+    {
+        uint64_t left = binary_bytes - offset;
+        event_log_reader_refill(&reader, &p_binary[offset], (left < DECODE_CHUNK_SIZE) ? (uint32_t)left : DECODE_CHUNK_SIZE);
+        while (event_log_read(&reader, &entry) && (records < num))
+        {
+            const decode_record_t *p_record = &p_records[records];
+            wraps += (records > 0) && (p_record->timestamp_ms < p_records[records - 1].timestamp_ms);
+            same = same && (entry.time_ms == (wraps << 32) + p_record->timestamp_ms) && (entry.event == p_record->event) && (entry.state == p_record->state) &&
+                   (entry.has_payload == p_record->has_payload) && (entry.payload == p_record->payload);
+            records++;
+        }
+    }
+    double decode_s = _now_s() - start;
+    printf("Decoded %" PRIu64 " records in %.3f s (%.0f MB/s, %.1f ns/record)\n", records, decode_s, binary_bytes / 1e6 / decode_s, decode_s * 1e9 / records);
+    free(p_records);
+    free(p_binary);
+    free(p_text);
+
+    if (!same || (records != num))
+    {
+        fprintf(stderr, "FAIL: the decoded records are not the encoded ones\n");
+        rc = EXIT_FAILURE;
+    }
+    if (bytes_gain < DECODE_MIN_GAIN)
+    {
+        fprintf(stderr, "FAIL: the binary log does not take %.0fx fewer bytes than the text\n", DECODE_MIN_GAIN);
+        rc = EXIT_FAILURE;
+    }
+#if defined(__OPTIMIZE__)
+    // Without optimizations the time of the encoder is that of -O0, not that of the firmware, while the C library that formats the text is always optimized
+    if (cpu_gain < DECODE_MIN_GAIN)
+    {
+        fprintf(stderr, "FAIL: the binary log does not take %.0fx less CPU than the text\n", DECODE_MIN_GAIN);
+        rc = EXIT_FAILURE;
+    }
+#endif
+    return rc;
+}
+
+static bool _parse_records(const char *p_text, uint64_t *p_num)
+{
+    *p_num = strtoull(p_text, NULL, 10);
+    if (*p_num == 0)
+    {
+        fprintf(stderr, "The number of records must be at least 1\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t num = 1000000;
+
+    if ((argc >= 2) && (strcmp(argv[1], "--self-test") == 0))
+    {
+        if ((argc >= 3) && !_parse_records(argv[2], &num))
+        {
+            return EXIT_FAILURE;
+        }
+        return _cmd_self_test(num);
+    }
+    if ((argc >= 4) && (strcmp(argv[1], "--generate") == 0))
+    {
+        if (!_parse_records(argv[2], &num))
+        {
+            return EXIT_FAILURE;
+        }
+        return _cmd_generate(num, argv[3], argc >= 5 ? strtoull(argv[4], NULL, 10) : 1);
+    }
+
+    decode_filter_t filter = {.event = DECODE_ANY, .state = DECODE_ANY, .from_ms = 0, .to_ms = UINT64_MAX, .count_only = false};
+    int i = 1;
+    for (; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "--count") == 0)
+        {
+            filter.count_only = true;
+        }
+        else if ((strcmp(argv[i], "--event") == 0) && (i + 2 < argc))
+        {
+            filter.event = _parse_name(argv[++i], p_event_names, EVENT_LOG_MAX_EVENT + 1);
+            if (filter.event == DECODE_ANY)
+            {
+                fprintf(stderr, "Unknown event %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ((strcmp(argv[i], "--state") == 0) && (i + 2 < argc))
+        {
+            filter.state = _parse_name(argv[++i], p_state_names, EVENT_LOG_MAX_STATE + 1);
+            if (filter.state == DECODE_ANY)
+            {
+                fprintf(stderr, "Unknown state %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ((strcmp(argv[i], "--from") == 0) && (i + 2 < argc))
+        {
+            filter.from_ms = strtoull(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--to") == 0) && (i + 2 < argc))
+        {
+            filter.to_ms = strtoull(argv[++i], NULL, 10);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (i == argc - 1)
+    {
+        return _cmd_decode(argv[i], &filter);
+    }
+    fprintf(stderr, "Usage: %s [--event <name>] [--state <name>] [--from <ms>] [--to <ms>] [--count] <log_file> | --generate <records> <log_file> [seed] | --self-test [records]\n", argv[0]);
+    return EXIT_FAILURE;
+}
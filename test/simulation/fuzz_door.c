@@ -0,0 +1,598 @@
+/**
+ * @file fuzz_door.c
+ * @brief Parallel property-based fuzzer of the automatic door FSM (native platform).
+ *
+ * Every case is a random sequence of operations on a real `fsm_automatic_door_t` with its own simulated peripherals: PIR edges, button press/release and waits of random length, during which the motor timeout expires if it is due. Each input is pushed as an event by the "ISR"; most of the times the "main loop" feeds it at once to the door with `fsm_automatic_door_fire_events()`, but an operation can be deferred, so that several events pile up in the queue and are fed in the same call, as when the main loop is late. After every run of the main loop the safety invariants of the door are checked:
+ *
+ * - The opening and the closing LEDs never blink at the same time.
+ * - In `OPENING`, `OPEN` and `CLOSING` the motor timeout is armed; in `CLOSING` the closing LED blinks and in `OPENING` the opening LED blinks.
+ * - In `CLOSED` no timer is armed (`fsm_automatic_door_check_activity()` is false).
+ * - The door is never left `CLOSING` with a presence or a button press not consumed yet, and the first presence or button press fed while `CLOSING` (before the door sees any motor timeout) reverses the door to `OPENING` in that same fire.
+ *
+ * The cases are spread over all the cores: each case only depends on its index and the seed, so the results do not depend on the number of threads. When a case fails, it is shrunk to a minimal reproducer (removing chunks of operations and simplifying the rest while it keeps failing the same invariant), which is printed step by step.
+ *
+ * `--planted` adds a wrong invariant (the door never reverses from `CLOSING` to `OPENING`) to check that the fuzzer finds and shrinks a violation: the program then succeeds only if it is found and shrunk to at most `FUZZ_PLANTED_MAX_OPS` operations.
+ *
+ * Usage: `fuzz_door [--cases <n>] [--ops <n>] [--threads <n>] [--seed <n>] [--planted]`
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "fsm_automatic_door.h"
+
+#define FUZZ_DEFAULT_CASES 1000000 /*!< Default number of cases */
+#define FUZZ_DEFAULT_OPS 64        /*!< Default number of operations per case */
+#define FUZZ_MAX_OPS 1024          /*!< Maximum number of operations per case */
+#define FUZZ_MAX_THREADS 64        /*!< Maximum number of worker threads */
+#define FUZZ_MAX_WAIT_MS 12000     /*!< Maximum length of a wait: longer than any timeout of the door */
+#define FUZZ_MAX_PENDING 8         /*!< Maximum number of events deferred in the queue: the main loop runs when they reach it */
+#define FUZZ_BATCH_CASES 256       /*!< Number of cases a worker takes at once */
+#define FUZZ_PLANTED_MAX_OPS 6     /*!< Maximum length of the shrunk reproducer of the planted violation */
+#define FUZZ_NO_FAILURE UINT64_MAX /*!< Index of the first failing case when there is none */
+
+/**
+ * @brief Operations of a case.
+ */
+enum FUZZ_OPS
+{
+    FUZZ_OP_PIR = 0, /*!< The PIR sensor toggles (rising or falling edge) */
+    FUZZ_OP_BUTTON,  /*!< The button toggles (press or release) */
+    FUZZ_OP_WAIT,    /*!< The time passes, up to the motor timeout if it is due before */
+    FUZZ_NUM_OPS
+};
+
+/**
+ * @brief Invariants of the door. `FUZZ_OK` means no violation.
+ */
+enum FUZZ_INVARIANTS
+{
+    FUZZ_OK = 0,
+    FUZZ_INV_BOTH_LEDS_BLINK,       /*!< Both LEDs blink at the same time */
+    FUZZ_INV_MOTOR_NOT_ARMED,       /*!< The motor timeout is not armed in `OPENING`, `OPEN` or `CLOSING` */
+    FUZZ_INV_WRONG_LED,             /*!< The LED of the movement does not blink in `OPENING` or `CLOSING` */
+    FUZZ_INV_ACTIVE_CLOSED,         /*!< A timer is armed in `CLOSED` */
+    FUZZ_INV_CLOSING_WITH_PRESENCE, /*!< The door stays `CLOSING` with a presence or the button pressed */
+    FUZZ_INV_NO_REVERSAL,           /*!< A presence while `CLOSING` does not reverse the door */
+    FUZZ_INV_PLANTED,               /*!< The door reverses (wrong on purpose, only with `--planted`) */
+    FUZZ_NUM_INVARIANTS
+};
+
+static const char *fuzz_invariant_names[FUZZ_NUM_INVARIANTS] = {
+    "none",
+    "both LEDs blink at the same time",
+    "motor timeout not armed while the door is not CLOSED",
+    "the LED of the movement does not blink",
+    "a timer is armed in CLOSED",
+    "the door stays CLOSING with a presence or the button pressed",
+    "a presence while CLOSING does not reverse the door to OPENING",
+    "the door reverses from CLOSING to OPENING (planted)"};
+
+static const char *fuzz_state_names[] = {"CLOSED", "OPENING", "OPEN", "CLOSING"};
+
+/**
+ * @brief An operation of a case.
+ */
+typedef struct
+{
+    uint8_t op;       /*!< Operation (`FUZZ_OPS`) */
+    bool deferred;    /*!< The main loop does not run after the operation */
+    uint32_t wait_ms; /*!< Time to wait, for `FUZZ_OP_WAIT` */
+} fuzz_op_t;
+
+/**
+ * @brief A door under test with its own simulated peripherals.
+ */
+typedef struct
+{
+    fsm_t *p_fsm;                      /*!< Automatic door FSM */
+    port_button_hw_t button;           /*!< Button of the door */
+    port_led_hw_t led_open;            /*!< Opening LED of the door */
+    port_led_hw_t led_close;           /*!< Closing LED of the door */
+    port_pir_hw_t pir;                 /*!< PIR sensor of the door */
+    port_motor_hw_t motor;             /*!< Motor of the door */
+    event_queue_t queue;               /*!< Events pushed by the ISRs and not fed yet */
+    uint8_t pending[FUZZ_MAX_PENDING]; /*!< Copy of the events in the queue, to know what the main loop will feed */
+    uint32_t num_pending;              /*!< Number of events in the queue */
+} fuzz_door_t;
+
+/**
+ * @brief A fuzzing run.
+ */
+typedef struct
+{
+    uint64_t num_cases;          /*!< Number of cases */
+    uint32_t num_ops;            /*!< Operations per case */
+    uint64_t seed;               /*!< Seed of the run */
+    bool planted;                /*!< Check the planted invariant too */
+    fuzz_door_t *p_doors;        /*!< A door per worker */
+    atomic_uint_fast64_t next;   /*!< Next case to take */
+    atomic_uint_fast64_t failed; /*!< Lowest failing case, `FUZZ_NO_FAILURE` if none */
+    atomic_uint_fast64_t steps;  /*!< Operations run */
+} fuzz_t;
+
+/**
+ * @brief Argument of a worker thread.
+ */
+typedef struct
+{
+    fuzz_t *p_fuzz;  /*!< Fuzzing run */
+    uint32_t worker; /*!< Index of the worker */
+} fuzz_worker_t;
+
+/* Random numbers -------------------------------------------------------------*/
+static uint64_t _splitmix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t _xorshift64s(uint64_t *p_state)
+{
+    uint64_t x = *p_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *p_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Generate the operations of a case from its index */
+static void _case_generate(uint64_t seed, uint64_t index, fuzz_op_t *p_ops, uint32_t num_ops)
+{
+    uint64_t rng = _splitmix64(seed ^ _splitmix64(index)) | 1U;
+    for (uint32_t i = 0; i < num_ops; i++)
+    {
+        uint64_t r = _xorshift64s(&rng);
+        p_ops[i].op = (uint8_t)(r % FUZZ_NUM_OPS);
+        p_ops[i].deferred = ((r >> 8) % 4) == 0;
+        // Short and long waits alike: the interesting things happen around the edges and the timeouts
+        uint32_t range = ((r >> 16) % 2) ? FUZZ_MAX_WAIT_MS : 200U;
+        p_ops[i].wait_ms = 1U + (uint32_t)((r >> 24) % range);
+    }
+}
+
+/* Door under test ---------------------------------------------------------------*/
+static void _door_reset(fuzz_door_t *p_door)
+{
+    port_system_set_millis(0);
+    fsm_automatic_door_init(p_door->p_fsm, &p_door->button, &p_door->led_open, &p_door->led_close, &p_door->pir, &p_door->motor);
+    event_queue_init(&p_door->queue);
+    p_door->num_pending = 0;
+}
+
+static uint32_t _door_reversals(fuzz_door_t *p_door)
+{
+    fsm_stats_data_t stats;
+    fsm_automatic_door_get_stats(p_door->p_fsm, &stats);
+    return stats.arcs[4]; // Arc 4 of fsm_trans_automatic_door: CLOSING -> OPENING
+}
+
+/* Check the invariants that must hold after every run of the main loop */
+static int _door_check(fuzz_door_t *p_door, bool planted, uint32_t reversals_before, bool reversal_due)
+{
+    int state = fsm_get_state(p_door->p_fsm);
+    bool blink_open = p_door->led_open.timer_active;
+    bool blink_close = p_door->led_close.timer_active;
+    uint32_t reversals = _door_reversals(p_door);
+
+    if (blink_open && blink_close)
+    {
+        return FUZZ_INV_BOTH_LEDS_BLINK;
+    }
+    if (state != CLOSED && !p_door->motor.timer_active)
+    {
+        return FUZZ_INV_MOTOR_NOT_ARMED;
+    }
+    if ((state == OPENING && !blink_open) || (state == CLOSING && !blink_close))
+    {
+        return FUZZ_INV_WRONG_LED;
+    }
+    if (state == CLOSED && fsm_automatic_door_check_activity(p_door->p_fsm))
+    {
+        return FUZZ_INV_ACTIVE_CLOSED;
+    }
+    if (state == CLOSING && (port_pir_sensor_get_status(&p_door->pir) || port_button_is_pressed(&p_door->button)))
+    {
+        return FUZZ_INV_CLOSING_WITH_PRESENCE;
+    }
+    if (reversal_due && reversals == reversals_before)
+    {
+        return FUZZ_INV_NO_REVERSAL;
+    }
+    if (planted && reversals != reversals_before)
+    {
+        return FUZZ_INV_PLANTED;
+    }
+    return FUZZ_OK;
+}
+
+/* Run the main loop: feed the pending events to the door and check the invariants */
+static int _door_main_loop(fuzz_door_t *p_door, bool planted)
+{
+    // The first presence or button press fed while CLOSING, with no timeout before it, must reverse the door.
+    // The timeout flag is set by its ISR before the main loop runs: if it is pending, an event fed before the presence
+    // or press (e.g. the release of a press already consumed) fires the door with the timeout, and it closes first
+    bool reversal_due = false;
+    if (fsm_get_state(p_door->p_fsm) == CLOSING)
+    {
+        bool timeout_pending = p_door->motor.timeout;
+        for (uint32_t i = 0; i < p_door->num_pending; i++)
+        {
+            uint8_t event = p_door->pending[i];
+            if (event == EVENT_MOTOR_TIMEOUT)
+            {
+                break;
+            }
+            if (event == EVENT_PIR_RISING || event == EVENT_BUTTON_PRESS)
+            {
+                reversal_due = (i == 0) || !timeout_pending;
+                break;
+            }
+        }
+    }
+    uint32_t reversals = _door_reversals(p_door);
+    fsm_automatic_door_fire_events(p_door->p_fsm, &p_door->queue);
+    p_door->num_pending = 0;
+    return _door_check(p_door, planted, reversals, reversal_due);
+}
+
+/* Play the role of an ISR: change the input as the hardware does and push its event */
+static void _door_isr(fuzz_door_t *p_door, uint8_t event)
+{
+    if (event == EVENT_MOTOR_TIMEOUT)
+    {
+        port_motor_set_timeout_status(&p_door->motor, true);
+    }
+    event_queue_push(&p_door->queue, event);
+    p_door->pending[p_door->num_pending++] = event;
+}
+
+/**
+ * @brief Run a case on a door from its initial status.
+ *
+ * @param p_door Door under test.
+ * @param p_ops Operations of the case.
+ * @param num_ops Number of operations.
+ * @param planted Check the planted invariant too.
+ * @param p_failed_op Where the index of the operation after which an invariant fails is stored.
+ * @param verbose Print every operation and the status of the door.
+ * @return int Violated invariant, `FUZZ_OK` if none.
+ */
+static int _case_run(fuzz_door_t *p_door, const fuzz_op_t *p_ops, uint32_t num_ops, bool planted, uint32_t *p_failed_op, bool verbose)
+{
+    bool pir = false;
+    bool button = false;
+    _door_reset(p_door);
+
+    for (uint32_t i = 0; i < num_ops; i++)
+    {
+        const char *what;
+        uint32_t now = port_system_get_millis();
+        switch (p_ops[i].op)
+        {
+        case FUZZ_OP_PIR:
+            pir = !pir;
+            _door_isr(p_door, pir ? EVENT_PIR_RISING : EVENT_PIR_FALLING);
+            what = pir ? "PIR rising" : "PIR falling";
+            break;
+        case FUZZ_OP_BUTTON:
+            button = !button;
+            _door_isr(p_door, button ? EVENT_BUTTON_PRESS : EVENT_BUTTON_RELEASE);
+            what = button ? "button press" : "button release";
+            break;
+        default:
+        {
+            uint32_t until = now + p_ops[i].wait_ms;
+            uint32_t deadline = p_door->motor.timer_start_ms + p_door->motor.timeout_ms;
+            if (p_door->motor.timer_active && deadline <= until)
+            {
+                port_system_set_millis(deadline > now ? deadline : now);
+                _door_isr(p_door, EVENT_MOTOR_TIMEOUT);
+                what = "motor timeout";
+            }
+            else
+            {
+                port_system_set_millis(until);
+                what = "wait";
+            }
+            break;
+        }
+        }
+
+        bool main_loop = !p_ops[i].deferred || p_door->num_pending == FUZZ_MAX_PENDING || i + 1 == num_ops;
+        int violation = FUZZ_OK;
+        if (main_loop)
+        {
+            violation = _door_main_loop(p_door, planted);
+        }
+        if (verbose)
+        {
+            printf("  %3" PRIu32 ": t=%6" PRIu32 " ms %-14s%s -> %s\n", i, port_system_get_millis(), what, main_loop ? "" : " (deferred)", fuzz_state_names[fsm_get_state(p_door->p_fsm)]);
+        }
+        if (violation != FUZZ_OK)
+        {
+            *p_failed_op = i;
+            return violation;
+        }
+    }
+    return FUZZ_OK;
+}
+
+/* Shrinking ----------------------------------------------------------------------*/
+/* Whether a candidate still fails the same invariant */
+static bool _shrink_try(fuzz_door_t *p_door, const fuzz_op_t *p_ops, uint32_t num_ops, bool planted, int violation)
+{
+    uint32_t failed_op;
+    return num_ops > 0 && _case_run(p_door, p_ops, num_ops, planted, &failed_op, false) == violation;
+}
+
+/* Copy a case without operations `i` and `j` (equal to remove only one) */
+static uint32_t _shrink_remove(fuzz_op_t *p_candidate, const fuzz_op_t *p_ops, uint32_t num_ops, uint32_t i, uint32_t j)
+{
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < num_ops; k++)
+    {
+        if (k != i && k != j)
+        {
+            p_candidate[n++] = p_ops[k];
+        }
+    }
+    return n;
+}
+
+/* Keep a candidate if it still fails the same invariant */
+static bool _shrink_accept(fuzz_door_t *p_door, fuzz_op_t *p_ops, uint32_t *p_num_ops, const fuzz_op_t *p_candidate, uint32_t num_candidate, bool planted, int violation)
+{
+    if (!_shrink_try(p_door, p_candidate, num_candidate, planted, violation))
+    {
+        return false;
+    }
+    memmove(p_ops, p_candidate, num_candidate * sizeof(fuzz_op_t));
+    *p_num_ops = num_candidate;
+    return true;
+}
+
+/**
+ * @brief Shrink a failing case while it keeps failing the same invariant: cut it after the failing operation, remove chunks of operations (halving their size down to one), remove pairs of toggles of the same input (a press and its release), merge consecutive waits and simplify the remaining operations (no deferral, shorter waits).
+ *
+ * @return uint32_t Number of operations of the shrunk case.
+ */
+static uint32_t _shrink(fuzz_door_t *p_door, fuzz_op_t *p_ops, uint32_t num_ops, bool planted, int violation, uint32_t failed_op)
+{
+    static fuzz_op_t candidate[FUZZ_MAX_OPS];
+    num_ops = failed_op + 1;
+
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+        for (uint32_t chunk = num_ops / 2 > 0 ? num_ops / 2 : 1; chunk > 0; chunk /= 2)
+        {
+            for (uint32_t start = 0; start + chunk <= num_ops;)
+            {
+                memcpy(candidate, p_ops, start * sizeof(fuzz_op_t));
+                memcpy(&candidate[start], &p_ops[start + chunk], (num_ops - start - chunk) * sizeof(fuzz_op_t));
+                if (_shrink_accept(p_door, p_ops, &num_ops, candidate, num_ops - chunk, planted, violation))
+                {
+                    progress = true;
+                }
+                else
+                {
+                    start++;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < num_ops; i++)
+        {
+            for (uint32_t j = i + 1; j < num_ops && p_ops[i].op != FUZZ_OP_WAIT; j++)
+            {
+                if (p_ops[j].op == p_ops[i].op)
+                {
+                    uint32_t n = _shrink_remove(candidate, p_ops, num_ops, i, j);
+                    progress |= _shrink_accept(p_door, p_ops, &num_ops, candidate, n, planted, violation);
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i + 1 < num_ops; i++)
+        {
+            if (p_ops[i].op == FUZZ_OP_WAIT && p_ops[i + 1].op == FUZZ_OP_WAIT)
+            {
+                uint32_t n = _shrink_remove(candidate, p_ops, num_ops, i + 1, i + 1);
+                uint32_t sum = p_ops[i].wait_ms + p_ops[i + 1].wait_ms;
+                candidate[i].wait_ms = sum < FUZZ_MAX_WAIT_MS ? sum : FUZZ_MAX_WAIT_MS;
+                candidate[i].deferred = p_ops[i + 1].deferred;
+                progress |= _shrink_accept(p_door, p_ops, &num_ops, candidate, n, planted, violation);
+            }
+        }
+
+        for (uint32_t i = 0; i < num_ops; i++)
+        {
+            fuzz_op_t saved = p_ops[i];
+            if (p_ops[i].deferred)
+            {
+                p_ops[i].deferred = false;
+                if (_shrink_try(p_door, p_ops, num_ops, planted, violation))
+                {
+                    progress = true;
+                    saved = p_ops[i];
+                }
+                p_ops[i] = saved;
+            }
+            while (p_ops[i].op == FUZZ_OP_WAIT && p_ops[i].wait_ms > 1)
+            {
+                p_ops[i].wait_ms /= 2;
+                if (!_shrink_try(p_door, p_ops, num_ops, planted, violation))
+                {
+                    p_ops[i] = saved;
+                    break;
+                }
+                progress = true;
+                saved = p_ops[i];
+            }
+        }
+    }
+    return num_ops;
+}
+
+/* Workers -----------------------------------------------------------------------*/
+static void *_worker(void *p_arg)
+{
+    fuzz_worker_t *p_worker = (fuzz_worker_t *)p_arg;
+    fuzz_t *p_fuzz = p_worker->p_fuzz;
+    fuzz_door_t *p_door = &p_fuzz->p_doors[p_worker->worker];
+    fuzz_op_t ops[FUZZ_MAX_OPS];
+    uint64_t steps = 0;
+
+    while (1)
+    {
+        uint64_t first = atomic_fetch_add(&p_fuzz->next, FUZZ_BATCH_CASES);
+        // Cases after a known failure are not needed: only the lowest failing case is reported
+        if (first >= p_fuzz->num_cases || first > atomic_load(&p_fuzz->failed))
+        {
+            break;
+        }
+        uint64_t last = first + FUZZ_BATCH_CASES < p_fuzz->num_cases ? first + FUZZ_BATCH_CASES : p_fuzz->num_cases;
+        for (uint64_t index = first; index < last; index++)
+        {
+            uint32_t failed_op;
+            _case_generate(p_fuzz->seed, index, ops, p_fuzz->num_ops);
+            int violation = _case_run(p_door, ops, p_fuzz->num_ops, p_fuzz->planted, &failed_op, false);
+            steps += violation == FUZZ_OK ? p_fuzz->num_ops : failed_op + 1;
+            if (violation != FUZZ_OK)
+            {
+                uint64_t failed = atomic_load(&p_fuzz->failed);
+                while (index < failed && !atomic_compare_exchange_weak(&p_fuzz->failed, &failed, index))
+                {
+                }
+                break;
+            }
+        }
+    }
+    atomic_fetch_add(&p_fuzz->steps, steps);
+    return NULL;
+}
+
+static double _now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t num_threads = num_cpus > 0 ? (uint32_t)num_cpus : 1;
+    fuzz_t fuzz = {.num_cases = FUZZ_DEFAULT_CASES, .num_ops = FUZZ_DEFAULT_OPS, .seed = 1, .planted = false};
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--cases") == 0 && i + 1 < argc)
+        {
+            fuzz.num_cases = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+        {
+            fuzz.num_ops = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            num_threads = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            fuzz.seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--planted") == 0)
+        {
+            fuzz.planted = true;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--cases <n>] [--ops <n>] [--threads <n>] [--seed <n>] [--planted]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_threads == 0 || num_threads > FUZZ_MAX_THREADS || fuzz.num_ops == 0 || fuzz.num_ops > FUZZ_MAX_OPS)
+    {
+        fprintf(stderr, "The number of threads must be 1..%d and the operations per case 1..%d\n", FUZZ_MAX_THREADS, FUZZ_MAX_OPS);
+        return 2;
+    }
+
+    // The doors are created here: the static pool of doors is not thread-safe
+    fuzz.p_doors = calloc(num_threads, sizeof(fuzz_door_t));
+    for (uint32_t t = 0; t < num_threads; t++)
+    {
+        fuzz_door_t *p_door = &fuzz.p_doors[t];
+        p_door->p_fsm = fsm_automatic_door_new(&p_door->button, &p_door->led_open, &p_door->led_close, &p_door->pir, &p_door->motor);
+        if (p_door->p_fsm == NULL)
+        {
+            fprintf(stderr, "Cannot create %" PRIu32 " doors\n", num_threads);
+            return 1;
+        }
+    }
+    atomic_init(&fuzz.next, 0);
+    atomic_init(&fuzz.failed, FUZZ_NO_FAILURE);
+    atomic_init(&fuzz.steps, 0);
+
+    printf("Fuzzing %" PRIu64 " cases of %" PRIu32 " operations (seed %" PRIu64 ") on %" PRIu32 " threads%s\n", fuzz.num_cases, fuzz.num_ops, fuzz.seed, num_threads, fuzz.planted ? ", with the planted invariant" : "");
+    double t0 = _now_s();
+    pthread_t threads[FUZZ_MAX_THREADS];
+    fuzz_worker_t workers[FUZZ_MAX_THREADS];
+    for (uint32_t t = 0; t < num_threads; t++)
+    {
+        workers[t] = (fuzz_worker_t){.p_fuzz = &fuzz, .worker = t};
+        pthread_create(&threads[t], NULL, _worker, &workers[t]);
+    }
+    for (uint32_t t = 0; t < num_threads; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    double elapsed = _now_s() - t0;
+    uint64_t steps = atomic_load(&fuzz.steps);
+    printf("%" PRIu64 " operations in %.2f s (%.1f M operations/s)\n", steps, elapsed, (double)steps / (elapsed > 0.0 ? elapsed : 1e-9) / 1e6);
+
+    int rc = 0;
+    uint64_t failed = atomic_load(&fuzz.failed);
+    if (failed == FUZZ_NO_FAILURE)
+    {
+        printf("No invariant violated\n");
+        rc = fuzz.planted ? 1 : 0;
+    }
+    else
+    {
+        // Shrink and print the reproducer on this thread
+        fuzz_door_t *p_door = &fuzz.p_doors[0];
+        fuzz_op_t ops[FUZZ_MAX_OPS];
+        uint32_t failed_op;
+        _case_generate(fuzz.seed, failed, ops, fuzz.num_ops);
+        int violation = _case_run(p_door, ops, fuzz.num_ops, fuzz.planted, &failed_op, false);
+        uint32_t num_ops = _shrink(p_door, ops, fuzz.num_ops, fuzz.planted, violation, failed_op);
+
+        printf("Case %" PRIu64 " violates: %s (after operation %" PRIu32 ")\n", failed, fuzz_invariant_names[violation], failed_op);
+        printf("Shrunk to %" PRIu32 " operations:\n", num_ops);
+        _case_run(p_door, ops, num_ops, fuzz.planted, &failed_op, true);
+        rc = (fuzz.planted && violation == FUZZ_INV_PLANTED && num_ops <= FUZZ_PLANTED_MAX_OPS) ? 0 : 1;
+    }
+
+    for (uint32_t t = 0; t < num_threads; t++)
+    {
+        fsm_automatic_door_delete(fuzz.p_doors[t].p_fsm);
+    }
+    free(fuzz.p_doors);
+    return rc;
+}
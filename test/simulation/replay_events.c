@@ -0,0 +1,357 @@
+/**
+ * @file replay_events.c
+ * @brief Record and replay of the input events of an automatic door (native platform).
+ *
+ * A log written by the event recorder (`event_record.h`, see `fsm_automatic_door_set_record()`) is replayed on a new, unmodified `fsm_automatic_door_t`: for each record the virtual time is set to its timestamp, the event is pushed and `fsm_automatic_door_fire_events()` is called, exactly as the main loop does on the board. If the log starts with `EVENT_RECORD_POSITION_FEEDBACK`, the door was recorded with position feedback: the motor of the replay gets end switches, pressed by the `EVENT_MOTOR_END_OF_TRAVEL` of the log, so that the movements end where they ended on the recorded door. There are no waits, so the replay runs as fast as the FSM does. The transitions and a digest of the sequence (time, event and state after each event) are reported: the same log always gives the same digest.
+ *
+ * To get logs without a board, `--record` drives a door with synthetic traffic (Poisson arrivals seen by the PIR sensor or pressing the button) with the recorder attached and writes the log. `--self-test` records some hours of traffic in memory, replays them twice and fails if the digests differ from the recording or if the replay is not at least 1000 times faster than real time.
+ *
+ * Usage:
+ * - `replay_events [-v] <log_file>`: replay a log (`-v` prints every transition)
+ * - `replay_events --record <hours> <log_file> [seed]`: record synthetic traffic
+ * - `replay_events --self-test [hours]`
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+#include "fsm_automatic_door.h"
+
+#define REPLAY_NEVER UINT32_MAX                 /*!< Time of an event that will not happen */
+#define REPLAY_BUFFER_SIZE (16U * 1024U * 1024U) /*!< Size of the buffer of the recorder (about 6 months of busy traffic) */
+#define REPLAY_MAX_HOURS 1000U                  /*!< Maximum hours of synthetic traffic (the virtual time is 32-bit milliseconds) */
+#define REPLAY_MIN_SPEEDUP 1000.0               /*!< Minimum speedup over real time required by the self-test */
+#define REPLAY_RATE_PER_HOUR 240.0              /*!< Arrivals per hour of the synthetic traffic */
+#define REPLAY_BUTTON_RATIO 0.1                 /*!< Fraction of the arrivals that press the button */
+#define REPLAY_PIR_HOLD_MS 2000U                /*!< Time the PIR sensor detects a person */
+#define REPLAY_BUTTON_HOLD_MS 300U              /*!< Time a person keeps the button pressed */
+
+static const char *const p_event_names[] = {"NONE", "PIR_RISING", "PIR_FALLING", "BUTTON_PRESS", "BUTTON_RELEASE", "MOTOR_TIMEOUT", "END_OF_TRAVEL"};
+static const char *const p_state_names[] = {"CLOSED", "OPENING", "OPEN", "CLOSING"};
+
+/**
+ * @brief Result of a run (recording or replay).
+ */
+typedef struct
+{
+    uint32_t events;      /*!< Events fed to the door */
+    uint32_t transitions; /*!< Transitions to a different state */
+    uint32_t last_ms;     /*!< Time of the last event */
+    int final_state;      /*!< State of the door at the end */
+    uint64_t digest;      /*!< FNV-1a digest of (time, event, state after the event) of every event */
+} replay_result_t;
+
+/* Helpers ----------------------------------------------------------------------*/
+static double _now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t _fnv1a(uint64_t hash, uint32_t value)
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        hash ^= (value >> (8 * i)) & 0xFFU;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static fsm_t *_door_new(event_queue_t *p_queue)
+{
+    port_system_init();
+    event_queue_init(p_queue);
+    motor_automatic_door.end_switches = false;
+    return fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+/* Feed an event to the door at time `now` and update the result */
+static void _feed(fsm_t *p_fsm, event_queue_t *p_queue, uint32_t now, uint8_t event, replay_result_t *p_result, bool verbose)
+{
+    int state = fsm_get_state(p_fsm);
+    port_system_set_millis(now);
+    if (event == EVENT_MOTOR_TIMEOUT)
+    {
+        // The event comes from the ISR of the timer, which sets the timeout before pushing it
+        port_motor_set_timeout_status(&motor_automatic_door, true);
+    }
+    else if (event == EVENT_MOTOR_END_OF_TRAVEL)
+    {
+        // And this one from the position sensor, which stops the motor at the end of the travel
+        port_motor_sim_set_end_of_travel(&motor_automatic_door);
+    }
+    event_queue_push(p_queue, event);
+    fsm_automatic_door_fire_events(p_fsm, p_queue);
+    int new_state = fsm_get_state(p_fsm);
+
+    if (new_state != state)
+    {
+        p_result->transitions++;
+        if (verbose)
+        {
+            printf("%10" PRIu32 " ms  %-14s  %-7s -> %s\n", now, (event < sizeof(p_event_names) / sizeof(p_event_names[0])) ? p_event_names[event] : "UNKNOWN", p_state_names[state], p_state_names[new_state]);
+        }
+    }
+    p_result->events++;
+    p_result->last_ms = now;
+    p_result->final_state = new_state;
+    p_result->digest = _fnv1a(_fnv1a(_fnv1a(p_result->digest, now), event), (uint32_t)new_state);
+}
+
+/* Random numbers (xorshift64*) */
+static double _uniform(uint64_t *p_state)
+{
+    uint64_t x = *p_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *p_state = x;
+    return (double)(((x * 0x2545F4914F6CDD1DULL) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+static uint32_t _interarrival_ms(uint64_t *p_rng)
+{
+    double dt = -log(_uniform(p_rng)) * 3600000.0 / REPLAY_RATE_PER_HOUR;
+    return dt < 1.0 ? 1 : (uint32_t)dt;
+}
+
+/* Record and replay ------------------------------------------------------------*/
+/* Drive a door with synthetic traffic for `duration_ms` with the recorder attached */
+static void _record(event_record_t *p_record, uint32_t duration_ms, uint64_t seed, replay_result_t *p_result)
+{
+    event_queue_t queue;
+    fsm_t *p_fsm = _door_new(&queue);
+    fsm_automatic_door_set_record(p_fsm, p_record);
+    *p_result = (replay_result_t){.digest = 0xCBF29CE484222325ULL};
+
+    uint64_t rng = seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint32_t next_arrival_ms = _interarrival_ms(&rng);
+    uint32_t pir_falling_ms = REPLAY_NEVER;
+    uint32_t button_release_ms = REPLAY_NEVER;
+
+    while (1)
+    {
+        // Next event of any kind
+        uint32_t now = next_arrival_ms;
+        now = pir_falling_ms < now ? pir_falling_ms : now;
+        now = button_release_ms < now ? button_release_ms : now;
+        uint32_t timeout_ms = motor_automatic_door.timer_active ? motor_automatic_door.timer_start_ms + motor_automatic_door.timeout_ms : REPLAY_NEVER;
+        now = timeout_ms < now ? timeout_ms : now;
+        if (now >= duration_ms)
+        {
+            break;
+        }
+
+        // Events due at the same time are fed in a fixed order: motor timeout, PIR falling, button release, new arrival
+        if (timeout_ms <= now)
+        {
+            _feed(p_fsm, &queue, now, EVENT_MOTOR_TIMEOUT, p_result, false);
+        }
+        if (pir_falling_ms <= now)
+        {
+            pir_falling_ms = REPLAY_NEVER;
+            _feed(p_fsm, &queue, now, EVENT_PIR_FALLING, p_result, false);
+        }
+        if (button_release_ms <= now)
+        {
+            button_release_ms = REPLAY_NEVER;
+            _feed(p_fsm, &queue, now, EVENT_BUTTON_RELEASE, p_result, false);
+        }
+        if (next_arrival_ms <= now)
+        {
+            if (_uniform(&rng) <= REPLAY_BUTTON_RATIO)
+            {
+                if (button_release_ms == REPLAY_NEVER)
+                {
+                    _feed(p_fsm, &queue, now, EVENT_BUTTON_PRESS, p_result, false);
+                }
+                button_release_ms = now + REPLAY_BUTTON_HOLD_MS;
+            }
+            else
+            {
+                // A person arriving while the sensor already detects someone only extends the detection
+                if (pir_falling_ms == REPLAY_NEVER)
+                {
+                    _feed(p_fsm, &queue, now, EVENT_PIR_RISING, p_result, false);
+                }
+                pir_falling_ms = now + REPLAY_PIR_HOLD_MS;
+            }
+            next_arrival_ms = now + _interarrival_ms(&rng);
+        }
+    }
+    fsm_automatic_door_delete(p_fsm);
+}
+
+/* Replay a log on a new door. It returns false if the log is truncated */
+static bool _replay(const uint8_t *p_buffer, uint32_t length, replay_result_t *p_result, bool verbose)
+{
+    event_queue_t queue;
+    fsm_t *p_fsm = _door_new(&queue);
+    event_record_reader_t reader;
+    uint32_t timestamp_ms;
+    uint8_t event;
+
+    *p_result = (replay_result_t){.digest = 0xCBF29CE484222325ULL};
+    event_record_reader_init(&reader, p_buffer, length);
+    while (event_record_read(&reader, &timestamp_ms, &event))
+    {
+        if (event == EVENT_RECORD_POSITION_FEEDBACK)
+        {
+            motor_automatic_door.end_switches = true;
+            continue;
+        }
+        _feed(p_fsm, &queue, timestamp_ms, event, p_result, verbose);
+    }
+    fsm_automatic_door_delete(p_fsm);
+    return reader.pos == length;
+}
+
+static void _print_result(const char *p_label, const replay_result_t *p_result)
+{
+    printf("%s: %" PRIu32 " events, %" PRIu32 " transitions, %.2f h, final state %s, digest 0x%016" PRIx64 "\n", p_label, p_result->events, p_result->transitions,
+           p_result->last_ms / 3600000.0, p_state_names[p_result->final_state], p_result->digest);
+}
+
+/* Commands ---------------------------------------------------------------------*/
+static int _cmd_replay(const char *p_path, bool verbose)
+{
+    FILE *p_file = fopen(p_path, "rb");
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "Cannot open log file %s\n", p_path);
+        return EXIT_FAILURE;
+    }
+    uint8_t *p_buffer = malloc(REPLAY_BUFFER_SIZE);
+    uint32_t length = (uint32_t)fread(p_buffer, 1, REPLAY_BUFFER_SIZE, p_file);
+    fclose(p_file);
+
+    replay_result_t result;
+    double start = _now_s();
+    bool complete = _replay(p_buffer, length, &result, verbose);
+    double wall_s = _now_s() - start;
+    free(p_buffer);
+
+    _print_result("Replay", &result);
+    printf("Replayed %.2f h in %.3f s (%.0fx real time)\n", result.last_ms / 3600000.0, wall_s, result.last_ms / 1000.0 / wall_s);
+    if (!complete)
+    {
+        fprintf(stderr, "The log ends with a truncated record\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int _cmd_record(uint32_t hours, const char *p_path, uint64_t seed)
+{
+    uint8_t *p_buffer = malloc(REPLAY_BUFFER_SIZE);
+    event_record_t record;
+    replay_result_t result;
+
+    event_record_init(&record, p_buffer, REPLAY_BUFFER_SIZE);
+    _record(&record, hours * 3600000U, seed, &result);
+    _print_result("Record", &result);
+    printf("Log: %" PRIu32 " records in %" PRIu32 " bytes (%.2f bytes/event), %" PRIu32 " dropped\n", event_record_get_count(&record), event_record_get_length(&record),
+           (double)event_record_get_length(&record) / event_record_get_count(&record), event_record_get_dropped(&record));
+
+    FILE *p_file = fopen(p_path, "wb");
+    bool ok = (p_file != NULL) && (fwrite(p_buffer, 1, event_record_get_length(&record), p_file) == event_record_get_length(&record));
+    if (p_file != NULL)
+    {
+        fclose(p_file);
+    }
+    free(p_buffer);
+    if (!ok)
+    {
+        fprintf(stderr, "Cannot write log file %s\n", p_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int _cmd_self_test(uint32_t hours)
+{
+    uint8_t *p_buffer = malloc(REPLAY_BUFFER_SIZE);
+    event_record_t record;
+    replay_result_t recorded, replayed[2];
+    double wall_s[2];
+    int rc = EXIT_SUCCESS;
+
+    event_record_init(&record, p_buffer, REPLAY_BUFFER_SIZE);
+    _record(&record, hours * 3600000U, 1, &recorded);
+    _print_result("Record", &recorded);
+    printf("Log: %" PRIu32 " bytes (%.2f bytes/event)\n", event_record_get_length(&record), (double)event_record_get_length(&record) / event_record_get_count(&record));
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        double start = _now_s();
+        _replay(p_buffer, event_record_get_length(&record), &replayed[i], false);
+        wall_s[i] = _now_s() - start;
+        _print_result("Replay", &replayed[i]);
+    }
+    free(p_buffer);
+
+    double speedup = recorded.last_ms / 1000.0 / wall_s[1];
+    printf("Replayed %.2f h in %.3f s (%.0fx real time)\n", recorded.last_ms / 3600000.0, wall_s[1], speedup);
+
+    if ((event_record_get_dropped(&record) != 0) || (replayed[0].digest != recorded.digest) || (replayed[1].digest != recorded.digest))
+    {
+        fprintf(stderr, "FAIL: the replay does not reproduce the recording\n");
+        rc = EXIT_FAILURE;
+    }
+    if (speedup < REPLAY_MIN_SPEEDUP)
+    {
+        fprintf(stderr, "FAIL: the replay is slower than %.0fx real time\n", REPLAY_MIN_SPEEDUP);
+        rc = EXIT_FAILURE;
+    }
+    return rc;
+}
+
+static bool _parse_hours(const char *p_text, uint32_t *p_hours)
+{
+    *p_hours = (uint32_t)strtoul(p_text, NULL, 10);
+    if ((*p_hours == 0) || (*p_hours > REPLAY_MAX_HOURS))
+    {
+        fprintf(stderr, "The hours of traffic must be between 1 and %" PRIu32 "\n", REPLAY_MAX_HOURS);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t hours = 24;
+
+    if ((argc >= 2) && (strcmp(argv[1], "--self-test") == 0))
+    {
+        if ((argc >= 3) && !_parse_hours(argv[2], &hours))
+        {
+            return EXIT_FAILURE;
+        }
+        return _cmd_self_test(hours);
+    }
+    if ((argc >= 4) && (strcmp(argv[1], "--record") == 0))
+    {
+        if (!_parse_hours(argv[2], &hours))
+        {
+            return EXIT_FAILURE;
+        }
+        return _cmd_record(hours, argv[3], argc >= 5 ? strtoull(argv[4], NULL, 10) : 1);
+    }
+    if ((argc == 3) && (strcmp(argv[1], "-v") == 0))
+    {
+        return _cmd_replay(argv[2], true);
+    }
+    if (argc == 2)
+    {
+        return _cmd_replay(argv[1], false);
+    }
+    fprintf(stderr, "Usage: %s [-v] <log_file> | --record <hours> <log_file> [seed] | --self-test [hours]\n", argv[0]);
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file sim_door_plant.c
+ * @brief Closed-loop simulation of the automatic door with the physical model of its leaf (native platform).
+ *
+ * A real `fsm_automatic_door_t` drives a motor with its speed profile, and the motor pushes the leaf of `port_door_sim.h` (mass, viscous and Coulomb friction, travel between two end stops). The same door is run twice: with position feedback, where the opening and the closing end when the leaf reaches the end stop and the timeout is only a fault limit, and with the timeout only, where every movement lasts `AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS`.
+ *
+ * For each reversal point (a presence at 10 %, 20 %, ..., 90 % of the closing) the time from the reversal to the door `OPEN` is reported for both doors, together with the position of the leaf when it reverses. The door with position feedback only travels back the way it has closed, so it saves the most on early reversals. The program fails if the door with position feedback is not fully open at the end of any reopening or if it is not faster than the timeout.
+ *
+ * Usage: `sim_door_plant [-v]` (`-v` prints the position of the leaf every 100 ms of every reopening)
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "fsm_automatic_door.h"
+
+#define PLANT_REVERSAL_STEPS 10      /*!< The closing is split in this many parts: a reversal at the end of each one but the last */
+#define PLANT_MAX_MS 60000U          /*!< Maximum time to wait for a state of the door */
+#define PLANT_VERBOSE_PERIOD_MS 100U /*!< Period of the positions printed with `-v` */
+
+/**
+ * @brief A door with its own simulated peripherals and leaf.
+ */
+typedef struct
+{
+    fsm_t *p_fsm;            /*!< Automatic door FSM */
+    port_button_hw_t button; /*!< Button of the door */
+    port_led_hw_t led_open;  /*!< Opening LED of the door */
+    port_led_hw_t led_close; /*!< Closing LED of the door */
+    port_pir_hw_t pir;       /*!< PIR sensor of the door */
+    port_motor_hw_t motor;   /*!< Motor of the door */
+    motor_profile_t profile; /*!< Speed profile of the motor */
+    port_door_sim_t leaf;    /*!< Leaf moved by the motor */
+    event_queue_t queue;     /*!< Events pushed by the "ISRs" */
+} plant_door_t;
+
+/* Door under test ---------------------------------------------------------------*/
+static bool _door_new(plant_door_t *p_door, bool feedback)
+{
+    memset(p_door, 0, sizeof(*p_door));
+    p_door->leaf = door_sim_automatic_door; // Same parameters as the leaf of the board
+    port_door_sim_init(&p_door->leaf, 0.0);
+    p_door->motor.p_profile = &p_door->profile;
+    p_door->motor.p_event_queue = &p_door->queue;
+    p_door->motor.p_door = feedback ? &p_door->leaf : NULL;
+    event_queue_init(&p_door->queue);
+    port_system_set_millis(0);
+    p_door->p_fsm = fsm_automatic_door_new(&p_door->button, &p_door->led_open, &p_door->led_close, &p_door->pir, &p_door->motor);
+    return p_door->p_fsm != NULL;
+}
+
+/* Push the leaf for a millisecond. Without position feedback the motor does not know about the leaf, but it is pushed all the same */
+static void _door_step_leaf(plant_door_t *p_door)
+{
+    if (p_door->motor.p_door != NULL)
+    {
+        port_motor_sim_step(&p_door->motor, 1);
+        return;
+    }
+    double force = p_door->leaf.force_n * (double)port_motor_get_duty(&p_door->motor) / (double)p_door->profile.full_scale;
+    port_door_sim_step(&p_door->leaf, p_door->motor.direction_open ? force : -force, 1);
+    port_motor_sim_step(&p_door->motor, 1);
+}
+
+/* Play the role of an ISR: change the input as the hardware does, push its event and run the main loop */
+static void _door_isr(plant_door_t *p_door, uint8_t event)
+{
+    if (event == EVENT_MOTOR_TIMEOUT)
+    {
+        port_motor_set_timeout_status(&p_door->motor, true);
+    }
+    else if (event == EVENT_PIR_RISING || event == EVENT_PIR_FALLING)
+    {
+        port_pir_sensor_set_status(&p_door->pir, event == EVENT_PIR_RISING);
+    }
+    event_queue_push(&p_door->queue, event);
+    fsm_automatic_door_fire_events(p_door->p_fsm, &p_door->queue);
+}
+
+/* Run the door a millisecond at a time until it is in `state` or `max_ms` have passed. Returns the time it took */
+static uint32_t _door_run(plant_door_t *p_door, int state, uint32_t max_ms, bool verbose)
+{
+    uint32_t start = port_system_get_millis();
+    while ((fsm_get_state(p_door->p_fsm) != state) && (port_system_get_millis() - start < max_ms))
+    {
+        // The leaf moves during the millisecond, and the timeout that expires at its end interrupts after it
+        _door_step_leaf(p_door);
+        fsm_automatic_door_fire_events(p_door->p_fsm, &p_door->queue);
+        uint32_t now = port_system_get_millis() + 1;
+        port_system_set_millis(now);
+        if (p_door->motor.timer_active && (now - p_door->motor.timer_start_ms >= p_door->motor.timeout_ms))
+        {
+            _door_isr(p_door, EVENT_MOTOR_TIMEOUT);
+        }
+        if (verbose && ((now - start) % PLANT_VERBOSE_PERIOD_MS == 0))
+        {
+            printf("    t=%5" PRIu32 " ms  x=%.3f m  v=%.3f m/s\n", now - start, p_door->leaf.position_m, p_door->leaf.velocity_m_s);
+        }
+    }
+    return port_system_get_millis() - start;
+}
+
+/* Open the door fully and start closing it. Returns the time of the full opening */
+static uint32_t _door_open_and_close(plant_door_t *p_door)
+{
+    _door_isr(p_door, EVENT_PIR_RISING);
+    _door_isr(p_door, EVENT_PIR_FALLING);
+    uint32_t opening_ms = _door_run(p_door, OPEN, PLANT_MAX_MS, false);
+    _door_run(p_door, CLOSING, PLANT_MAX_MS, false);
+    return opening_ms;
+}
+
+/**
+ * @brief Result of a reversal.
+ */
+typedef struct
+{
+    uint32_t position;  /*!< Position of the leaf when the door reverses, in per mille */
+    uint32_t reopen_ms; /*!< Time from the reversal to the door `OPEN` */
+    bool fully_open;    /*!< Whether the door is `OPEN` with the leaf at the open end stop */
+} plant_reversal_t;
+
+/* Close the door for `closing_ms`, reverse it with a presence and wait until it is open again */
+static bool _door_reversal(bool feedback, uint32_t closing_ms, plant_reversal_t *p_result, bool verbose)
+{
+    plant_door_t door;
+    if (!_door_new(&door, feedback))
+    {
+        return false;
+    }
+    _door_open_and_close(&door);
+    _door_run(&door, CLOSED, closing_ms, false);
+    p_result->position = (uint32_t)(door.leaf.position_m / door.leaf.length_m * MOTOR_POSITION_OPEN + 0.5);
+
+    _door_isr(&door, EVENT_PIR_RISING);
+    _door_isr(&door, EVENT_PIR_FALLING);
+    p_result->reopen_ms = _door_run(&door, OPEN, PLANT_MAX_MS, verbose);
+    p_result->fully_open = (fsm_get_state(door.p_fsm) == OPEN) && port_door_sim_is_at_stop(&door.leaf, true);
+    fsm_automatic_door_delete(door.p_fsm);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    bool verbose = (argc == 2) && (strcmp(argv[1], "-v") == 0);
+    if ((argc > 2) || ((argc == 2) && !verbose))
+    {
+        fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("Leaf: %.1f kg, viscous friction %.1f N/(m/s), Coulomb friction %.1f N, %.1f N at full duty, travel %.2f m\n", door_sim_automatic_door.mass_kg,
+           door_sim_automatic_door.viscous_ns_m, door_sim_automatic_door.coulomb_n, door_sim_automatic_door.force_n, door_sim_automatic_door.length_m);
+
+    // Full travels
+    plant_door_t door;
+    uint32_t full_ms[2];
+    uint32_t full_closing_ms[2];
+    for (int feedback = 0; feedback < 2; feedback++)
+    {
+        if (!_door_new(&door, feedback))
+        {
+            fprintf(stderr, "Cannot create the door\n");
+            return EXIT_FAILURE;
+        }
+        full_ms[feedback] = _door_open_and_close(&door);
+        full_closing_ms[feedback] = _door_run(&door, CLOSED, PLANT_MAX_MS, false);
+        fsm_automatic_door_delete(door.p_fsm);
+    }
+    printf("Full opening: %" PRIu32 " ms with position feedback, %" PRIu32 " ms with the timeout only\n", full_ms[1], full_ms[0]);
+    printf("Full closing: %" PRIu32 " ms with position feedback, %" PRIu32 " ms with the timeout only\n\n", full_closing_ms[1], full_closing_ms[0]);
+
+    // Reversals while closing
+    printf("Reversal  Position  Reopening (feedback)  Reopening (timeout)  Saved\n");
+    uint64_t total_feedback_ms = 0;
+    uint64_t total_timeout_ms = 0;
+    bool ok = full_ms[1] < full_ms[0];
+    for (uint32_t i = 1; i < PLANT_REVERSAL_STEPS; i++)
+    {
+        uint32_t closing_ms = AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS * i / PLANT_REVERSAL_STEPS;
+        plant_reversal_t with_feedback;
+        plant_reversal_t with_timeout;
+        if (verbose)
+        {
+            printf("  Reversal after %" PRIu32 " ms of closing, with position feedback:\n", closing_ms);
+        }
+        if (!_door_reversal(true, closing_ms, &with_feedback, verbose) || !_door_reversal(false, closing_ms, &with_timeout, false))
+        {
+            fprintf(stderr, "Cannot create the door\n");
+            return EXIT_FAILURE;
+        }
+        uint32_t saved_ms = (with_timeout.reopen_ms > with_feedback.reopen_ms) ? with_timeout.reopen_ms - with_feedback.reopen_ms : 0;
+        printf("  %3" PRIu32 " %%    %5.1f %%  %17" PRIu32 " ms  %16" PRIu32 " ms  %5" PRIu32 " ms (%4.1f%%)\n", 100U * i / PLANT_REVERSAL_STEPS, with_feedback.position / 10.0,
+               with_feedback.reopen_ms, with_timeout.reopen_ms, saved_ms, 100.0 * saved_ms / with_timeout.reopen_ms);
+        total_feedback_ms += with_feedback.reopen_ms;
+        total_timeout_ms += with_timeout.reopen_ms;
+        ok = ok && with_feedback.fully_open && (with_feedback.reopen_ms < with_timeout.reopen_ms);
+    }
+
+    printf("\nReopening after a reversal: %.0f ms on average with position feedback, %.0f ms with the timeout only: %.1f%% shorter\n",
+           (double)total_feedback_ms / (PLANT_REVERSAL_STEPS - 1), (double)total_timeout_ms / (PLANT_REVERSAL_STEPS - 1),
+           100.0 * (double)(total_timeout_ms - total_feedback_ms) / (double)total_timeout_ms);
+    if (!ok)
+    {
+        printf("FAILED: the door with position feedback is not fully open or not faster than the timeout\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,674 @@
+/**
+ * @file sim_fleet.c
+ * @brief Multi-threaded discrete-event simulator of a fleet of automatic doors (native platform).
+ *
+ * Every door is a real `fsm_automatic_door_t` with its own simulated peripherals. People arrive at each door as a Poisson process: most of them are seen by the PIR sensor for `pir_hold_ms`, some press the button for `button_hold_ms`. The motor timeout expires when the motor timer of the door says so. Each input is pushed as an event and fed to the door with `fsm_automatic_door_fire_events()`, exactly as the ISRs and the main loop do on the board.
+ *
+ * The doors are split into a fixed number of shards. A shard keeps its own virtual clock and processes the events of its doors in time order (a binary heap keyed by the next event time of each door). The simulated time is cut into windows of `window_ms`: in every window each worker thread takes shards from its own deque and, when it runs out, steals shards from the deques of the other workers; all the shards reach the end of the window before any of them starts the next one (conservative synchronisation). Doors do not interact and the inputs of a door only depend on its own random generator, so the results do not depend on the number of threads nor on which thread runs each shard.
+ *
+ * The scenario is run with 1 thread and with N threads. The wall-clock time, the speedup and a checksum of the final status of all the doors are reported; the program fails if the checksums differ.
+ *
+ * Usage: `sim_fleet <scenario_file> [num_threads]`
+ * @author agent (agent@local)
+ * @date 2026-10-17
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "fsm_automatic_door.h"
+
+#define SIM_NEVER UINT32_MAX    /*!< Time of an event that will not happen */
+#define SIM_MAX_THREADS 64      /*!< Maximum number of worker threads */
+#define SIM_MAX_LINE 128        /*!< Maximum length of a line of the scenario file */
+
+/**
+ * @brief Scenario of the simulation, read from the scenario file.
+ */
+typedef struct
+{
+    uint32_t doors;          /*!< Number of doors */
+    double rate_per_hour;    /*!< Mean number of people arriving at each door per hour */
+    uint32_t duration_s;     /*!< Simulated time in seconds */
+    double button_ratio;     /*!< Fraction of the arrivals that press the button instead of being seen by the PIR sensor */
+    uint32_t pir_hold_ms;    /*!< Time the PIR sensor detects a person */
+    uint32_t button_hold_ms; /*!< Time a person keeps the button pressed */
+    uint64_t seed;           /*!< Seed of the random generators */
+    uint32_t shards;         /*!< Number of shards (it must not depend on the number of threads) */
+    uint32_t window_ms;      /*!< Synchronisation window of the shards */
+} sim_scenario_t;
+
+/**
+ * @brief A simulated door: the FSM, its peripherals and its pending inputs.
+ */
+typedef struct
+{
+    fsm_t *p_fsm;                 /*!< Automatic door FSM */
+    port_button_hw_t button;      /*!< Button of the door */
+    port_led_hw_t led_open;       /*!< Opening LED of the door */
+    port_led_hw_t led_close;      /*!< Closing LED of the door */
+    port_pir_hw_t pir;            /*!< PIR sensor of the door */
+    port_motor_hw_t motor;        /*!< Motor of the door */
+    uint64_t rng;                 /*!< State of the random generator of the door */
+    uint32_t next_arrival_ms;     /*!< Time of the next arrival */
+    uint32_t pir_falling_ms;      /*!< Time at which the PIR sensor stops detecting presence */
+    uint32_t button_release_ms;   /*!< Time at which the button is released */
+    uint32_t next_event_ms;       /*!< Time of the next event of any kind */
+    uint32_t events;              /*!< Events fed to the FSM */
+    uint32_t state_changes;       /*!< Transitions to a different state */
+    uint32_t openings;            /*!< Transitions to OPENING */
+} sim_door_t;
+
+/**
+ * @brief A shard: a contiguous block of doors with its own virtual clock.
+ */
+typedef struct
+{
+    uint32_t first_door;    /*!< Index of the first door of the shard */
+    uint32_t num_doors;     /*!< Number of doors of the shard */
+    uint32_t *p_heap;       /*!< Binary min-heap of doors (global indexes) keyed by (`next_event_ms`, index) */
+    uint32_t clock_ms;      /*!< Virtual clock of the shard */
+    uint32_t active_doors;  /*!< Doors of the shard that are not CLOSED */
+} sim_shard_t;
+
+/**
+ * @brief Deque of shards of a worker. The owner takes from the tail and the thieves from the head.
+ */
+typedef struct
+{
+    pthread_mutex_t lock; /*!< Lock of the deque */
+    uint32_t *p_items;    /*!< Indexes of the shards */
+    uint32_t head;        /*!< First valid item */
+    uint32_t tail;        /*!< One past the last valid item */
+} sim_deque_t;
+
+/**
+ * @brief Reusable barrier (pthread_barrier_t is not available on every host).
+ */
+typedef struct
+{
+    pthread_mutex_t lock; /*!< Lock of the barrier */
+    pthread_cond_t cond;  /*!< Condition to wake up the waiting threads */
+    uint32_t count;       /*!< Threads that have arrived in the current round */
+    uint32_t round;       /*!< Number of completed rounds */
+    uint32_t num_threads; /*!< Threads to wait for */
+} sim_barrier_t;
+
+/**
+ * @brief A whole simulation run.
+ */
+typedef struct
+{
+    const sim_scenario_t *p_scenario;  /*!< Scenario */
+    sim_door_t *p_doors;               /*!< Doors */
+    sim_shard_t *p_shards;             /*!< Shards */
+    sim_deque_t deques[SIM_MAX_THREADS]; /*!< Deque of each worker */
+    sim_barrier_t barrier;             /*!< Barrier between windows */
+    uint32_t num_threads;              /*!< Number of worker threads */
+    uint32_t window_end_ms;            /*!< End of the current window */
+    uint32_t end_ms;                   /*!< End of the simulation */
+    bool done;                         /*!< The simulation has reached `end_ms` */
+    uint32_t steals[SIM_MAX_THREADS];  /*!< Shards stolen by each worker */
+    uint32_t peak_active_doors;        /*!< Maximum number of doors not CLOSED at the end of a window */
+} sim_t;
+
+/**
+ * @brief Argument of a worker thread.
+ */
+typedef struct
+{
+    sim_t *p_sim;    /*!< Simulation */
+    uint32_t worker; /*!< Index of the worker */
+} sim_worker_t;
+
+/* Random numbers -------------------------------------------------------------*/
+static uint64_t _splitmix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t _xorshift64s(uint64_t *p_state)
+{
+    uint64_t x = *p_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *p_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Uniform number in (0, 1] */
+static double _uniform(uint64_t *p_state)
+{
+    return (double)((_xorshift64s(p_state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+/* Time to the next arrival at a door (at least 1 ms) */
+static uint32_t _interarrival_ms(const sim_scenario_t *p_scenario, uint64_t *p_state)
+{
+    if (p_scenario->rate_per_hour <= 0.0)
+    {
+        return SIM_NEVER;
+    }
+    double dt = -log(_uniform(p_state)) * 3600000.0 / p_scenario->rate_per_hour;
+    return dt < 1.0 ? 1 : (dt > 1e9 ? 1000000000U : (uint32_t)dt);
+}
+
+/* Scenario file ---------------------------------------------------------------*/
+static bool _scenario_load(const char *p_path, sim_scenario_t *p_scenario)
+{
+    *p_scenario = (sim_scenario_t){.doors = 1000, .rate_per_hour = 60.0, .duration_s = 3600, .button_ratio = 0.1, .pir_hold_ms = 2000, .button_hold_ms = 300, .seed = 1, .shards = 64, .window_ms = 1000};
+
+    FILE *p_file = fopen(p_path, "r");
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "Cannot open scenario file %s\n", p_path);
+        return false;
+    }
+
+    char line[SIM_MAX_LINE];
+    uint32_t line_number = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), p_file) != NULL)
+    {
+        char key[SIM_MAX_LINE];
+        double value;
+        line_number++;
+
+        // Comments and blank lines
+        char *p_comment = strchr(line, '#');
+        if (p_comment != NULL)
+        {
+            *p_comment = '\0';
+        }
+        if (sscanf(line, " %s", key) != 1)
+        {
+            continue;
+        }
+        if (sscanf(line, " %[a-z_] = %lf", key, &value) != 2 || value < 0.0)
+        {
+            fprintf(stderr, "%s:%" PRIu32 ": expected \"<key> = <non-negative number>\"\n", p_path, line_number);
+            ok = false;
+        }
+        else if (strcmp(key, "doors") == 0)
+            p_scenario->doors = (uint32_t)value;
+        else if (strcmp(key, "rate_per_hour") == 0)
+            p_scenario->rate_per_hour = value;
+        else if (strcmp(key, "duration_s") == 0)
+            p_scenario->duration_s = (uint32_t)value;
+        else if (strcmp(key, "button_ratio") == 0)
+            p_scenario->button_ratio = value;
+        else if (strcmp(key, "pir_hold_ms") == 0)
+            p_scenario->pir_hold_ms = (uint32_t)value;
+        else if (strcmp(key, "button_hold_ms") == 0)
+            p_scenario->button_hold_ms = (uint32_t)value;
+        else if (strcmp(key, "seed") == 0)
+            p_scenario->seed = (uint64_t)value;
+        else if (strcmp(key, "shards") == 0)
+            p_scenario->shards = (uint32_t)value;
+        else if (strcmp(key, "window_ms") == 0)
+            p_scenario->window_ms = (uint32_t)value;
+        else
+        {
+            fprintf(stderr, "%s:%" PRIu32 ": unknown key \"%s\"\n", p_path, line_number, key);
+            ok = false;
+        }
+    }
+    fclose(p_file);
+
+    if (ok && (p_scenario->doors == 0 || p_scenario->shards == 0 || p_scenario->window_ms == 0 || p_scenario->duration_s > 4000000))
+    {
+        fprintf(stderr, "%s: doors, shards and window_ms must be greater than 0 and duration_s at most 4000000\n", p_path);
+        ok = false;
+    }
+    if (ok && p_scenario->shards > p_scenario->doors)
+    {
+        p_scenario->shards = p_scenario->doors;
+    }
+    return ok;
+}
+
+/* Doors ------------------------------------------------------------------------*/
+static uint32_t _door_next_event_ms(const sim_door_t *p_door)
+{
+    uint32_t next = p_door->next_arrival_ms;
+    if (p_door->pir_falling_ms < next)
+    {
+        next = p_door->pir_falling_ms;
+    }
+    if (p_door->button_release_ms < next)
+    {
+        next = p_door->button_release_ms;
+    }
+    if (p_door->motor.timer_active && (p_door->motor.timer_start_ms + p_door->motor.timeout_ms) < next)
+    {
+        next = p_door->motor.timer_start_ms + p_door->motor.timeout_ms;
+    }
+    return next;
+}
+
+/* Feed an event to the FSM of a door and update the statistics of the door and its shard */
+static void _door_feed(sim_door_t *p_door, sim_shard_t *p_shard, event_queue_t *p_queue, uint8_t event)
+{
+    int state = fsm_get_state(p_door->p_fsm);
+    event_queue_push(p_queue, event);
+    fsm_automatic_door_fire_events(p_door->p_fsm, p_queue);
+    int new_state = fsm_get_state(p_door->p_fsm);
+
+    p_door->events++;
+    if (new_state != state)
+    {
+        p_door->state_changes++;
+        p_door->openings += (new_state == OPENING);
+        if (state == CLOSED)
+        {
+            p_shard->active_doors++;
+        }
+        else if (new_state == CLOSED)
+        {
+            p_shard->active_doors--;
+        }
+    }
+}
+
+/* Process all the events of a door due at time `now` (the virtual clock of the thread is already `now`) */
+static void _door_step(sim_t *p_sim, sim_door_t *p_door, sim_shard_t *p_shard, event_queue_t *p_queue, uint32_t now)
+{
+    const sim_scenario_t *p_scenario = p_sim->p_scenario;
+
+    // Events due at the same time are fed in a fixed order: motor timeout, PIR falling, button release, new arrival
+    if (p_door->motor.timer_active && (p_door->motor.timer_start_ms + p_door->motor.timeout_ms) <= now)
+    {
+        port_motor_set_timeout_status(&p_door->motor, true); // What the ISR of the timer does before pushing the event
+        _door_feed(p_door, p_shard, p_queue, EVENT_MOTOR_TIMEOUT);
+    }
+    if (p_door->pir_falling_ms <= now)
+    {
+        p_door->pir_falling_ms = SIM_NEVER;
+        _door_feed(p_door, p_shard, p_queue, EVENT_PIR_FALLING);
+    }
+    if (p_door->button_release_ms <= now)
+    {
+        p_door->button_release_ms = SIM_NEVER;
+        _door_feed(p_door, p_shard, p_queue, EVENT_BUTTON_RELEASE);
+    }
+    if (p_door->next_arrival_ms <= now)
+    {
+        if (_uniform(&p_door->rng) <= p_scenario->button_ratio)
+        {
+            p_door->button_release_ms = now + p_scenario->button_hold_ms;
+            _door_feed(p_door, p_shard, p_queue, EVENT_BUTTON_PRESS);
+        }
+        else
+        {
+            // A person arriving while the sensor already detects someone only extends the detection
+            if (p_door->pir_falling_ms == SIM_NEVER)
+            {
+                _door_feed(p_door, p_shard, p_queue, EVENT_PIR_RISING);
+            }
+            p_door->pir_falling_ms = now + p_scenario->pir_hold_ms;
+        }
+        uint32_t dt = _interarrival_ms(p_scenario, &p_door->rng);
+        p_door->next_arrival_ms = (dt == SIM_NEVER || dt > SIM_NEVER - now) ? SIM_NEVER : now + dt;
+    }
+    p_door->next_event_ms = _door_next_event_ms(p_door);
+}
+
+/* Shards -----------------------------------------------------------------------*/
+static bool _heap_less(const sim_door_t *p_doors, uint32_t a, uint32_t b)
+{
+    return (p_doors[a].next_event_ms < p_doors[b].next_event_ms) || ((p_doors[a].next_event_ms == p_doors[b].next_event_ms) && (a < b));
+}
+
+static void _heap_sift_down(const sim_door_t *p_doors, uint32_t *p_heap, uint32_t size, uint32_t i)
+{
+    while (1)
+    {
+        uint32_t smallest = i;
+        uint32_t left = 2 * i + 1;
+        uint32_t right = left + 1;
+        if (left < size && _heap_less(p_doors, p_heap[left], p_heap[smallest]))
+        {
+            smallest = left;
+        }
+        if (right < size && _heap_less(p_doors, p_heap[right], p_heap[smallest]))
+        {
+            smallest = right;
+        }
+        if (smallest == i)
+        {
+            return;
+        }
+        uint32_t tmp = p_heap[i];
+        p_heap[i] = p_heap[smallest];
+        p_heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+/* Advance a shard up to the end of the current window */
+static void _shard_run_window(sim_t *p_sim, sim_shard_t *p_shard, event_queue_t *p_queue)
+{
+    sim_door_t *p_doors = p_sim->p_doors;
+    uint32_t *p_heap = p_shard->p_heap;
+
+    while (p_doors[p_heap[0]].next_event_ms < p_sim->window_end_ms)
+    {
+        sim_door_t *p_door = &p_doors[p_heap[0]];
+        p_shard->clock_ms = p_door->next_event_ms;
+        port_system_set_millis(p_shard->clock_ms);
+        _door_step(p_sim, p_door, p_shard, p_queue, p_shard->clock_ms);
+        _heap_sift_down(p_doors, p_heap, p_shard->num_doors, 0);
+    }
+    p_shard->clock_ms = p_sim->window_end_ms;
+}
+
+/* Workers ----------------------------------------------------------------------*/
+static void _barrier_wait(sim_barrier_t *p_barrier)
+{
+    pthread_mutex_lock(&p_barrier->lock);
+    uint32_t round = p_barrier->round;
+    if (++p_barrier->count == p_barrier->num_threads)
+    {
+        p_barrier->count = 0;
+        p_barrier->round++;
+        pthread_cond_broadcast(&p_barrier->cond);
+    }
+    else
+    {
+        while (round == p_barrier->round)
+        {
+            pthread_cond_wait(&p_barrier->cond, &p_barrier->lock);
+        }
+    }
+    pthread_mutex_unlock(&p_barrier->lock);
+}
+
+/* Take a shard: from the tail of the own deque, or else from the head of another deque */
+static bool _take_shard(sim_t *p_sim, uint32_t worker, uint32_t *p_shard)
+{
+    for (uint32_t i = 0; i < p_sim->num_threads; i++)
+    {
+        uint32_t victim = (worker + i) % p_sim->num_threads;
+        sim_deque_t *p_deque = &p_sim->deques[victim];
+        bool found = false;
+
+        pthread_mutex_lock(&p_deque->lock);
+        if (p_deque->head < p_deque->tail)
+        {
+            *p_shard = (victim == worker) ? p_deque->p_items[--p_deque->tail] : p_deque->p_items[p_deque->head++];
+            found = true;
+        }
+        pthread_mutex_unlock(&p_deque->lock);
+
+        if (found)
+        {
+            p_sim->steals[worker] += (victim != worker);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Hand out the shards to the deques of the workers in contiguous blocks, and move the window forward */
+static void _start_window(sim_t *p_sim)
+{
+    uint32_t num_shards = p_sim->p_scenario->shards;
+    for (uint32_t w = 0; w < p_sim->num_threads; w++)
+    {
+        sim_deque_t *p_deque = &p_sim->deques[w];
+        uint32_t first = (uint32_t)((uint64_t)num_shards * w / p_sim->num_threads);
+        uint32_t last = (uint32_t)((uint64_t)num_shards * (w + 1) / p_sim->num_threads);
+        p_deque->head = 0;
+        p_deque->tail = last - first;
+        for (uint32_t i = first; i < last; i++)
+        {
+            p_deque->p_items[i - first] = i;
+        }
+    }
+    uint32_t window_end_ms = p_sim->window_end_ms + p_sim->p_scenario->window_ms;
+    p_sim->window_end_ms = (window_end_ms > p_sim->end_ms || window_end_ms < p_sim->window_end_ms) ? p_sim->end_ms : window_end_ms;
+}
+
+/* Gather the results of the window, in shard order so that they are deterministic */
+static void _end_window(sim_t *p_sim)
+{
+    uint32_t active_doors = 0;
+    for (uint32_t i = 0; i < p_sim->p_scenario->shards; i++)
+    {
+        active_doors += p_sim->p_shards[i].active_doors;
+    }
+    if (active_doors > p_sim->peak_active_doors)
+    {
+        p_sim->peak_active_doors = active_doors;
+    }
+    p_sim->done = p_sim->window_end_ms >= p_sim->end_ms;
+}
+
+static void *_worker(void *p_arg)
+{
+    sim_worker_t *p_worker = (sim_worker_t *)p_arg;
+    sim_t *p_sim = p_worker->p_sim;
+    event_queue_t queue; // Scratch queue to feed the events to the FSMs run by this worker
+    event_queue_init(&queue);
+
+    // Worker 0 prepares each window while the others wait at the barrier
+    if (p_worker->worker == 0)
+    {
+        _start_window(p_sim);
+    }
+    while (1)
+    {
+        _barrier_wait(&p_sim->barrier);
+        if (p_sim->done)
+        {
+            return NULL;
+        }
+
+        uint32_t shard;
+        while (_take_shard(p_sim, p_worker->worker, &shard))
+        {
+            _shard_run_window(p_sim, &p_sim->p_shards[shard], &queue);
+        }
+
+        // All the shards have reached the end of the window
+        _barrier_wait(&p_sim->barrier);
+        if (p_worker->worker == 0)
+        {
+            _end_window(p_sim);
+            if (!p_sim->done)
+            {
+                _start_window(p_sim);
+            }
+        }
+    }
+}
+
+/* Simulation -------------------------------------------------------------------*/
+static double _now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Result of a simulation run.
+ */
+typedef struct
+{
+    double wall_s;              /*!< Wall-clock time of the run */
+    uint64_t events;            /*!< Events fed to the FSMs */
+    uint64_t state_changes;     /*!< Transitions to a different state */
+    uint64_t openings;          /*!< Transitions to OPENING */
+    uint32_t doors_per_state[4]; /*!< Doors in each state at the end */
+    uint32_t peak_active_doors; /*!< Maximum number of doors not CLOSED at the end of a window */
+    uint32_t steals;            /*!< Shards stolen by the workers */
+    uint64_t input_reads;       /*!< Inputs read from the hardware by the guards */
+    uint64_t input_reads_saved; /*!< Inputs served from the input snapshot */
+    uint64_t checksum;          /*!< Checksum of the final status of all the doors */
+} sim_result_t;
+
+static bool _sim_run(const sim_scenario_t *p_scenario, uint32_t num_threads, sim_result_t *p_result)
+{
+    sim_t sim = {.p_scenario = p_scenario, .num_threads = num_threads, .window_end_ms = 0, .end_ms = p_scenario->duration_s * 1000U};
+    sim.p_doors = calloc(p_scenario->doors, sizeof(sim_door_t));
+    sim.p_shards = calloc(p_scenario->shards, sizeof(sim_shard_t));
+    uint32_t *p_heaps = malloc(p_scenario->doors * sizeof(uint32_t));
+    uint32_t *p_items = malloc((size_t)num_threads * p_scenario->shards * sizeof(uint32_t));
+    if (sim.p_doors == NULL || sim.p_shards == NULL || p_heaps == NULL || p_items == NULL)
+    {
+        fprintf(stderr, "Not enough memory for %" PRIu32 " doors\n", p_scenario->doors);
+        return false;
+    }
+
+    // Doors. All of them start CLOSED at time 0
+    port_system_set_millis(0);
+    for (uint32_t i = 0; i < p_scenario->doors; i++)
+    {
+        sim_door_t *p_door = &sim.p_doors[i];
+        p_door->led_open.timer_blink_semi_period_ms = LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS;
+        p_door->led_close.timer_blink_semi_period_ms = LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS;
+        p_door->p_fsm = fsm_automatic_door_new(&p_door->button, &p_door->led_open, &p_door->led_close, &p_door->pir, &p_door->motor);
+        if (p_door->p_fsm == NULL)
+        {
+            fprintf(stderr, "Cannot create door %" PRIu32 " (static pool too small?)\n", i);
+            return false;
+        }
+        p_door->rng = _splitmix64(p_scenario->seed ^ _splitmix64(i));
+        p_door->pir_falling_ms = SIM_NEVER;
+        p_door->button_release_ms = SIM_NEVER;
+        p_door->next_arrival_ms = _interarrival_ms(p_scenario, &p_door->rng);
+        p_door->next_event_ms = _door_next_event_ms(p_door);
+    }
+
+    // Shards: contiguous blocks of doors, each one with a heap of its doors
+    for (uint32_t s = 0; s < p_scenario->shards; s++)
+    {
+        sim_shard_t *p_shard = &sim.p_shards[s];
+        p_shard->first_door = (uint32_t)((uint64_t)p_scenario->doors * s / p_scenario->shards);
+        p_shard->num_doors = (uint32_t)((uint64_t)p_scenario->doors * (s + 1) / p_scenario->shards) - p_shard->first_door;
+        p_shard->p_heap = &p_heaps[p_shard->first_door];
+        for (uint32_t i = 0; i < p_shard->num_doors; i++)
+        {
+            p_shard->p_heap[i] = p_shard->first_door + i;
+        }
+        for (uint32_t i = p_shard->num_doors / 2; i-- > 0;)
+        {
+            _heap_sift_down(sim.p_doors, p_shard->p_heap, p_shard->num_doors, i);
+        }
+    }
+
+    // Workers
+    pthread_mutex_init(&sim.barrier.lock, NULL);
+    pthread_cond_init(&sim.barrier.cond, NULL);
+    sim.barrier.num_threads = num_threads;
+    for (uint32_t w = 0; w < num_threads; w++)
+    {
+        pthread_mutex_init(&sim.deques[w].lock, NULL);
+        sim.deques[w].p_items = &p_items[(size_t)w * p_scenario->shards];
+    }
+
+    sim_worker_t workers[SIM_MAX_THREADS];
+    pthread_t threads[SIM_MAX_THREADS];
+    double t0 = _now_s();
+    for (uint32_t w = 0; w < num_threads; w++)
+    {
+        workers[w] = (sim_worker_t){.p_sim = &sim, .worker = w};
+        pthread_create(&threads[w], NULL, _worker, &workers[w]);
+    }
+    for (uint32_t w = 0; w < num_threads; w++)
+    {
+        pthread_join(threads[w], NULL);
+    }
+
+    // Results
+    *p_result = (sim_result_t){.wall_s = _now_s() - t0, .peak_active_doors = sim.peak_active_doors, .checksum = 0xCBF29CE484222325ULL};
+    for (uint32_t w = 0; w < num_threads; w++)
+    {
+        p_result->steals += sim.steals[w];
+        pthread_mutex_destroy(&sim.deques[w].lock);
+    }
+    for (uint32_t i = 0; i < p_scenario->doors; i++)
+    {
+        sim_door_t *p_door = &sim.p_doors[i];
+        uint32_t fields[] = {(uint32_t)fsm_get_state(p_door->p_fsm), fsm_automatic_door_get_last_time_presence(p_door->p_fsm), p_door->events, p_door->state_changes};
+        p_result->events += p_door->events;
+        p_result->state_changes += p_door->state_changes;
+        p_result->openings += p_door->openings;
+        p_result->input_reads += fsm_automatic_door_get_input_reads(p_door->p_fsm);
+        p_result->input_reads_saved += fsm_automatic_door_get_input_reads_saved(p_door->p_fsm);
+        p_result->doors_per_state[fields[0] & 3]++;
+        for (uint32_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++)
+        {
+            p_result->checksum = (p_result->checksum ^ fields[f]) * 0x100000001B3ULL;
+        }
+        fsm_automatic_door_delete(p_door->p_fsm);
+    }
+    pthread_cond_destroy(&sim.barrier.cond);
+    pthread_mutex_destroy(&sim.barrier.lock);
+    free(p_items);
+    free(p_heaps);
+    free(sim.p_shards);
+    free(sim.p_doors);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    sim_scenario_t scenario;
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "Usage: %s <scenario_file> [num_threads]\n", argv[0]);
+        return 2;
+    }
+    if (!_scenario_load(argv[1], &scenario))
+    {
+        return 2;
+    }
+
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t num_threads = (argc == 3) ? (uint32_t)strtoul(argv[2], NULL, 10) : (num_cpus > 0 ? (uint32_t)num_cpus : 1);
+    if (num_threads == 0 || num_threads > SIM_MAX_THREADS)
+    {
+        fprintf(stderr, "The number of threads must be between 1 and %d\n", SIM_MAX_THREADS);
+        return 2;
+    }
+
+    printf("Scenario %s: %" PRIu32 " doors, %.1f arrivals/door/hour (%.0f%% button), %" PRIu32 " s, %" PRIu32 " shards, window %" PRIu32 " ms\n",
+           argv[1], scenario.doors, scenario.rate_per_hour, 100.0 * scenario.button_ratio, scenario.duration_s, scenario.shards, scenario.window_ms);
+
+    sim_result_t results[2];
+    uint32_t thread_counts[2] = {1, num_threads};
+    printf("%8s %10s %14s %8s %7s %18s\n", "threads", "wall (s)", "events/s", "speedup", "steals", "checksum");
+    for (uint32_t r = 0; r < 2; r++)
+    {
+        if (!_sim_run(&scenario, thread_counts[r], &results[r]))
+        {
+            return 1;
+        }
+        printf("%8" PRIu32 " %10.3f %14.0f %7.2fx %7" PRIu32 " 0x%016" PRIx64 "\n", thread_counts[r], results[r].wall_s, (double)results[r].events / results[r].wall_s,
+               results[0].wall_s / results[r].wall_s, results[r].steals, results[r].checksum);
+    }
+
+    const sim_result_t *p_result = &results[1];
+    printf("Events: %" PRIu64 ", state changes: %" PRIu64 ", openings: %" PRIu64 ", peak doors not closed: %" PRIu32 "\n", p_result->events, p_result->state_changes, p_result->openings, p_result->peak_active_doors);
+    printf("Input reads: %" PRIu64 ", saved by the input snapshot: %" PRIu64 " (%.1f%%)\n", p_result->input_reads, p_result->input_reads_saved,
+           100.0 * (double)p_result->input_reads_saved / (double)(p_result->input_reads + p_result->input_reads_saved + 1));
+    printf("Doors at the end: CLOSED %" PRIu32 ", OPENING %" PRIu32 ", OPEN %" PRIu32 ", CLOSING %" PRIu32 "\n", p_result->doors_per_state[CLOSED], p_result->doors_per_state[OPENING], p_result->doors_per_state[OPEN], p_result->doors_per_state[CLOSING]);
+
+    if (results[0].checksum != results[1].checksum || results[0].events != results[1].events)
+    {
+        printf("ERROR: the results with %" PRIu32 " threads differ from the results with 1 thread\n", num_threads);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+#include "port_gpio_sim.h"
+
+#define TEST_PRESSES 10       /*!< Presses of the button in a train */
+#define TEST_BOUNCE_EDGES 7   /*!< Edges of the contact at every press and release, 1 ms apart. Odd: it settles at the new level */
+#define TEST_HOLD_MS 200      /*!< Time the button is held pressed */
+#define TEST_GAP_MS 300       /*!< Time between a release and the next press */
+#define TEST_ARC_KEEP_OPEN 2  /*!< Arc of fsm_trans_automatic_door: OPEN -> OPEN re-arming the inactivity timeout */
+
+static fsm_t *p_fsm = NULL;
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+    button_emergency.debounce.window_ms = BUTTON_EMERGENCY_DEBOUNCE_MS;
+}
+
+/* The contact of the button bounces before it settles at `pressed`: an interrupt per edge, and the main loop feeds the events after each one */
+static uint32_t _bounce_train(uint32_t *p_now_ms, bool pressed)
+{
+    uint32_t events = 0;
+    for (uint32_t i = 0; i < TEST_BOUNCE_EDGES; i++)
+    {
+        bool level_pressed = (i % 2 == 0) ? pressed : !pressed;
+        button_emergency.gpio_level = !level_pressed; // Pull-up: low when pressed
+        port_system_set_millis(*p_now_ms);
+        port_gpio_sim_exti_edge(BUTTON_EMERGENCY_PIN);
+        events += fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+        (*p_now_ms)++;
+    }
+    return events;
+}
+
+/* Open the door and press the button TEST_PRESSES times while it is open. Returns the events fed to the FSM */
+static uint32_t _press_while_open(uint32_t *p_keep_open)
+{
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TIM2_IRQHandler(); // The motor timeout expires
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+
+    uint32_t now = 1000;
+    uint32_t events = 0;
+    for (uint32_t press = 0; press < TEST_PRESSES; press++)
+    {
+        events += _bounce_train(&now, true);
+        now += TEST_HOLD_MS;
+        events += _bounce_train(&now, false);
+        now += TEST_GAP_MS;
+    }
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+
+    fsm_stats_data_t stats;
+    fsm_automatic_door_get_stats(p_fsm, &stats);
+    *p_keep_open = stats.arcs[TEST_ARC_KEEP_OPEN];
+    return events;
+}
+
+/**
+ * @brief The edges inside the window of an accepted edge, or that do not change the level, are rejected and counted.
+ */
+void test_debounce_window(void)
+{
+    debounce_t debounce;
+    debounce_init(&debounce, 50, false);
+
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, 1000, true));
+    TEST_ASSERT_FALSE(debounce_edge(&debounce, 1001, false));
+    TEST_ASSERT_FALSE(debounce_edge(&debounce, 1049, false));
+    TEST_ASSERT_TRUE(debounce.level);
+    TEST_ASSERT_FALSE(debounce_edge(&debounce, 1050, true)); // Out of the window, but the level is the same
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, 1050, false));
+    TEST_ASSERT_EQUAL(2, debounce.accepted);
+    TEST_ASSERT_EQUAL(3, debounce.rejected);
+
+    // Across the wrap-around of the system time
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, UINT32_MAX - 9, true));
+    TEST_ASSERT_FALSE(debounce_edge(&debounce, 20, false));
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, 40, false));
+
+    // Without a window every change of level is accepted
+    debounce_init(&debounce, 0, false);
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, 7, true));
+    TEST_ASSERT_TRUE(debounce_edge(&debounce, 7, false));
+    TEST_ASSERT_FALSE(debounce_edge(&debounce, 7, false));
+}
+
+/**
+ * @brief Without debouncing every bounce is an event and every bounce of a press re-arms the door.
+ */
+void test_bounces_without_debouncing(void)
+{
+    button_emergency.debounce.window_ms = 0;
+    uint32_t keep_open;
+    uint32_t events = _press_while_open(&keep_open);
+
+    TEST_ASSERT_EQUAL(2 * TEST_PRESSES * TEST_BOUNCE_EDGES, events);
+    TEST_ASSERT_EQUAL(TEST_PRESSES * TEST_BOUNCE_EDGES, keep_open); // (edges + 1) / 2 presses in a press train, (edges - 1) / 2 in a release train
+    TEST_ASSERT_EQUAL(0, port_button_get_bounces(&button_emergency));
+}
+
+/**
+ * @brief With debouncing a press and a release are an event each, and a press re-arms the door once: the FSM consumes it.
+ */
+void test_bounces_with_debouncing(void)
+{
+    uint32_t keep_open;
+    uint32_t events = _press_while_open(&keep_open);
+
+    TEST_ASSERT_EQUAL(2 * TEST_PRESSES, events);
+    TEST_ASSERT_EQUAL(TEST_PRESSES, keep_open);
+    TEST_ASSERT_EQUAL(2 * TEST_PRESSES * (TEST_BOUNCE_EDGES - 1), port_button_get_bounces(&button_emergency));
+    TEST_ASSERT_FALSE(port_button_is_pressed(&button_emergency));
+}
+
+/**
+ * @brief A press that is not consumed when it is released is not lost, and it is taken only once.
+ */
+void test_press_consumed_once(void)
+{
+    uint32_t now = 1000;
+    button_emergency.gpio_level = LOW;
+    port_system_set_millis(now);
+    port_gpio_sim_exti_edge(BUTTON_EMERGENCY_PIN);
+    button_emergency.gpio_level = HIGH;
+    port_system_set_millis(now + BUTTON_EMERGENCY_DEBOUNCE_MS);
+    port_gpio_sim_exti_edge(BUTTON_EMERGENCY_PIN);
+    TEST_ASSERT_TRUE(port_button_is_pressed(&button_emergency));
+
+    // Both edges are fed after the release
+    TEST_ASSERT_EQUAL(2, fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door));
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(port_button_is_pressed(&button_emergency));
+    TEST_ASSERT_FALSE(port_button_consume_press(&button_emergency));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_debounce_window);
+    RUN_TEST(test_bounces_without_debouncing);
+    RUN_TEST(test_bounces_with_debouncing);
+    RUN_TEST(test_press_consumed_once);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+#include "port_timer_sim.h"
+
+static fsm_t *p_fsm = NULL;
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    timer_sim_tim2.irqs = 0;
+    port_door_sim_init(&door_sim_automatic_door, 0.0);
+    motor_automatic_door.p_door = &door_sim_automatic_door;
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+    motor_automatic_door.p_door = NULL;
+    motor_automatic_door.end_switches = false;
+    door_sim_automatic_door.force_n = DOOR_SIM_AUTOMATIC_DOOR_FORCE_N;
+}
+
+static void _presence(bool status)
+{
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, status);
+    event_queue_push(&event_queue_automatic_door, status ? EVENT_PIR_RISING : EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+}
+
+/* Run the timers and the leaf a millisecond at a time, feeding the events of the ISRs to the door as the main loop does, until the door is in `state` or `max_ms` have passed. Returns the time it took */
+static uint32_t _run_until_state(int state, uint32_t max_ms)
+{
+    uint32_t start = port_system_get_millis();
+    while ((fsm_get_state(p_fsm) != state) && (port_system_get_millis() - start < max_ms))
+    {
+        // The leaf moves during the millisecond, and the timers that expire at its end interrupt after it
+        uint32_t next = port_system_get_millis() + 1;
+        port_motor_sim_step(&motor_automatic_door, 1);
+        fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+        while (port_timer_sim_step(next))
+        {
+            fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+        }
+    }
+    return port_system_get_millis() - start;
+}
+
+/**
+ * @brief The door ends the opening and the closing when the leaf reaches the end stop, before the timeout of the movement, which does not expire.
+ */
+void test_full_travel_ends_on_position(void)
+{
+    _presence(true);
+    _presence(false);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + AUTOMATIC_DOOR_TRAVEL_FAULT_MARGIN_MS, motor_automatic_door.timeout_ms);
+
+    uint32_t opening_ms = _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(opening_ms < AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(MOTOR_POSITION_OPEN, port_motor_get_position(&motor_automatic_door));
+    TEST_ASSERT_EQUAL(0, port_motor_get_duty(&motor_automatic_door));
+    TEST_ASSERT_EQUAL(0, timer_sim_tim2.irqs);
+
+    _run_until_state(CLOSING, 2 * AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
+    uint32_t closing_ms = _run_until_state(CLOSED, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(opening_ms, closing_ms);
+    TEST_ASSERT_EQUAL(0, port_motor_get_position(&motor_automatic_door));
+    TEST_ASSERT_EQUAL(1, timer_sim_tim2.irqs); // Only the inactivity timeout
+}
+
+/**
+ * @brief A presence while the door is closing reopens it from where it is: the shorter the way back, the sooner the door is open.
+ */
+void test_reversal_reopens_from_position(void)
+{
+    _presence(true);
+    _presence(false);
+    uint32_t full_ms = _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    _run_until_state(CLOSING, 2 * AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
+
+    // A third of the closing
+    _run_until_state(CLOSED, full_ms / 3);
+    uint32_t position = port_motor_get_position(&motor_automatic_door);
+    TEST_ASSERT_TRUE(position > 0 && position < MOTOR_POSITION_OPEN);
+
+    _presence(true);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    uint32_t reopening_ms = _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(MOTOR_POSITION_OPEN, port_motor_get_position(&motor_automatic_door));
+    TEST_ASSERT_TRUE(reopening_ms < full_ms);
+}
+
+/**
+ * @brief A blocked leaf never reaches the end stop: the timeout of the movement, with its margin, ends the opening as a fault limit.
+ */
+void test_blocked_door_falls_back_to_timeout(void)
+{
+    door_sim_automatic_door.force_n = 0.0;
+    _presence(true);
+    uint32_t opening_ms = _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + AUTOMATIC_DOOR_TRAVEL_FAULT_MARGIN_MS, opening_ms);
+    TEST_ASSERT_EQUAL(0, port_motor_get_position(&motor_automatic_door));
+    TEST_ASSERT_EQUAL(1, timer_sim_tim2.irqs);
+}
+
+/**
+ * @brief The log of a door with position feedback says so, and its replay on a door without leaf ends the movements on the ends of the travel of the log, with the same transitions.
+ */
+void test_replay_with_position_feedback(void)
+{
+    uint8_t buffer[64];
+    event_record_t record;
+    event_record_reader_t reader;
+    fsm_stats_data_t recorded, replayed;
+    uint32_t timestamp_ms;
+    uint8_t event;
+
+    event_record_init(&record, buffer, sizeof(buffer));
+    fsm_automatic_door_set_record(p_fsm, &record);
+    _presence(true);
+    _presence(false);
+    uint32_t full_ms = _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    _run_until_state(CLOSING, 2 * AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
+    _run_until_state(CLOSED, full_ms / 2);
+    _presence(true);
+    _presence(false);
+    _run_until_state(OPEN, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    _run_until_state(CLOSING, 2 * AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS);
+    _run_until_state(CLOSED, 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, event_record_get_dropped(&record));
+    fsm_automatic_door_get_stats(p_fsm, &recorded);
+
+    // Replay on a new door without leaf
+    fsm_automatic_door_delete(p_fsm);
+    motor_automatic_door.p_door = NULL;
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    event_record_reader_init(&reader, buffer, event_record_get_length(&record));
+    TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+    TEST_ASSERT_EQUAL(EVENT_RECORD_POSITION_FEEDBACK, event);
+    motor_automatic_door.end_switches = true;
+    while (event_record_read(&reader, &timestamp_ms, &event))
+    {
+        port_system_set_millis(timestamp_ms);
+        if (event == EVENT_MOTOR_TIMEOUT)
+        {
+            port_motor_set_timeout_status(&motor_automatic_door, true);
+        }
+        else if (event == EVENT_MOTOR_END_OF_TRAVEL)
+        {
+            port_motor_sim_set_end_of_travel(&motor_automatic_door);
+        }
+        event_queue_push(&event_queue_automatic_door, event);
+        fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    }
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    fsm_automatic_door_get_stats(p_fsm, &replayed);
+    TEST_ASSERT_EQUAL(recorded.arcs[4], 1); // The reversal
+    TEST_ASSERT_EQUAL_MEMORY(recorded.arcs, replayed.arcs, sizeof(recorded.arcs));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_full_travel_ends_on_position);
+    RUN_TEST(test_reversal_reopens_from_position);
+    RUN_TEST(test_blocked_door_falls_back_to_timeout);
+    RUN_TEST(test_replay_with_position_feedback);
+    return UNITY_END();
+}
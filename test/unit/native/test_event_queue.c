@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <pthread.h>
+#include "event_queue.h"
+
+#define HAMMER_PRODUCERS 3      /*!< Number of producer threads of the hammer test */
+#define HAMMER_EVENTS 2000000   /*!< Number of events pushed by each producer of the hammer test */
+
+static event_queue_t queue;
+
+void setUp(void)
+{
+    event_queue_init(&queue);
+}
+
+void tearDown(void)
+{
+}
+
+void test_empty(void)
+{
+    uint8_t event = EVENT_NONE;
+    TEST_ASSERT_FALSE(event_queue_is_pending(&queue));
+    TEST_ASSERT_FALSE(event_queue_pop(&queue, &event));
+    TEST_ASSERT_EQUAL(EVENT_NONE, event);
+    TEST_ASSERT_EQUAL(0, event_queue_get_dropped(&queue));
+}
+
+void test_fifo_order_and_wrap_around(void)
+{
+    uint8_t event;
+
+    // Several laps of the ring to check the wrap around of the positions
+    for (uint32_t lap = 0; lap < 5; lap++)
+    {
+        for (uint32_t i = 0; i < EVENT_QUEUE_SIZE - 3; i++)
+        {
+            TEST_ASSERT_TRUE(event_queue_push(&queue, (uint8_t)(i % EVENT_MOTOR_TIMEOUT + 1)));
+        }
+        TEST_ASSERT_TRUE(event_queue_is_pending(&queue));
+        for (uint32_t i = 0; i < EVENT_QUEUE_SIZE - 3; i++)
+        {
+            TEST_ASSERT_TRUE(event_queue_pop(&queue, &event));
+            TEST_ASSERT_EQUAL(i % EVENT_MOTOR_TIMEOUT + 1, event);
+        }
+        TEST_ASSERT_FALSE(event_queue_is_pending(&queue));
+    }
+}
+
+void test_overflow_drops_and_counts(void)
+{
+    uint8_t event;
+
+    for (uint32_t i = 0; i < EVENT_QUEUE_SIZE; i++)
+    {
+        TEST_ASSERT_TRUE(event_queue_push(&queue, EVENT_PIR_RISING));
+    }
+    TEST_ASSERT_FALSE(event_queue_push(&queue, EVENT_PIR_FALLING));
+    TEST_ASSERT_FALSE(event_queue_push(&queue, EVENT_PIR_FALLING));
+    TEST_ASSERT_EQUAL(2, event_queue_get_dropped(&queue));
+
+    // The queued events are kept and a slot is freed after a pop
+    TEST_ASSERT_TRUE(event_queue_pop(&queue, &event));
+    TEST_ASSERT_EQUAL(EVENT_PIR_RISING, event);
+    TEST_ASSERT_TRUE(event_queue_push(&queue, EVENT_BUTTON_PRESS));
+    TEST_ASSERT_EQUAL(2, event_queue_get_dropped(&queue));
+}
+
+/* Hammer test: several producers push numbered events while one consumer pops them. The event encodes the producer (high bits) and a sequence number modulo 64 (low bits) */
+static atomic_uint accepted[HAMMER_PRODUCERS];
+
+static void *hammer_producer(void *p_arg)
+{
+    uint8_t id = (uint8_t)(uintptr_t)p_arg;
+    uint8_t seq = 0;
+    for (uint32_t i = 0; i < HAMMER_EVENTS; i++)
+    {
+        if (event_queue_push(&queue, (uint8_t)((id << 6) | seq)))
+        {
+            // Only accepted events advance the sequence, so the consumer can check that nothing is lost or reordered
+            seq = (seq + 1) & 0x3F;
+            atomic_fetch_add(&accepted[id], 1);
+        }
+    }
+    return NULL;
+}
+
+void test_hammer_multiple_producers(void)
+{
+    pthread_t producers[HAMMER_PRODUCERS];
+    uint32_t received[HAMMER_PRODUCERS] = {0};
+    uint8_t expected_seq[HAMMER_PRODUCERS] = {0};
+    uint32_t errors = 0;
+
+    for (uintptr_t id = 0; id < HAMMER_PRODUCERS; id++)
+    {
+        atomic_store(&accepted[id], 0);
+        pthread_create(&producers[id], NULL, hammer_producer, (void *)id);
+    }
+
+    uint32_t total_received = 0;
+    uint32_t total_expected = HAMMER_PRODUCERS * HAMMER_EVENTS;
+    while (total_received + event_queue_get_dropped(&queue) < total_expected)
+    {
+        uint8_t event;
+        if (event_queue_pop(&queue, &event))
+        {
+            uint8_t id = event >> 6;
+            if ((id >= HAMMER_PRODUCERS) || ((event & 0x3F) != expected_seq[id]))
+            {
+                errors++;
+            }
+            else
+            {
+                expected_seq[id] = (expected_seq[id] + 1) & 0x3F;
+                received[id]++;
+            }
+            total_received++;
+        }
+    }
+
+    for (uint32_t id = 0; id < HAMMER_PRODUCERS; id++)
+    {
+        pthread_join(producers[id], NULL);
+    }
+
+    // Every accepted event is received once and in order; every rejected one is counted as dropped
+    TEST_ASSERT_EQUAL(0, errors);
+    TEST_ASSERT_FALSE(event_queue_is_pending(&queue));
+    for (uint32_t id = 0; id < HAMMER_PRODUCERS; id++)
+    {
+        TEST_ASSERT_EQUAL(atomic_load(&accepted[id]), received[id]);
+    }
+    TEST_ASSERT_EQUAL(total_expected, total_received + event_queue_get_dropped(&queue));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_fifo_order_and_wrap_around);
+    RUN_TEST(test_overflow_drops_and_counts);
+    RUN_TEST(test_hammer_multiple_producers);
+    return UNITY_END();
+}
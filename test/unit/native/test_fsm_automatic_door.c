@@ -0,0 +1,442 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+#include "latency.h"
+#include "port_gpio_sim.h"
+
+static fsm_t *p_fsm = NULL;
+
+/* The motor timeout expires: what TIM2_IRQHandler() does */
+static void _motor_timeout_isr(void)
+{
+    port_motor_set_timeout_status(&motor_automatic_door, true);
+    event_queue_push(&event_queue_automatic_door, EVENT_MOTOR_TIMEOUT);
+}
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+}
+
+void test_starts_closed(void)
+{
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(port_led_get_status(&led_closing));
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
+}
+
+void test_no_event_no_evaluation(void)
+{
+    // The PIR flag is set behind the back of the queue: without an event the FSM is not evaluated
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
+    TEST_ASSERT_EQUAL(0, fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door));
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+}
+
+void test_situation_1_with_events(void)
+{
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    TEST_ASSERT_EQUAL(2, fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door));
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(led_opening.timer_active);
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, motor_automatic_door.timeout_ms);
+
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS, motor_automatic_door.timeout_ms);
+
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(led_closing.timer_active);
+
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(led_closing.timer_active);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_closing));
+}
+
+void test_press_and_release_between_two_fires_is_not_lost(void)
+{
+    // Both edges happen before the main loop gets to fire: the flags already say "released"
+    button_emergency.flag_pressed = false;
+    button_emergency.flag_released = true;
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_RELEASE);
+
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(fsm_automatic_door_get_presence_status(p_fsm));
+}
+
+void test_stale_timeout_after_reversal_in_same_drain(void)
+{
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+
+    // A presence and then the timeout of the closing arrive before the main loop drains the queue
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+
+    // The reversal re-armed the timer: the older timeout must not end the opening
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(motor_automatic_door.timeout);
+    TEST_ASSERT_TRUE(motor_automatic_door.timer_active);
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, motor_automatic_door.timeout_ms);
+}
+
+void test_press_while_opening_is_taken_on_open(void)
+{
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+
+    // No guard of OPENING reads the button: the press stays pending
+    port_system_set_millis(1000);
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_RELEASE);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+
+    // The door opens and takes the press at once, as the main loop of the polling mode would
+    port_system_set_millis(5000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(button_emergency.flag_pressed);
+    TEST_ASSERT_EQUAL(5000, motor_automatic_door.timer_start_ms);
+
+    // The inactivity timeout counts from the opening: the door closes
+    port_system_set_millis(15000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+}
+
+void test_activity_only_when_not_closed(void)
+{
+    TEST_ASSERT_FALSE(fsm_automatic_door_check_activity(p_fsm));
+
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_TRUE(fsm_automatic_door_check_activity(p_fsm));
+    TEST_ASSERT_TRUE(motor_automatic_door.timer_active);
+}
+
+void test_snapshot_reads_only_the_changed_input(void)
+{
+    fsm_set_state(p_fsm, OPEN);
+
+    // First fire: fresh snapshot, the three inputs are read (presence, button, timeout) and no transition is taken.
+    // Second fire: only the presence is read again, button and timeout come from the snapshot
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_RELEASE);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(4, fsm_automatic_door_get_input_reads(p_fsm));
+    TEST_ASSERT_EQUAL(2, fsm_automatic_door_get_input_reads_saved(p_fsm));
+
+    // After a transition the snapshot is discarded: the timeout restarted by the action must not be seen as expired
+    _motor_timeout_isr();
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+}
+
+void test_no_stale_snapshot_out_of_the_engine(void)
+{
+    fsm_set_state(p_fsm, CLOSED);
+    TEST_ASSERT_FALSE(fsm_automatic_door_fire(p_fsm));
+
+    // The stock dispatcher does not use the snapshot: it sees the new presence
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
+    fsm_fire(p_fsm);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+}
+
+void test_trace_of_transitions(void)
+{
+    fsm_trace_entry_t entries[FSM_TRACE_SIZE];
+
+    port_system_set_millis(1000);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    port_system_set_millis(6000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+
+#if defined(FSM_AUTOMATIC_DOOR_TRACE)
+    TEST_ASSERT_EQUAL(3, fsm_automatic_door_get_trace(p_fsm, entries, FSM_TRACE_SIZE));
+
+    // CLOSED -> OPENING by check_open (arc 0) with presence read from the PIR and the button read too
+    TEST_ASSERT_EQUAL(1000, entries[0].timestamp_ms);
+    TEST_ASSERT_EQUAL(CLOSED, entries[0].from_state);
+    TEST_ASSERT_EQUAL(OPENING, entries[0].to_state);
+    TEST_ASSERT_EQUAL(0, entries[0].arc);
+    TEST_ASSERT_EQUAL_HEX8(((FSM_AUTOMATIC_DOOR_INPUT_PRESENCE | FSM_AUTOMATIC_DOOR_INPUT_BUTTON) << 4) | FSM_AUTOMATIC_DOOR_INPUT_PRESENCE, entries[0].inputs);
+
+    // OPENING -> OPEN by check_opening_timeout (arc 1), only the timeout was read
+    TEST_ASSERT_EQUAL(6000, entries[1].timestamp_ms);
+    TEST_ASSERT_EQUAL(OPENING, entries[1].from_state);
+    TEST_ASSERT_EQUAL(OPEN, entries[1].to_state);
+    TEST_ASSERT_EQUAL(1, entries[1].arc);
+    TEST_ASSERT_EQUAL_HEX8((FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT << 4) | FSM_AUTOMATIC_DOOR_INPUT_TIMEOUT, entries[1].inputs);
+
+    // The FSM runs to completion: the presence still there keeps the door open (arc 2), with the inputs read again after the transition
+    TEST_ASSERT_EQUAL(6000, entries[2].timestamp_ms);
+    TEST_ASSERT_EQUAL(OPEN, entries[2].from_state);
+    TEST_ASSERT_EQUAL(OPEN, entries[2].to_state);
+    TEST_ASSERT_EQUAL(2, entries[2].arc);
+    TEST_ASSERT_EQUAL_HEX8(((FSM_AUTOMATIC_DOOR_INPUT_PRESENCE | FSM_AUTOMATIC_DOOR_INPUT_BUTTON) << 4) | FSM_AUTOMATIC_DOOR_INPUT_PRESENCE, entries[2].inputs);
+#else
+    // Without trace nothing is recorded
+    TEST_ASSERT_EQUAL(0, fsm_automatic_door_get_trace(p_fsm, entries, FSM_TRACE_SIZE));
+#endif
+}
+
+void test_dwell_histograms_and_arc_counters(void)
+{
+    fsm_stats_data_t stats;
+
+    port_system_set_millis(1000);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    port_system_set_millis(6000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    port_system_set_millis(16000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+
+    // Presence while closing: the door reverses
+    port_system_set_millis(17000);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+
+    TEST_ASSERT_TRUE(fsm_automatic_door_get_stats(p_fsm, &stats));
+    TEST_ASSERT_EQUAL(1, stats.dwell[CLOSED][fsm_stats_bucket(1000)]);
+    TEST_ASSERT_EQUAL(1, stats.dwell[OPENING][13]); // 5000 ms in [4096, 8192)
+    TEST_ASSERT_EQUAL(1, stats.dwell[OPEN][fsm_stats_bucket(10000)]);
+    TEST_ASSERT_EQUAL(1, stats.dwell[CLOSING][fsm_stats_bucket(1000)]);
+    TEST_ASSERT_EQUAL(1, stats.arcs[0]);
+    TEST_ASSERT_EQUAL(1, stats.arcs[1]);
+    TEST_ASSERT_EQUAL(0, stats.arcs[2]);
+    TEST_ASSERT_EQUAL(1, stats.arcs[3]);
+    TEST_ASSERT_EQUAL(1, stats.arcs[4]); // CLOSING -> OPENING
+    TEST_ASSERT_EQUAL(0, stats.arcs[5]);
+    TEST_ASSERT_EQUAL(17000, stats.state_entry_ms);
+}
+
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+void test_latency_from_pir_edge_to_opening(void)
+{
+    latency_report_t report;
+    latency_init(&latency_automatic_door);
+
+    // What EXTI15_10_IRQHandler() does on a rising edge of the PIR sensor
+    latency_start(&latency_automatic_door, port_system_get_cycles());
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+
+    latency_get_report(&latency_automatic_door, &report);
+    TEST_ASSERT_EQUAL(1, report.count);
+    TEST_ASSERT_EQUAL(report.min_cycles, report.max_cycles);
+    latency_print_report("PIR to door opening", &latency_automatic_door);
+}
+
+/* Change the output of the PIR sensor at `now_ms` and let the SysTick deliver it once the filter has settled, as on the board */
+static void _pir_output(uint32_t now_ms, bool level)
+{
+    port_system_set_millis(now_ms);
+    pir_sensor_automatic_door.gpio_level = level;
+    port_gpio_sim_exti_edge(PIR_SENSOR_AUTOMATIC_DOOR_PIN);
+    port_system_set_millis(now_ms + (level ? PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS : PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS));
+    SysTick_Handler();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+}
+
+void test_latency_only_of_openings_by_presence(void)
+{
+    latency_report_t report;
+    latency_init(&latency_automatic_door);
+
+    // A presence opens the door: one sample, started by the ISR of the sensor
+    _pir_output(1000, HIGH);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    latency_get_report(&latency_automatic_door, &report);
+    TEST_ASSERT_EQUAL(1, report.count);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    _pir_output(2000, LOW);
+
+    // Another presence only keeps the door open
+    _pir_output(10000, HIGH);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    _pir_output(11000, LOW);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+
+    // The button opens the door later: the start of the second presence is not a sample
+    port_system_set_millis(30000);
+    event_queue_push(&event_queue_automatic_door, EVENT_BUTTON_PRESS);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    latency_get_report(&latency_automatic_door, &report);
+    TEST_ASSERT_EQUAL(1, report.count);
+}
+#endif
+
+void test_record_and_replay(void)
+{
+    uint8_t buffer[32];
+    event_record_t record;
+    event_record_reader_t reader;
+    uint32_t timestamp_ms;
+    uint8_t event;
+
+    event_record_init(&record, buffer, sizeof(buffer));
+    fsm_automatic_door_set_record(p_fsm, &record);
+    port_system_set_millis(1000);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    port_system_set_millis(6000);
+    _motor_timeout_isr();
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(3, event_record_get_count(&record));
+
+    // Replay on a new door
+    fsm_automatic_door_delete(p_fsm);
+    port_system_init();
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    event_record_reader_init(&reader, buffer, event_record_get_length(&record));
+    while (event_record_read(&reader, &timestamp_ms, &event))
+    {
+        port_system_set_millis(timestamp_ms);
+        if (event == EVENT_MOTOR_TIMEOUT)
+        {
+            _motor_timeout_isr();
+        }
+        else
+        {
+            event_queue_push(&event_queue_automatic_door, event);
+        }
+        fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    }
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(1000, fsm_automatic_door_get_last_time_presence(p_fsm));
+}
+
+void test_delete_and_new_again(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    TEST_ASSERT_NOT_NULL(p_fsm);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+}
+
+#if defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) && (FSM_AUTOMATIC_DOOR_POOL_SIZE > 0)
+void test_pool_exhaustion_and_reuse(void)
+{
+    fsm_t *p_doors[FSM_AUTOMATIC_DOOR_POOL_SIZE];
+
+    // setUp() already took one slot
+    p_doors[0] = p_fsm;
+    for (int i = 1; i < FSM_AUTOMATIC_DOOR_POOL_SIZE; i++)
+    {
+        p_doors[i] = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+        TEST_ASSERT_NOT_NULL(p_doors[i]);
+    }
+    TEST_ASSERT_NULL(fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door));
+
+    // A freed slot is the next one handed out
+    fsm_automatic_door_delete(p_doors[1]);
+    TEST_ASSERT_EQUAL_PTR(p_doors[1], fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door));
+
+    for (int i = 1; i < FSM_AUTOMATIC_DOOR_POOL_SIZE; i++)
+    {
+        fsm_automatic_door_delete(p_doors[i]);
+    }
+}
+
+void test_pool_ignores_double_and_foreign_delete(void)
+{
+    fsm_automatic_door_t foreign;
+    fsm_t *p_doors[FSM_AUTOMATIC_DOOR_POOL_SIZE];
+
+    fsm_automatic_door_delete(p_fsm);
+    fsm_automatic_door_delete(p_fsm);
+    fsm_automatic_door_delete(&foreign.f);
+
+    // Only one slot was given back: every slot is handed out once and then the pool is full
+    for (int i = 0; i < FSM_AUTOMATIC_DOOR_POOL_SIZE; i++)
+    {
+        p_doors[i] = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+        TEST_ASSERT_NOT_NULL(p_doors[i]);
+        for (int j = 0; j < i; j++)
+        {
+            TEST_ASSERT_TRUE(p_doors[j] != p_doors[i]);
+        }
+    }
+    TEST_ASSERT_NULL(fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door));
+
+    p_fsm = p_doors[0];
+    for (int i = 1; i < FSM_AUTOMATIC_DOOR_POOL_SIZE; i++)
+    {
+        fsm_automatic_door_delete(p_doors[i]);
+    }
+}
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_closed);
+    RUN_TEST(test_no_event_no_evaluation);
+    RUN_TEST(test_situation_1_with_events);
+    RUN_TEST(test_press_and_release_between_two_fires_is_not_lost);
+    RUN_TEST(test_stale_timeout_after_reversal_in_same_drain);
+    RUN_TEST(test_press_while_opening_is_taken_on_open);
+    RUN_TEST(test_activity_only_when_not_closed);
+    RUN_TEST(test_snapshot_reads_only_the_changed_input);
+    RUN_TEST(test_no_stale_snapshot_out_of_the_engine);
+    RUN_TEST(test_trace_of_transitions);
+    RUN_TEST(test_dwell_histograms_and_arc_counters);
+#if defined(FSM_AUTOMATIC_DOOR_LATENCY)
+    RUN_TEST(test_latency_from_pir_edge_to_opening);
+    RUN_TEST(test_latency_only_of_openings_by_presence);
+#endif
+    RUN_TEST(test_record_and_replay);
+    RUN_TEST(test_delete_and_new_again);
+#if defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) && (FSM_AUTOMATIC_DOOR_POOL_SIZE > 0)
+    RUN_TEST(test_pool_exhaustion_and_reuse);
+    RUN_TEST(test_pool_ignores_double_and_foreign_delete);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <unity.h>
+#include "fsm_automatic_door_fleet.h"
+
+#define FLEET_TEST_DOORS 64     /*!< Number of doors of the fleet under test */
+#define FLEET_TEST_STEPS 20000  /*!< Number of steps of the equivalence test */
+#define FLEET_TEST_STEP_MS 250  /*!< Virtual time between two steps */
+
+static fsm_automatic_door_fleet_t *p_fleet = NULL;
+
+void setUp(void)
+{
+    port_system_init();
+    p_fleet = fsm_automatic_door_fleet_new(FLEET_TEST_DOORS);
+    TEST_ASSERT_NOT_NULL(p_fleet);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_fleet_delete(p_fleet);
+}
+
+void test_initial_status(void)
+{
+    for (uint32_t i = 0; i < FLEET_TEST_DOORS; i++)
+    {
+        TEST_ASSERT_EQUAL(CLOSED, p_fleet->p_state[i]);
+        TEST_ASSERT_EQUAL(FLEET_FLAG_LED_CLOSE_ON, p_fleet->p_flags[i]);
+    }
+    TEST_ASSERT_EQUAL(0, fsm_automatic_door_fleet_fire_all(p_fleet, 0));
+    TEST_ASSERT_EQUAL(11, fsm_automatic_door_fleet_bytes_per_door());
+}
+
+void test_doors_are_independent(void)
+{
+    fsm_automatic_door_fleet_set_inputs(p_fleet, 3, true, false);
+    fsm_automatic_door_fleet_set_inputs(p_fleet, 7, false, true);
+    TEST_ASSERT_EQUAL(2, fsm_automatic_door_fleet_fire_all(p_fleet, 100));
+    for (uint32_t i = 0; i < FLEET_TEST_DOORS; i++)
+    {
+        bool opened = (i == 3) || (i == 7);
+        TEST_ASSERT_EQUAL(opened ? OPENING : CLOSED, p_fleet->p_state[i]);
+    }
+    TEST_ASSERT_EQUAL(100, p_fleet->p_last_time_presence_or_button[3]);
+    TEST_ASSERT_EQUAL(100 + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, p_fleet->p_motor_deadline_ms[7]);
+}
+
+void test_press_is_taken_once(void)
+{
+    // A press while the door opens is kept and then keeps the door open once
+    fsm_automatic_door_fleet_set_inputs(p_fleet, 0, true, false);
+    fsm_automatic_door_fleet_fire_all(p_fleet, 0);
+    fsm_automatic_door_fleet_set_inputs(p_fleet, 0, false, true);
+    fsm_automatic_door_fleet_set_inputs(p_fleet, 0, false, false);
+    TEST_ASSERT_EQUAL(0, fsm_automatic_door_fleet_fire_all(p_fleet, 100));
+    TEST_ASSERT_EQUAL(FLEET_INPUT_BUTTON, p_fleet->p_inputs[0]);
+
+    uint32_t now = AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS;
+    fsm_automatic_door_fleet_fire_all(p_fleet, now);
+    TEST_ASSERT_EQUAL(OPEN, p_fleet->p_state[0]);
+    TEST_ASSERT_EQUAL(1, fsm_automatic_door_fleet_fire_all(p_fleet, now + 100));
+    TEST_ASSERT_EQUAL(0, p_fleet->p_inputs[0]);
+    TEST_ASSERT_EQUAL(now + 100 + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS, p_fleet->p_motor_deadline_ms[0]);
+
+    // With the press taken, the door closes and stays closed
+    now += 100 + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS;
+    fsm_automatic_door_fleet_fire_all(p_fleet, now);
+    TEST_ASSERT_EQUAL(CLOSING, p_fleet->p_state[0]);
+    now += AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS;
+    fsm_automatic_door_fleet_fire_all(p_fleet, now);
+    TEST_ASSERT_EQUAL(0, fsm_automatic_door_fleet_fire_all(p_fleet, now + 100));
+    TEST_ASSERT_EQUAL(CLOSED, p_fleet->p_state[0]);
+}
+
+/**
+ * @brief Drive a real door (native port, motor without position feedback) and door 0 of the fleet with the same random inputs and check that they always agree.
+ */
+void test_same_behaviour_as_single_door(void)
+{
+    fsm_t *p_door = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    uint32_t seed = 12345;
+    TEST_ASSERT_FALSE(port_motor_has_position(&motor_automatic_door));
+
+    for (uint32_t step = 0; step < FLEET_TEST_STEPS; step++)
+    {
+        uint32_t now = step * FLEET_TEST_STEP_MS;
+        port_system_set_millis(now);
+
+        // Inputs change rarely, so that the door goes through all the states
+        seed = seed * 1103515245 + 12345;
+        bool presence = ((seed >> 16) % 16) == 0;
+        bool button = ((seed >> 20) % 64) == 0;
+        port_pir_sensor_set_status(&pir_sensor_automatic_door, presence);
+        if (button)
+        {
+            // The ISR of the button sets the flag of a press, the FSM clears it when it takes the press
+            button_emergency.flag_pressed = true;
+        }
+        fsm_automatic_door_fleet_set_inputs(p_fleet, 0, presence, button);
+
+        // The test plays the role of the timer ISR of the real door
+        if (motor_automatic_door.timer_active && (now - motor_automatic_door.timer_start_ms >= motor_automatic_door.timeout_ms))
+        {
+            port_motor_set_timeout_status(&motor_automatic_door, true);
+        }
+
+        fsm_automatic_door_fire(p_door);
+        fsm_automatic_door_fleet_fire_all(p_fleet, now);
+
+        uint8_t flags = p_fleet->p_flags[0];
+        TEST_ASSERT_EQUAL(fsm_get_state(p_door), p_fleet->p_state[0]);
+        TEST_ASSERT_EQUAL(button_emergency.flag_pressed, (p_fleet->p_inputs[0] & FLEET_INPUT_BUTTON) != 0);
+        TEST_ASSERT_EQUAL(fsm_automatic_door_get_presence_status(p_door), (flags & FLEET_FLAG_PRESENCE) != 0);
+        TEST_ASSERT_EQUAL(fsm_automatic_door_get_last_time_presence(p_door), p_fleet->p_last_time_presence_or_button[0]);
+        TEST_ASSERT_EQUAL(led_opening.timer_active, (flags & FLEET_FLAG_LED_OPEN_BLINK) != 0);
+        TEST_ASSERT_EQUAL(led_closing.timer_active, (flags & FLEET_FLAG_LED_CLOSE_BLINK) != 0);
+        if (!led_opening.timer_active)
+        {
+            TEST_ASSERT_EQUAL(port_led_get_status(&led_opening), (flags & FLEET_FLAG_LED_OPEN_ON) != 0);
+        }
+        if (!led_closing.timer_active)
+        {
+            TEST_ASSERT_EQUAL(port_led_get_status(&led_closing), (flags & FLEET_FLAG_LED_CLOSE_ON) != 0);
+        }
+        if (motor_automatic_door.timer_active)
+        {
+            TEST_ASSERT_EQUAL(motor_automatic_door.timer_start_ms + motor_automatic_door.timeout_ms, p_fleet->p_motor_deadline_ms[0]);
+        }
+    }
+    fsm_automatic_door_delete(p_door);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_initial_status);
+    RUN_TEST(test_doors_are_independent);
+    RUN_TEST(test_press_is_taken_once);
+    RUN_TEST(test_same_behaviour_as_single_door);
+    return UNITY_END();
+}
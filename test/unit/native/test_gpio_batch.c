@@ -0,0 +1,150 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+
+// Both LEDs of the door are on the simulated GPIOB (PB3 and PB4), which counts the bus accesses of the port layer
+static fsm_t *p_fsm = NULL;
+
+static void _reset_counters(void)
+{
+    gpio_sim_b.reads = 0;
+    gpio_sim_b.writes = 0;
+}
+
+static void _fire(uint8_t event)
+{
+    if (event == EVENT_MOTOR_TIMEOUT)
+    {
+        TIM2_IRQHandler(); // Sets the timeout and pushes the event, as on the board
+    }
+    else
+    {
+        event_queue_push(&event_queue_automatic_door, event);
+    }
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+}
+
+void setUp(void)
+{
+    port_system_init();
+    gpio_sim_b.ODR = 0;
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, false);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+}
+
+/**
+ * @brief The on/off of a LED is a single write of BSRR, with no read of ODR, and the toggle reads ODR once. The other pins of the port keep their level.
+ */
+void test_led_single_access(void)
+{
+    gpio_sim_b.ODR |= BIT_POS_TO_MASK(0); // Another pin of the port, written by someone else
+    _reset_counters();
+
+    port_led_on(&led_opening);
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.writes);
+    port_led_off(&led_closing);
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(2, gpio_sim_b.writes);
+    port_led_toggle(&led_closing);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(3, gpio_sim_b.writes);
+
+    TEST_ASSERT_EQUAL_HEX32(BIT_POS_TO_MASK(0) | BIT_POS_TO_MASK(LED_OPENING_PIN) | BIT_POS_TO_MASK(LED_CLOSING_PIN), gpio_sim_b.ODR);
+}
+
+/**
+ * @brief Every action of the door writes both LEDs in a single write of the port and reads nothing.
+ */
+void test_one_write_per_action(void)
+{
+    // do_open_door
+    _reset_counters();
+    _fire(EVENT_PIR_RISING);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.writes);
+    TEST_ASSERT_EQUAL_HEX32(0, gpio_sim_b.ODR);
+
+    // do_stay_open
+    _reset_counters();
+    _fire(EVENT_MOTOR_TIMEOUT);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.writes);
+    TEST_ASSERT_EQUAL_HEX32(BIT_POS_TO_MASK(LED_OPENING_PIN), gpio_sim_b.ODR);
+
+    // do_keep_open: no LED changes, no access
+    _reset_counters();
+    _fire(EVENT_PIR_RISING);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads + gpio_sim_b.writes);
+
+    // do_close_door
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, false);
+    _fire(EVENT_PIR_FALLING);
+    _reset_counters();
+    _fire(EVENT_MOTOR_TIMEOUT);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.writes);
+    TEST_ASSERT_EQUAL_HEX32(0, gpio_sim_b.ODR);
+
+    // do_stay_closed
+    _reset_counters();
+    _fire(EVENT_MOTOR_TIMEOUT);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, gpio_sim_b.reads);
+    TEST_ASSERT_EQUAL(1, gpio_sim_b.writes);
+    TEST_ASSERT_EQUAL_HEX32(BIT_POS_TO_MASK(LED_CLOSING_PIN), gpio_sim_b.ODR);
+}
+
+/**
+ * @brief A batch keeps the last level of each pin and writes each port once. A port that does not fit is written at once.
+ */
+void test_batch_composes_per_port(void)
+{
+    port_gpio_sim_t ports[PORT_GPIO_SIM_BATCH_MAX_PORTS + 1] = {0};
+    port_gpio_sim_batch_t batch;
+    port_gpio_sim_batch_init(&batch);
+
+    ports[0].ODR = BIT_POS_TO_MASK(1) | BIT_POS_TO_MASK(15);
+    port_gpio_sim_batch_write(&batch, &ports[0], 1, LOW);
+    port_gpio_sim_batch_write(&batch, &ports[0], 2, HIGH);
+    port_gpio_sim_batch_write(&batch, &ports[0], 2, LOW);
+    port_gpio_sim_batch_write(&batch, &ports[0], 3, LOW);
+    port_gpio_sim_batch_write(&batch, &ports[0], 3, HIGH);
+    for (uint32_t i = 1; i <= PORT_GPIO_SIM_BATCH_MAX_PORTS; i++)
+    {
+        port_gpio_sim_batch_write(&batch, &ports[i], 15, HIGH);
+    }
+    TEST_ASSERT_EQUAL(0, ports[0].writes);
+    TEST_ASSERT_EQUAL(1, ports[PORT_GPIO_SIM_BATCH_MAX_PORTS].writes);
+
+    port_gpio_sim_batch_commit(&batch);
+    for (uint32_t i = 0; i <= PORT_GPIO_SIM_BATCH_MAX_PORTS; i++)
+    {
+        TEST_ASSERT_EQUAL(0, ports[i].reads);
+        TEST_ASSERT_EQUAL(1, ports[i].writes);
+    }
+    TEST_ASSERT_EQUAL_HEX32(BIT_POS_TO_MASK(3) | BIT_POS_TO_MASK(15), ports[0].ODR);
+    TEST_ASSERT_EQUAL_HEX32(BIT_POS_TO_MASK(15), ports[1].ODR);
+
+    // The batch is empty after the commit
+    port_gpio_sim_batch_commit(&batch);
+    TEST_ASSERT_EQUAL(1, ports[0].writes);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_led_single_access);
+    RUN_TEST(test_one_write_per_action);
+    RUN_TEST(test_batch_composes_per_port);
+    return UNITY_END();
+}
@@ -0,0 +1,174 @@
+#include <unity.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include "fsm_automatic_door.h"
+#include "port_timer_sim.h"
+#include "port_log.h"
+
+#define TEST_NS_PER_MS 1000000ULL /*!< Nanoseconds per tick of the main loop */
+#define TEST_LOOP_MS 2000U        /*!< Duration of the main loop in the test of the period */
+#define TEST_PIR_PERIOD_MS 40U    /*!< Period of the presences in the test of the period */
+
+static char sink[16 * LOG_RING_SIZE];
+
+void setUp(void)
+{
+    log_uart.p_sink = sink;
+    log_uart.sink_size = sizeof(sink);
+    port_log_init(&log_uart);
+}
+
+void tearDown(void)
+{
+}
+
+/* A line of exactly `len` bytes (`len` >= 8), numbered so that a missing, repeated or split line shows in the sink */
+static int _line(char *p_buf, uint32_t number, int len)
+{
+    snprintf(p_buf, (size_t)len + 1, "%06" PRIu32 "%-*s", number, len - 6, ":");
+    p_buf[len - 1] = '\n';
+    return len;
+}
+
+/**
+ * @brief A write returns without waiting for the UART, and the DMA sends the lines in the background, in order and intact, also when they wrap around the end of the ring.
+ */
+void test_output_drains_in_background(void)
+{
+    char expected[4 * LOG_RING_SIZE];
+    char line[64];
+    uint32_t expected_len = 0;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        int len = _line(line, i, 20 + (int)(i % 37));
+        TEST_ASSERT_EQUAL(len, port_log_write(&log_uart, line, len));
+        TEST_ASSERT_EQUAL_UINT64(i * 3 * TEST_NS_PER_MS, log_uart.now_ns); // The write has not waited
+        memcpy(&expected[expected_len], line, (size_t)len);
+        expected_len += (uint32_t)len;
+
+        // Sometimes less time than the lines take to go out
+        port_log_sim_advance(&log_uart, 3 * TEST_NS_PER_MS);
+    }
+    TEST_ASSERT_TRUE(log_ring_get_used(&log_uart.ring) > 0);
+    port_log_sim_advance(&log_uart, 1000 * TEST_NS_PER_MS);
+    TEST_ASSERT_EQUAL(0, log_ring_get_used(&log_uart.ring));
+    TEST_ASSERT_EQUAL(0, log_uart.dma_len);
+    TEST_ASSERT_EQUAL(0, port_log_get_lost(&log_uart));
+    TEST_ASSERT_EQUAL(expected_len, log_uart.sink_len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, sink, expected_len);
+    TEST_ASSERT_TRUE(expected_len > LOG_RING_SIZE);
+    TEST_ASSERT_TRUE(log_uart.transfers < 100); // The lines queued while the DMA is busy go out together
+}
+
+/**
+ * @brief When the ring is full a write is dropped whole and its bytes are counted as lost: the UART only sends whole lines, and the log goes on when there is room again.
+ */
+void test_drop_on_full_counts_lost_bytes(void)
+{
+    char line[32];
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        port_log_write(&log_uart, line, _line(line, i, 20));
+    }
+    uint32_t queued = LOG_RING_SIZE / 20;
+    TEST_ASSERT_EQUAL((100 - queued) * 20, port_log_get_lost(&log_uart));
+    TEST_ASSERT_EQUAL_UINT64(0, log_uart.now_ns);
+
+    port_log_sim_advance(&log_uart, 1000 * TEST_NS_PER_MS);
+    TEST_ASSERT_EQUAL(queued * 20, log_uart.sink_len);
+    for (uint32_t i = 0; i < queued; i++)
+    {
+        TEST_ASSERT_EQUAL_MEMORY(line, &sink[i * 20], _line(line, i, 20));
+    }
+
+    port_log_write(&log_uart, line, _line(line, 1000, 20));
+    port_log_sim_advance(&log_uart, 1000 * TEST_NS_PER_MS);
+    TEST_ASSERT_EQUAL((queued + 1) * 20, log_uart.sink_len);
+    TEST_ASSERT_EQUAL_MEMORY(line, &sink[queued * 20], 20);
+    TEST_ASSERT_EQUAL((100 - queued) * 20, port_log_get_lost(&log_uart));
+}
+
+/* Run the main loop of the door for `TEST_LOOP_MS` ticks with a presence every `TEST_PIR_PERIOD_MS`. On every change of the state of the door it logs `lines` lines of 64 bytes, through the DMA or waiting for the UART. Returns the longest period of the loop in ns */
+static uint64_t _main_loop_period(uint32_t lines, bool blocking, uint32_t *p_bytes)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    fsm_t *p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    port_log_init(&log_uart);
+    int state = fsm_get_state(p_fsm);
+    uint64_t max_period_ns = 0;
+    char line[64];
+    *p_bytes = 0;
+    for (uint32_t ms = 0; ms < TEST_LOOP_MS; ms++)
+    {
+        uint64_t start_ns = log_uart.now_ns;
+        if (ms % (TEST_PIR_PERIOD_MS / 2) == 0)
+        {
+            bool presence = (ms % TEST_PIR_PERIOD_MS) == 0;
+            port_pir_sensor_set_status(&pir_sensor_automatic_door, presence);
+            event_queue_push(&event_queue_automatic_door, presence ? EVENT_PIR_RISING : EVENT_PIR_FALLING);
+        }
+        while (port_timer_sim_step(ms + 1))
+        {
+        }
+        fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+        if (fsm_get_state(p_fsm) != state)
+        {
+            state = fsm_get_state(p_fsm);
+            for (uint32_t i = 0; i < lines; i++)
+            {
+                int len = _line(line, *p_bytes, sizeof(line));
+                *p_bytes += (uint32_t)len;
+                if (blocking)
+                {
+                    port_log_sim_write_blocking(&log_uart, line, len);
+                }
+                else
+                {
+                    port_log_write(&log_uart, line, len);
+                }
+            }
+        }
+
+        // Sleep until the next tick, unless the log has already taken it
+        uint64_t busy_ns = log_uart.now_ns - start_ns;
+        port_log_sim_advance(&log_uart, (busy_ns < TEST_NS_PER_MS) ? TEST_NS_PER_MS - busy_ns : 0);
+        uint64_t period_ns = log_uart.now_ns - start_ns;
+        max_period_ns = (period_ns > max_period_ns) ? period_ns : max_period_ns;
+    }
+    fsm_automatic_door_delete(p_fsm);
+    port_log_sim_advance(&log_uart, 1000 * TEST_NS_PER_MS);
+    return max_period_ns;
+}
+
+/**
+ * @brief With the DMA the period of the main loop is the tick whatever the volume of the log: the bytes that do not fit are lost and counted instead. Waiting for the UART, the period grows with the volume.
+ */
+void test_loop_period_does_not_depend_on_log_volume(void)
+{
+    const uint32_t lines[] = {1, 4, 16};
+    uint64_t blocking_ns[3];
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t bytes;
+        TEST_ASSERT_EQUAL_UINT64(TEST_NS_PER_MS, _main_loop_period(lines[i], false, &bytes));
+        TEST_ASSERT_TRUE(bytes > 0);
+        TEST_ASSERT_EQUAL(bytes, log_uart.sink_len + port_log_get_lost(&log_uart));
+        TEST_ASSERT_EQUAL(0, log_uart.sink_len % 64); // Whole lines only
+
+        blocking_ns[i] = _main_loop_period(lines[i], true, &bytes);
+        TEST_ASSERT_EQUAL_UINT64(lines[i] * 64 * LOG_UART_BYTE_NS, blocking_ns[i]); // Longer than the tick: the loop misses ticks
+        TEST_ASSERT_EQUAL(0, port_log_get_lost(&log_uart));
+    }
+    TEST_ASSERT_TRUE(blocking_ns[0] < blocking_ns[1] && blocking_ns[1] < blocking_ns[2]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_output_drains_in_background);
+    RUN_TEST(test_drop_on_full_counts_lost_bytes);
+    RUN_TEST(test_loop_period_does_not_depend_on_log_volume);
+    return UNITY_END();
+}
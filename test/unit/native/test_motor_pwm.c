@@ -0,0 +1,158 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+
+static fsm_t *p_fsm = NULL;
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+}
+
+static void _fire(uint8_t event)
+{
+    if (event == EVENT_MOTOR_TIMEOUT)
+    {
+        TIM2_IRQHandler(); // Sets the timeout and pushes the event, as on the board
+    }
+    else
+    {
+        event_queue_push(&event_queue_automatic_door, event);
+    }
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+}
+
+/* Run the update ISR of the PWM timer every step until the profile ends. Checks that every ISR writes the compare register once with the duty of the table, and returns the travel in counts times milliseconds */
+static uint64_t _run_profile(uint32_t *p_irqs)
+{
+    const motor_profile_t *p_profile = motor_automatic_door.p_profile;
+    uint64_t travel = (uint64_t)port_motor_get_duty(&motor_automatic_door) * p_profile->step_ms;
+    *p_irqs = 0;
+    while (motor_automatic_door.pwm_update_irq)
+    {
+        uint32_t writes = motor_automatic_door.duty_writes;
+        TIM1_UP_TIM10_IRQHandler();
+        (*p_irqs)++;
+        TEST_ASSERT_EQUAL(writes + 1, motor_automatic_door.duty_writes);
+        uint32_t step = motor_automatic_door.profile_step;
+        TEST_ASSERT_EQUAL((step < p_profile->steps) ? p_profile->duty[step] : 0, port_motor_get_duty(&motor_automatic_door));
+        travel += (uint64_t)port_motor_get_duty(&motor_automatic_door) * p_profile->step_ms;
+    }
+    return travel;
+}
+
+/**
+ * @brief The profile accelerates, cruises at full scale and decelerates, and it integrates exactly to the travel of `total_ms` - `ramp_ms` at full speed.
+ */
+void test_profile_integrates_to_full_travel(void)
+{
+    motor_profile_t profile;
+    TEST_ASSERT_TRUE(motor_profile_build(&profile, AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS, MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS, MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE));
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS / MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS, profile.steps);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE * (AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS - MOTOR_AUTOMATIC_DOOR_PROFILE_RAMP_MS), motor_profile_get_travel(&profile, profile.steps));
+
+    for (uint32_t i = 1; i < profile.steps; i++)
+    {
+        TEST_ASSERT_TRUE(profile.duty[i] <= MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE);
+        if (i < profile.ramp_steps)
+        {
+            TEST_ASSERT_TRUE(profile.duty[i] > profile.duty[i - 1]);
+        }
+        else if (i < profile.steps - profile.ramp_steps)
+        {
+            TEST_ASSERT_EQUAL(MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE, profile.duty[i]);
+        }
+        else
+        {
+            TEST_ASSERT_TRUE(profile.duty[i] < profile.duty[i - 1]);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, motor_profile_get_travel(&profile, 0));
+    TEST_ASSERT_EQUAL_UINT64(motor_profile_get_travel(&profile, profile.steps), motor_profile_get_travel(&profile, profile.steps + 10));
+
+    // Durations that do not divide evenly: the rounding errors of the duties do not accumulate
+    TEST_ASSERT_TRUE(motor_profile_build(&profile, 990, 10, 337, 777));
+    TEST_ASSERT_EQUAL(33, profile.ramp_steps);
+    TEST_ASSERT_EQUAL_UINT64(777ULL * (990 - 330), motor_profile_get_travel(&profile, profile.steps));
+
+    // Without ramps the duty is full scale all along
+    TEST_ASSERT_TRUE(motor_profile_build(&profile, 100, 10, 0, 800));
+    TEST_ASSERT_EQUAL_UINT64(800ULL * 100, motor_profile_get_travel(&profile, profile.steps));
+
+    // Parameters that are not valid
+    TEST_ASSERT_FALSE(motor_profile_build(&profile, 105, 10, 0, 800));
+    TEST_ASSERT_EQUAL(0, profile.steps);
+    TEST_ASSERT_FALSE(motor_profile_build(&profile, 10 * (MOTOR_PROFILE_MAX_STEPS + 1), 10, 0, 800));
+    TEST_ASSERT_FALSE(motor_profile_build(&profile, 100, 10, 60, 800));
+    TEST_ASSERT_FALSE(motor_profile_build(&profile, 100, 0, 0, 800));
+    TEST_ASSERT_FALSE(motor_profile_build(&profile, 100, 10, 0, 70000));
+}
+
+/**
+ * @brief The door opens with the profile: the update ISR runs once per step, loads the duty of the table with a single write whatever the step, and the door travels all the way before the timeout of the opening.
+ */
+void test_opening_with_constant_cost_isr(void)
+{
+    const motor_profile_t *p_profile = motor_automatic_door.p_profile;
+    TEST_ASSERT_EQUAL(0, port_motor_get_duty(&motor_automatic_door));
+    TEST_ASSERT_FALSE(motor_automatic_door.pwm_update_irq);
+
+    _fire(EVENT_PIR_RISING);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(motor_automatic_door.direction_open);
+    TEST_ASSERT_EQUAL(p_profile->duty[0], port_motor_get_duty(&motor_automatic_door));
+
+    uint32_t irqs;
+    uint64_t travel = _run_profile(&irqs);
+    TEST_ASSERT_EQUAL(p_profile->steps, irqs);
+    TEST_ASSERT_EQUAL(irqs * MOTOR_AUTOMATIC_DOOR_PROFILE_STEP_MS, AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_UINT64(motor_profile_get_travel(p_profile, p_profile->steps), travel);
+    TEST_ASSERT_EQUAL(0, port_motor_get_duty(&motor_automatic_door));
+
+    _fire(EVENT_PIR_FALLING);
+    _fire(EVENT_MOTOR_TIMEOUT);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(0, port_motor_get_duty(&motor_automatic_door));
+}
+
+/**
+ * @brief A presence while the door is closing stops the motor and starts the profile again from the beginning, in the opening direction.
+ */
+void test_reversal_restarts_profile(void)
+{
+    _fire(EVENT_PIR_RISING);
+    _fire(EVENT_PIR_FALLING);
+    _fire(EVENT_MOTOR_TIMEOUT);
+    _fire(EVENT_MOTOR_TIMEOUT);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(motor_automatic_door.direction_open);
+
+    // Half way through the closing
+    for (uint32_t i = 0; i < motor_automatic_door.p_profile->steps / 2; i++)
+    {
+        TIM1_UP_TIM10_IRQHandler();
+    }
+    TEST_ASSERT_EQUAL(MOTOR_AUTOMATIC_DOOR_PWM_FULL_SCALE, port_motor_get_duty(&motor_automatic_door));
+
+    _fire(EVENT_PIR_RISING);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_TRUE(motor_automatic_door.direction_open);
+    TEST_ASSERT_EQUAL(0, motor_automatic_door.profile_step);
+    TEST_ASSERT_EQUAL(motor_automatic_door.p_profile->duty[0], port_motor_get_duty(&motor_automatic_door));
+    TEST_ASSERT_TRUE(motor_automatic_door.pwm_update_irq);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_profile_integrates_to_full_travel);
+    RUN_TEST(test_opening_with_constant_cost_isr);
+    RUN_TEST(test_reversal_restarts_profile);
+    return UNITY_END();
+}
@@ -0,0 +1,185 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+#include "port_gpio_sim.h"
+
+#define TEST_PRESENCES 10      /*!< People that walk in front of the sensor while the door is open */
+#define TEST_PERIOD_MS 5000    /*!< Time between two people */
+#define TEST_GLITCH_AT_MS 100  /*!< Time of a spike of the output with nobody there, from the start of a period */
+#define TEST_GLITCH_MS 10      /*!< Length of the spike: shorter than the minimum high time */
+#define TEST_HIGH_AT_MS 1000   /*!< Time of the presence, from the start of a period */
+#define TEST_HIGH_MS 2000      /*!< Length of the presence */
+#define TEST_DROP_EVERY_MS 300 /*!< Time between the drops of the output during a presence */
+#define TEST_DROP_MS 20        /*!< Length of a drop: shorter than the hold */
+#define TEST_ARC_KEEP_OPEN 2   /*!< Arc of fsm_trans_automatic_door: OPEN -> OPEN re-arming the inactivity timeout */
+
+static fsm_t *p_fsm = NULL;
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+    pir_filter_init(&pir_sensor_automatic_door.filter, PIR_SENSOR_AUTOMATIC_DOOR_MIN_HIGH_MS, PIR_SENSOR_AUTOMATIC_DOOR_HOLD_MS, LOW);
+}
+
+/* Level of the output of the sensor at a time: in every period a spike, and a presence with `drops` short drops */
+static bool _chatter_level(uint32_t t_ms, uint32_t drops)
+{
+    uint32_t offset = t_ms % TEST_PERIOD_MS;
+    if ((offset >= TEST_GLITCH_AT_MS) && (offset < TEST_GLITCH_AT_MS + TEST_GLITCH_MS))
+    {
+        return HIGH;
+    }
+    if ((offset < TEST_HIGH_AT_MS) || (offset >= TEST_HIGH_AT_MS + TEST_HIGH_MS))
+    {
+        return LOW;
+    }
+    uint32_t in_high = offset - TEST_HIGH_AT_MS;
+    uint32_t drop = in_high / TEST_DROP_EVERY_MS;
+    return !((drop >= 1) && (drop <= drops) && ((in_high % TEST_DROP_EVERY_MS) < TEST_DROP_MS));
+}
+
+/* Open the door and replay TEST_PRESENCES periods millisecond by millisecond: an interrupt per edge, a SysTick per millisecond, and the main loop feeds the events. Returns the events fed to the FSM */
+static uint32_t _replay(uint32_t drops, uint32_t *p_keep_open)
+{
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TIM2_IRQHandler(); // The motor timeout expires
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    fsm_stats_data_t stats;
+    fsm_automatic_door_get_stats(p_fsm, &stats);
+    uint32_t keep_open_before = stats.arcs[TEST_ARC_KEEP_OPEN];
+
+    uint32_t events = 0;
+    for (uint32_t t = 0; t < TEST_PRESENCES * TEST_PERIOD_MS; t++)
+    {
+        port_system_set_millis(t);
+        bool level = _chatter_level(t, drops);
+        if (level != pir_sensor_automatic_door.gpio_level)
+        {
+            pir_sensor_automatic_door.gpio_level = level;
+            port_gpio_sim_exti_edge(PIR_SENSOR_AUTOMATIC_DOOR_PIN);
+        }
+        SysTick_Handler();
+        events += fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    }
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    TEST_ASSERT_FALSE(port_pir_sensor_get_status(&pir_sensor_automatic_door));
+
+    fsm_automatic_door_get_stats(p_fsm, &stats);
+    *p_keep_open = stats.arcs[TEST_ARC_KEEP_OPEN] - keep_open_before;
+    return events;
+}
+
+/**
+ * @brief A pulse shorter than the minimum high time is a glitch, a presence is delivered when its minimum high time has elapsed, and a drop shorter than the hold is coalesced.
+ */
+void test_filter_edges(void)
+{
+    pir_filter_t filter;
+    pir_filter_init(&filter, 50, 1000, false);
+
+    // Glitch
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 100, true));
+    TEST_ASSERT_TRUE(pir_filter_is_pending(&filter));
+    TEST_ASSERT_FALSE(pir_filter_poll(&filter, 149));
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 110, false));
+    TEST_ASSERT_FALSE(pir_filter_is_pending(&filter));
+    TEST_ASSERT_EQUAL(1, filter.glitches);
+
+    // Presence, with a drop inside the hold
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 1000, true));
+    TEST_ASSERT_FALSE(pir_filter_poll(&filter, 1049));
+    TEST_ASSERT_TRUE(pir_filter_poll(&filter, 1050));
+    TEST_ASSERT_TRUE(filter.present);
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 1500, false));
+    TEST_ASSERT_FALSE(pir_filter_poll(&filter, 1999));
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 1600, true));
+    TEST_ASSERT_FALSE(pir_filter_is_pending(&filter));
+    TEST_ASSERT_EQUAL(1, filter.coalesced);
+
+    // End of the presence after the hold
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 2000, false));
+    TEST_ASSERT_FALSE(pir_filter_poll(&filter, 2999));
+    TEST_ASSERT_TRUE(pir_filter_poll(&filter, 3000));
+    TEST_ASSERT_FALSE(filter.present);
+
+    // A pulse long enough whose presence no poll delivered is delivered by its falling edge, and its end by the next poll
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 4000, true));
+    TEST_ASSERT_TRUE(pir_filter_edge(&filter, 4060, false));
+    TEST_ASSERT_TRUE(filter.present);
+    TEST_ASSERT_TRUE(pir_filter_poll(&filter, 5060));
+    TEST_ASSERT_EQUAL(8, filter.raw_edges);
+    TEST_ASSERT_EQUAL(4, filter.delivered);
+
+    // Across the wrap-around of the system time
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, UINT32_MAX - 9, true));
+    TEST_ASSERT_FALSE(pir_filter_poll(&filter, 30));
+    TEST_ASSERT_TRUE(pir_filter_poll(&filter, 40));
+
+    // With both times at 0 every change of level is delivered at once
+    pir_filter_init(&filter, 0, 0, false);
+    TEST_ASSERT_TRUE(pir_filter_edge(&filter, 7, true));
+    TEST_ASSERT_TRUE(pir_filter_edge(&filter, 7, false));
+    TEST_ASSERT_FALSE(pir_filter_edge(&filter, 7, false));
+    TEST_ASSERT_FALSE(pir_filter_is_pending(&filter));
+}
+
+/**
+ * @brief Without the filter every edge is an event, and every spike and every end of a drop re-arms the door: the work of the FSM grows with the chatter.
+ */
+void test_chatter_without_filter(void)
+{
+    for (uint32_t drops = 2; drops <= 6; drops += 4)
+    {
+        pir_filter_init(&pir_sensor_automatic_door.filter, 0, 0, LOW);
+        uint32_t keep_open;
+        uint32_t events = _replay(drops, &keep_open);
+
+        TEST_ASSERT_EQUAL(TEST_PRESENCES * (4 + 2 * drops), events);
+        TEST_ASSERT_EQUAL(TEST_PRESENCES * (2 + drops), keep_open);
+        TEST_ASSERT_EQUAL(events, pir_sensor_automatic_door.filter.delivered);
+
+        fsm_automatic_door_delete(p_fsm);
+        setUp();
+    }
+}
+
+/**
+ * @brief With the filter a presence is two events and re-arms the door once, however much the sensor chatters. The counters tell the raw edges from the delivered ones.
+ */
+void test_chatter_with_filter(void)
+{
+    for (uint32_t drops = 2; drops <= 6; drops += 4)
+    {
+        uint32_t keep_open;
+        uint32_t events = _replay(drops, &keep_open);
+
+        TEST_ASSERT_EQUAL(2 * TEST_PRESENCES, events);
+        TEST_ASSERT_EQUAL(TEST_PRESENCES, keep_open);
+        TEST_ASSERT_EQUAL(TEST_PRESENCES * (4 + 2 * drops), pir_sensor_automatic_door.filter.raw_edges);
+        TEST_ASSERT_EQUAL(2 * TEST_PRESENCES, pir_sensor_automatic_door.filter.delivered);
+        TEST_ASSERT_EQUAL(TEST_PRESENCES, pir_sensor_automatic_door.filter.glitches);
+        TEST_ASSERT_EQUAL(TEST_PRESENCES * drops, pir_sensor_automatic_door.filter.coalesced);
+        TEST_ASSERT_FALSE(port_pir_sensor_is_filter_pending(&pir_sensor_automatic_door));
+
+        fsm_automatic_door_delete(p_fsm);
+        setUp();
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_filter_edges);
+    RUN_TEST(test_chatter_without_filter);
+    RUN_TEST(test_chatter_with_filter);
+    return UNITY_END();
+}
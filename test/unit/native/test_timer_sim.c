@@ -0,0 +1,136 @@
+#include <unity.h>
+#include "fsm_automatic_door.h"
+#include "port_timer_sim.h"
+
+static fsm_t *p_fsm = NULL;
+static uint32_t handler_calls[2];
+static uint32_t num_handler_calls;
+
+void setUp(void)
+{
+    port_system_init();
+    event_queue_init(&event_queue_automatic_door);
+    p_fsm = fsm_automatic_door_new(&button_emergency, &led_opening, &led_closing, &pir_sensor_automatic_door, &motor_automatic_door);
+    timer_sim_tim2.irqs = 0;
+    timer_sim_tim3.irqs = 0;
+    timer_sim_tim4.irqs = 0;
+}
+
+void tearDown(void)
+{
+    fsm_automatic_door_delete(p_fsm);
+}
+
+/* Run the simulation up to `until_ms` feeding the events of the ISRs to the door, as the main loop does */
+static void _run_until(uint32_t until_ms)
+{
+    while (port_timer_sim_step(until_ms))
+    {
+        fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    }
+}
+
+static void _tim3_handler(void)
+{
+    handler_calls[num_handler_calls++ % 2] = 3;
+}
+
+static void _tim4_handler(void)
+{
+    handler_calls[num_handler_calls++ % 2] = 4;
+}
+
+void test_period_from_psc_and_arr(void)
+{
+    // 5 s do not fit in 16 bits at 16 MHz: PSC 1249, ARR 63999, exact
+    port_motor_timeout_timer_activate(&motor_automatic_door, AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(1249, timer_sim_tim2.PSC);
+    TEST_ASSERT_EQUAL(63999, timer_sim_tim2.ARR);
+    TEST_ASSERT_EQUAL(1250ULL * 64000ULL, port_timer_sim_get_period_cycles(&timer_sim_tim2));
+
+    // 100 ms: PSC 24, ARR 63999, exact
+    TEST_ASSERT_EQUAL(24, timer_sim_tim4.PSC);
+    TEST_ASSERT_EQUAL(63999, timer_sim_tim4.ARR);
+
+    // The timeout expires at 5 s
+    TEST_ASSERT_TRUE(port_timer_sim_step(10000));
+    TEST_ASSERT_EQUAL(1250ULL * 64000ULL, port_timer_sim_get_cycles());
+    TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS, port_system_get_millis());
+    TEST_ASSERT_TRUE(motor_automatic_door.timeout);
+
+    // It does not interrupt again: the simulation jumps to the limit
+    TEST_ASSERT_FALSE(port_timer_sim_step(10000));
+    TEST_ASSERT_EQUAL(10000, port_system_get_millis());
+    TEST_ASSERT_EQUAL(1, timer_sim_tim2.irqs);
+}
+
+void test_situation_1_in_virtual_time(void)
+{
+    // Presence for 200 ms at 1 s
+    port_system_set_millis(1000);
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, true);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_RISING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    port_system_set_millis(1200);
+    port_pir_sensor_set_status(&pir_sensor_automatic_door, false);
+    event_queue_push(&event_queue_automatic_door, EVENT_PIR_FALLING);
+    fsm_automatic_door_fire_events(p_fsm, &event_queue_automatic_door);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+
+    // The opening LED blinks every 500 ms while opening
+    _run_until(5999);
+    TEST_ASSERT_EQUAL(OPENING, fsm_get_state(p_fsm));
+    TEST_ASSERT_EQUAL(9, timer_sim_tim3.irqs);
+    _run_until(6000);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+
+    // Open for the inactivity timeout, then closing with the closing LED blinking every 100 ms
+    _run_until(15999);
+    TEST_ASSERT_EQUAL(OPEN, fsm_get_state(p_fsm));
+    _run_until(16000);
+    TEST_ASSERT_EQUAL(CLOSING, fsm_get_state(p_fsm));
+    _run_until(21000);
+    TEST_ASSERT_EQUAL(CLOSED, fsm_get_state(p_fsm));
+    // The last toggle of the closing LED comes in the same cycle as the timeout, right after it (NVIC order)
+    TEST_ASSERT_EQUAL(50, timer_sim_tim4.irqs);
+    TEST_ASSERT_EQUAL(3, timer_sim_tim2.irqs);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_closing));
+
+    // Nothing else happens: a day passes in one step
+    TEST_ASSERT_FALSE(port_timer_sim_step(86400000));
+    TEST_ASSERT_EQUAL(86400000, port_system_get_millis());
+}
+
+void test_simultaneous_expiries_in_nvic_order(void)
+{
+    void (*p_tim3_handler)(void) = timer_sim_tim3.p_handler;
+    void (*p_tim4_handler)(void) = timer_sim_tim4.p_handler;
+    timer_sim_tim3.p_handler = _tim3_handler;
+    timer_sim_tim4.p_handler = _tim4_handler;
+    num_handler_calls = 0;
+
+    // TIM4 started first, but with the same period and start time TIM3 (lower IRQ number) runs first
+    port_timer_sim_set_period_ms(&timer_sim_tim3, 100);
+    port_timer_sim_set_period_ms(&timer_sim_tim4, 100);
+    port_timer_sim_start(&timer_sim_tim4);
+    port_timer_sim_start(&timer_sim_tim3);
+    TEST_ASSERT_TRUE(port_timer_sim_step(1000));
+    TEST_ASSERT_EQUAL(2, num_handler_calls);
+    TEST_ASSERT_EQUAL(3, handler_calls[0]);
+    TEST_ASSERT_EQUAL(4, handler_calls[1]);
+    TEST_ASSERT_EQUAL(100, port_system_get_millis());
+
+    port_timer_sim_stop(&timer_sim_tim3);
+    port_timer_sim_stop(&timer_sim_tim4);
+    timer_sim_tim3.p_handler = p_tim3_handler;
+    timer_sim_tim4.p_handler = p_tim4_handler;
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_period_from_psc_and_arr);
+    RUN_TEST(test_situation_1_in_virtual_time);
+    RUN_TEST(test_simultaneous_expiries_in_nvic_order);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+#include <unity.h>
+#include <string.h>
+#include "fsm_automatic_door.h"
+
+// Every door has 3 software timers (motor timeout and the blinking of both LEDs) on a single timing wheel
+#if defined(FSM_AUTOMATIC_DOOR_POOL_SIZE) && (FSM_AUTOMATIC_DOOR_POOL_SIZE > 0) && (FSM_AUTOMATIC_DOOR_POOL_SIZE < 64)
+#define TEST_NUM_DOORS FSM_AUTOMATIC_DOOR_POOL_SIZE
+#else
+#define TEST_NUM_DOORS 64
+#endif
+#define TEST_DOOR_STAGGER_MS 37 /*!< Time between the arrivals at consecutive doors */
+
+typedef struct
+{
+    fsm_t *p_fsm;
+    port_button_hw_t button;
+    port_led_hw_t led_open;
+    port_led_hw_t led_close;
+    port_pir_hw_t pir;
+    port_motor_hw_t motor;
+    event_queue_t queue;
+} test_door_t;
+
+static test_door_t doors[TEST_NUM_DOORS];
+static timer_wheel_t wheel;
+
+void setUp(void)
+{
+    port_system_init();
+    timer_wheel_init(&wheel, 0);
+    memset(doors, 0, sizeof(doors));
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        test_door_t *p_door = &doors[i];
+        p_door->led_open.timer_blink_semi_period_ms = LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS;
+        p_door->led_open.p_wheel = &wheel;
+        p_door->led_close.timer_blink_semi_period_ms = LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS;
+        p_door->led_close.p_wheel = &wheel;
+        p_door->motor.p_wheel = &wheel;
+        p_door->motor.p_event_queue = &p_door->queue;
+        event_queue_init(&p_door->queue);
+        p_door->p_fsm = fsm_automatic_door_new(&p_door->button, &p_door->led_open, &p_door->led_close, &p_door->pir, &p_door->motor);
+        TEST_ASSERT_NOT_NULL(p_door->p_fsm);
+    }
+}
+
+void tearDown(void)
+{
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        fsm_automatic_door_delete(doors[i].p_fsm);
+    }
+}
+
+/**
+ * @brief Full cycle of every door (situation 1) with all the timeouts and the blinking on the timing wheel: the transitions happen in the exact millisecond and the LEDs blink at their semi-period.
+ */
+void test_doors_cycle_on_one_wheel(void)
+{
+    uint32_t toggles_open[TEST_NUM_DOORS] = {0};
+    uint32_t toggles_close[TEST_NUM_DOORS] = {0};
+    uint32_t peak_pending = 0;
+    uint32_t end_ms = (TEST_NUM_DOORS - 1) * TEST_DOOR_STAGGER_MS + 21000;
+
+    for (uint32_t now = 1; now <= end_ms; now++)
+    {
+        // The SysTick: the wheel runs the callbacks of the timers that expire, which toggle the LEDs and push the motor timeouts
+        bool led_open[TEST_NUM_DOORS];
+        bool led_close[TEST_NUM_DOORS];
+        for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+        {
+            led_open[i] = port_led_get_status(&doors[i].led_open);
+            led_close[i] = port_led_get_status(&doors[i].led_close);
+        }
+        port_system_set_millis(now);
+        timer_wheel_advance(&wheel, now);
+
+        for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+        {
+            test_door_t *p_door = &doors[i];
+            uint32_t arrival_ms = 1 + i * TEST_DOOR_STAGGER_MS;
+            toggles_open[i] += (port_led_get_status(&p_door->led_open) != led_open[i]);
+            toggles_close[i] += (port_led_get_status(&p_door->led_close) != led_close[i]);
+
+            // Someone walks by: the PIR sensor detects them and stops at once
+            if (now == arrival_ms)
+            {
+                event_queue_push(&p_door->queue, EVENT_PIR_RISING);
+                event_queue_push(&p_door->queue, EVENT_PIR_FALLING);
+            }
+            fsm_automatic_door_fire_events(p_door->p_fsm, &p_door->queue);
+
+            int expected = CLOSED;
+            if (now >= arrival_ms && now < arrival_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS)
+            {
+                expected = OPENING;
+            }
+            else if (now >= arrival_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS && now < arrival_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS)
+            {
+                expected = OPEN;
+            }
+            else if (now >= arrival_ms + AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS && now < arrival_ms + 2 * AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS + AUTOMATIC_DOOR_INACTIVITY_TIMEOUT_MS)
+            {
+                expected = CLOSING;
+            }
+            TEST_ASSERT_EQUAL(expected, fsm_get_state(p_door->p_fsm));
+        }
+        peak_pending = wheel.pending > peak_pending ? wheel.pending : peak_pending;
+    }
+
+    // Every door was opening at the same time (motor timeout and opening LED)
+    TEST_ASSERT_EQUAL(2 * TEST_NUM_DOORS, peak_pending);
+    TEST_ASSERT_EQUAL(0, wheel.pending);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        // A toggle every semi-period while opening or closing, the last one in the same millisecond as the motor timeout
+        TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS / LED_OPENING_TIMER_BLINK_SEMI_PERIOD_MS, toggles_open[i]);
+        TEST_ASSERT_EQUAL(AUTOMATIC_DOOR_OPENING_CLOSING_TIMEOUT_MS / LED_CLOSING_TIMER_BLINK_SEMI_PERIOD_MS, toggles_close[i]);
+    }
+}
+
+/**
+ * @brief Re-arming a motor timeout postpones it and deactivating it cancels it, with the other timers of the wheel untouched.
+ */
+void test_motor_rearm_and_cancel(void)
+{
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        port_motor_timeout_timer_activate(&doors[i].motor, 1000);
+    }
+    timer_wheel_advance(&wheel, 500);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i += 2)
+    {
+        port_motor_timeout_timer_activate(&doors[i].motor, 1000);
+    }
+    timer_wheel_advance(&wheel, 700);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i += 3)
+    {
+        port_motor_timeout_timer_deactivate(&doors[i].motor);
+    }
+
+    timer_wheel_advance(&wheel, 999);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        TEST_ASSERT_FALSE(event_queue_is_pending(&doors[i].queue));
+    }
+    timer_wheel_advance(&wheel, 1000);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        bool expired = (i % 3 != 0) && (i % 2 != 0);
+        TEST_ASSERT_EQUAL(expired, event_queue_is_pending(&doors[i].queue));
+        TEST_ASSERT_EQUAL(expired, doors[i].motor.timeout);
+    }
+    timer_wheel_advance(&wheel, 1499);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        TEST_ASSERT_EQUAL((i % 3 != 0) && (i % 2 != 0), doors[i].motor.timeout);
+    }
+    timer_wheel_advance(&wheel, 1500);
+    for (uint32_t i = 0; i < TEST_NUM_DOORS; i++)
+    {
+        TEST_ASSERT_EQUAL(i % 3 != 0, doors[i].motor.timeout);
+    }
+    TEST_ASSERT_EQUAL(0, wheel.pending);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_doors_cycle_on_one_wheel);
+    RUN_TEST(test_motor_rearm_and_cancel);
+    return UNITY_END();
+}
@@ -14,19 +14,51 @@ void tearDown(void)
 
 void test_led(void)
 {
-    port_led_gpio_setup();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_init(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 
-    port_led_on();
-    TEST_ASSERT_TRUE(port_led_get_status());
+    port_led_on(&led_opening);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_opening));
 
-    port_led_off();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_off(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 
-    port_led_toggle();
-    TEST_ASSERT_TRUE(port_led_get_status());
-    port_led_toggle();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_toggle(&led_opening);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_opening));
+    port_led_toggle(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
+}
+
+void test_led_output_compare_blink(void)
+{
+    if (led_opening.timer_channel == 0)
+    {
+        TEST_IGNORE_MESSAGE("The LEDs are not blinked by output-compare channels (USE_LED_OUTPUT_COMPARE)");
+    }
+    port_led_init(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
+
+    // The timer toggles the pin by itself, with the update interrupt disabled
+    port_led_timer_activate(&led_opening);
+    TEST_ASSERT_FALSE(led_opening.p_timer->DIER & TIM_DIER_UIE);
+    for (uint32_t toggles = 0; toggles < 2; toggles++)
+    {
+        bool status = port_led_get_status(&led_opening);
+        uint32_t spins = 0;
+        while ((port_led_get_status(&led_opening) == status) && (spins < 100000000U))
+        {
+            spins++;
+        }
+        TEST_ASSERT_NOT_EQUAL(status, port_led_get_status(&led_opening));
+    }
+
+    // Deactivated, the LED keeps its level and the forced levels still work
+    port_led_timer_deactivate(&led_opening);
+    TEST_ASSERT_FALSE(led_opening.p_timer->CR1 & TIM_CR1_CEN);
+    port_led_on(&led_opening);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_opening));
+    port_led_off(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 }
 
 
@@ -34,5 +66,6 @@ int main(void)
 {
     UNITY_BEGIN();
     RUN_TEST(test_led);
+    RUN_TEST(test_led_output_compare_blink);
     return UNITY_END();
 }
@@ -0,0 +1,135 @@
+#include <unity.h>
+#include <string.h>
+#include "event_queue.h"
+#include "event_log.h"
+
+static uint8_t stream[256];
+static uint32_t stream_len;
+static event_log_t event_log;
+
+void setUp(void)
+{
+    event_log_init(&event_log);
+    stream_len = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/* Encode a record into the stream and commit it */
+static uint32_t _log(uint32_t timestamp_ms, uint8_t event, uint8_t state, bool has_payload, uint32_t payload)
+{
+    uint8_t record[EVENT_LOG_MAX_SIZE];
+    uint32_t len = has_payload ? event_log_encode_payload(&event_log, record, timestamp_ms, event, state, payload) : event_log_encode(&event_log, record, timestamp_ms, event, state);
+    memcpy(&stream[stream_len], record, len);
+    stream_len += len;
+    event_log_commit(&event_log, timestamp_ms);
+    return len;
+}
+
+/**
+ * @brief A record takes a byte of code and a byte of time up to 127 ms since the previous one, one more byte every 7 bits of time, and the bytes of its payload.
+ */
+void test_record_size(void)
+{
+    TEST_ASSERT_EQUAL(2, _log(127, EVENT_PIR_RISING, 0, false, 0));
+    TEST_ASSERT_EQUAL(2, _log(128, EVENT_LOG_STATE, 1, false, 0));
+    TEST_ASSERT_EQUAL(3, _log(128 + 16383, EVENT_MOTOR_TIMEOUT, 2, false, 0));
+    TEST_ASSERT_EQUAL(4, _log(128 + 16383 + 16384, EVENT_LOG_PRESENCE, 2, false, 0));
+    TEST_ASSERT_EQUAL(3, _log(128 + 16383 + 16384 + 1, EVENT_LOG_LOST, 3, true, 127));
+
+    // The longest record: 2^32 - 1 ms later and the largest payload
+    TEST_ASSERT_EQUAL(EVENT_LOG_MAX_SIZE, _log(128 + 16383 + 16384, EVENT_LOG_LOST, EVENT_LOG_MAX_STATE, true, UINT32_MAX));
+}
+
+/**
+ * @brief The records are read back with their event, state, payload and time, which goes on past the wrap-around of the 32-bit system time. A record encoded but not committed does not count for the time of the next one.
+ */
+void test_encode_and_read(void)
+{
+    const uint32_t times[] = {0, 0, 5000, 5001, 70000, 3600000, UINT32_MAX, 10};
+    const uint8_t events[] = {EVENT_PIR_RISING, EVENT_LOG_STATE, EVENT_LOG_PRESENCE, EVENT_MOTOR_TIMEOUT, EVENT_LOG_LOST, EVENT_BUTTON_PRESS, EVENT_LOG_STATE, EVENT_LOG_MAX_EVENT};
+    const uint8_t states[] = {0, 1, 1, 2, 2, 3, 0, EVENT_LOG_MAX_STATE};
+    for (uint32_t i = 0; i < sizeof(events); i++)
+    {
+        _log(times[i], events[i], states[i], events[i] == EVENT_LOG_LOST, 1000000U + i);
+
+        // Dropped by the output
+        uint8_t record[EVENT_LOG_MAX_SIZE];
+        event_log_encode(&event_log, record, times[i] + 3, EVENT_PIR_FALLING, states[i]);
+    }
+
+    event_log_reader_t reader;
+    event_log_entry_t entry;
+    event_log_reader_init(&reader, stream, stream_len);
+    for (uint32_t i = 0; i < sizeof(events); i++)
+    {
+        TEST_ASSERT_TRUE(event_log_read(&reader, &entry));
+        TEST_ASSERT_EQUAL_UINT64((i < 7) ? times[i] : (uint64_t)UINT32_MAX + 1 + times[i], entry.time_ms);
+        TEST_ASSERT_EQUAL(events[i], entry.event);
+        TEST_ASSERT_EQUAL(states[i], entry.state);
+        TEST_ASSERT_EQUAL(events[i] == EVENT_LOG_LOST, entry.has_payload);
+        TEST_ASSERT_EQUAL(entry.has_payload ? 1000000U + i : 0, entry.payload);
+    }
+    TEST_ASSERT_FALSE(event_log_read(&reader, &entry));
+    TEST_ASSERT_EQUAL(stream_len, reader.pos);
+}
+
+/**
+ * @brief A stream split in chunks at every possible byte reads the same: a record cut at the end of a chunk is read whole from the next one. A varint longer than 32 bits is not read.
+ */
+void test_chunks(void)
+{
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        _log(i * 40000U, (uint8_t)(i % 10), (uint8_t)(i % 4), (i % 3) == 0, i << 20);
+    }
+
+    for (uint32_t chunk = 1; chunk <= stream_len; chunk++)
+    {
+        uint8_t buffer[256];
+        uint32_t used = 0;
+        uint32_t offset = 0;
+        uint32_t count = 0;
+        event_log_reader_t reader;
+        event_log_entry_t entry;
+        event_log_reader_init(&reader, buffer, 0);
+        while (offset < stream_len)
+        {
+            // Keep the cut record and append the next chunk
+            memmove(buffer, &buffer[reader.pos], used - reader.pos);
+            used -= reader.pos;
+            uint32_t len = (stream_len - offset < chunk) ? stream_len - offset : chunk;
+            memcpy(&buffer[used], &stream[offset], len);
+            used += len;
+            offset += len;
+            event_log_reader_refill(&reader, buffer, used);
+            while (event_log_read(&reader, &entry))
+            {
+                TEST_ASSERT_EQUAL_UINT64(count * 40000U, entry.time_ms);
+                TEST_ASSERT_EQUAL(count % 10, entry.event);
+                TEST_ASSERT_EQUAL(((count % 3) == 0) ? count << 20 : 0, entry.payload);
+                count++;
+            }
+        }
+        TEST_ASSERT_EQUAL(20, count);
+        TEST_ASSERT_EQUAL(used, reader.pos);
+    }
+
+    const uint8_t too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x10};
+    event_log_reader_t reader;
+    event_log_entry_t entry;
+    event_log_reader_init(&reader, too_long, sizeof(too_long));
+    TEST_ASSERT_FALSE(event_log_read(&reader, &entry));
+    TEST_ASSERT_EQUAL(0, reader.pos);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_record_size);
+    RUN_TEST(test_encode_and_read);
+    RUN_TEST(test_chunks);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+#include <unity.h>
+#include "event_queue.h"
+#include "event_record.h"
+
+static uint8_t buffer[64];
+static event_record_t record;
+
+void setUp(void)
+{
+    event_record_init(&record, buffer, sizeof(buffer));
+}
+
+void tearDown(void)
+{
+}
+
+void test_record_size(void)
+{
+    // The first record counts from 0: 15 ms fits in the header byte, 16 ms does not
+    TEST_ASSERT_TRUE(event_record_append(&record, 15, EVENT_PIR_RISING));
+    TEST_ASSERT_EQUAL(1, event_record_get_length(&record));
+    TEST_ASSERT_TRUE(event_record_append(&record, 31, EVENT_PIR_FALLING));
+    TEST_ASSERT_EQUAL(3, event_record_get_length(&record));
+    TEST_ASSERT_TRUE(event_record_append(&record, 31 + 2047, EVENT_MOTOR_TIMEOUT));
+    TEST_ASSERT_EQUAL(5, event_record_get_length(&record));
+    TEST_ASSERT_TRUE(event_record_append(&record, UINT32_MAX, EVENT_BUTTON_PRESS));
+    TEST_ASSERT_EQUAL(5 + EVENT_RECORD_MAX_SIZE, event_record_get_length(&record));
+    TEST_ASSERT_EQUAL(4, event_record_get_count(&record));
+}
+
+void test_record_and_read(void)
+{
+    const uint32_t times[] = {0, 0, 5000, 5001, 6000, 70000, 3600000, 3600000};
+    const uint8_t events[] = {EVENT_PIR_RISING, EVENT_PIR_FALLING, EVENT_MOTOR_TIMEOUT, EVENT_BUTTON_PRESS, EVENT_BUTTON_RELEASE, EVENT_MOTOR_TIMEOUT, EVENT_PIR_RISING, EVENT_MOTOR_TIMEOUT};
+    event_record_reader_t reader;
+    uint32_t timestamp_ms;
+    uint8_t event;
+
+    for (uint32_t i = 0; i < sizeof(events); i++)
+    {
+        TEST_ASSERT_TRUE(event_record_append(&record, times[i], events[i]));
+    }
+
+    event_record_reader_init(&reader, buffer, event_record_get_length(&record));
+    for (uint32_t i = 0; i < sizeof(events); i++)
+    {
+        TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+        TEST_ASSERT_EQUAL(times[i], timestamp_ms);
+        TEST_ASSERT_EQUAL(events[i], event);
+    }
+    TEST_ASSERT_FALSE(event_record_read(&reader, &timestamp_ms, &event));
+
+    // A truncated record is not read
+    event_record_reader_init(&reader, buffer, 3);
+    TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+    TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+    TEST_ASSERT_FALSE(event_record_read(&reader, &timestamp_ms, &event));
+}
+
+void test_full_buffer_keeps_a_prefix(void)
+{
+    event_record_reader_t reader;
+    uint32_t timestamp_ms;
+    uint8_t event;
+
+    event_record_init(&record, buffer, 4);
+    TEST_ASSERT_TRUE(event_record_append(&record, 1, EVENT_PIR_RISING));
+    TEST_ASSERT_TRUE(event_record_append(&record, 1000, EVENT_PIR_FALLING));
+    TEST_ASSERT_FALSE(event_record_append(&record, 100000, EVENT_MOTOR_TIMEOUT));
+
+    // A record that would fit is dropped too: there must be no gap in the sequence
+    TEST_ASSERT_FALSE(event_record_append(&record, 100000, EVENT_BUTTON_PRESS));
+    TEST_ASSERT_EQUAL(2, event_record_get_dropped(&record));
+    TEST_ASSERT_EQUAL(2, event_record_get_count(&record));
+
+    event_record_reader_init(&reader, buffer, event_record_get_length(&record));
+    TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+    TEST_ASSERT_TRUE(event_record_read(&reader, &timestamp_ms, &event));
+    TEST_ASSERT_EQUAL(1000, timestamp_ms);
+    TEST_ASSERT_EQUAL(EVENT_PIR_FALLING, event);
+    TEST_ASSERT_FALSE(event_record_read(&reader, &timestamp_ms, &event));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_record_size);
+    RUN_TEST(test_record_and_read);
+    RUN_TEST(test_full_buffer_keeps_a_prefix);
+    return UNITY_END();
+}
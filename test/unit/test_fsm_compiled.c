@@ -0,0 +1,88 @@
+#include <unity.h>
+#include "fsm_compiled.h"
+
+/* Test FSM: arcs deliberately interleaved and with two arcs leaving the same state, to check the priority */
+static bool input_a = false;
+static bool input_b = false;
+static int last_output = -1;
+
+static bool check_a(fsm_t *p_this) { return input_a; }
+static bool check_b(fsm_t *p_this) { return input_b; }
+static void do_0(fsm_t *p_this) { last_output = 0; }
+static void do_1(fsm_t *p_this) { last_output = 1; }
+static void do_2(fsm_t *p_this) { last_output = 2; }
+
+#define TEST_TRANSITIONS(ARC)                  \
+    ARC(2, check_a, 0, do_2)                   \
+    ARC(0, check_a, 1, do_0)                   \
+    ARC(1, check_b, 2, fsm_compiled_no_action) \
+    ARC(0, check_b, 2, do_1)
+
+static fsm_trans_t test_trans[] = FSM_COMPILED_TABLE(TEST_TRANSITIONS);
+
+FSM_COMPILED_DEFINE_FIRE(test_fire_compiled, TEST_TRANSITIONS)
+
+void setUp(void)
+{
+    input_a = false;
+    input_b = false;
+    last_output = -1;
+}
+
+void tearDown(void)
+{
+}
+
+void test_table(void)
+{
+    TEST_ASSERT_EQUAL(2, test_trans[0].orig_state);
+    TEST_ASSERT_TRUE(test_trans[0].in == check_a);
+    TEST_ASSERT_EQUAL(0, test_trans[0].dest_state);
+    TEST_ASSERT_TRUE(test_trans[0].out == do_2);
+    TEST_ASSERT_EQUAL(-1, test_trans[4].orig_state);
+}
+
+void test_fire_same_as_stock(void)
+{
+    fsm_t stock;
+    fsm_t compiled;
+    fsm_init(&stock, test_trans);
+    fsm_init(&compiled, test_trans);
+
+    // Every combination of inputs from every state gives the same state, output and return value
+    for (int state = 0; state < 3; state++)
+    {
+        for (int inputs = 0; inputs < 4; inputs++)
+        {
+            input_a = inputs & 0x01;
+            input_b = inputs & 0x02;
+
+            fsm_set_state(&stock, state);
+            last_output = -1;
+            bool stock_transition = fsm_fire(&stock);
+            int stock_output = last_output;
+
+            fsm_set_state(&compiled, state);
+            last_output = -1;
+            int arc = test_fire_compiled(&compiled);
+
+            TEST_ASSERT_EQUAL(fsm_get_state(&stock), fsm_get_state(&compiled));
+            TEST_ASSERT_EQUAL(stock_output, last_output);
+            TEST_ASSERT_EQUAL(stock_transition, arc >= 0);
+            if (arc >= 0)
+            {
+                // The index is the row of the table that has been taken
+                TEST_ASSERT_EQUAL(state, test_trans[arc].orig_state);
+                TEST_ASSERT_EQUAL(fsm_get_state(&compiled), test_trans[arc].dest_state);
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_table);
+    RUN_TEST(test_fire_same_as_stock);
+    return UNITY_END();
+}
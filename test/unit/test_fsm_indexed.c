@@ -0,0 +1,134 @@
+#include <unity.h>
+#include "fsm_indexed.h"
+
+/* Test FSM: arcs deliberately interleaved and with two arcs leaving the same state, to check the stable sort */
+static bool input_a = false;
+static bool input_b = false;
+static int last_output = -1;
+
+static bool check_a(fsm_t *p_this) { return input_a; }
+static bool check_b(fsm_t *p_this) { return input_b; }
+static void do_0(fsm_t *p_this) { last_output = 0; }
+static void do_1(fsm_t *p_this) { last_output = 1; }
+static void do_2(fsm_t *p_this) { last_output = 2; }
+
+static fsm_trans_t test_trans[] = {
+    {2, check_a, 0, do_2},
+    {0, check_a, 1, do_0},
+    {1, check_b, 2, NULL},
+    {0, check_b, 2, do_1},
+    {-1, NULL, -1, NULL}};
+
+static fsm_indexed_t index_fsm;
+
+void setUp(void)
+{
+    input_a = false;
+    input_b = false;
+    last_output = -1;
+    TEST_ASSERT_TRUE(fsm_indexed_init(&index_fsm, test_trans));
+}
+
+void tearDown(void)
+{
+}
+
+void test_index_layout(void)
+{
+    TEST_ASSERT_EQUAL(4, index_fsm.num_trans);
+    TEST_ASSERT_EQUAL(2, index_fsm.count[0]);
+    TEST_ASSERT_EQUAL(1, index_fsm.count[1]);
+    TEST_ASSERT_EQUAL(1, index_fsm.count[2]);
+    TEST_ASSERT_EQUAL(0, index_fsm.offset[0]);
+    TEST_ASSERT_EQUAL(2, index_fsm.offset[1]);
+    TEST_ASSERT_EQUAL(3, index_fsm.offset[2]);
+
+    // Arcs of the same state keep the order of the table
+    TEST_ASSERT_TRUE(index_fsm.trans[0].out == do_0);
+    TEST_ASSERT_TRUE(index_fsm.trans[1].out == do_1);
+}
+
+void test_fire_same_as_stock(void)
+{
+    fsm_t stock;
+    fsm_t indexed;
+    fsm_init(&stock, test_trans);
+    fsm_init(&indexed, test_trans);
+
+    // Every combination of inputs from every state gives the same state and output
+    for (int state = 0; state < 3; state++)
+    {
+        for (int inputs = 0; inputs < 4; inputs++)
+        {
+            input_a = inputs & 0x01;
+            input_b = inputs & 0x02;
+
+            fsm_set_state(&stock, state);
+            last_output = -1;
+            fsm_fire(&stock);
+            int stock_output = last_output;
+
+            fsm_set_state(&indexed, state);
+            last_output = -1;
+            fsm_indexed_fire(&index_fsm, &indexed);
+
+            TEST_ASSERT_EQUAL(fsm_get_state(&stock), fsm_get_state(&indexed));
+            TEST_ASSERT_EQUAL(stock_output, last_output);
+        }
+    }
+}
+
+void test_no_transition(void)
+{
+    fsm_t fsm;
+    fsm_init(&fsm, test_trans);
+    fsm_set_state(&fsm, 1);
+    TEST_ASSERT_FALSE(fsm_indexed_fire(&index_fsm, &fsm));
+    TEST_ASSERT_EQUAL(1, fsm_get_state(&fsm));
+}
+
+void test_fire_arc_of_original_table(void)
+{
+    fsm_t fsm;
+    fsm_init(&fsm, test_trans);
+
+    // Both arcs leaving state 0 are true: the first one of the table is taken
+    input_a = true;
+    input_b = true;
+    fsm_set_state(&fsm, 0);
+    TEST_ASSERT_EQUAL(1, fsm_indexed_fire_arc(&index_fsm, &fsm));
+    fsm_set_state(&fsm, 2);
+    TEST_ASSERT_EQUAL(0, fsm_indexed_fire_arc(&index_fsm, &fsm));
+
+    input_a = false;
+    fsm_set_state(&fsm, 0);
+    TEST_ASSERT_EQUAL(3, fsm_indexed_fire_arc(&index_fsm, &fsm));
+    TEST_ASSERT_EQUAL(2, fsm_get_state(&fsm));
+
+    input_b = false;
+    fsm_set_state(&fsm, 1);
+    TEST_ASSERT_EQUAL(-1, fsm_indexed_fire_arc(&index_fsm, &fsm));
+}
+
+void test_table_too_big(void)
+{
+    static fsm_trans_t big_trans[FSM_INDEXED_MAX_TRANSITIONS + 2];
+    for (int i = 0; i < FSM_INDEXED_MAX_TRANSITIONS + 1; i++)
+    {
+        big_trans[i] = (fsm_trans_t){0, check_a, 0, NULL};
+    }
+    big_trans[FSM_INDEXED_MAX_TRANSITIONS + 1] = (fsm_trans_t){-1, NULL, -1, NULL};
+    TEST_ASSERT_FALSE(fsm_indexed_init(&index_fsm, big_trans));
+    TEST_ASSERT_EQUAL(0, index_fsm.num_trans);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_index_layout);
+    RUN_TEST(test_fire_same_as_stock);
+    RUN_TEST(test_no_transition);
+    RUN_TEST(test_fire_arc_of_original_table);
+    RUN_TEST(test_table_too_big);
+    return UNITY_END();
+}
@@ -0,0 +1,73 @@
+#include <unity.h>
+#include "fsm_stats.h"
+
+static fsm_stats_t stats;
+
+void setUp(void)
+{
+    fsm_stats_init(&stats, 0);
+}
+
+void tearDown(void)
+{
+}
+
+void test_bucket_boundaries(void)
+{
+    TEST_ASSERT_EQUAL(0, fsm_stats_bucket(0));
+    TEST_ASSERT_EQUAL(1, fsm_stats_bucket(1));
+    TEST_ASSERT_EQUAL(2, fsm_stats_bucket(2));
+    TEST_ASSERT_EQUAL(2, fsm_stats_bucket(3));
+    TEST_ASSERT_EQUAL(3, fsm_stats_bucket(4));
+
+    // Every bucket but the last one starts at a power of 2 and ends right before the next one
+    for (uint32_t b = 1; b < FSM_STATS_NUM_BUCKETS - 1; b++)
+    {
+        TEST_ASSERT_EQUAL(b, fsm_stats_bucket(fsm_stats_bucket_min_ms(b)));
+        TEST_ASSERT_EQUAL(b, fsm_stats_bucket(fsm_stats_bucket_min_ms(b + 1) - 1));
+        TEST_ASSERT_EQUAL(b + 1, fsm_stats_bucket(fsm_stats_bucket_min_ms(b + 1)));
+    }
+
+    // The last bucket is open-ended
+    TEST_ASSERT_EQUAL(FSM_STATS_NUM_BUCKETS - 1, fsm_stats_bucket(fsm_stats_bucket_min_ms(FSM_STATS_NUM_BUCKETS - 1)));
+    TEST_ASSERT_EQUAL(FSM_STATS_NUM_BUCKETS - 1, fsm_stats_bucket(UINT32_MAX));
+}
+
+void test_record_dwell_and_arcs(void)
+{
+    fsm_stats_data_t data;
+
+    fsm_stats_record(&stats, 5000, 0, 1, 0);
+    fsm_stats_record(&stats, 5000, 1, 2, 1); // 0 ms in state 1
+    fsm_stats_record(&stats, 7000, 2, 2, 2); // a transition to the same state does not end the dwell
+    fsm_stats_record(&stats, 9000, 2, 3, 3);
+
+    TEST_ASSERT_TRUE(fsm_stats_read(&stats, &data));
+    TEST_ASSERT_EQUAL(1, data.dwell[0][13]); // 5000 ms in [4096, 8192)
+    TEST_ASSERT_EQUAL(1, data.dwell[1][0]);
+    TEST_ASSERT_EQUAL(1, data.dwell[2][12]); // 4000 ms in [2048, 4096)
+    TEST_ASSERT_EQUAL(0, data.dwell[2][11]);
+    TEST_ASSERT_EQUAL(1, data.arcs[0]);
+    TEST_ASSERT_EQUAL(1, data.arcs[2]);
+    TEST_ASSERT_EQUAL(9000, data.state_entry_ms);
+}
+
+void test_dwell_across_wrap_around(void)
+{
+    fsm_stats_data_t data;
+
+    fsm_stats_init(&stats, UINT32_MAX - 99);
+    fsm_stats_record(&stats, 100, 0, 1, 0); // 200 ms across the wrap-around of the system time
+
+    TEST_ASSERT_TRUE(fsm_stats_read(&stats, &data));
+    TEST_ASSERT_EQUAL(1, data.dwell[0][fsm_stats_bucket(200)]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bucket_boundaries);
+    RUN_TEST(test_record_dwell_and_arcs);
+    RUN_TEST(test_dwell_across_wrap_around);
+    return UNITY_END();
+}
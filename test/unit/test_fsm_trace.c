@@ -0,0 +1,67 @@
+#include <unity.h>
+#include "fsm_trace.h"
+
+static fsm_trace_t trace;
+
+void setUp(void)
+{
+    fsm_trace_init(&trace);
+}
+
+void tearDown(void)
+{
+}
+
+void test_empty(void)
+{
+    fsm_trace_entry_t entries[FSM_TRACE_SIZE];
+    TEST_ASSERT_EQUAL(0, fsm_trace_dump(&trace, entries, FSM_TRACE_SIZE));
+    TEST_ASSERT_EQUAL(0, fsm_trace_get_count(&trace));
+}
+
+void test_record_and_dump(void)
+{
+    fsm_trace_entry_t entries[FSM_TRACE_SIZE];
+    fsm_trace_record(&trace, 100, 0, 1, 0, 0x31);
+    fsm_trace_record(&trace, 5100, 1, 2, 1, 0x44);
+
+    TEST_ASSERT_EQUAL(2, fsm_trace_dump(&trace, entries, FSM_TRACE_SIZE));
+    TEST_ASSERT_EQUAL(100, entries[0].timestamp_ms);
+    TEST_ASSERT_EQUAL(0, entries[0].from_state);
+    TEST_ASSERT_EQUAL(1, entries[0].to_state);
+    TEST_ASSERT_EQUAL(0, entries[0].arc);
+    TEST_ASSERT_EQUAL_HEX8(0x31, entries[0].inputs);
+    TEST_ASSERT_EQUAL(5100, entries[1].timestamp_ms);
+    TEST_ASSERT_EQUAL(1, entries[1].arc);
+}
+
+void test_overwrite_oldest(void)
+{
+    fsm_trace_entry_t entries[FSM_TRACE_SIZE];
+    for (uint32_t i = 0; i < FSM_TRACE_SIZE + 5; i++)
+    {
+        fsm_trace_record(&trace, i, 0, 0, 0, 0);
+    }
+    TEST_ASSERT_EQUAL(FSM_TRACE_SIZE + 5, fsm_trace_get_count(&trace));
+
+    // Only the last FSM_TRACE_SIZE entries are kept, oldest first
+    TEST_ASSERT_EQUAL(FSM_TRACE_SIZE, fsm_trace_dump(&trace, entries, FSM_TRACE_SIZE));
+    for (uint32_t i = 0; i < FSM_TRACE_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL(i + 5, entries[i].timestamp_ms);
+    }
+
+    // With a smaller array, the newest entries are copied
+    TEST_ASSERT_EQUAL(3, fsm_trace_dump(&trace, entries, 3));
+    TEST_ASSERT_EQUAL(FSM_TRACE_SIZE + 2, entries[0].timestamp_ms);
+    TEST_ASSERT_EQUAL(FSM_TRACE_SIZE + 4, entries[2].timestamp_ms);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_record_and_dump);
+    RUN_TEST(test_overwrite_oldest);
+    return UNITY_END();
+}
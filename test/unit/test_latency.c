@@ -0,0 +1,98 @@
+#include <unity.h>
+#include "latency.h"
+#include "port_system.h"
+
+static latency_t latency;
+
+void setUp(void)
+{
+    latency_init(&latency);
+}
+
+void tearDown(void)
+{
+}
+
+void test_bucket_boundaries(void)
+{
+    // Exact buckets below LATENCY_SUB_BUCKETS, then LATENCY_SUB_BUCKETS per power of 2
+    for (uint32_t cycles = 0; cycles < LATENCY_SUB_BUCKETS; cycles++)
+    {
+        TEST_ASSERT_EQUAL(cycles, latency_bucket(cycles));
+    }
+    for (uint32_t b = 0; b < LATENCY_NUM_BUCKETS - 1; b++)
+    {
+        TEST_ASSERT_EQUAL(b, latency_bucket(latency_bucket_min_cycles(b)));
+        TEST_ASSERT_EQUAL(b, latency_bucket(latency_bucket_min_cycles(b + 1) - 1));
+    }
+    TEST_ASSERT_EQUAL(LATENCY_NUM_BUCKETS - 1, latency_bucket(UINT32_MAX));
+}
+
+void test_report(void)
+{
+    latency_report_t report;
+
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(0, report.count);
+    TEST_ASSERT_EQUAL(0, report.min_cycles);
+
+    // 99 fast samples and a slow one: the p99 is in the fast ones
+    for (uint32_t i = 0; i < 99; i++)
+    {
+        latency_record(&latency, 1000);
+    }
+    latency_record(&latency, 100000);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(100, report.count);
+    TEST_ASSERT_EQUAL(1000, report.min_cycles);
+    TEST_ASSERT_EQUAL(1990, report.mean_cycles);
+    TEST_ASSERT_EQUAL(100000, report.max_cycles);
+    TEST_ASSERT_EQUAL(latency_bucket(1000), latency_bucket(report.p99_cycles));
+    TEST_ASSERT_EQUAL(port_system_get_cycles_per_us(), report.cycles_per_us);
+
+    // One more slow sample moves the p99 to the slow ones, never above the max
+    latency_record(&latency, 100000);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(100000, report.p99_cycles);
+}
+
+void test_start_and_stop(void)
+{
+    latency_report_t report;
+
+    // A stop without start is not a sample
+    latency_stop(&latency, 500);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(0, report.count);
+
+    // The last start before the stop is the one measured, and only once
+    latency_start(&latency, 100);
+    latency_start(&latency, 1000);
+    latency_stop(&latency, 1500);
+    latency_stop(&latency, 2000);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(1, report.count);
+    TEST_ASSERT_UINT32_WITHIN(1, 500, report.max_cycles);
+
+    // Across the wrap-around of the cycle counter
+    latency_start(&latency, UINT32_MAX - 99);
+    latency_stop(&latency, 100);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_UINT32_WITHIN(1, 200, report.min_cycles);
+
+    // A cancelled start is not a sample
+    latency_start(&latency, 3000);
+    latency_cancel(&latency);
+    latency_stop(&latency, 4000);
+    latency_get_report(&latency, &report);
+    TEST_ASSERT_EQUAL(2, report.count);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bucket_boundaries);
+    RUN_TEST(test_report);
+    RUN_TEST(test_start_and_stop);
+    return UNITY_END();
+}
@@ -13,19 +13,19 @@ void tearDown(void)
 
 void test_led(void)
 {
-    port_led_gpio_setup();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_init(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 
-    port_led_on();
-    TEST_ASSERT_TRUE(port_led_get_status());
+    port_led_on(&led_opening);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_opening));
 
-    port_led_off();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_off(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 
-    port_led_toggle();
-    TEST_ASSERT_TRUE(port_led_get_status());
-    port_led_toggle();
-    TEST_ASSERT_FALSE(port_led_get_status());
+    port_led_toggle(&led_opening);
+    TEST_ASSERT_TRUE(port_led_get_status(&led_opening));
+    port_led_toggle(&led_opening);
+    TEST_ASSERT_FALSE(port_led_get_status(&led_opening));
 }
 
 
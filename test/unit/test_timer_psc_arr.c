@@ -0,0 +1,148 @@
+#include <unity.h>
+#include "timer_psc_arr.h"
+
+#define TEST_CLOCK_HZ 16000000U  /*!< Clock of the timers of the board */
+#define TEST_MAX_PERIOD_MS 60000 /*!< Longest period of the sweep */
+
+/* Nearest integer, halfway cases away from zero, as round() (without libm) */
+static double _round(double x)
+{
+    return (double)(int64_t)(x >= 0.0 ? x + 0.5 : x - 0.5);
+}
+
+/**
+ * @brief Computation of PSC and ARR replaced by the solver, as it was in `port_motor_timeout_timer_activate()` and `port_led_timer_setup()`.
+ *
+ * @return false if it gives values out of the registers.
+ */
+static bool _reference_solve(uint32_t clock_hz, uint32_t period_ms, timer_psc_arr_t *p_psc_arr)
+{
+    double sec = (double)period_ms / 1000.0;
+    double scc = (double)clock_hz;
+    double psc = _round(((scc * sec) / (65535.0 + 1.0)) - 1.0);
+    double arr = _round(((scc * sec) / (psc + 1.0)) - 1.0);
+    if (arr > 0xFFFF)
+    {
+        psc += 1.0;
+        arr = _round((scc * sec) / (psc + 1.0) - 1.0);
+    }
+    if (psc < 0.0 || psc > 0xFFFF || arr < 0.0 || arr > 0xFFFF)
+    {
+        return false;
+    }
+    p_psc_arr->psc = (uint32_t)psc;
+    p_psc_arr->arr = (uint32_t)arr;
+    return true;
+}
+
+static uint64_t _error(const timer_psc_arr_t *p_psc_arr, uint64_t ticks)
+{
+    uint64_t period = timer_psc_arr_get_ticks(p_psc_arr);
+    return period > ticks ? period - ticks : ticks - period;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_timeouts_of_the_door_are_exact(void)
+{
+    timer_psc_arr_t psc_arr;
+    TEST_ASSERT_TRUE(timer_psc_arr_solve(TEST_CLOCK_HZ, 5000, &psc_arr));
+    TEST_ASSERT_EQUAL(1249, psc_arr.psc);
+    TEST_ASSERT_EQUAL(63999, psc_arr.arr);
+    TEST_ASSERT_TRUE(timer_psc_arr_solve(TEST_CLOCK_HZ, 10000, &psc_arr));
+    TEST_ASSERT_EQUAL(160000000ULL, timer_psc_arr_get_ticks(&psc_arr));
+    TEST_ASSERT_TRUE(timer_psc_arr_solve(TEST_CLOCK_HZ, 100, &psc_arr));
+    TEST_ASSERT_EQUAL(24, psc_arr.psc);
+    TEST_ASSERT_EQUAL(63999, psc_arr.arr);
+    TEST_ASSERT_TRUE(timer_psc_arr_solve(TEST_CLOCK_HZ, 500, &psc_arr));
+    TEST_ASSERT_EQUAL(8000000ULL, timer_psc_arr_get_ticks(&psc_arr));
+}
+
+/**
+ * @brief Sweep 1 ms..60 s: the registers always fit, the error is at most half a tick of the prescaled clock and never worse than with the `double` computation. The old computation gave no valid values below 3 ms (negative prescaler).
+ */
+void test_sweep_never_worse_than_double(void)
+{
+    uint32_t reference_invalid = 0;
+    uint64_t error_sum = 0;
+    uint64_t reference_error_sum = 0;
+
+    for (uint32_t ms = 1; ms <= TEST_MAX_PERIOD_MS; ms++)
+    {
+        uint64_t ticks = (uint64_t)(TEST_CLOCK_HZ / 1000U) * ms;
+        timer_psc_arr_t psc_arr;
+        TEST_ASSERT_TRUE(timer_psc_arr_solve(TEST_CLOCK_HZ, ms, &psc_arr));
+        TEST_ASSERT_TRUE(psc_arr.psc <= 0xFFFF);
+        TEST_ASSERT_TRUE(psc_arr.arr <= 0xFFFF);
+        uint64_t error = _error(&psc_arr, ticks);
+        TEST_ASSERT_TRUE(2 * error <= psc_arr.psc + 1);
+        error_sum += error;
+
+        timer_psc_arr_t reference;
+        if (!_reference_solve(TEST_CLOCK_HZ, ms, &reference))
+        {
+            reference_invalid++;
+            continue;
+        }
+        uint64_t reference_error = _error(&reference, ticks);
+        TEST_ASSERT_TRUE(error <= reference_error);
+        reference_error_sum += reference_error;
+    }
+    TEST_ASSERT_EQUAL(2, reference_invalid);
+    TEST_ASSERT_TRUE(error_sum * 10 < reference_error_sum);
+}
+
+void test_other_clocks_and_limits(void)
+{
+    static const uint32_t clocks_hz[] = {1000000U, 32768U, 84000000U, 180000000U};
+    for (uint32_t c = 0; c < sizeof(clocks_hz) / sizeof(clocks_hz[0]); c++)
+    {
+        for (uint32_t ms = 1; ms <= TEST_MAX_PERIOD_MS; ms += 7)
+        {
+            uint64_t ticks = TIMER_PSC_ARR_TICKS(clocks_hz[c], ms);
+            timer_psc_arr_t psc_arr;
+            if (ticks > UINT32_MAX)
+            {
+                TEST_ASSERT_FALSE(timer_psc_arr_solve(clocks_hz[c], ms, &psc_arr));
+                TEST_ASSERT_EQUAL(0xFFFF, psc_arr.psc);
+                TEST_ASSERT_EQUAL(0xFFFF, psc_arr.arr);
+                continue;
+            }
+            TEST_ASSERT_TRUE(timer_psc_arr_solve(clocks_hz[c], ms, &psc_arr));
+            TEST_ASSERT_TRUE(2 * _error(&psc_arr, ticks) <= psc_arr.psc + 1);
+        }
+    }
+
+    // Shorter than a tick
+    timer_psc_arr_t psc_arr;
+    TEST_ASSERT_FALSE(timer_psc_arr_solve(TEST_CLOCK_HZ, 0, &psc_arr));
+    TEST_ASSERT_EQUAL(1, timer_psc_arr_get_ticks(&psc_arr));
+}
+
+void test_compile_time_values(void)
+{
+    // The smallest prescaler that fits, with the nearest ARR
+    static const timer_psc_arr_t blink = TIMER_PSC_ARR_CONST(TEST_CLOCK_HZ, 100);
+    static const timer_psc_arr_t timeout = TIMER_PSC_ARR_CONST(TEST_CLOCK_HZ, 5000);
+    TEST_ASSERT_EQUAL(24, blink.psc);
+    TEST_ASSERT_EQUAL(63999, blink.arr);
+    TEST_ASSERT_EQUAL(1220, timeout.psc);
+    TEST_ASSERT_EQUAL(65520 - 1, timeout.arr);
+    TEST_ASSERT_TRUE(2 * _error(&timeout, 80000000ULL) <= timeout.psc + 1);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_timeouts_of_the_door_are_exact);
+    RUN_TEST(test_sweep_never_worse_than_double);
+    RUN_TEST(test_other_clocks_and_limits);
+    RUN_TEST(test_compile_time_values);
+    return UNITY_END();
+}
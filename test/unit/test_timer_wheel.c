@@ -0,0 +1,181 @@
+#include <unity.h>
+#include "timer_wheel.h"
+
+#define TEST_NUM_TIMERS 256 /*!< Timers pending at the same time in the random test */
+
+static timer_wheel_t wheel;
+static timer_wheel_timer_t timers[TEST_NUM_TIMERS];
+static uint32_t fired_at[TEST_NUM_TIMERS];    /*!< Tick of the last expiry of each timer */
+static uint32_t fired_count[TEST_NUM_TIMERS]; /*!< Number of expiries of each timer */
+static uint32_t rng_state;
+
+static uint32_t _rand(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void _record(void *p_arg)
+{
+    timer_wheel_timer_t *p_timer = p_arg;
+    uint32_t index = (uint32_t)(p_timer - timers);
+    fired_at[index] = wheel.now;
+    fired_count[index]++;
+}
+
+void setUp(void)
+{
+    rng_state = 0x2545F491;
+    for (uint32_t i = 0; i < TEST_NUM_TIMERS; i++)
+    {
+        timer_wheel_timer_init(&timers[i], _record, &timers[i]);
+        fired_at[i] = 0;
+        fired_count[i] = 0;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief One-shot timers expire in the exact tick at the boundaries of every level, also across the wrap-around of the 32-bit time.
+ */
+void test_exact_expiry_at_level_boundaries(void)
+{
+    static const uint32_t delays[] = {1, 2, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145, TIMER_WHEEL_MAX_DELAY};
+    static const uint32_t starts[] = {0, 12345, 0xFFFFFFFFU - 100};
+    for (uint32_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++)
+    {
+        for (uint32_t d = 0; d < sizeof(delays) / sizeof(delays[0]); d++)
+        {
+            timer_wheel_init(&wheel, starts[s]);
+            fired_count[0] = 0;
+            timer_wheel_arm(&wheel, &timers[0], delays[d], 0);
+            TEST_ASSERT_TRUE(timer_wheel_timer_is_pending(&timers[0]));
+            timer_wheel_advance(&wheel, starts[s] + delays[d] - 1);
+            TEST_ASSERT_EQUAL(0, fired_count[0]);
+            timer_wheel_advance(&wheel, starts[s] + delays[d]);
+            TEST_ASSERT_EQUAL(1, fired_count[0]);
+            TEST_ASSERT_EQUAL(starts[s] + delays[d], fired_at[0]);
+            TEST_ASSERT_FALSE(timer_wheel_timer_is_pending(&timers[0]));
+            TEST_ASSERT_EQUAL(0, wheel.pending);
+        }
+    }
+
+    // Delay 0 expires in the next tick and longer delays are clamped
+    timer_wheel_init(&wheel, 0);
+    timer_wheel_arm(&wheel, &timers[0], 0, 0);
+    timer_wheel_arm(&wheel, &timers[1], UINT32_MAX, 0);
+    timer_wheel_advance(&wheel, TIMER_WHEEL_MAX_DELAY);
+    TEST_ASSERT_EQUAL(1, fired_at[0]);
+    TEST_ASSERT_EQUAL(TIMER_WHEEL_MAX_DELAY, fired_at[1]);
+}
+
+/**
+ * @brief Random arms, re-arms and cancels of many timers against a reference of their expiry times.
+ */
+void test_random_timers_against_reference(void)
+{
+    uint32_t expected[TEST_NUM_TIMERS];
+    bool armed[TEST_NUM_TIMERS];
+    uint32_t now = 1000;
+    timer_wheel_init(&wheel, now);
+    for (uint32_t i = 0; i < TEST_NUM_TIMERS; i++)
+    {
+        armed[i] = false;
+    }
+
+    for (uint32_t step = 0; step < 20000; step++)
+    {
+        uint32_t i = _rand() % TEST_NUM_TIMERS;
+        uint32_t op = _rand() % 8;
+        if (op < 6)
+        {
+            // Mostly short delays (blinking and door timeouts), some long ones to cross the upper levels
+            uint32_t delay = (op < 5) ? 1 + _rand() % 12000 : 1 + _rand() % 400000;
+            timer_wheel_arm(&wheel, &timers[i], delay, 0);
+            expected[i] = now + delay;
+            armed[i] = true;
+        }
+        else if (op == 6)
+        {
+            timer_wheel_cancel(&wheel, &timers[i]);
+            armed[i] = false;
+        }
+        else
+        {
+            now += _rand() % 200;
+            timer_wheel_advance(&wheel, now);
+        }
+
+        uint32_t pending = 0;
+        for (uint32_t j = 0; j < TEST_NUM_TIMERS; j++)
+        {
+            if (armed[j] && (int32_t)(now - expected[j]) >= 0)
+            {
+                // Expired: exactly at its tick
+                TEST_ASSERT_FALSE(timer_wheel_timer_is_pending(&timers[j]));
+                TEST_ASSERT_EQUAL(expected[j], fired_at[j]);
+                armed[j] = false;
+            }
+            pending += armed[j];
+            TEST_ASSERT_EQUAL(armed[j], timer_wheel_timer_is_pending(&timers[j]));
+        }
+        TEST_ASSERT_EQUAL(pending, wheel.pending);
+    }
+}
+
+static void _cancel_other(void *p_arg)
+{
+    _record(p_arg);
+    timer_wheel_cancel(&wheel, (p_arg == &timers[2]) ? &timers[3] : &timers[2]);
+}
+
+/**
+ * @brief Periodic timers keep their exact period, and callbacks can cancel timers that expire in the same tick.
+ */
+void test_periodic_and_callbacks(void)
+{
+    timer_wheel_init(&wheel, 0);
+    timer_wheel_arm(&wheel, &timers[0], 100, 100);
+    timer_wheel_arm(&wheel, &timers[1], 500, 500);
+    timer_wheel_advance(&wheel, 10000);
+    TEST_ASSERT_EQUAL(100, fired_count[0]);
+    TEST_ASSERT_EQUAL(10000, fired_at[0]);
+    TEST_ASSERT_EQUAL(20, fired_count[1]);
+    TEST_ASSERT_TRUE(timer_wheel_timer_is_pending(&timers[0]));
+
+    // Re-arming a periodic timer restarts its period from now
+    timer_wheel_arm(&wheel, &timers[0], 30, 100);
+    timer_wheel_advance(&wheel, 10130);
+    TEST_ASSERT_EQUAL(102, fired_count[0]);
+    TEST_ASSERT_EQUAL(10130, fired_at[0]);
+    timer_wheel_cancel(&wheel, &timers[0]);
+    timer_wheel_cancel(&wheel, &timers[1]);
+    TEST_ASSERT_EQUAL(0, wheel.pending);
+
+    // Two timers in the same tick: whichever runs first cancels the other
+    timer_wheel_timer_init(&timers[2], _cancel_other, &timers[2]);
+    timer_wheel_timer_init(&timers[3], _cancel_other, &timers[3]);
+    timer_wheel_arm(&wheel, &timers[2], 5000, 0);
+    timer_wheel_arm(&wheel, &timers[3], 5000, 0);
+    timer_wheel_advance(&wheel, 20000);
+    TEST_ASSERT_EQUAL(1, fired_count[2] + fired_count[3]);
+    TEST_ASSERT_EQUAL(0, wheel.pending);
+
+    // With no timer pending the wheel jumps to the current time
+    timer_wheel_advance(&wheel, 0x80000000U);
+    TEST_ASSERT_EQUAL(0x80000000U, wheel.now);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_exact_expiry_at_level_boundaries);
+    RUN_TEST(test_random_timers_against_reference);
+    RUN_TEST(test_periodic_and_callbacks);
+    return UNITY_END();
+}